@@ -0,0 +1,131 @@
+#include "ArenaAllocator.hpp"
+
+#include <algorithm>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+// 块直接向系统申请页面: release 时立即归还系统, 也不会像大块 malloc/free 那样抬高 malloc 的 mmap 阈值,
+// 使之后的中等分配留在堆里形成碎片。未写入的页面不计入 RSS, 因此按估算上限申请块没有额外代价
+static size_t pageSize() {
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return static_cast<size_t>(info.dwPageSize);
+#else
+    return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+static uint8_t* mapPages(size_t size) {
+#ifdef _WIN32
+    return static_cast<uint8_t*>(VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE));
+#else
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    return data == MAP_FAILED ? nullptr : static_cast<uint8_t*>(data);
+#endif
+}
+
+static void unmapPages(uint8_t* data, size_t size) {
+#ifdef _WIN32
+    (void)size;
+    VirtualFree(data, 0, MEM_RELEASE);
+#else
+    munmap(data, size);
+#endif
+}
+
+MonotonicArena::MonotonicArena(size_t initialBlockSize, bool threadSafe)
+    : m_initialBlockSize(std::max<size_t>(initialBlockSize, 256)),
+      m_threadSafe(threadSafe),
+      m_nextBlockSize(m_initialBlockSize) {
+}
+
+MonotonicArena::~MonotonicArena() {
+    release();
+}
+
+void* MonotonicArena::allocate(size_t bytes, size_t alignment) {
+    if (m_threadSafe) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return allocateLocked(bytes, alignment);
+    }
+    return allocateLocked(bytes, alignment);
+}
+
+void* MonotonicArena::allocateLocked(size_t bytes, size_t alignment) {
+    if (bytes == 0) bytes = 1;      // 与 operator new 一致: 零字节分配也返回不同的地址
+
+    // 先在当前块及 rewind 后保留的块中查找, 都放不下时申请新块
+    while (m_current < m_blocks.size()) {
+        const Block& block = m_blocks[m_current];
+        const uintptr_t base = reinterpret_cast<uintptr_t>(block.data);
+        const size_t aligned = static_cast<size_t>(((base + m_offset + alignment - 1) & ~(uintptr_t(alignment) - 1)) - base);
+        if (aligned + bytes <= block.size) {
+            m_stats.usedBytes += aligned + bytes - m_offset;
+            m_stats.peakUsedBytes = std::max(m_stats.peakUsedBytes, m_stats.usedBytes);
+            ++m_stats.allocations;
+            m_offset = aligned + bytes;
+            return block.data + aligned;
+        }
+        if (m_current + 1 == m_blocks.size()) break;
+        m_stats.usedBytes += block.size - m_offset;     // 放弃当前块的剩余部分
+        ++m_current;
+        m_offset = 0;
+    }
+
+    // 块起点按页对齐, 超过页大小的对齐要求靠多申请 alignment 字节满足
+    static const size_t kPageSize = pageSize();
+    const size_t padding = alignment > kPageSize ? alignment : 0;
+    const size_t size = (std::max(m_nextBlockSize, bytes + padding) + kPageSize - 1) & ~(kPageSize - 1);
+    uint8_t* data = mapPages(size);
+    if (!data) throw std::bad_alloc();
+    if (!m_blocks.empty()) {
+        m_stats.usedBytes += m_blocks[m_current].size - m_offset;
+    }
+    m_blocks.push_back({ data, size });
+    m_current = m_blocks.size() - 1;
+    m_offset = 0;
+    m_nextBlockSize = std::min(m_nextBlockSize * 2, std::max(kMaxBlockSize, m_initialBlockSize));
+    ++m_stats.blocks;
+    m_stats.reservedBytes += size;
+    return allocateLocked(bytes, alignment);
+}
+
+void MonotonicArena::release() {
+    std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+    if (m_threadSafe) lock.lock();
+    for (const Block& block : m_blocks) {
+        unmapPages(block.data, block.size);
+    }
+    m_blocks.clear();
+    m_current = 0;
+    m_offset = 0;
+    m_nextBlockSize = m_initialBlockSize;
+    m_stats.reservedBytes = 0;
+    m_stats.usedBytes = 0;
+}
+
+MonotonicArena::Marker MonotonicArena::mark() const {
+    return { m_current, m_offset, m_stats.usedBytes };
+}
+
+void MonotonicArena::rewind(const Marker& marker) {
+    if (m_blocks.empty()) return;
+    m_current = marker.block;
+    m_offset = marker.offset;
+    m_stats.usedBytes = marker.used;
+}
+
+MonotonicArena::Stats MonotonicArena::stats() const {
+    std::unique_lock<std::mutex> lock(m_mutex, std::defer_lock);
+    if (m_threadSafe) lock.lock();
+    return m_stats;
+}
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 单调 (只增不减) 内存区: 按块向系统申请内存, 分配只移动块内游标, 整体一次性释放
+ *
+ * 用于导入期间的临时数据: 大量生命周期相同的缓冲区不再逐个 new/delete, 而是在 release()
+ * 或析构时一起归还。单个分配不能单独释放 (deallocate 为空操作)。
+ *
+ * 块大小从 initialBlockSize 开始逐块翻倍 (上限 kMaxBlockSize), 超过当前块大小的请求单独成块。
+ * threadSafe 为 true 时 allocate 加锁, 可被多个工作线程共享; mark / rewind 只能在单线程下使用。
+ */
+class MonotonicArena {
+public:
+    static constexpr size_t kDefaultBlockSize = 64u << 10;
+    static constexpr size_t kMaxBlockSize     = 16u << 20;
+
+    struct Stats {
+        size_t allocations   = 0;   // allocate 调用次数
+        size_t blocks        = 0;   // 向系统申请的块数 (即实际的堆分配次数)
+        size_t reservedBytes = 0;   // 当前持有的块总大小
+        size_t usedBytes     = 0;   // 当前已分配出去的字节 (含对齐填充)
+        size_t peakUsedBytes = 0;
+    };
+
+    // rewind 的回退点
+    struct Marker {
+        size_t block  = 0;
+        size_t offset = 0;
+        size_t used   = 0;
+    };
+
+    explicit MonotonicArena(size_t initialBlockSize = kDefaultBlockSize, bool threadSafe = false);
+    ~MonotonicArena();
+
+    MonotonicArena(const MonotonicArena&)            = delete;
+    MonotonicArena& operator=(const MonotonicArena&) = delete;
+
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t));
+
+    template <typename T>
+    T* allocateArray(size_t count) {
+        return static_cast<T*>(allocate(count * sizeof(T), alignof(T)));
+    }
+
+    // 归还全部块, 之前分配的内存全部失效
+    void release();
+
+    // 回退到 mark() 时的位置, 保留已申请的块供后续分配复用 (单线程)
+    Marker mark() const;
+    void rewind(const Marker& marker);
+
+    Stats stats() const;
+
+private:
+    struct Block {
+        uint8_t* data = nullptr;
+        size_t   size = 0;
+    };
+
+    void* allocateLocked(size_t bytes, size_t alignment);
+
+    const size_t m_initialBlockSize;
+    const bool   m_threadSafe;
+    mutable std::mutex m_mutex;
+
+    std::vector<Block> m_blocks;
+    size_t m_current = 0;       // 正在使用的块下标 (rewind 后其后的块保留复用)
+    size_t m_offset  = 0;       // 当前块内的游标
+    size_t m_nextBlockSize;
+    Stats  m_stats;
+};
+
+/**
+ * @brief 在作用域结束时把 arena 回退到进入时的位置, 用于函数内的临时数组
+ */
+class ArenaScope {
+public:
+    explicit ArenaScope(MonotonicArena* arena) : m_arena(arena) {
+        if (m_arena) m_marker = m_arena->mark();
+    }
+    ~ArenaScope() {
+        if (m_arena) m_arena->rewind(m_marker);
+    }
+
+    ArenaScope(const ArenaScope&)            = delete;
+    ArenaScope& operator=(const ArenaScope&) = delete;
+
+private:
+    MonotonicArena* m_arena;
+    MonotonicArena::Marker m_marker;
+};
+
+/**
+ * @brief 标准容器分配器适配: 从 MonotonicArena 分配, arena 为空时退回全局 operator new
+ *
+ * 无参 construct 采用默认初始化 (不清零), resize 出的算术类型元素需要调用方自行写满。
+ * 移动/交换时分配器随容器一起传递, 容器可以在 Model 的成员之间自由移动。
+ */
+template <typename T>
+class ArenaAllocator {
+public:
+    using value_type = T;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap            = std::true_type;
+
+    ArenaAllocator() noexcept = default;
+    explicit ArenaAllocator(MonotonicArena* arena) noexcept : m_arena(arena) {}
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept : m_arena(other.arena()) {}
+
+    T* allocate(size_t count) {
+        if (m_arena) return m_arena->allocateArray<T>(count);
+        return static_cast<T*>(::operator new(count * sizeof(T)));
+    }
+
+    void deallocate(T* pointer, size_t) noexcept {
+        if (!m_arena) ::operator delete(pointer);
+    }
+
+    template <typename U>
+    void construct(U* pointer) noexcept(std::is_nothrow_default_constructible<U>::value) {
+        ::new (static_cast<void*>(pointer)) U;
+    }
+
+    template <typename U, typename... Args>
+    void construct(U* pointer, Args&&... args) {
+        ::new (static_cast<void*>(pointer)) U(std::forward<Args>(args)...);
+    }
+
+    MonotonicArena* arena() const noexcept { return m_arena; }
+
+private:
+    MonotonicArena* m_arena = nullptr;
+};
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept {
+    return a.arena() == b.arena();
+}
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept {
+    return a.arena() != b.arena();
+}
+
+template <typename T>
+using ArenaVector = std::vector<T, ArenaAllocator<T>>;
@@ -0,0 +1,98 @@
+#include "AssetCache.hpp"
+
+#include "macros.h"
+
+AssetCache& AssetCache::getInstance() {
+    static AssetCache instance;
+    return instance;
+}
+
+std::shared_ptr<const void> AssetCache::findErased(const std::string& key, const std::type_info& type) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_index.find(key);
+    if (it == m_index.end() || *it->second->type != type) {
+        ++m_misses;
+        return nullptr;
+    }
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    ++m_hits;
+    return it->second->value;
+}
+
+void AssetCache::insertErased(const std::string& key, std::shared_ptr<const void> value, const std::type_info& type,
+                              size_t bytes) {
+    if (!value) return;
+
+    // 旧值与被淘汰的值可能是最后一个引用 (析构会释放大块内存), 放到锁外析构
+    EntryList dropped;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (bytes > m_capacity) {
+            LOGI("AssetCache: %s (%d KB) exceeds the capacity of %d KB, not cached",
+                 key.c_str(), static_cast<int>(bytes / 1024), static_cast<int>(m_capacity / 1024));
+            return;
+        }
+        auto it = m_index.find(key);
+        if (it != m_index.end()) {
+            m_bytes -= it->second->bytes;
+            dropped.splice(dropped.end(), m_entries, it->second);
+            m_index.erase(it);
+        }
+        m_entries.push_front({ key, std::move(value), &type, bytes });
+        m_index[key] = m_entries.begin();
+        m_bytes += bytes;
+        ++m_insertions;
+        evictLocked(m_capacity, dropped);
+    }
+}
+
+void AssetCache::evictLocked(size_t capacity, EntryList& dropped) {
+    while (m_bytes > capacity && !m_entries.empty()) {
+        auto last = std::prev(m_entries.end());
+        m_bytes -= last->bytes;
+        m_index.erase(last->key);
+        dropped.splice(dropped.end(), m_entries, last);
+        ++m_evictions;
+    }
+}
+
+void AssetCache::setCapacity(size_t bytes) {
+    EntryList dropped;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_capacity = bytes;
+    evictLocked(m_capacity, dropped);
+}
+
+size_t AssetCache::capacity() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_capacity;
+}
+
+void AssetCache::clear() {
+    EntryList dropped;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    dropped.swap(m_entries);
+    m_index.clear();
+    m_bytes = 0;
+}
+
+AssetCache::Stats AssetCache::stats() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    Stats result;
+    result.hits       = m_hits;
+    result.misses     = m_misses;
+    result.insertions = m_insertions;
+    result.evictions  = m_evictions;
+    result.entries    = m_entries.size();
+    result.bytes      = m_bytes;
+    result.capacity   = m_capacity;
+    return result;
+}
+
+void AssetCache::logStats() const {
+    const Stats s = stats();
+    LOGI("AssetCache: %d hits, %d misses, %d insertions, %d evictions, %d entries, %d KB / %d KB",
+         static_cast<int>(s.hits), static_cast<int>(s.misses), static_cast<int>(s.insertions),
+         static_cast<int>(s.evictions), static_cast<int>(s.entries),
+         static_cast<int>(s.bytes / 1024), static_cast<int>(s.capacity / 1024));
+}
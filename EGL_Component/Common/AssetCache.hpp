@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+
+/**
+ * @brief 进程级 CPU 资源缓存 - 单例模式
+ *
+ * 保存解码后的图像与暂存完成的模型几何 (只读快照), 生命周期与进程相同, 不依赖 GL 上下文。
+ * Android 上表面重建 (旋转、切换应用) 会销毁并重新创建 ModelRenderer, 新的渲染器从这里取回
+ * CPU 数据, 只需重新上传到 GL, 不再重新导入模型或解码图像。
+ * 条目在上传后仍占用 CPU 内存, 只有调用方显式选择时才放入 (TextureLoadOptions::cacheDecoded,
+ * ModelLoadOptions::assetCache 或 ResidencyPolicy::KeepSource)。
+ *
+ * - 按字节数限制容量, 超出时淘汰最久未使用的条目 (LRU); 单个条目超过容量时不缓存
+ * - 条目以 shared_ptr<const T> 共享: 淘汰只丢掉缓存自己的引用, 仍在使用的调用方不受影响
+ * - 键由调用方生成, 必须包含影响内容的全部因素 (源文件大小/修改时间、解码/导入选项等);
+ *   同一个键只能对应一种类型, 类型不符时视为未命中
+ *
+ * find / insert 可在任意线程调用。
+ */
+class AssetCache {
+public:
+#ifdef __ANDROID__
+    static constexpr size_t kDefaultCapacity = 64u * 1024 * 1024;
+#else
+    static constexpr size_t kDefaultCapacity = 256u * 1024 * 1024;
+#endif
+
+    struct Stats {
+        size_t hits       = 0;
+        size_t misses     = 0;
+        size_t insertions = 0;
+        size_t evictions  = 0;
+        size_t entries    = 0;      // 当前条目数
+        size_t bytes      = 0;      // 当前条目的字节数合计
+        size_t capacity   = 0;
+    };
+
+    static AssetCache& getInstance();
+
+    AssetCache(const AssetCache&) = delete;
+    AssetCache& operator=(const AssetCache&) = delete;
+
+    // 命中时把条目移到最近使用的位置; 未命中返回空指针
+    template <typename T>
+    std::shared_ptr<const T> find(const std::string& key) {
+        return std::static_pointer_cast<const T>(findErased(key, typeid(T)));
+    }
+
+    /**
+     * @brief 放入 (或替换) 条目, 随后按容量淘汰
+     * @param bytes 条目占用的 CPU 内存估算, 用于容量统计
+     */
+    template <typename T>
+    void insert(const std::string& key, std::shared_ptr<const T> value, size_t bytes) {
+        insertErased(key, std::static_pointer_cast<const void>(std::move(value)), typeid(T), bytes);
+    }
+
+    // 调整容量 (立即按新容量淘汰)
+    void setCapacity(size_t bytes);
+    size_t capacity() const;
+
+    // 丢弃全部条目 (对比测试的冷启动轮次使用)
+    void clear();
+
+    Stats stats() const;
+    void logStats() const;
+
+private:
+    struct Entry {
+        std::string key;
+        std::shared_ptr<const void> value;
+        const std::type_info* type = nullptr;
+        size_t bytes = 0;
+    };
+    using EntryList = std::list<Entry>;
+
+    AssetCache() = default;
+    ~AssetCache() = default;
+
+    std::shared_ptr<const void> findErased(const std::string& key, const std::type_info& type);
+    void insertErased(const std::string& key, std::shared_ptr<const void> value, const std::type_info& type, size_t bytes);
+    // 调用方持有 m_mutex; 被淘汰的值移入 dropped, 在锁外析构
+    void evictLocked(size_t capacity, EntryList& dropped);
+
+    mutable std::mutex m_mutex;
+    EntryList m_entries;    // 头部为最近使用
+    std::unordered_map<std::string, EntryList::iterator> m_index;
+    size_t m_capacity = kDefaultCapacity;
+    size_t m_bytes = 0;
+
+    size_t m_hits = 0;
+    size_t m_misses = 0;
+    size_t m_insertions = 0;
+    size_t m_evictions = 0;
+};
@@ -0,0 +1,277 @@
+#include "AssetPackage.hpp"
+#include "macros.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+constexpr uint64_t kBlockAlignment = 16;
+
+#pragma pack(push, 1)
+struct FileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t reserved;
+    uint64_t entryTableOffset;
+    uint64_t stringTableOffset;
+    uint64_t stringTableSize;
+    uint64_t fileSize;
+};
+
+struct EntryRecord {
+    uint64_t pathHash;
+    uint32_t pathOffset;            // 相对字符串表
+    uint32_t pathLength;
+    uint64_t dataOffset;            // 相对文件头
+    uint64_t dataSize;
+    int64_t  sourceMTime;
+    uint32_t kind;
+    uint32_t reserved;
+};
+#pragma pack(pop)
+
+uint64_t alignUp(uint64_t value) {
+    return (value + kBlockAlignment - 1) & ~(kBlockAlignment - 1);
+}
+
+void writePadding(std::ofstream& out, uint64_t& cursor, uint64_t target) {
+    static const char zeros[kBlockAlignment] = {};
+    while (cursor < target) {
+        uint64_t chunk = std::min<uint64_t>(target - cursor, kBlockAlignment);
+        out.write(zeros, static_cast<std::streamsize>(chunk));
+        cursor += chunk;
+    }
+}
+
+} // namespace
+
+uint64_t AssetPackage::hashPath(const std::string& path) {
+    uint64_t hash = 14695981039346656037ull;
+    for (unsigned char c : path) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// ---------------------------------------------------------------------------
+// 读取
+// ---------------------------------------------------------------------------
+
+bool AssetPackage::open(const std::string& packagePath) {
+    close();
+
+    if (!m_file.open(packagePath)) {
+        return false;
+    }
+
+    const uint8_t* base = m_file.data();
+    const uint64_t size = m_file.size();
+
+    auto fail = [&](const char* reason) {
+        LOGE("AssetPackage: rejecting %s (%s)", packagePath.c_str(), reason);
+        close();
+        return false;
+    };
+
+    if (size < sizeof(FileHeader)) return fail("truncated header");
+
+    FileHeader header;
+    std::memcpy(&header, base, sizeof(header));
+    if (header.magic != kMagic)     return fail("bad magic");
+    if (header.version != kVersion) return fail("version mismatch");
+    if (header.fileSize != size)    return fail("truncated file");
+
+    auto inRange = [size](uint64_t offset, uint64_t bytes) {
+        return offset <= size && bytes <= size - offset;
+    };
+
+    if (!inRange(header.entryTableOffset, sizeof(EntryRecord) * uint64_t(header.entryCount)) ||
+        !inRange(header.stringTableOffset, header.stringTableSize)) {
+        return fail("corrupt tables");
+    }
+
+    const char* strings = reinterpret_cast<const char*>(base + header.stringTableOffset);
+    const EntryRecord* records = reinterpret_cast<const EntryRecord*>(base + header.entryTableOffset);
+
+    m_entries.resize(header.entryCount);
+    m_hashes.resize(header.entryCount);
+    for (uint32_t i = 0; i < header.entryCount; ++i) {
+        EntryRecord record;
+        std::memcpy(&record, &records[i], sizeof(record));
+
+        if (uint64_t(record.pathOffset) + record.pathLength > header.stringTableSize ||
+            !inRange(record.dataOffset, record.dataSize) ||
+            (i > 0 && record.pathHash < m_hashes[i - 1])) {
+            return fail("corrupt entry record");
+        }
+
+        Entry& entry = m_entries[i];
+        entry.path.assign(strings + record.pathOffset, record.pathLength);
+        entry.kind        = static_cast<Kind>(record.kind);
+        entry.sourceMTime = record.sourceMTime;
+        entry.data.data   = base + record.dataOffset;
+        entry.data.size   = static_cast<size_t>(record.dataSize);
+        m_hashes[i] = record.pathHash;
+    }
+
+    LOGI("AssetPackage: mounted %s (%d entries, %d KB)", packagePath.c_str(),
+         static_cast<int>(m_entries.size()), static_cast<int>(size / 1024));
+    return true;
+}
+
+void AssetPackage::close() {
+    m_entries.clear();
+    m_hashes.clear();
+    m_file.close();
+}
+
+const AssetPackage::Entry* AssetPackage::findEntry(const std::string& path) const {
+    const uint64_t hash = hashPath(path);
+    auto it = std::lower_bound(m_hashes.begin(), m_hashes.end(), hash);
+    // 哈希冲突时相同哈希的条目相邻, 逐个比较路径
+    for (; it != m_hashes.end() && *it == hash; ++it) {
+        const Entry& entry = m_entries[static_cast<size_t>(it - m_hashes.begin())];
+        if (entry.path == path) return &entry;
+    }
+    return nullptr;
+}
+
+AssetSpan AssetPackage::find(const std::string& path) const {
+    const Entry* entry = findEntry(path);
+    return entry ? entry->data : AssetSpan();
+}
+
+// ---------------------------------------------------------------------------
+// 写出
+// ---------------------------------------------------------------------------
+
+void AssetPackageWriter::add(const std::string& path, AssetPackage::Kind kind, std::vector<uint8_t> data, int64_t sourceMTime) {
+    auto it = m_index.find(path);
+    if (it == m_index.end()) {
+        it = m_index.emplace(path, m_entries.size()).first;
+        m_entries.emplace_back();
+    }
+    PendingEntry& entry = m_entries[it->second];
+    entry.path        = path;
+    entry.kind        = kind;
+    entry.sourceMTime = sourceMTime;
+    entry.data        = std::move(data);
+}
+
+bool AssetPackageWriter::addFile(const std::string& path, AssetPackage::Kind kind, const std::string& filePath) {
+    std::error_code ec;
+    const auto mtime = std::filesystem::last_write_time(filePath, ec);
+    if (ec) {
+        LOGE("AssetPackage: %s not found", filePath.c_str());
+        return false;
+    }
+
+    std::vector<uint8_t> data;
+    MappedFile file;
+    if (file.open(filePath)) {
+        data.assign(file.data(), file.data() + file.size());
+    } else if (std::filesystem::file_size(filePath, ec) != 0 || ec) {   // MappedFile 不映射空文件
+        LOGE("AssetPackage: failed to read %s", filePath.c_str());
+        return false;
+    }
+    add(path, kind, std::move(data), static_cast<int64_t>(mtime.time_since_epoch().count()));
+    return true;
+}
+
+size_t AssetPackageWriter::payloadBytes() const {
+    size_t bytes = 0;
+    for (const PendingEntry& entry : m_entries) bytes += entry.data.size();
+    return bytes;
+}
+
+bool AssetPackageWriter::write(const std::string& packagePath) const {
+    // ---- 1. 按 (哈希, 路径) 排序, 运行时二分查找 ----
+    std::vector<const PendingEntry*> sorted;
+    sorted.reserve(m_entries.size());
+    for (const PendingEntry& entry : m_entries) sorted.push_back(&entry);
+    std::sort(sorted.begin(), sorted.end(), [](const PendingEntry* a, const PendingEntry* b) {
+        const uint64_t ha = AssetPackage::hashPath(a->path);
+        const uint64_t hb = AssetPackage::hashPath(b->path);
+        return ha != hb ? ha < hb : a->path < b->path;
+    });
+
+    // ---- 2. 计算布局 ----
+    std::string stringTable;
+    std::vector<EntryRecord> records(sorted.size());
+    FileHeader header{};
+    uint64_t cursor = sizeof(FileHeader);
+    header.entryTableOffset = cursor;
+    cursor += sizeof(EntryRecord) * records.size();
+
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        records[i].pathHash    = AssetPackage::hashPath(sorted[i]->path);
+        records[i].pathOffset  = static_cast<uint32_t>(stringTable.size());
+        records[i].pathLength  = static_cast<uint32_t>(sorted[i]->path.size());
+        records[i].kind        = static_cast<uint32_t>(sorted[i]->kind);
+        records[i].sourceMTime = sorted[i]->sourceMTime;
+        stringTable.append(sorted[i]->path);
+    }
+    header.stringTableOffset = cursor;
+    header.stringTableSize   = stringTable.size();
+    cursor += stringTable.size();
+
+    for (size_t i = 0; i < sorted.size(); ++i) {
+        cursor = alignUp(cursor);
+        records[i].dataOffset = cursor;
+        records[i].dataSize   = sorted[i]->data.size();
+        cursor += sorted[i]->data.size();
+    }
+
+    header.magic      = AssetPackage::kMagic;
+    header.version    = AssetPackage::kVersion;
+    header.entryCount = static_cast<uint32_t>(records.size());
+    header.fileSize   = cursor;
+
+    // ---- 3. 写入临时文件 ----
+    const std::string tmpPath = packagePath + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            LOGE("AssetPackage: cannot open %s for writing", tmpPath.c_str());
+            return false;
+        }
+
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(records.data()), sizeof(EntryRecord) * records.size());
+        out.write(stringTable.data(), static_cast<std::streamsize>(stringTable.size()));
+        uint64_t written = header.stringTableOffset + stringTable.size();
+
+        for (size_t i = 0; i < sorted.size(); ++i) {
+            writePadding(out, written, records[i].dataOffset);
+            out.write(reinterpret_cast<const char*>(sorted[i]->data.data()), static_cast<std::streamsize>(sorted[i]->data.size()));
+            written += sorted[i]->data.size();
+        }
+
+        if (!out) {
+            LOGE("AssetPackage: failed while writing %s", tmpPath.c_str());
+            out.close();
+            std::error_code ec;
+            std::filesystem::remove(tmpPath, ec);
+            return false;
+        }
+    }
+
+    // ---- 4. 原子替换 ----
+    std::error_code ec;
+    std::filesystem::remove(packagePath, ec);     // Windows 下 rename 不能覆盖已存在文件
+    std::filesystem::rename(tmpPath, packagePath, ec);
+    if (ec) {
+        LOGE("AssetPackage: rename %s failed: %s", tmpPath.c_str(), ec.message().c_str());
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+
+    LOGI("AssetPackage: wrote %s (%u entries, %llu bytes)", packagePath.c_str(),
+         header.entryCount, static_cast<unsigned long long>(cursor));
+    return true;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "MappedFile.hpp"
+
+// 包内一段只读数据, 指向映射内存 (不拥有), 包保持挂载期间有效
+struct AssetSpan {
+    const uint8_t* data = nullptr;
+    size_t         size = 0;
+
+    bool empty() const { return data == nullptr; }
+};
+
+/**
+ * @brief 单文件资源包 (.wpak), 由 wind_cook 离线生成
+ *
+ * 运行时整个文件只做一次 mmap, 条目按路径哈希排序, 查找为二分; 返回的 AssetSpan 直接指向映射内存,
+ * 烘焙好的网格缓存 / KTX 纹理不经过任何拷贝即可交给 glBufferData / glCompressedTexImage2D。
+ *
+ * 条目路径是相对挂载目录的路径 (正斜杠, 区分大小写), 例如 "chufeng.obj.meshcache"、"skybox/top.etc2.ktx"。
+ *
+ * 文件布局 (小端, 数据块按 16 字节对齐):
+ *   FileHeader | EntryRecord[entryCount] (按 pathHash, path 排序) | 字符串表 | 数据块
+ */
+class AssetPackage {
+public:
+    static constexpr uint32_t kMagic   = 0x4B415057;   // "WPAK"
+    static constexpr uint32_t kVersion = 1;
+
+    // 条目内容的来源, 只用于统计与工具输出, 查找不区分
+    enum class Kind : uint32_t {
+        Raw       = 0,  // 原样拷贝的源文件 (未烘焙的模型 / 源图 / MTL 等, 供回退路径读取)
+        MeshCache = 1,  // MeshCache 格式的烘焙网格, 路径为 MeshCache::cachePathFor(源文件)
+        Texture   = 2,  // 带 mip 链的 KTX, 路径为 TextureFormat::variantPath(源图, codec)
+        Shader    = 3,  // 着色器源码
+    };
+
+    struct Entry {
+        std::string path;
+        Kind        kind = Kind::Raw;
+        int64_t     sourceMTime = 0;    // 烘焙时源文件的修改时间
+        AssetSpan   data;
+    };
+
+    // 条目路径的哈希 (FNV-1a 64)
+    static uint64_t hashPath(const std::string& path);
+
+    /**
+     * @brief 映射并校验包文件
+     * @return false 文件不存在或已损坏
+     */
+    bool open(const std::string& packagePath);
+    void close();
+
+    bool isOpen() const { return m_file.isOpen(); }
+    size_t mappedBytes() const { return m_file.size(); }
+
+    // 查找条目, 找不到返回空 span
+    AssetSpan find(const std::string& path) const;
+    const Entry* findEntry(const std::string& path) const;
+    const std::vector<Entry>& entries() const { return m_entries; }
+
+private:
+    MappedFile         m_file;
+    std::vector<Entry> m_entries;       // 与文件中的顺序一致 (按哈希排序)
+    std::vector<uint64_t> m_hashes;
+};
+
+/**
+ * @brief 资源包写出 (离线工具使用)
+ *
+ * 先收集全部条目, write() 时排序、对齐并一次写出 (临时文件 + 重命名, 同 MeshCache::write)。
+ */
+class AssetPackageWriter {
+public:
+    // 同一路径重复添加时后者覆盖前者
+    void add(const std::string& path, AssetPackage::Kind kind, std::vector<uint8_t> data, int64_t sourceMTime = 0);
+    bool addFile(const std::string& path, AssetPackage::Kind kind, const std::string& filePath);
+
+    size_t entryCount() const { return m_entries.size(); }
+    size_t payloadBytes() const;
+
+    bool write(const std::string& packagePath) const;
+
+private:
+    struct PendingEntry {
+        std::string path;
+        AssetPackage::Kind kind = AssetPackage::Kind::Raw;
+        int64_t sourceMTime = 0;
+        std::vector<uint8_t> data;
+    };
+    std::vector<PendingEntry> m_entries;
+    std::unordered_map<std::string, size_t> m_index;
+};
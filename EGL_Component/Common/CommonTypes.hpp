@@ -1,22 +1,17 @@
 #pragma once
 #include <glm/glm.hpp>
 
+// 默认场景 (没有 scene.json) 的实例数; 实例数由清单在运行时决定, 不再受着色器中固定数组的限制
 #define INSTANCES_COUNT 4
 #define INSTANCE_SCALE 0.1f
 
 
 
-// 每个实例的偏移状态
-struct InstanceOffset {
-    float deltaX;
-    float deltaY;
-    float _padding1;  // 为了对齐
-    float _padding2;  // 为了对齐
-};
-
+// 实例缓冲中的一项, 布局与 Model::setupInstances 中的属性指针对应 (location 5 ~ 11)
 struct InstanceData {
     glm::mat4 modelMatrix;
     glm::vec4 color;
+    glm::vec4 offset = glm::vec4(0.0f);     // 拖拽产生的独立偏移 (xy), zw 保留
     uint32_t instanceId;
 };
 
@@ -31,8 +26,6 @@ struct InstanceData_Adjust_Dynamic {
     float speed;
     float axis_x_delta_percent;     // 传入变化量来改变风向
     float axis_y_delta_percent;
-    // 添加每个实例的累积偏移
-    InstanceOffset instanceOffsets[INSTANCES_COUNT];
 };
 
 
@@ -42,8 +35,6 @@ struct Globals
     glm::mat4 viewMatrix;
     glm::mat4 projMatrix;
 
-    // 每个实例的独立偏移数组
-    InstanceOffset instanceOffsets[INSTANCES_COUNT];
     // 新增字段
     int pickedInstanceID;
     float deltaX;
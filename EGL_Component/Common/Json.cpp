@@ -0,0 +1,309 @@
+#include "Json.hpp"
+
+#include <cstdlib>
+#include <cstring>
+
+namespace {
+
+const JsonValue& nullValue() {
+    static const JsonValue value;
+    return value;
+}
+
+const std::string& emptyString() {
+    static const std::string value;
+    return value;
+}
+
+constexpr int kMaxDepth = 256;  // 防止恶意/损坏文件导致递归过深
+
+} // namespace
+
+// 递归下降解析器, 只在本文件中使用 (JsonValue 的友元)
+class JsonParser {
+public:
+    JsonParser(const char* text, size_t length) : m_cur(text), m_begin(text), m_end(text + length) {}
+
+    bool parseDocument(JsonValue& out) {
+        // UTF-8 BOM
+        if (m_end - m_cur >= 3 && std::memcmp(m_cur, "\xEF\xBB\xBF", 3) == 0) m_cur += 3;
+        skipWhitespace();
+        if (!parseValue(out, 0)) return false;
+        skipWhitespace();
+        if (m_cur != m_end) return fail("trailing characters");
+        return true;
+    }
+
+    std::string error() const {
+        return m_error + " at byte " + std::to_string(static_cast<long long>(m_errorPos - m_begin));
+    }
+
+private:
+    bool fail(const char* message) {
+        if (m_error.empty()) {
+            m_error = message;
+            m_errorPos = m_cur;
+        }
+        return false;
+    }
+
+    void skipWhitespace() {
+        while (m_cur < m_end && (*m_cur == ' ' || *m_cur == '\t' || *m_cur == '\n' || *m_cur == '\r')) ++m_cur;
+    }
+
+    bool consume(const char* literal) {
+        const size_t n = std::strlen(literal);
+        if (static_cast<size_t>(m_end - m_cur) < n || std::memcmp(m_cur, literal, n) != 0) return false;
+        m_cur += n;
+        return true;
+    }
+
+    bool parseValue(JsonValue& out, int depth) {
+        if (depth > kMaxDepth) return fail("nesting too deep");
+        if (m_cur >= m_end) return fail("unexpected end of input");
+
+        switch (*m_cur) {
+        case '{': return parseObject(out, depth);
+        case '[': return parseArray(out, depth);
+        case '"':
+            out.m_type = JsonValue::Type::String;
+            return parseString(out.m_string);
+        case 't':
+            if (!consume("true")) return fail("invalid literal");
+            out.m_type = JsonValue::Type::Bool;
+            out.m_bool = true;
+            return true;
+        case 'f':
+            if (!consume("false")) return fail("invalid literal");
+            out.m_type = JsonValue::Type::Bool;
+            out.m_bool = false;
+            return true;
+        case 'n':
+            if (!consume("null")) return fail("invalid literal");
+            out.m_type = JsonValue::Type::Null;
+            return true;
+        default:
+            return parseNumber(out);
+        }
+    }
+
+    bool parseObject(JsonValue& out, int depth) {
+        out.m_type = JsonValue::Type::Object;
+        ++m_cur;    // '{'
+        skipWhitespace();
+        if (m_cur < m_end && *m_cur == '}') {
+            ++m_cur;
+            return true;
+        }
+        for (;;) {
+            skipWhitespace();
+            if (m_cur >= m_end || *m_cur != '"') return fail("expected object key");
+            out.m_members.emplace_back();
+            JsonValue::Member& member = out.m_members.back();
+            if (!parseString(member.first)) return false;
+            skipWhitespace();
+            if (m_cur >= m_end || *m_cur != ':') return fail("expected ':'");
+            ++m_cur;
+            skipWhitespace();
+            if (!parseValue(member.second, depth + 1)) return false;
+            skipWhitespace();
+            if (m_cur < m_end && *m_cur == ',') {
+                ++m_cur;
+                continue;
+            }
+            if (m_cur < m_end && *m_cur == '}') {
+                ++m_cur;
+                return true;
+            }
+            return fail("expected ',' or '}'");
+        }
+    }
+
+    bool parseArray(JsonValue& out, int depth) {
+        out.m_type = JsonValue::Type::Array;
+        ++m_cur;    // '['
+        skipWhitespace();
+        if (m_cur < m_end && *m_cur == ']') {
+            ++m_cur;
+            return true;
+        }
+        for (;;) {
+            skipWhitespace();
+            out.m_elements.emplace_back();
+            if (!parseValue(out.m_elements.back(), depth + 1)) return false;
+            skipWhitespace();
+            if (m_cur < m_end && *m_cur == ',') {
+                ++m_cur;
+                continue;
+            }
+            if (m_cur < m_end && *m_cur == ']') {
+                ++m_cur;
+                return true;
+            }
+            return fail("expected ',' or ']'");
+        }
+    }
+
+    bool parseHex4(uint32_t& out) {
+        if (m_end - m_cur < 4) return fail("truncated \\u escape");
+        out = 0;
+        for (int i = 0; i < 4; ++i) {
+            const char c = *m_cur++;
+            out <<= 4;
+            if (c >= '0' && c <= '9')      out |= static_cast<uint32_t>(c - '0');
+            else if (c >= 'a' && c <= 'f') out |= static_cast<uint32_t>(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F') out |= static_cast<uint32_t>(c - 'A' + 10);
+            else return fail("invalid \\u escape");
+        }
+        return true;
+    }
+
+    static void appendUtf8(std::string& out, uint32_t cp) {
+        if (cp < 0x80) {
+            out.push_back(static_cast<char>(cp));
+        } else if (cp < 0x800) {
+            out.push_back(static_cast<char>(0xC0 | (cp >> 6)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else if (cp < 0x10000) {
+            out.push_back(static_cast<char>(0xE0 | (cp >> 12)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        } else {
+            out.push_back(static_cast<char>(0xF0 | (cp >> 18)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 12) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | ((cp >> 6) & 0x3F)));
+            out.push_back(static_cast<char>(0x80 | (cp & 0x3F)));
+        }
+    }
+
+    bool parseString(std::string& out) {
+        ++m_cur;    // '"'
+        // 无转义的连续片段整体追加 (glTF 中的 base64 data URI 可达数 MB)
+        const char* run = m_cur;
+        for (;;) {
+            if (m_cur >= m_end) return fail("unterminated string");
+            const char c = *m_cur;
+            if (c == '"') {
+                out.append(run, m_cur);
+                ++m_cur;
+                return true;
+            }
+            if (static_cast<unsigned char>(c) < 0x20) return fail("control character in string");
+            if (c != '\\') {
+                ++m_cur;
+                continue;
+            }
+
+            out.append(run, m_cur);
+            ++m_cur;
+            if (m_cur >= m_end) return fail("unterminated escape");
+            const char e = *m_cur++;
+            switch (e) {
+            case '"':  out.push_back('"');  break;
+            case '\\': out.push_back('\\'); break;
+            case '/':  out.push_back('/');  break;
+            case 'b':  out.push_back('\b'); break;
+            case 'f':  out.push_back('\f'); break;
+            case 'n':  out.push_back('\n'); break;
+            case 'r':  out.push_back('\r'); break;
+            case 't':  out.push_back('\t'); break;
+            case 'u': {
+                uint32_t cp = 0;
+                if (!parseHex4(cp)) return false;
+                // 代理对
+                if (cp >= 0xD800 && cp <= 0xDBFF) {
+                    uint32_t low = 0;
+                    if (!consume("\\u") || !parseHex4(low) || low < 0xDC00 || low > 0xDFFF) {
+                        return fail("invalid surrogate pair");
+                    }
+                    cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                } else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+                    return fail("unpaired low surrogate");
+                }
+                appendUtf8(out, cp);
+                break;
+            }
+            default:
+                return fail("invalid escape");
+            }
+            run = m_cur;
+        }
+    }
+
+    bool parseNumber(JsonValue& out) {
+        const char* start = m_cur;
+        if (m_cur < m_end && *m_cur == '-') ++m_cur;
+        if (m_cur >= m_end || *m_cur < '0' || *m_cur > '9') return fail("invalid value");
+        if (*m_cur == '0') {
+            ++m_cur;
+        } else {
+            while (m_cur < m_end && *m_cur >= '0' && *m_cur <= '9') ++m_cur;
+        }
+        if (m_cur < m_end && *m_cur == '.') {
+            ++m_cur;
+            if (m_cur >= m_end || *m_cur < '0' || *m_cur > '9') return fail("invalid fraction");
+            while (m_cur < m_end && *m_cur >= '0' && *m_cur <= '9') ++m_cur;
+        }
+        if (m_cur < m_end && (*m_cur == 'e' || *m_cur == 'E')) {
+            ++m_cur;
+            if (m_cur < m_end && (*m_cur == '+' || *m_cur == '-')) ++m_cur;
+            if (m_cur >= m_end || *m_cur < '0' || *m_cur > '9') return fail("invalid exponent");
+            while (m_cur < m_end && *m_cur >= '0' && *m_cur <= '9') ++m_cur;
+        }
+
+        // 输入不一定以 '\0' 结尾, 拷贝到栈上再交给 strtod
+        char buffer[64];
+        const size_t length = static_cast<size_t>(m_cur - start);
+        if (length >= sizeof(buffer)) return fail("number too long");
+        std::memcpy(buffer, start, length);
+        buffer[length] = '\0';
+
+        out.m_type = JsonValue::Type::Number;
+        out.m_number = std::strtod(buffer, nullptr);
+        return true;
+    }
+
+    const char* m_cur;
+    const char* m_begin;
+    const char* m_end;
+    std::string m_error;
+    const char* m_errorPos = nullptr;
+};
+
+bool JsonValue::parse(const char* text, size_t length, JsonValue& out, std::string* outError) {
+    out = JsonValue();
+    JsonParser parser(text, length);
+    if (!parser.parseDocument(out)) {
+        if (outError) *outError = parser.error();
+        out = JsonValue();
+        return false;
+    }
+    return true;
+}
+
+const std::string& JsonValue::asString() const {
+    return isString() ? m_string : emptyString();
+}
+
+size_t JsonValue::size() const {
+    if (isArray())  return m_elements.size();
+    if (isObject()) return m_members.size();
+    return 0;
+}
+
+const JsonValue& JsonValue::operator[](size_t index) const {
+    return (isArray() && index < m_elements.size()) ? m_elements[index] : nullValue();
+}
+
+const JsonValue& JsonValue::operator[](const char* key) const {
+    const JsonValue* value = find(key);
+    return value ? *value : nullValue();
+}
+
+const JsonValue* JsonValue::find(const char* key) const {
+    if (!isObject()) return nullptr;
+    for (const Member& member : m_members) {
+        if (member.first == key) return &member.second;
+    }
+    return nullptr;
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief 最小 JSON DOM (glTF / 场景清单等配置文件使用)
+ *
+ * - 完整支持 RFC 8259 语法 (含 \uXXXX 与代理对, 转为 UTF-8), 数值统一存为 double
+ * - 对象保持文件中的键顺序, 查找为线性扫描 (配置文件中的对象都很小)
+ * - 访问不存在的键/下标返回共享的 null 值, 便于链式读取: doc["a"][0]["b"].asInt(-1)
+ */
+class JsonValue {
+public:
+    enum class Type : uint8_t { Null, Bool, Number, String, Array, Object };
+
+    using Member = std::pair<std::string, JsonValue>;
+
+    JsonValue() = default;
+
+    /**
+     * @brief 解析 UTF-8 文本 (允许前导 BOM 与首尾空白)
+     * @param outError 失败时写入错误描述与字节位置, 可为 nullptr
+     * @return false 语法错误
+     */
+    static bool parse(const char* text, size_t length, JsonValue& out, std::string* outError = nullptr);
+
+    Type type() const { return m_type; }
+    bool isNull()   const { return m_type == Type::Null; }
+    bool isBool()   const { return m_type == Type::Bool; }
+    bool isNumber() const { return m_type == Type::Number; }
+    bool isString() const { return m_type == Type::String; }
+    bool isArray()  const { return m_type == Type::Array; }
+    bool isObject() const { return m_type == Type::Object; }
+
+    // 类型不符时返回 fallback
+    bool asBool(bool fallback = false) const { return isBool() ? m_bool : fallback; }
+    double asNumber(double fallback = 0.0) const { return isNumber() ? m_number : fallback; }
+    int64_t asInt(int64_t fallback = 0) const { return isNumber() ? static_cast<int64_t>(m_number) : fallback; }
+    float asFloat(float fallback = 0.0f) const { return isNumber() ? static_cast<float>(m_number) : fallback; }
+    const std::string& asString() const;
+
+    // 数组元素数 / 对象成员数, 其它类型为 0
+    size_t size() const;
+
+    const JsonValue& operator[](size_t index) const;
+    const JsonValue& operator[](int index) const { return index < 0 ? (*this)[size()] : (*this)[static_cast<size_t>(index)]; } // 避免字面量 0 与 const char* 重载歧义
+    const JsonValue& operator[](const char* key) const;
+    const JsonValue& operator[](const std::string& key) const { return (*this)[key.c_str()]; }
+
+    // 键不存在时返回 nullptr
+    const JsonValue* find(const char* key) const;
+    bool has(const char* key) const { return find(key) != nullptr; }
+
+    const std::vector<JsonValue>& elements() const { return m_elements; }
+    const std::vector<Member>& members() const { return m_members; }
+
+private:
+    friend class JsonParser;
+
+    Type m_type = Type::Null;
+    bool m_bool = false;
+    double m_number = 0.0;
+    std::string m_string;
+    std::vector<JsonValue> m_elements;
+    std::vector<Member> m_members;
+};
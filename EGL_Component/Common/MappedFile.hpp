@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/**
+ * @brief 只读文件内存映射 (RAII)
+ *
+ * Windows 使用 CreateFileMapping/MapViewOfFile，其余平台使用 mmap。
+ * 映射后的数据可以直接交给 glBufferData 等接口，避免一次额外的 RAM 拷贝。
+ * 只允许移动，不允许拷贝（同 ShaderProgram 的资源语义）。
+ */
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief 映射整个文件
+     * @return false 文件不存在、为空或映射失败
+     */
+    bool open(const std::string& path);
+    void close();
+
+    bool           isOpen() const { return m_data != nullptr; }
+    const uint8_t* data()   const { return m_data; }
+    size_t         size()   const { return m_size; }
+
+private:
+    const uint8_t* m_data = nullptr;
+    size_t         m_size = 0;
+
+#ifdef _WIN32
+    void* m_fileHandle    = nullptr;
+    void* m_mappingHandle = nullptr;
+#endif
+};
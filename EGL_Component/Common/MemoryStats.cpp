@@ -0,0 +1,122 @@
+#include "MemoryStats.hpp"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <psapi.h>
+#pragma comment(lib, "psapi.lib")
+#else
+#include <cstdio>
+#include <cstring>
+#include <unistd.h>
+#endif
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#if MEMORY_STATS_COUNT_HEAP_ALLOCATIONS
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<size_t> g_heapAllocations{0};
+
+void* operator new(size_t size) {
+    g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* pointer = std::malloc(size ? size : 1)) return pointer;
+    throw std::bad_alloc();
+}
+void* operator new[](size_t size) {
+    return ::operator new(size);
+}
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    g_heapAllocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size ? size : 1);
+}
+void* operator new[](size_t size, const std::nothrow_t& tag) noexcept {
+    return ::operator new(size, tag);
+}
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+#endif
+
+namespace MemoryStats {
+
+size_t residentBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+    return static_cast<size_t>(counters.WorkingSetSize);
+#else
+    FILE* statm = std::fopen("/proc/self/statm", "r");
+    if (!statm) return 0;
+    unsigned long totalPages = 0, residentPages = 0;
+    const int fields = std::fscanf(statm, "%lu %lu", &totalPages, &residentPages);
+    std::fclose(statm);
+    if (fields != 2) return 0;
+    return static_cast<size_t>(residentPages) * static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+#ifndef _WIN32
+// /proc/self/status 中以 key 开头的行, 单位为 kB
+static size_t readStatusKilobytes(const char* key) {
+    FILE* status = std::fopen("/proc/self/status", "r");
+    if (!status) return 0;
+    const size_t keyLength = std::strlen(key);
+    char line[256];
+    unsigned long kilobytes = 0;
+    while (std::fgets(line, sizeof(line), status)) {
+        if (std::strncmp(line, key, keyLength) == 0) {
+            std::sscanf(line + keyLength, "%lu", &kilobytes);
+            break;
+        }
+    }
+    std::fclose(status);
+    return static_cast<size_t>(kilobytes) * 1024;
+}
+#endif
+
+size_t peakResidentBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) return 0;
+    return static_cast<size_t>(counters.PeakWorkingSetSize);
+#else
+    return readStatusKilobytes("VmHWM:");
+#endif
+}
+
+bool resetPeakResident() {
+#ifdef _WIN32
+    return false;
+#else
+    // Linux 4.0+: 向 clear_refs 写入 5 把 VmHWM 重置为当前 RSS
+    FILE* clearRefs = std::fopen("/proc/self/clear_refs", "w");
+    if (!clearRefs) return false;
+    const bool written = std::fputs("5", clearRefs) >= 0;
+    return std::fclose(clearRefs) == 0 && written;
+#endif
+}
+
+void releaseFreeHeap() {
+#if defined(__GLIBC__)
+    malloc_trim(0);
+#endif
+}
+
+size_t heapAllocations() {
+#if MEMORY_STATS_COUNT_HEAP_ALLOCATIONS
+    return g_heapAllocations.load(std::memory_order_relaxed);
+#else
+    return 0;
+#endif
+}
+
+} // namespace MemoryStats
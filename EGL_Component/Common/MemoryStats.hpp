@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+
+// 置 1 后 MemoryStats.cpp 替换全局 operator new / delete 以统计堆分配次数 (heapAllocations),
+// 只用于基准测试 (如 IMPORT_ARENA_BENCHMARK_ON_STARTUP), 正常构建保持 0
+#define MEMORY_STATS_COUNT_HEAP_ALLOCATIONS 0
+
+/**
+ * @brief 进程内存统计 (用于加载/驻留日志)
+ *
+ * Linux / Android 读取 /proc/self/statm 与 /proc/self/status, Windows 使用 GetProcessMemoryInfo。
+ * 无法获取时返回 0。
+ */
+namespace MemoryStats {
+
+    // 当前常驻内存 (RSS / Working Set), 字节
+    size_t residentBytes();
+
+    // 常驻内存峰值 (VmHWM / PeakWorkingSetSize), 字节
+    size_t peakResidentBytes();
+
+    /**
+     * @brief 把峰值重置为当前常驻内存, 之后的 peakResidentBytes 只反映这段时间内的峰值
+     * @return false 平台不支持 (Linux 需要可写的 /proc/self/clear_refs), 此时峰值为进程启动以来的最大值
+     */
+    bool resetPeakResident();
+
+    // 把 malloc 已释放但仍驻留的内存归还系统 (glibc malloc_trim, 其它平台为空操作), 让对比测试的各轮起点一致
+    void releaseFreeHeap();
+
+    // 进程累计的 operator new 调用次数; MEMORY_STATS_COUNT_HEAP_ALLOCATIONS 为 0 时恒为 0
+    size_t heapAllocations();
+
+} // namespace MemoryStats
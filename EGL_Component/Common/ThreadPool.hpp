@@ -0,0 +1,69 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief 固定线程数的任务池
+ *
+ * 用于加载阶段的 CPU 工作 (网格转换、纹理解码等)，不得在任务中调用 GL 接口。
+ * 析构时会等待队列中剩余的任务执行完毕再回收线程。
+ */
+class ThreadPool {
+public:
+    /**
+     * @param threadCount 工作线程数量, 0 表示使用 hardware_concurrency()
+     */
+    explicit ThreadPool(size_t threadCount = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&)            = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return m_workers.size(); }
+
+    /**
+     * @brief 提交一个任务, 返回其结果的 future (任务中的异常会在 get() 时重新抛出)
+     */
+    template <typename F>
+    auto submit(F&& task) -> std::future<decltype(task())> {
+        using Result = decltype(task());
+        auto packaged = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(task));
+        std::future<Result> future = packaged->get_future();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_tasks.emplace([packaged]() { (*packaged)(); });
+        }
+        m_condition.notify_one();
+        return future;
+    }
+
+    /**
+     * @brief 把 [0, count) 切分给所有线程执行 body(i), 阻塞直到全部完成
+     *
+     * 调用线程也参与执行; 每个下标只执行一次, 输出写到预分配的槽位即可保证结果顺序确定。
+     * 任一任务抛出的异常会在全部任务结束后重新抛出。
+     */
+    void parallelFor(size_t count, const std::function<void(size_t)>& body);
+
+    /**
+     * @brief 推荐的工作线程数量 (至少为 1)
+     */
+    static size_t defaultThreadCount();
+
+private:
+    std::vector<std::thread>          m_workers;
+    std::queue<std::function<void()>> m_tasks;
+    std::mutex                        m_mutex;
+    std::condition_variable           m_condition;
+    bool                              m_stopping = false;
+
+    void workerLoop();
+};
@@ -0,0 +1,139 @@
+#include "VirtualFileSystem.hpp"
+#include "macros.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <utility>
+
+VirtualFileSystem& VirtualFileSystem::getInstance() {
+    static VirtualFileSystem instance;
+    return instance;
+}
+
+std::string VirtualFileSystem::normalize(const std::string& path) {
+    std::string generic = path;
+    std::replace(generic.begin(), generic.end(), '\\', '/');
+    return std::filesystem::path(generic).lexically_normal().generic_string();
+}
+
+bool VirtualFileSystem::mount(const std::string& packagePath, const std::string& mountPoint) {
+    auto package = std::make_unique<AssetPackage>();
+    if (!package->open(packagePath)) {
+        return false;
+    }
+
+    // TextureCache 等调用方会把路径解析为 weakly_canonical, 两种形式都需要匹配
+    Mount mount;
+    std::error_code ec;
+    const std::filesystem::path canonical = std::filesystem::weakly_canonical(mountPoint, ec);
+    for (const std::string& candidate : { mountPoint, ec ? mountPoint : canonical.string() }) {
+        std::string root = normalize(candidate);
+        if (root.empty() || root.back() != '/') root += '/';
+        if (std::find(mount.roots.begin(), mount.roots.end(), root) == mount.roots.end()) {
+            mount.roots.push_back(std::move(root));
+        }
+    }
+    mount.package = std::move(package);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_mounts.insert(m_mounts.begin(), std::move(mount));
+    return true;
+}
+
+void VirtualFileSystem::unmountAll() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_mounts.clear();
+}
+
+bool VirtualFileSystem::hasMounts() const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return !m_mounts.empty();
+}
+
+const AssetPackage::Entry* VirtualFileSystem::findEntry(const std::string& path) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_mounts.empty()) return nullptr;
+
+    const std::string normalized = normalize(path);
+    for (const Mount& mount : m_mounts) {
+        for (const std::string& root : mount.roots) {
+            if (normalized.size() <= root.size() || normalized.compare(0, root.size(), root) != 0) {
+                continue;
+            }
+            // 包保持挂载期间条目地址不变, 可以在锁外使用
+            if (const AssetPackage::Entry* entry = mount.package->findEntry(normalized.substr(root.size()))) {
+                return entry;
+            }
+        }
+    }
+    return nullptr;
+}
+
+AssetSpan VirtualFileSystem::find(const std::string& path) const {
+    const AssetPackage::Entry* entry = findEntry(path);
+    return entry ? entry->data : AssetSpan();
+}
+
+bool VirtualFileSystem::exists(const std::string& path) const {
+    if (findEntry(path)) return true;
+    std::error_code ec;
+    return std::filesystem::is_regular_file(path, ec);
+}
+
+bool VirtualFileSystem::stat(const std::string& path, uint64_t& outSize, int64_t& outMTime) const {
+    if (const AssetPackage::Entry* entry = findEntry(path)) {
+        outSize  = entry->data.size;
+        outMTime = entry->sourceMTime;
+        return true;
+    }
+
+    std::error_code ec;
+    const uint64_t size = std::filesystem::file_size(path, ec);
+    if (ec) return false;
+    const auto mtime = std::filesystem::last_write_time(path, ec);
+    if (ec) return false;
+    outSize  = size;
+    outMTime = static_cast<int64_t>(mtime.time_since_epoch().count());
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// AssetFile
+// ---------------------------------------------------------------------------
+
+AssetFile::AssetFile(AssetFile&& other) noexcept {
+    *this = std::move(other);
+}
+
+AssetFile& AssetFile::operator=(AssetFile&& other) noexcept {
+    if (this != &other) {
+        close();
+        m_file = std::move(other.m_file);   // 移动不改变映射地址
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+    }
+    return *this;
+}
+
+bool AssetFile::open(const std::string& path) {
+    close();
+
+    const AssetSpan span = VirtualFileSystem::getInstance().find(path);
+    if (!span.empty()) {
+        if (span.size == 0) return false;   // 与 MappedFile 一致: 空文件视为打开失败
+        m_data = span.data;
+        m_size = span.size;
+        return true;
+    }
+
+    if (!m_file.open(path)) return false;
+    m_data = m_file.data();
+    m_size = m_file.size();
+    return true;
+}
+
+void AssetFile::close() {
+    m_file.close();
+    m_data = nullptr;
+    m_size = 0;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "AssetPackage.hpp"
+#include "MappedFile.hpp"
+
+/**
+ * @brief 虚拟文件系统 - 单例模式
+ *
+ * 把资源包 (.wpak) 挂载到一个目录上: 该目录下的路径先在包中查找, 找不到再读磁盘上的散文件。
+ * 调用方继续使用原来的完整路径 (如 "<modelDir>/skybox/top.jpg"), 不需要知道资源是否已打包。
+ *
+ * 挂载应在任何加载线程启动前完成; 包内数据以零拷贝方式交给调用方,
+ * 因此 unmountAll() 只能在没有 AssetFile / AssetSpan 仍被使用时调用 (通常是进程退出前)。
+ */
+class VirtualFileSystem {
+public:
+    static VirtualFileSystem& getInstance();
+
+    VirtualFileSystem(const VirtualFileSystem&) = delete;
+    VirtualFileSystem& operator=(const VirtualFileSystem&) = delete;
+
+    /**
+     * @brief 把资源包挂载到 mountPoint 目录, 后挂载的包优先
+     * @return false 包文件不存在或已损坏 (此时仍按散文件读取)
+     */
+    bool mount(const std::string& packagePath, const std::string& mountPoint);
+    void unmountAll();
+    bool hasMounts() const;
+
+    // 只在已挂载的包中查找, 找不到返回空 span
+    AssetSpan find(const std::string& path) const;
+
+    // 包中或磁盘上存在该文件
+    bool exists(const std::string& path) const;
+
+    /**
+     * @brief 文件大小与修改时间; 包内条目的修改时间为烘焙时源文件的修改时间
+     * @return false 包中与磁盘上都不存在
+     */
+    bool stat(const std::string& path, uint64_t& outSize, int64_t& outMTime) const;
+
+    // 统一的路径形式: 正斜杠 + 词法规范化 (去掉 "." / ".."), 用于挂载点前缀匹配
+    static std::string normalize(const std::string& path);
+
+private:
+    VirtualFileSystem() = default;
+    ~VirtualFileSystem() = default;
+
+    struct Mount {
+        std::vector<std::string> roots;     // 规范化后的挂载目录 (及其解析符号链接后的形式), 以 '/' 结尾
+        std::unique_ptr<AssetPackage> package;
+    };
+
+    const AssetPackage::Entry* findEntry(const std::string& path) const;
+
+    mutable std::mutex m_mutex;
+    std::vector<Mount> m_mounts;
+};
+
+/**
+ * @brief 通过虚拟文件系统打开的只读文件
+ *
+ * 包内条目直接指向包的映射内存, 否则退回 MappedFile 映射磁盘文件, 两者对调用方没有区别。
+ * 只允许移动, 不允许拷贝 (同 MappedFile)。
+ */
+class AssetFile {
+public:
+    AssetFile() = default;
+    ~AssetFile() { close(); }
+
+    AssetFile(AssetFile&& other) noexcept;
+    AssetFile& operator=(AssetFile&& other) noexcept;
+
+    AssetFile(const AssetFile&)            = delete;
+    AssetFile& operator=(const AssetFile&) = delete;
+
+    /**
+     * @return false 包中与磁盘上都不存在, 或为空文件
+     */
+    bool open(const std::string& path);
+    void close();
+
+    bool           isOpen()     const { return m_data != nullptr; }
+    const uint8_t* data()       const { return m_data; }
+    size_t         size()       const { return m_size; }
+    bool           isPackaged() const { return m_data != nullptr && !m_file.isOpen(); }
+
+private:
+    MappedFile     m_file;
+    const uint8_t* m_data = nullptr;
+    size_t         m_size = 0;
+};
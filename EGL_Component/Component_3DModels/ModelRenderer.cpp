@@ -3,6 +3,9 @@
 
 auto startTime = std::chrono::high_resolution_clock::now();
 
+// 进程内已创建的渲染器数 (Android 每次表面重建都会重新创建)
+static int g_rendererCount = 0;
+
 
 #ifdef __ANDROID__
 ModelRenderer::ModelRenderer( ANativeWindow* window, const std::string& modelDir, int width, int height)
@@ -11,6 +14,9 @@ ModelRenderer::ModelRenderer( ANativeWindow* window, const std::string& modelDir
 ModelRenderer::ModelRenderer(GLFWwindow* window, const std::string& modelDir, int width, int height)
     : mWindow(window), mWidth(width), mHeight(height) {
 #endif
+    m_createTime = std::chrono::high_resolution_clock::now();
+    m_assetCacheAtCreate = AssetCache::getInstance().stats();
+    m_rendererIndex = g_rendererCount++;
 
     // 移除重复的GLAD初始化，因为main.cpp已经初始化过了
     // 只需确保上下文是当前即可
@@ -35,14 +41,6 @@ ModelRenderer::ModelRenderer(GLFWwindow* window, const std::string& modelDir, in
         return;
     }
     
-    // 初始化所有实例的偏移为0
-    for (int i = 0; i < INSTANCES_COUNT; i++) {
-        m_instanceOffsets[i].deltaX = 0.0f;
-        m_instanceOffsets[i].deltaY = 0.0f;
-        m_instanceOffsets[i]._padding1 = 0.0f;
-        m_instanceOffsets[i]._padding2 = 0.0f;
-    }
-
     // 确保OffscreenRenderer总是被初始化
     try {
         mOffscreenRenderer = std::make_unique<OffscreenRenderer>(width, height);
@@ -58,10 +56,25 @@ ModelRenderer::ModelRenderer(GLFWwindow* window, const std::string& modelDir, in
 }
 
 ModelRenderer::~ModelRenderer() {
-    // 渲染器销毁之前 确保线程已经执行完毕
-    if ( mLoadingThread.joinable() ) {
-        mLoadingThread.join();
+    #ifdef __ANDROID__
+    // 析构可能发生在渲染线程之外 (stop_render), GL 资源释放前先在当前线程绑定上下文
+    if (mEgl) {
+        mEgl->makeCurrent();
     }
+    #endif
+    // 渲染器销毁之前 确保加载任务已经执行完毕; 模型的 GL 资源在上下文销毁前释放
+    m_touchPad.reset();
+    m_sceneModels.clear();
+    mModel = nullptr;
+    m_sceneLoader.reset();
+    mSkybox.reset();
+
+    // 上下文销毁前释放全局纹理的引用并删除/作废全部纹理名, 下一个渲染器在新上下文中重新创建;
+    // 放入 AssetCache 的解码图像与模型快照 (KeepSource 或显式开启 assetCache 的模型) 留给下一个渲染器, 只需重新上传
+    if (m_textureManager) {
+        m_textureManager->cleanup();
+    }
+    TextureCache::getInstance().releaseGLResources();
     
     // 清理包围盒渲染器资源
     if (mBoundingBoxRenderer) {
@@ -74,7 +87,7 @@ ModelRenderer::~ModelRenderer() {
     #else
     destroyOpenGL();
     #endif
-    // unique_ptr 会自动释放 mModel 和 mProgram
+    // unique_ptr 会自动释放 mProgram
 }
 
 bool ModelRenderer::initOpenGL() {
@@ -100,23 +113,48 @@ void ModelRenderer::draw() {
     if (!mIsInitialized || !mOffscreenRenderer) {
         return;
     }
+    #ifdef __ANDROID__
+    // 表面已分离, 等待新的窗口: 不绘制, GL 资源保留
+    if (!mEgl->hasSurface()) {
+        return;
+    }
+    #endif
+
+    // 上传后台线程已解码完成的纹理 (模型/天空盒/全局纹理), 按预算分摊到多帧
+    TextureLoader& textureLoader = TextureLoader::getInstance();
+    if (textureLoader.pumpUploads(kTextureUploadBytesPerFrame) > 0 && textureLoader.pendingCount() == 0) {
+        // 一批纹理全部上传完成, 此时的显存估算才完整
+        TextureCache::getInstance().logStats();
+    }
+    TextureCache::getInstance().collectGarbage();
     
-    #ifndef __ANDROID__
-    // 显示加载界面（模型未加载完成时）
+    // 显示加载界面（还没有任何模型加载完成时）
+    if (!mIsModelLoaded && m_sceneLoader && m_sceneLoader->residentCount() > 0) {
+        mIsModelLoaded = true;
+    }
     if (!mIsModelLoaded) {
+        #ifndef __ANDROID__
         drawLoadingView();
+        #else
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        mEgl->swapBuffers();
+        #endif
         return;
     }
-    #endif
 
     // ========== 一次性初始化 ==========
     performFirstTimeInitialization();
+    // 其余模型陆续就绪, 上传后立即参与绘制
+    uploadResidentModels();
+    logSceneReadyIfDone();
     updateCameraIfNeeded();
     initializeTouchPadIfNeeded();
+    applyInstanceEdits();
     
     // ========== 每帧计算和更新 ==========
     glm::mat4 modelMatrix = glm::mat4(1.0f);
     glm::mat4 viewMatrix = mCamera->getViewMatrix();
+    cullInstances(viewMatrix);
     
     // 执行拾取操作（如果需要）
     performPickingIfRequested(modelMatrix, viewMatrix);
@@ -124,16 +162,16 @@ void ModelRenderer::draw() {
     // ========== 主渲染流程 ==========
     mOffscreenRenderer->beginFrame();
     
-    if (mIsModelLoaded && mModel) {
+    if (!m_sceneModels.empty()) {
         renderScene(viewMatrix, modelMatrix);
     } else {
-        LOGE("mModel is NOT set");
+        LOGE("No scene model uploaded");
     }
 
     mOffscreenRenderer->endFrame();
     mOffscreenRenderer->drawToScreen();
     #ifdef __ANDROID__
-    eglSwapBuffers(mDisplay, mSurface);
+    mEgl->swapBuffers();
     #else
     glfwSwapBuffers(mWindow);
     #endif
@@ -141,71 +179,54 @@ void ModelRenderer::draw() {
 
 #ifdef __ANDROID__      /* 如果是编译为安卓.so 修改destroy实现 添加 initEGL */
 bool ModelRenderer::initEGL() {
-    // --- 这部分代码基本可以从你的 jni_cpp.cpp 中复制 ---
-    mDisplay = eglGetDisplay(EGL_DEFAULT_DISPLAY);
-    if (mDisplay == EGL_NO_DISPLAY) {
-        LOGE("eglGetDisplay failed");
+    mEgl = std::make_unique<EglSurfaceHost>();
+    if (!mEgl->initialize() || !mEgl->attachWindow(mWindow)) {
         return false;
     }
+    LOGI("EGL Initialized Successfully.");
+    return true;
+}
 
-    if (eglInitialize(mDisplay, nullptr, nullptr) != EGL_TRUE) {
-        LOGE("eglInitialize failed");
-        return false;
-    }
-
-    EGLConfig config;
-    EGLint numConfigs;
-    EGLint configAttribs[] = {
-        EGL_SURFACE_TYPE, EGL_WINDOW_BIT,
-        EGL_RED_SIZE, 8,
-        EGL_GREEN_SIZE, 8,
-        EGL_BLUE_SIZE, 8,
-        EGL_DEPTH_SIZE, 24, // !! 添加深度缓冲配置，对于3D渲染至关重要 !!
-        EGL_RENDERABLE_TYPE, EGL_OPENGL_ES3_BIT, // 使用 GLES 3
-        EGL_NONE
-    };
-
-    if (eglChooseConfig(mDisplay, configAttribs, &config, 1, &numConfigs) != EGL_TRUE) {
-        LOGE("eglChooseConfig failed");
-        return false;
+void ModelRenderer::destroyEGL() {
+    mEgl.reset();
+    if (mWindow) {
+        ANativeWindow_release(mWindow);
+        mWindow = nullptr;
     }
+}
 
-    mSurface = eglCreateWindowSurface(mDisplay, config, mWindow, nullptr);
-    if (mSurface == EGL_NO_SURFACE) {
-        LOGE("eglCreateWindowSurface failed");
+bool ModelRenderer::attachSurface(ANativeWindow* window, int width, int height) {
+    if (!mEgl || !mEgl->attachWindow(window)) {
+        LOGE("attachSurface: failed to attach the new window");
+        ANativeWindow_release(window);
         return false;
     }
-
-    EGLint contextAttribs[] = { EGL_CONTEXT_CLIENT_VERSION, 3, EGL_NONE };
-    mContext = eglCreateContext(mDisplay, config, EGL_NO_CONTEXT, contextAttribs);
-    if (mContext == EGL_NO_CONTEXT) {
-        LOGE("eglCreateContext failed");
-        return false;
+    // 每次 ANativeWindow_fromSurface 都持有一个引用, 同一个窗口重新挂载时同样释放旧引用
+    if (mWindow) {
+        ANativeWindow_release(mWindow);
     }
+    mWindow = window;
+    // 以表面的实际尺寸为准, 查询失败时使用 Java 侧传入的尺寸
+    resizeRenderTargets(mEgl->width() > 0 ? mEgl->width() : width, mEgl->height() > 0 ? mEgl->height() : height);
+    return true;
+}
 
-    if (eglMakeCurrent(mDisplay, mSurface, mSurface, mContext) != EGL_TRUE) {
-        LOGE("eglMakeCurrent failed");
-        return false;
+void ModelRenderer::detachSurface() {
+    if (!mEgl) return;
+    // 调用线程不一定是渲染线程: 先绑定上下文, 分离后再让出
+    mEgl->makeCurrent();
+    mEgl->detach();
+    if (mWindow) {
+        ANativeWindow_release(mWindow);
+        mWindow = nullptr;
     }
-    LOGI("EGL Initialized Successfully.");
-    return true;
+    mEgl->releaseCurrent();
 }
 
-void ModelRenderer::destroyEGL() {
-    if (mDisplay != EGL_NO_DISPLAY) {
-        eglMakeCurrent(mDisplay, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
-        if (mContext != EGL_NO_CONTEXT) {
-            eglDestroyContext(mDisplay, mContext);
-        }
-        if (mSurface != EGL_NO_SURFACE) {
-            eglDestroySurface(mDisplay, mSurface);
-        }
-        eglTerminate(mDisplay);
+void ModelRenderer::releaseCurrent() {
+    if (mEgl) {
+        mEgl->releaseCurrent();
     }
-    mDisplay = EGL_NO_DISPLAY;
-    mContext = EGL_NO_CONTEXT;
-    mSurface = EGL_NO_SURFACE;
-    ANativeWindow_release(mWindow);
 }
 #else /* 如果是编译为安卓.so 修改destroy实现 添加 initEGL */
 
@@ -219,53 +240,52 @@ void ModelRenderer::destroyOpenGL() {
 /* initGLES 在编译为.so时需要保留  */
 void ModelRenderer::initGLES(const std::string& modelDir) {
     m_modelDir = modelDir;
-    // 1. 加载模型
+    // wind_cook 烘焙的资源包 (<modelDir>.wpak) 挂载到模型目录上: 包内的网格缓存/KTX/源文件优先, 其余仍读散文件
+    // 必须在任何加载线程启动前挂载
+    if (!VirtualFileSystem::getInstance().hasMounts()) {
+        VirtualFileSystem::getInstance().mount(modelDir + ".wpak", modelDir);
+    }
+    // 压缩纹理能力需在加载线程启动前查询, 纹理解码任务据此挑选 KTX 版本
+    TextureFormat::queryCapabilities();
+#if MIP_BENCHMARK_ON_STARTUP
+    MipGenerator::benchmark();
+#endif
+    // 1. 读取场景清单, 没有 scene.json 时退回默认场景 (chufeng.obj + fadeEdgeMask)
     startTime = std::chrono::high_resolution_clock::now();
-    try {
-        std::string modelPath = modelDir + "/chufeng.obj";              // 37ms
-        // std::string modelPath = modelDir + "/fox.gltf";
-        // std::string modelPath = modelDir + "/ddm.glb";              // 204ms
-        // std::string modelPath = modelDir + "/r35/r35.fbx";
-        // std::string modelPath = modelDir + "/lk1a.gltf";
-        LOGI("Loading model from: %s", modelPath.c_str());
-        std::uintmax_t fileSize = 0;
-        try {
-            fileSize = std::filesystem::file_size( modelPath );
-            LOGI("Filesize is %lu", fileSize);
-        } catch(const std::exception& e) {
-            LOGE( "Get Filesize failed" );
-        }
-        
-        // 模型小于1MB就不需要多线程加载(甚至10MB); Bytes为单位; wind.obj 753KB
-        if ( fileSize/1000 > 1000 ) {
-            // 使用多线程加载模型
-            mLoadingThread = std::thread( [this, modelPath](){
-                try {
-                auto loadedModel = std::make_unique<Model>( modelPath );
-                mModel = std::move( loadedModel );
-                
-                mIsModelLoaded = true;
-                LOGI( "Model loading finished successfully on background thread." );
-                } catch ( const std::exception& e ) {
-                    LOGE( "Thread Fail: %s", e.what() );
-                }
-            } );
-        } else {
-            try {
-                auto loadedModel = std::make_unique<Model>( modelPath );
-                mModel = std::move( loadedModel );
-                mIsModelLoaded = true;
-                LOGI( "Direct load model successfully" );
-            } catch ( const std::exception& e ) {
-                LOGE( "Direct load model failed: %s", e.what() );
-            }
-        }
+    SceneManifest manifest;
+    std::string manifestError;
+    if (manifest.load(modelDir + "/scene.json", modelDir, &manifestError)) {
+        LOGI("Scene manifest: %d models, %d textures, %d shaders, hero: %s",
+             static_cast<int>(manifest.models.size()), static_cast<int>(manifest.textures.size()),
+             static_cast<int>(manifest.shaders.size()), manifest.hero()->path.c_str());
+    } else {
+        LOGI("No usable scene manifest (%s), loading default scene", manifestError.c_str());
+        manifest = SceneManifest::makeDefault(modelDir);
+    }
 
-    } catch (const std::exception& e) {
-        LOGE("Failed to load model: %s", e.what());
-        return;
+    // 2. 全局纹理最先提交解码 (纹理 -> 材质 -> 网格), 解码队列先进先出, 按清单优先级排在所有模型纹理之前
+    m_textureManager = &GlobalTextureManager::getInstance();
+    m_textureManager->initialize();
+    for (const SceneManifest::Texture& texture : manifest.textures) {
+        if (!m_textureManager->loadTexture(texture.path, texture.key, texture.mipmap)) {
+            LOGE("(%s) Load texture failed: %s", texture.key.c_str(), texture.path.c_str());
+        }
     }
 
+    // 3. 模型在 SceneLoader 的线程池中并行加载, hero 模型最先开始
+    // Model 构造函数只做 CPU 工作(导入/顶点转换/纹理解码), 渲染线程在 uploadResidentModels 中只负责 GL 上传
+    m_sceneLoader = std::make_unique<SceneLoader>(std::move(manifest));
+    m_slotUploaded.assign(m_sceneLoader->modelCount(), false);
+    m_sceneLoader->start([](const SceneManifest::Model& entry) {
+        // 只导入/上传绑定到该模型的程序会读取的属性: 风场着色, hero 模型还要绘制轮廓拾取
+        ModelLoadOptions options;
+        options.vertexAttributes = ModelProgram::kVertexAttributes;
+        if (entry.hero) {
+            options.vertexAttributes |= SilhouettesClass::kVertexAttributes;
+        }
+        return options;
+    });
+
     #ifndef __ANDROID__
     // 模型未完全载入时显示的OpenGL绘制的画面
     mLoadingViewProgram = std::make_unique<LoadingViewClass>();
@@ -297,38 +317,40 @@ Camera& ModelRenderer::getCamera() {
 
 
 
-void  ModelRenderer::generateInstanceData( std::vector<InstanceData>& instanceData, int instanceCount ) {
-    // std::vector<InstanceData_Adjust_Static> static_data = {
-    //     { 0.1f, glm::vec3( -0.3f, 0.0f, 0.0f ) },  // 增大x轴间距
-    //     { 0.1f, glm::vec3( -0.1f, 0.0f, 0.0f ) },
-    //     { 0.1f, glm::vec3( 0.1f, 0.0f, 0.0f ) },
-    //     { 0.1f, glm::vec3( 0.3f, 0.0f, 0.0f ) },
-    // };
-    float scale = INSTANCE_SCALE;
-    float translate_factor = abs(mModel->scaled_boundsMin(scale).x - mModel->scaled_boundsMax(scale).x);
-    std::vector<InstanceData_Adjust_Static> static_data = {
-        { scale, glm::vec3( -1.5f * translate_factor, 0.0f, 0.0f ) },  // 左下
-        { scale, glm::vec3( -0.5f * translate_factor, 0.0f, 0.0f ) },   // 左上
-        { scale, glm::vec3( 0.5f * translate_factor, 0.0f, 0.0f ) },   // 右下
-        { scale, glm::vec3( 1.5f * translate_factor, 0.0f, 0.0f )},    // 右上
-    };
+void ModelRenderer::generateInstanceData( const Model& model, const SceneManifest::InstanceSet& set,
+                                          uint32_t firstInstanceId, std::vector<InstanceData>& instanceData ) {
+    const int instanceCount = std::max( 1, set.count );
+    instanceData.assign( instanceCount, InstanceData{} );
+
+    // 没有逐个给出位置时按缩放后的模型宽度沿 X 轴居中排列 (默认 4 个实例: -1.5, -0.5, 0.5, 1.5 倍宽度);
+    // 给出 columns 时排成网格, 行沿 Z 轴展开, 整个网格以原点为中心
+    const bool explicitPositions = set.positions.size() >= static_cast<size_t>(instanceCount);
+    float translate_factor = abs(model.scaled_boundsMin(set.scale).x - model.scaled_boundsMax(set.scale).x) * set.spacing;
+    const int columns = set.columns > 0 ? std::min(set.columns, instanceCount) : instanceCount;
+    const int rows = ( instanceCount + columns - 1 ) / columns;
 
-    // 根据静态数据设置实例
     for (int i = 0; i < instanceCount; i++) {
-        const auto& data = static_data[i];
+        const int column = i % columns;
+        const int row = i / columns;
+        glm::vec3 position = explicitPositions
+            ? set.positions[i]
+            : glm::vec3( ( column - ( columns - 1 ) * 0.5f ) * translate_factor, 0.0f,
+                         ( row - ( rows - 1 ) * 0.5f ) * translate_factor );
+        position += set.offset;
+
         // 创建模型矩阵
-        glm::mat4 model = glm::mat4(1.0f);
+        glm::mat4 matrix = glm::mat4(1.0f);
         
         // 应用位置
-        model = glm::translate(model, data.position);
+        matrix = glm::translate(matrix, position);
         
         // 应用缩放
-        model = glm::scale(model, glm::vec3(data.scale));
+        matrix = glm::scale(matrix, glm::vec3(set.scale));
         
         // 设置实例数据
-        instanceData[i].modelMatrix = model;
+        instanceData[i].modelMatrix = matrix;
         // 设置实例ID
-        instanceData[i].instanceId = i + 1;
+        instanceData[i].instanceId = firstInstanceId > 0 ? firstInstanceId + i : 0;
     }
 }
 
@@ -342,7 +364,7 @@ void ModelRenderer::drawLoadingView() {
     mOffscreenRenderer->endFrame();
     mOffscreenRenderer->drawToScreen();
     #ifdef __ANDROID__
-    eglSwapBuffers(mDisplay, mSurface);
+    mEgl->swapBuffers();
     #else
     glfwSwapBuffers(mWindow);
     #endif
@@ -355,37 +377,52 @@ void ModelRenderer::performFirstTimeInitialization() {
     LOGI("std::chrono::high_resolution_clock::now(); mIsFirstDrawAfterModelLoaded, used:%lld ms", 
             std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - startTime).count());
 
-    // 将模型数据从RAM上传到GPU
-    mModel->uploadToGPU();
+    // 相机按 hero 模型取景; hero 还没就绪时按最先就绪的模型取景
+    const Model* framingModel = nullptr;
+    for (size_t i = 0; i < m_sceneLoader->modelCount() && !framingModel; ++i) {
+        SceneLoader::ModelSlot& slot = m_sceneLoader->slot(i);
+        if (slot.currentState() == SceneLoader::State::Resident) {
+            framingModel = slot.model.get();
+        }
+    }
 
     // 初始化相机系统
-    initializeCameraSystem();
+    initializeCameraSystem(*framingModel);
     
     // 初始化渲染组件
     initializeRenderingComponents();
     
-    // 初始化实例化数据
-    initializeInstancedData();
-    
-    // 初始化纹理管理器
+    // 绑定清单中的全局纹理
     initializeTextureManager();
 }
 
-void ModelRenderer::initializeCameraSystem() {
+void ModelRenderer::initializeCameraSystem(const Model& model) {
     mCamera = std::make_unique<Camera>();
     m_cameraInteractor = std::make_unique<CameraInteractor>(mCamera.get());
     
     // 计算模型尺寸和设置相机
-    m_modelCenter = (mModel->boundsMin() + mModel->boundsMax()) * 0.5f;
-    m_modelDepth = glm::length(mModel->boundsMax() - mModel->boundsMin());
+    m_modelCenter = (model.boundsMin() + model.boundsMax()) * 0.5f;
+    m_modelDepth = glm::length(model.boundsMax() - model.boundsMin());
     mCamera->setTarget(glm::vec3(0.0, 0.0, 0.0));
     mCamera->setDistance(m_modelDepth * 0.7f);
     std::cout << "Distance:" << m_modelDepth << std::endl;
 }
 
 void ModelRenderer::initializeRenderingComponents() {
-    // 创建Shader程序
-    mProgram = std::make_unique<ModelProgram>();
+    // 创建Shader程序: 优先使用清单中 (资源包内) 的着色器源码, 缺失或编译失败时使用内置源码
+    const std::string& shaderName = m_sceneLoader->manifest().hero()->shader;
+    SceneLoader::ShaderSource shaderSource = m_sceneLoader->shaderSource(shaderName);
+    if (!shaderSource.empty()) {
+        try {
+            mProgram = std::make_unique<ModelProgram>(shaderSource.vertex, shaderSource.fragment);
+            LOGI("ModelProgram built from scene shader '%s'", shaderName.c_str());
+        } catch (const std::exception& e) {
+            LOGE("Scene shader '%s' failed, using built-in source: %s", shaderName.c_str(), e.what());
+        }
+    }
+    if (!mProgram) {
+        mProgram = std::make_unique<ModelProgram>();
+    }
     glEnable(GL_DEPTH_TEST);
     LOGI("GLES Initialized for model rendering.");
     
@@ -404,6 +441,12 @@ void ModelRenderer::initializeRenderingComponents() {
     axisConfig.length = m_modelDepth * 0.1f;
     axisConfig.depthTest = false;
     mAxis = std::make_unique<AxisRenderer>(axisConfig);
+    if (!mAxis->init()) {
+        LOGE("Failed to initialize AxisRenderer");
+    }
+
+    // 风场模型共用的全局纹理; activateTextures 中的绑定都属于 mProgram, 切换材质时不改变当前程序
+    m_windMaterial = m_renderQueue.registerMaterial([this]() { m_textureManager->activateTextures(); });
     
     // 初始化包围盒渲染器
     mBoundingBoxRenderer = std::make_unique<BoundingBoxRenderer>();
@@ -429,41 +472,273 @@ void ModelRenderer::initializeUBOData() {
     m_ubo.deltaX = 0.0f;
     m_ubo.deltaY = 0.0f;
     
-    // 初始化实例偏移数组
-    for (int i = 0; i < INSTANCES_COUNT; i++) {
-        m_ubo.instanceOffsets[i] = m_instanceOffsets[i];
-    }
-    
     // 立即更新到GPU
     mProgram->updateGlobals(m_ubo);
 }
 
-void ModelRenderer::initializeInstancedData() {
-    constexpr int instance_count = INSTANCES_COUNT;
-    render_instance_data.resize(instance_count);
-    generateInstanceData(render_instance_data, instance_count);
-    mModel->setupInstances(render_instance_data);
-    LOGI("Instances data generated.");
+void ModelRenderer::resizeRenderTargets(int width, int height) {
+    if (width <= 0 || height <= 0 || (width == mWidth && height == mHeight)) {
+        return;
+    }
+    LOGI("Render targets resized %dx%d -> %dx%d", mWidth, mHeight, width, height);
+    mWidth = width;
+    mHeight = height;
+    if (mOffscreenRenderer) {
+        mOffscreenRenderer->resize(width, height);
+    }
+    // 投影在首次初始化时按宽高比计算, 之后随尺寸更新
+    if (!mIsFirstDrawAfterModelLoaded) {
+        float aspect = static_cast<float>(mWidth) / static_cast<float>(mHeight);
+        m_projectionMatrix = glm::perspective(glm::radians(45.0f), aspect, 0.1f, m_modelDepth * 20.0f);
+    }
+    // 拾取缓冲按视口尺寸创建, 下一帧 initializeTouchPadIfNeeded 按新尺寸重建
+    if (m_touchPad) {
+        m_touchPad.reset();
+        mIsFirstTouchPadLoaded = true;
+    }
 }
 
-void ModelRenderer::initializeTextureManager() {
-    m_textureManager = &GlobalTextureManager::getInstance();
-    m_textureManager->initialize();
-    
-    // 加载图片到 map容器 -> m_textures; key = "cpp_vertexMovementTexture"
-    bool flag_texture = m_textureManager->loadTexture(m_modelDir + "/chufengmask.jpg", "fadeEdgeMask", false);
-    if (flag_texture) {
-        LOGI(" (fadeEdgeMask) Load texture success");
-    } else {
-        LOGE("(fadeEdgeMask)Load texture failed");
+void ModelRenderer::logSceneReadyIfDone() {
+    if (m_sceneReadyLogged || !m_sceneLoader->finished() || m_sceneModels.size() != m_sceneLoader->residentCount() ||
+        TextureLoader::getInstance().pendingCount() != 0) {
+        return;
     }
-    
+    m_sceneReadyLogged = true;
+
+    const AssetCache::Stats stats = AssetCache::getInstance().stats();
+    LOGI("Scene ready %lld ms after renderer creation (%s, renderer #%d): asset cache %d hits / %d misses",
+         static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::high_resolution_clock::now() - m_createTime).count()),
+         m_rendererIndex == 0 ? "cold start" : "warm restart", m_rendererIndex,
+         static_cast<int>(stats.hits - m_assetCacheAtCreate.hits),
+         static_cast<int>(stats.misses - m_assetCacheAtCreate.misses));
+    AssetCache::getInstance().logStats();
+#if INSTANCE_SCALING_BENCHMARK_ON_STARTUP
+    benchmarkInstanceScaling();
+#endif
+#if INSTANCE_BUFFER_BENCHMARK_ON_STARTUP
+    InstanceBufferManager::benchmark();
+#endif
+#if INSTANCE_CULL_BENCHMARK_ON_STARTUP
+    InstanceCuller::benchmark();
+#endif
+#if INSTANCE_BVH_BENCHMARK_ON_STARTUP
+    InstanceBVH::benchmark();
+#endif
+#if RENDER_QUEUE_BENCHMARK_ON_STARTUP
+    RenderQueue::benchmark();
+#endif
+}
+
+void ModelRenderer::applyInstanceEdits() {
+    std::vector<std::pair<size_t, glm::vec2>> offsetDeltas;
+    {
+        std::lock_guard<std::mutex> lock(m_instanceEditMutex);
+        offsetDeltas.swap(m_pendingOffsetDeltas);
+    }
+    SceneModel* hero = heroSceneModel();
+    if (hero) {
+        for (const auto& edit : offsetDeltas) {
+            if (edit.first >= hero->instances.size()) {
+                continue;
+            }
+            glm::vec4& offset = hero->instances[edit.first].offset;
+            offset.x += edit.second.x;
+            offset.y += edit.second.y;
+            hero->model->updateInstanceOffset(edit.first, offset);
+            hero->culler.updateInstance(edit.first, hero->instances[edit.first]);
+            hero->bvh.refitInstance(edit.first, hero->culler);
+        }
+    }
+    for (SceneModel& sceneModel : m_sceneModels) {
+        sceneModel.model->flushInstanceUpdates();
+    }
+}
+
+void ModelRenderer::cullInstances(const glm::mat4& viewMatrix) {
+    constexpr uint64_t kCullLogInterval = 300;    // 每 300 帧输出一次剔除统计
+    // 实例数达到该值时按 BVH 剔除 (InstanceBVH::benchmark: 1k 时与逐个测试持平, 10k 起明显更快)
+    constexpr size_t kBvhCullMinInstances = 4096;
+
+    const InstanceCuller::Frustum frustum = InstanceCuller::Frustum::fromMatrix(mCamera->getProjectionMatrix() * viewMatrix);
+    const float inflateY = InstanceCuller::windDisplacement(m_ubo.waveAmp);
+    size_t tested = 0;
+    size_t visible = 0;
+    double cullMs = 0.0;
+    size_t bvhNodes = 0;
+    for (SceneModel& sceneModel : m_sceneModels) {
+        const size_t count = sceneModel.instances.size();
+        if (sceneModel.cullerDirty) {
+            sceneModel.culler.setInstances(sceneModel.instances.data(), count,
+                                           sceneModel.model->boundsMin(), sceneModel.model->boundsMax());
+            sceneModel.bvh.build(sceneModel.culler);
+            sceneModel.cullerDirty = false;
+        } else if (sceneModel.bvh.refitsSinceBuild() > std::max<size_t>(256, count / 4)) {
+            // refit 只扩张/收缩节点, 拖动的实例多了以后树的划分不再合理
+            sceneModel.bvh.build(sceneModel.culler);
+        }
+        if (count >= kBvhCullMinInstances) {
+            sceneModel.bvh.cullFrustum(frustum, inflateY, sceneModel.visible);
+            cullMs += sceneModel.bvh.stats().queryMs;
+            bvhNodes += sceneModel.bvh.stats().nodesVisited;
+        } else {
+            sceneModel.culler.cull(frustum, inflateY, sceneModel.visible);
+            cullMs += sceneModel.culler.stats().cullMs;
+        }
+        sceneModel.model->setVisibleInstances(sceneModel.visible);
+        tested += count;
+        visible += sceneModel.visible.size();
+    }
+    if (++m_cullFrame % kCullLogInterval == 0) {
+        LOGI("Frustum culling: %d / %d instances visible, %.3f ms (%s, %d BVH nodes visited)", static_cast<int>(visible),
+             static_cast<int>(tested), cullMs, InstanceCuller::simdAvailable() ? "SIMD" : "scalar", static_cast<int>(bvhNodes));
+    }
+}
+
+bool ModelRenderer::pickRayHitsInstance(const glm::mat4& viewMatrix) {
+    SceneModel* hero = heroSceneModel();
+    if (!hero || hero->bvh.nodeCount() == 0 || mWidth <= 0 || mHeight <= 0) {
+        return true;    // 没有 BVH 时不做判断, 交给拾取 pass
+    }
+    // 触摸点 (左上角为原点的像素坐标) -> 近/远裁剪面上的世界坐标
+    const glm::vec2 position = m_cameraInteractor->getMouseLastPos();
+    const glm::vec2 ndc(position.x / mWidth * 2.0f - 1.0f, 1.0f - position.y / mHeight * 2.0f);
+    const glm::mat4 inverseViewProj = glm::inverse(mCamera->getProjectionMatrix() * viewMatrix);
+    glm::vec4 nearPoint = inverseViewProj * glm::vec4(ndc, -1.0f, 1.0f);
+    glm::vec4 farPoint = inverseViewProj * glm::vec4(ndc, 1.0f, 1.0f);
+    nearPoint /= nearPoint.w;
+    farPoint /= farPoint.w;
+    const glm::vec3 direction = glm::vec3(farPoint - nearPoint);
+
+    InstanceBVH::RayHit hit;
+    return hero->bvh.raycast(glm::vec3(nearPoint), direction, InstanceCuller::windDisplacement(m_ubo.waveAmp), hit, 1.0f);
+}
+
+ModelRenderer::SceneModel* ModelRenderer::heroSceneModel() {
+    for (SceneModel& sceneModel : m_sceneModels) {
+        if (sceneModel.hero) {
+            return &sceneModel;
+        }
+    }
+    return nullptr;
+}
+
+bool ModelRenderer::setHeroInstanceCount(int count) {
+    SceneModel* hero = heroSceneModel();
+    if (!hero || count <= 0) {
+        return false;
+    }
+    hero->set.count = count;
+    hero->set.columns = static_cast<int>(std::ceil(std::sqrt(static_cast<float>(count))));
+    hero->set.positions.clear();
+    generateInstanceData(*hero->model, hero->set, 1, hero->instances);
+    hero->model->setupInstances(hero->instances);
+    hero->cullerDirty = true;
+    m_lastPickedID = BACKGROUND_ID;
+    {
+        std::lock_guard<std::mutex> lock(m_instanceEditMutex);
+        m_pendingOffsetDeltas.clear();
+    }
+    LOGI("Hero instances: %d (%d columns)", count, hero->set.columns);
+    return true;
+}
+
+// ---- 帧耗时随实例数的变化 (INSTANCE_SCALING_BENCHMARK_ON_STARTUP) ----
+void ModelRenderer::benchmarkInstanceScaling() {
+    SceneModel* hero = heroSceneModel();
+    if (!hero || !mCamera) {
+        return;
+    }
+    const SceneManifest::InstanceSet original = hero->set;
+    const int counts[] = { 4, 64, 1024, 16384, 131072 };
+    constexpr int kWarmupFrames = 3;
+    constexpr int kFrames = 30;
+
+    glm::mat4 viewMatrix = mCamera->getViewMatrix();
+    const glm::mat4 modelMatrix = glm::mat4(1.0f);
+    auto drawFrame = [&]() {
+        mOffscreenRenderer->beginFrame();
+        updateUBOData(viewMatrix, modelMatrix);
+        m_renderQueue.reset(m_modelDepth * 20.0f);
+        submitModels(viewMatrix);
+        m_renderQueue.execute();
+        mOffscreenRenderer->endFrame();
+    };
+
+    for (int count : counts) {
+        setHeroInstanceCount(count);
+        for (int i = 0; i < kWarmupFrames; ++i) {
+            drawFrame();
+        }
+        glFinish();
+        const auto begin = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < kFrames; ++i) {
+            drawFrame();
+        }
+        glFinish();
+        const double ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - begin).count() / kFrames;
+        LOGI("Instance scaling: %6d instances, %.3f ms/frame (%.4f ms per 1k instances)",
+             count, ms, ms * 1000.0 / count);
+    }
+
+    // 恢复清单中的实例
+    hero->set = original;
+    generateInstanceData(*hero->model, hero->set, 1, hero->instances);
+    hero->model->setupInstances(hero->instances);
+    hero->cullerDirty = true;
+}
+
+void ModelRenderer::uploadResidentModels() {
+    // 每帧最多上传一个模型, 多个模型同时就绪时分摊到多帧; 槽位按清单顺序遍历, 同时就绪时 hero 先上传
+    for (size_t i = 0; i < m_sceneLoader->modelCount(); ++i) {
+        SceneLoader::ModelSlot& slot = m_sceneLoader->slot(i);
+        if (m_slotUploaded[i] || slot.currentState() != SceneLoader::State::Resident) {
+            continue;
+        }
+        m_slotUploaded[i] = true;
+
+        // 将模型数据从RAM上传到GPU
+        Model& model = *slot.model;
+        model.uploadToGPU();
+        model.checkProgramAttributes("ModelProgram", mProgram->activeAttributeMask());
+        if (slot.entry.shader != m_sceneLoader->manifest().hero()->shader) {
+            LOGE("Model '%s' requests shader '%s', only '%s' is bound; drawing with it",
+                 slot.entry.name.c_str(), slot.entry.shader.c_str(), m_sceneLoader->manifest().hero()->shader.c_str());
+        }
+
+        // hero 的实例编号 1..count 作为拾取 ID, 拖拽偏移随实例缓冲逐实例提供; 其余模型不参与拾取
+        SceneModel sceneModel;
+        sceneModel.model = &model;
+        sceneModel.hero = slot.entry.hero;
+        sceneModel.set = slot.entry.instances;
+        generateInstanceData(model, sceneModel.set, sceneModel.hero ? 1 : 0, sceneModel.instances);
+        model.setupInstances(sceneModel.instances);
+
+        if (sceneModel.hero) {
+            mModel = &model;
+        }
+        m_sceneModels.push_back(std::move(sceneModel));
+        LOGI("Model '%s' uploaded with %d instances (%d / %d models drawn), used:%lld ms",
+             slot.entry.name.c_str(), static_cast<int>(m_sceneModels.back().instances.size()),
+             static_cast<int>(m_sceneModels.size()), static_cast<int>(m_sceneLoader->modelCount()),
+             static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                 std::chrono::high_resolution_clock::now() - startTime).count()));
+        return;
+    }
+}
+
+void ModelRenderer::initializeTextureManager() {
+    // 纹理已在 initGLES 中提交解码, 这里只把带 uniform 的纹理绑定到着色器
     //  BUGFIXED -> 检测到错误 m_texture 绑定纹理到了 TEXTURE0 与ModelLoader纹理冲突
-    flag_texture = m_textureManager->bindToShader("fadeEdgeMask", mProgram->getProgramId(), "fadeEdgeMaskTexture");
-    if (flag_texture) {
-        LOGI("(fadeEdgeMask) Load texture success");
-    } else {
-        LOGE("(fadeEdgeMask) Load texture failed");
+    for (const SceneManifest::Texture& texture : m_sceneLoader->manifest().textures) {
+        if (texture.uniform.empty()) {
+            continue;
+        }
+        if (m_textureManager->bindToShader(texture.key, mProgram->getProgramId(), texture.uniform)) {
+            LOGI("(%s) Bind texture success", texture.key.c_str());
+        } else {
+            LOGE("(%s) Bind texture failed", texture.key.c_str());
+        }
     }
 }
 
@@ -478,7 +753,8 @@ void ModelRenderer::updateCameraIfNeeded() {
 }
 
 void ModelRenderer::initializeTouchPadIfNeeded() {
-    if (!mIsFirstTouchPadLoaded) return;
+    // 拾取与触摸交互只针对 hero 模型, 等它上传后再创建
+    if (!mIsFirstTouchPadLoaded || !mModel) return;
     
     mIsFirstTouchPadLoaded = false;
     try {
@@ -498,22 +774,18 @@ void ModelRenderer::initializeTouchPadIfNeeded() {
     // 设置相机移动回调
     m_cameraInteractor->setOnMoveCallbackFunction([&](float deltaX, float deltaY) {
         if (deltaX != 0.0f || deltaY != 0.0f) {
-            if (m_lastPickedID > 0 && m_lastPickedID <= INSTANCES_COUNT) {
-                int instanceIndex = m_lastPickedID - 1;
-                m_instanceOffsets[instanceIndex].deltaX += deltaX * 0.01f;
-                m_instanceOffsets[instanceIndex].deltaY += deltaY * 0.01f;
-
-                for (int i = 0; i < INSTANCES_COUNT; i++) {
-                    m_ubo.instanceOffsets[i] = m_instanceOffsets[i];
-                }
-                m_touchPad->updatePadGlobalInstanceOffsetArray(m_instanceOffsets);
+            // 拾取 ID 为 hero 的实例编号 (从 1 开始); 偏移在渲染线程写回实例缓冲, 绘制与拾取 pass 共用
+            if (m_lastPickedID > 0) {
+                std::lock_guard<std::mutex> lock(m_instanceEditMutex);
+                m_pendingOffsetDeltas.emplace_back(static_cast<size_t>(m_lastPickedID - 1),
+                                                   glm::vec2(deltaX, deltaY) * 0.01f);
             }
         }
     });
 }
 
 void ModelRenderer::performPickingIfRequested(const glm::mat4& modelMatrix, const glm::mat4& viewMatrix) {
-    if (!((m_touchPad && m_pickRequested) || mIsFirstAutomaticPicking)) return;
+    if (!m_touchPad || !(m_pickRequested || mIsFirstAutomaticPicking)) return;
     
     m_pickRequested = false;
     mIsFirstAutomaticPicking = false;
@@ -523,7 +795,8 @@ void ModelRenderer::performPickingIfRequested(const glm::mat4& modelMatrix, cons
     m_globals->projMatrix = mCamera->getProjectionMatrix();
 
     #ifdef ENABLE_INSTANCING
-    int pickedID = m_touchPad->performPickingInstancing();
+    // 触摸射线没有穿过任何 hero 实例的 (保守) 包围盒时必然拾取到背景, 省去拾取 pass 与像素回读
+    int pickedID = pickRayHitsInstance(viewMatrix) ? m_touchPad->performPickingInstancing() : BACKGROUND_ID;
     #else 
     int pickedID = m_touchPad->performPicking();
     #endif
@@ -541,20 +814,27 @@ void ModelRenderer::performPickingIfRequested(const glm::mat4& modelMatrix, cons
 }
 
 void ModelRenderer::renderScene(glm::mat4& viewMatrix, const glm::mat4& modelMatrix) {
-    // 渲染天空盒
+    constexpr uint64_t kQueueLogInterval = 300;   // 每 300 帧输出一次绘制队列统计
+
+    // 渲染天空盒 (启用时应作为 RenderQueue::Pass::Background 提交)
     //renderSkybox(viewMatrix);
     
-    // 设置模型渲染状态
-    setupModelRenderingState();
-    
     // 更新UBO数据
     updateUBOData(viewMatrix, modelMatrix);
-    
-    // 渲染模型
-    renderModel();
-    
-    // 渲染辅助元素
-    renderAuxiliaryElements(viewMatrix, modelMatrix);
+
+    // 提交模型与辅助元素, 按排序键执行 (深度范围取远裁剪面)
+    m_renderQueue.reset(m_modelDepth * 20.0f);
+    submitModels(viewMatrix);
+    submitAuxiliaryElements(viewMatrix, modelMatrix);
+    m_renderQueue.execute();
+
+    if (m_cullFrame % kQueueLogInterval == 0) {
+        const RenderQueue::Stats& stats = m_renderQueue.stats();
+        LOGI("RenderQueue: %d items, program/material/blend/depth changes %d/%d/%d/%d, sort %.3f ms, execute %.3f ms",
+             static_cast<int>(stats.items), static_cast<int>(stats.programChanges),
+             static_cast<int>(stats.materialChanges), static_cast<int>(stats.blendChanges),
+             static_cast<int>(stats.depthStateChanges), stats.sortMs, stats.executeMs);
+    }
 }
 
 void ModelRenderer::renderSkybox(glm::mat4& viewMatrix) {
@@ -572,14 +852,6 @@ void ModelRenderer::renderSkybox(glm::mat4& viewMatrix) {
     viewMatrix = originalView;
 }
 
-void ModelRenderer::setupModelRenderingState() {
-    static int frameCount = 0;
-    frameCount++;
-    
-    mProgram->use();
-    m_textureManager->activateTextures();
-}
-
 void ModelRenderer::updateUBOData(const glm::mat4& viewMatrix, const glm::mat4& modelMatrix) {
     static glm::mat4 lastProj, lastView, lastModel;
     static float lastUboTime = -1.0f;
@@ -616,10 +888,10 @@ void ModelRenderer::updateUBOData(const glm::mat4& viewMatrix, const glm::mat4&
     m_ubo.time = wrappedTime;
     m_ubo.pickedInstanceID = m_lastPickedID;
     
-    // 更新模型边界
-    if (mModel) {
-        m_ubo.boundMax = mModel->boundsMax();
-        m_ubo.boundMin = mModel->boundsMin();
+    // 更新模型边界 (第一个模型; 其余模型在 submitModels 的绘制回调中逐个替换)
+    if (!m_sceneModels.empty()) {
+        m_ubo.boundMax = m_sceneModels.front().model->boundsMax();
+        m_ubo.boundMin = m_sceneModels.front().model->boundsMin();
         mProgram->updateGlobals(m_ubo);
     }
 
@@ -628,47 +900,116 @@ void ModelRenderer::updateUBOData(const glm::mat4& viewMatrix, const glm::mat4&
     }
 }
 
-void ModelRenderer::renderModel() {
-    #ifndef ENABLE_INSTANCING
-    mModel->Draw(mProgram->getProgramId());
-    #else 
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-    glDepthMask(GL_FALSE);
-    mModel->DrawInstancedWind(mProgram->getProgramId(), INSTANCES_COUNT);
-    glDepthMask(GL_TRUE);
-    #endif
-}
+void ModelRenderer::submitModels(const glm::mat4& viewMatrix) {
+    const glm::vec3 eye = glm::vec3(glm::inverse(viewMatrix)[3]);
+    const GLuint program = mProgram->getProgramId();
 
-void ModelRenderer::renderAuxiliaryElements(const glm::mat4& viewMatrix, const glm::mat4& modelMatrix) {
-    // 渲染坐标轴
-    glDisable(GL_DEPTH_TEST);
-    mAxis->render(viewMatrix, m_projectionMatrix);
-    glEnable(GL_DEPTH_TEST);
+    for (size_t i = 0; i < m_sceneModels.size(); ++i) {
+        Model* model = m_sceneModels[i].model;
+        #ifdef ENABLE_INSTANCING
+        // 只绘制 cullInstances 留下的实例
+        if (model->drawInstanceCount() == 0) {
+            continue;
+        }
+        #endif
+
+        // 深度取全部实例包围盒 (没有 BVH 时取模型包围盒) 的中心; 同一次实例化绘制内的实例不排序
+        InstanceBVH::Aabb bounds;
+        if (!m_sceneModels[i].bvh.rootBounds(bounds)) {
+            bounds = { model->boundsMin(), model->boundsMax() };
+        }
 
-    // 渲染包围盒
-    if (mShowBoundingBox && mBoundingBoxRenderer && mModel) {
-        renderBoundingBoxes(viewMatrix, modelMatrix);
+        RenderQueue::DrawItem item;
+        #ifdef ENABLE_INSTANCING
+        // 半透明的风场分层: 关闭深度写入, 由远到近
+        item.pass = RenderQueue::Pass::Transparent;
+        item.blend = RenderQueue::BlendMode::Alpha;
+        #else
+        item.pass = RenderQueue::Pass::Opaque;
+        item.blend = RenderQueue::BlendMode::Opaque;
+        #endif
+        item.program = program;
+        item.material = m_windMaterial;
+        item.depth = glm::length((bounds.min + bounds.max) * 0.5f - eye);
+        item.mesh = static_cast<uint32_t>(i);
+        item.draw = [this, model, program]() {
+            // 风场分层按各模型自身的包围盒计算
+            if (m_ubo.boundMin != model->boundsMin() || m_ubo.boundMax != model->boundsMax()) {
+                m_ubo.boundMin = model->boundsMin();
+                m_ubo.boundMax = model->boundsMax();
+                mProgram->updateGlobals(m_ubo);
+            }
+            #ifdef ENABLE_INSTANCING
+            model->DrawInstancedWind(program, model->drawInstanceCount());
+            #else
+            model->Draw(program);
+            #endif
+        };
+        m_renderQueue.submit(std::move(item));
     }
 }
 
-void ModelRenderer::renderBoundingBoxes(const glm::mat4& viewMatrix, const glm::mat4& modelMatrix) {
-    glm::vec3 minBounds = mModel->boundsMin();
-    glm::vec3 maxBounds = mModel->boundsMax();
-    glm::vec3 boundingBoxColor(1.0f, 1.0f, 0.0f);
-    
-    // 渲染全局模型包围盒
-    glm::mat4 mvpMatrix = mCamera->getProjectionMatrix() * viewMatrix * modelMatrix;
-    mBoundingBoxRenderer->drawBoundingBox(minBounds, maxBounds, mvpMatrix, boundingBoxColor);
-    
-    #ifdef ENABLE_INSTANCING
-    // 渲染实例包围盒
-    glm::vec3 instanceColor(0.0f, 1.0f, 1.0f);
-    for (int i = 0; i < INSTANCES_COUNT; i++) {
-        glm::mat4 instanceModelMatrix = render_instance_data[i].modelMatrix;
-        glm::mat4 instanceMvpMatrix = mCamera->getProjectionMatrix() * viewMatrix * instanceModelMatrix;
-        mBoundingBoxRenderer->drawBoundingBox(minBounds, maxBounds, instanceMvpMatrix, instanceColor);
+void ModelRenderer::submitAuxiliaryElements(const glm::mat4& viewMatrix, const glm::mat4& modelMatrix) {
+    // 坐标轴
+    if (mAxis && mAxis->program() != 0) {
+        RenderQueue::DrawItem axisItem;
+        axisItem.pass = RenderQueue::Pass::Overlay;
+        axisItem.program = mAxis->program();
+        axisItem.depthTest = mAxis->depthTestEnabled();
+        axisItem.depthWrite = false;
+        axisItem.mesh = 0;
+        axisItem.draw = [this, viewMatrix]() { mAxis->draw(viewMatrix, m_projectionMatrix); };
+        m_renderQueue.submit(std::move(axisItem));
+    }
+
+    // 包围盒
+    if (mShowBoundingBox && mBoundingBoxRenderer && !m_sceneModels.empty()) {
+        RenderQueue::DrawItem boxItem;
+        boxItem.pass = RenderQueue::Pass::Overlay;
+        boxItem.blend = RenderQueue::BlendMode::Alpha;
+        boxItem.program = mBoundingBoxRenderer->programHandle();
+        boxItem.depthWrite = false;
+        boxItem.mesh = 1;
+        boxItem.draw = [this, viewMatrix, modelMatrix]() { renderBoundingBoxes(viewMatrix, modelMatrix); };
+        m_renderQueue.submit(std::move(boxItem));
     }
-    #endif
 }
 
+// 由 RenderQueue 执行: 包围盒程序、混合与深度状态已设置, 这里只批量发出绘制调用
+void ModelRenderer::renderBoundingBoxes(const glm::mat4& viewMatrix, const glm::mat4& modelMatrix) {
+    glm::vec3 boundingBoxColor(1.0f, 1.0f, 0.0f);
+
+    mBoundingBoxRenderer->beginBatch();
+
+    for (const SceneModel& sceneModel : m_sceneModels) {
+        glm::vec3 minBounds = sceneModel.model->boundsMin();
+        glm::vec3 maxBounds = sceneModel.model->boundsMax();
+
+        // 渲染全局模型包围盒
+        glm::mat4 mvpMatrix = mCamera->getProjectionMatrix() * viewMatrix * modelMatrix;
+        mBoundingBoxRenderer->drawBatched(minBounds, maxBounds, mvpMatrix, boundingBoxColor);
+
+        #ifdef ENABLE_INSTANCING
+        // 渲染实例包围盒 (只画视锥内的实例); 可见实例过多时改画 BVH 中不超过 kMaxDebugBoxes 个节点的那一层
+        constexpr size_t kMaxDebugBoxes = 256;
+        glm::vec3 instanceColor(0.0f, 1.0f, 1.0f);
+        if (sceneModel.visible.size() <= kMaxDebugBoxes) {
+            for (uint32_t index : sceneModel.visible) {
+                const InstanceData& instance = sceneModel.instances[index];
+                glm::mat4 instanceMvpMatrix = mCamera->getProjectionMatrix() * viewMatrix * instance.modelMatrix;
+                mBoundingBoxRenderer->drawBatched(minBounds, maxBounds, instanceMvpMatrix, instanceColor);
+            }
+        } else {
+            const glm::mat4 viewProj = mCamera->getProjectionMatrix() * viewMatrix;
+            std::vector<InstanceBVH::Aabb> nodeBounds;
+            sceneModel.bvh.collectVisibleNodeBounds(InstanceCuller::Frustum::fromMatrix(viewProj),
+                                                    InstanceCuller::windDisplacement(m_ubo.waveAmp), kMaxDebugBoxes, nodeBounds);
+            glm::vec3 nodeColor(1.0f, 0.0f, 1.0f);
+            for (const InstanceBVH::Aabb& bounds : nodeBounds) {
+                mBoundingBoxRenderer->drawBatched(bounds.min, bounds.max, viewProj, nodeColor);
+            }
+        }
+        #endif
+    }
+    mBoundingBoxRenderer->endBatch();
+}
\ No newline at end of file
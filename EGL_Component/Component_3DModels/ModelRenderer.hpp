@@ -10,11 +10,14 @@
 // ColorPick功能中的背景ID
 #define BACKGROUND_ID 0
 
+// 置 1 后在场景就绪时运行一次 benchmarkInstanceScaling: hero 实例数 4 ~ 131072 的帧耗时
+#define INSTANCE_SCALING_BENCHMARK_ON_STARTUP 0
+
 #include <string>
 #include <memory>
 #include <vector>
-#include <thread> // 用于异步加载模型的线程
 #include <atomic>
+#include <mutex>
 #include <ctime>
 #include <random>
 
@@ -30,6 +33,7 @@
 #endif
 
 #include "ModelLoader_Universal_Instancing.hpp"
+#include "SceneLoader.hpp"
 // #include "Component_Shader_Blinn_Phong/PhongModelProgram.hpp"
 #include "Component_Shader_Blinn_Phong/WindShader.hpp"
 #include "glm/glm.hpp"
@@ -50,6 +54,13 @@
 #endif
 
 #include "Component_TextureManager/TextureManager.hpp"
+#include "TextureLoader.hpp"
+#include "TextureCache.hpp"
+#include "VirtualFileSystem.hpp"
+#include "EglSurfaceHost.hpp"
+#include "InstanceCuller.hpp"
+#include "InstanceBVH.hpp"
+#include "RenderQueue.hpp"
 
 struct Globals;
 
@@ -74,14 +85,33 @@ public:
     Camera &getCamera();
     CameraInteractor* getInteractor() { return m_cameraInteractor.get(); }
 
-    // 生成实例化数据
-    void generateInstanceData( std::vector<InstanceData>& instanceData, int instanceCount );
+    // 按清单中的实例组生成实例化数据; firstInstanceId 为 0 时实例不参与拾取
+    void generateInstanceData( const Model& model, const SceneManifest::InstanceSet& set,
+                               uint32_t firstInstanceId, std::vector<InstanceData>& instanceData );
+
+    /**
+     * @brief 运行时修改 hero 的实例数: 按近似正方形的网格重新排列并重新上传实例缓冲, 已有的拖拽偏移清零
+     * @return false hero 模型尚未上传
+     */
+    bool setHeroInstanceCount(int count);
 
     // 包围盒控制方法
     void setBoundingBoxVisible(bool visible) { mShowBoundingBox = visible; }
     bool isBoundingBoxVisible() const { return mShowBoundingBox; }
     void requestPick() { m_pickRequested = true; }
 
+    #ifdef __ANDROID__
+    /**
+     * @brief 把渲染器挂到新的窗口上并在调用线程上设为当前: EGL 上下文与全部 GL 资源保留,
+     *        尺寸变化时只重建离屏渲染目标与拾取缓冲。接管 window 的引用 (失败时释放), 之前的窗口随旧表面释放
+     */
+    bool attachSurface(ANativeWindow* window, int width, int height);
+    // 销毁窗口表面并释放窗口 (Java 侧 surfaceDestroyed), 上下文保留; 之后 draw() 直接返回, 直到 attachSurface
+    void detachSurface();
+    // 渲染线程退出前调用: 让出上下文, 其它线程随后可以 attachSurface / 析构
+    void releaseCurrent();
+    #endif
+
 private:
     bool mIsInitialized = false;
     // 初始化 OpenGL 环境
@@ -91,10 +121,8 @@ private:
 
     #ifdef __ANDROID__
     ANativeWindow* mWindow;
-    // EGL 相关
-    EGLDisplay mDisplay = EGL_NO_DISPLAY;
-    EGLSurface mSurface = EGL_NO_SURFACE;
-    EGLContext mContext = EGL_NO_CONTEXT;
+    // EGL 上下文与窗口表面分开管理, 表面重建时上下文 (及全部 GL 资源) 保留
+    std::unique_ptr<EglSurfaceHost> mEgl;
     bool initEGL();
     void destroyEGL();
     #else
@@ -106,15 +134,15 @@ private:
     int mWidth;
     int mHeight;
 
-    // 模型异步加载相关
-    std::thread mLoadingThread;
-    std::atomic<bool> mIsModelLoaded{false}; // 原子化布尔值 保证线程安全
+    // 场景异步加载相关: 清单中的模型由 SceneLoader 在后台并行加载, 任一模型就绪即可开始绘制
+    std::unique_ptr<SceneLoader> m_sceneLoader;
+    std::atomic<bool> mIsModelLoaded{false}; // 至少一个模型已经就绪
     std::atomic<bool> mIsFirstDrawAfterModelLoaded{true};
     std::atomic<bool> mIsFirstTouchPadLoaded{true};
     std::atomic<bool> mIsFirstAutomaticPicking{true};   // 程序一开始自动触发一次Pick渲染
 
     // 渲染相关
-    std::unique_ptr<Model> mModel;
+    Model* mModel = nullptr;    // hero 模型 (拾取/触摸交互), 由 m_sceneLoader 持有, 上传后才设置
     std::unique_ptr<ModelProgram> mProgram;
     std::unique_ptr<LoadingViewClass> mLoadingViewProgram;
     std::unique_ptr<OffscreenRenderer> mOffscreenRenderer; // 使用组合
@@ -127,6 +155,9 @@ private:
     // 天空盒
     std::unique_ptr<Skybox> mSkybox;
 
+    // 每帧最多上传的纹理像素字节数, 避免一次上传全部纹理造成掉帧
+    static constexpr size_t kTextureUploadBytesPerFrame = 16 * 1024 * 1024;
+
     // 坐标轴
     std::unique_ptr<AxisRenderer> mAxis;
 
@@ -188,21 +219,44 @@ private:
     float m_modelDepth;
     std::atomic<bool> m_pickRequested{false};
 
-    // instancing
-    std::vector<InstanceData> render_instance_data;
+    // 已上传到 GPU 的模型, 按上传顺序提交到绘制队列 (hero 优先)
+    struct SceneModel {
+        Model* model = nullptr;
+        std::vector<InstanceData> instances;    // 与模型实例缓冲一致的 CPU 副本 (包含拖拽偏移)
+        SceneManifest::InstanceSet set;
+        bool hero = false;
+        // 视锥剔除: 实例重新生成后 cullerDirty 置位, 下一次剔除前重建全部包围盒与 BVH
+        InstanceCuller culler;
+        InstanceBVH bvh;                        // 实例多时的剔除、射线拾取预判与包围盒调试绘制
+        std::vector<uint32_t> visible;
+        bool cullerDirty = true;
+    };
+    std::vector<SceneModel> m_sceneModels;
+    std::vector<bool> m_slotUploaded;   // 与 m_sceneLoader 的模型槽位一一对应
 
     // 触摸相关
     int m_lastPickedID = BACKGROUND_ID;        // 跟踪最后一次拾取的模型
+    // 拖拽回调可能在触摸线程上执行: 偏移增量 (hero 实例下标, 增量) 先记在这里, 渲染线程每帧写入实例数据
+    std::mutex m_instanceEditMutex;
+    std::vector<std::pair<size_t, glm::vec2>> m_pendingOffsetDeltas;
     ModelProgram::WindUBO m_ubo;    // 存储当前UBO参数
 
-    // 每个实例的独立偏移状态
-    InstanceOffset m_instanceOffsets[INSTANCES_COUNT];
-
-    // 额外纹理加载 使用全局纹理管理器
+    // 清单中的全局纹理 使用全局纹理管理器
     std::string m_modelDir = "";
     // auto& m_textureManager = GlobalTextureManager::getInstance();
     GlobalTextureManager* m_textureManager = nullptr;
 
+    // 重建耗时: 构造 -> 全部模型与纹理上传完成; 同一进程中的后续渲染器从 AssetCache 取回 CPU 数据
+    std::chrono::high_resolution_clock::time_point m_createTime;
+    AssetCache::Stats m_assetCacheAtCreate;
+    int m_rendererIndex = 0;            // 本进程中第几个渲染器 (0 为冷启动)
+    bool m_sceneReadyLogged = false;
+    uint64_t m_cullFrame = 0;
+
+    // 每帧的绘制队列: 模型与辅助元素提交绘制项, 排序后统一执行
+    RenderQueue m_renderQueue;
+    uint32_t m_windMaterial = RenderQueue::kNoMaterial;    // 全局纹理 (activateTextures)
+
     // ========== 私有辅助方法 ==========
     // 渲染相关辅助方法
     void drawLoadingView();
@@ -213,18 +267,29 @@ private:
     void renderScene(glm::mat4& viewMatrix, const glm::mat4& modelMatrix);
     
     // 初始化相关辅助方法
-    void initializeCameraSystem();
+    void initializeCameraSystem(const Model& model);
     void initializeRenderingComponents();
     void initializeUBOData();
-    void initializeInstancedData();
+    void uploadResidentModels();
+    void logSceneReadyIfDone();
+    // 写入本帧的实例修改并上传 (每个模型合并为一次 flush), 拾取与绘制之前调用
+    void applyInstanceEdits();
+    // 按当前相机剔除每个模型的实例, 可见实例写入模型的紧凑实例缓冲; 拾取与绘制之前调用
+    void cullInstances(const glm::mat4& viewMatrix);
+    // 触摸点的射线是否穿过 hero 的某个实例包围盒 (BVH 查询); false 时拾取结果一定是背景
+    bool pickRayHitsInstance(const glm::mat4& viewMatrix);
+    SceneModel* heroSceneModel();
+    // hero 实例数从 4 到 131072 逐级放大, 每级离屏绘制若干帧并输出平均帧耗时, 结束后恢复清单中的实例
+    void benchmarkInstanceScaling();
+    // 表面尺寸变化: 重建离屏 FBO、更新投影, 拾取缓冲下一帧按新尺寸重建
+    void resizeRenderTargets(int width, int height);
     void initializeTextureManager();
     
     // 渲染流程辅助方法
     void renderSkybox(glm::mat4& viewMatrix);
-    void setupModelRenderingState();
     void updateUBOData(const glm::mat4& viewMatrix, const glm::mat4& modelMatrix);
-    void renderModel();
-    void renderAuxiliaryElements(const glm::mat4& viewMatrix, const glm::mat4& modelMatrix);
+    void submitModels(const glm::mat4& viewMatrix);
+    void submitAuxiliaryElements(const glm::mat4& viewMatrix, const glm::mat4& modelMatrix);
     void renderBoundingBoxes(const glm::mat4& viewMatrix, const glm::mat4& modelMatrix);
 
 };
\ No newline at end of file
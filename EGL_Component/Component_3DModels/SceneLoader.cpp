@@ -0,0 +1,124 @@
+#include "SceneLoader.hpp"
+#include "VirtualFileSystem.hpp"
+#include "macros.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+#ifdef __ANDROID__
+const char* const kShaderSuffix = ".es";
+#else
+const char* const kShaderSuffix = ".core";
+#endif
+
+bool readText(const std::string& path, std::string& out) {
+    AssetFile file;
+    if (!file.open(path)) {
+        return false;
+    }
+    out.assign(reinterpret_cast<const char*>(file.data()), file.size());
+    return true;
+}
+
+} // namespace
+
+SceneLoader::SceneLoader(SceneManifest manifest)
+    : m_manifest(std::move(manifest)) {
+    m_slots.reserve(m_manifest.models.size());
+    for (const SceneManifest::Model& entry : m_manifest.models) {
+        auto slot = std::make_unique<ModelSlot>();
+        slot->entry = entry;
+        m_slots.push_back(std::move(slot));
+    }
+}
+
+SceneLoader::~SceneLoader() {
+    m_pool.reset();
+}
+
+void SceneLoader::start(const OptionsProvider& optionsFor) {
+    if (m_pool) {
+        LOGE("SceneLoader::start called twice");
+        return;
+    }
+    m_optionsFor = optionsFor;
+
+    // 同时加载的模型数不超过核心数, 每个模型内部的网格转换再分到剩余的核心
+    const size_t cores = ThreadPool::defaultThreadCount();
+    const size_t concurrent = std::max<size_t>(1, std::min(cores, m_slots.size()));
+    const size_t workerThreads = std::max<size_t>(1, cores / concurrent);
+    m_pool = std::make_unique<ThreadPool>(concurrent);
+
+    // 着色器源码很小, 先于模型提交
+    for (const SceneManifest::Shader& shader : m_manifest.shaders) {
+        m_shaders[shader.name] = m_pool->submit([shader]() { return readShader(shader); }).share();
+    }
+
+    for (const std::unique_ptr<ModelSlot>& slot : m_slots) {
+        ModelSlot* target = slot.get();
+        m_pool->submit([this, target, workerThreads]() { loadModel(*target, m_optionsFor, workerThreads); });
+    }
+    LOGI("SceneLoader: %d models, %d shaders queued on %d threads (%d mesh workers each)",
+         static_cast<int>(m_slots.size()), static_cast<int>(m_manifest.shaders.size()),
+         static_cast<int>(concurrent), static_cast<int>(workerThreads));
+}
+
+SceneLoader::ShaderSource SceneLoader::shaderSource(const std::string& name) {
+    auto it = m_shaders.find(name);
+    if (it == m_shaders.end()) {
+        return {};
+    }
+    return it->second.get();
+}
+
+void SceneLoader::loadModel(ModelSlot& slot, const OptionsProvider& optionsFor, size_t workerThreads) {
+    const auto start = std::chrono::high_resolution_clock::now();
+    slot.state.store(static_cast<int>(State::Loading), std::memory_order_relaxed);
+    const std::string& path = slot.entry.path;
+    try {
+        ModelLoadOptions options = optionsFor ? optionsFor(slot.entry) : ModelLoadOptions();
+        if (options.workerThreads == 0) {
+            options.workerThreads = workerThreads;
+        }
+#if OBJ_BENCHMARK_ON_STARTUP
+        if (slot.entry.hero && ObjAsset::isObjPath(path)) {
+            ObjAsset::compareWithAssimp(path, Model::assimpImportFlags());
+            ObjAsset::benchmark(path, Model::assimpImportFlags());
+        }
+#endif
+#if IMPORT_ARENA_BENCHMARK_ON_STARTUP
+        if (slot.entry.hero) {
+            Model::benchmarkImportArena(path, options);
+        }
+#endif
+#if ASSET_CACHE_BENCHMARK_ON_STARTUP
+        if (slot.entry.hero) {
+            Model::benchmarkWarmRestart(path, options);
+        }
+#endif
+        slot.model = std::make_unique<Model>(path, options);
+        slot.state.store(static_cast<int>(State::Resident), std::memory_order_release);
+        m_resident.fetch_add(1, std::memory_order_acq_rel);
+        LOGI("SceneLoader: '%s' resident in %lld ms", slot.entry.name.c_str(),
+             static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                 std::chrono::high_resolution_clock::now() - start).count()));
+    } catch (const std::exception& e) {
+        slot.model.reset();
+        slot.state.store(static_cast<int>(State::Failed), std::memory_order_release);
+        LOGE("SceneLoader: failed to load '%s': %s", path.c_str(), e.what());
+    }
+    m_finished.fetch_add(1, std::memory_order_acq_rel);
+}
+
+SceneLoader::ShaderSource SceneLoader::readShader(const SceneManifest::Shader& shader) {
+    ShaderSource source;
+    if (!readText(shader.vertex + kShaderSuffix, source.vertex) ||
+        !readText(shader.fragment + kShaderSuffix, source.fragment)) {
+        LOGI("SceneLoader: shader '%s' not found as %s%s, using built-in source",
+             shader.name.c_str(), shader.vertex.c_str(), kShaderSuffix);
+        return {};
+    }
+    return source;
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "SceneManifest.hpp"
+#include "ModelLoader_Universal_Instancing.hpp"
+#include "ThreadPool.hpp"
+
+/**
+ * @brief 按场景清单在后台并行加载全部模型与着色器源码
+ *
+ * 依赖顺序: 全局纹理由调用方在 start() 之前交给 GlobalTextureManager (解码队列先进先出, 排在最前),
+ * 模型内部先提交材质纹理的解码再转换网格, 因此解码与网格转换重叠进行。
+ * 模型任务按清单顺序 (hero 在前, 其余按优先级) 提交, 空闲线程总是先取优先级最高的模型。
+ *
+ * 每个模型有独立的状态, 变为 Resident 后 GL 线程即可 uploadToGPU 并绘制, 不必等待其它模型。
+ * 析构时等待仍在执行的任务结束。
+ */
+class SceneLoader {
+public:
+    enum class State : int {
+        Pending  = 0,   // 排队中
+        Loading  = 1,   // 正在导入 / 转换
+        Resident = 2,   // CPU 端数据就绪, 等待 GL 线程上传
+        Failed   = 3,
+    };
+
+    struct ModelSlot {
+        SceneManifest::Model entry;
+        std::unique_ptr<Model> model;   // state 变为 Resident 之后才可以访问
+        std::atomic<int> state{static_cast<int>(State::Pending)};
+
+        State currentState() const { return static_cast<State>(state.load(std::memory_order_acquire)); }
+    };
+
+    // 为空表示清单中没有该着色器或读取失败, 调用方使用内置源码
+    struct ShaderSource {
+        std::string vertex;
+        std::string fragment;
+
+        bool empty() const { return vertex.empty() || fragment.empty(); }
+    };
+
+    using OptionsProvider = std::function<ModelLoadOptions(const SceneManifest::Model&)>;
+
+    explicit SceneLoader(SceneManifest manifest);
+    ~SceneLoader();
+
+    SceneLoader(const SceneLoader&)            = delete;
+    SceneLoader& operator=(const SceneLoader&) = delete;
+
+    /**
+     * @brief 提交全部加载任务后立即返回
+     * @param optionsFor 每个模型的导入选项 (例如按绑定的程序裁剪顶点属性); 在工作线程中调用
+     */
+    void start(const OptionsProvider& optionsFor);
+
+    const SceneManifest& manifest() const { return m_manifest; }
+
+    size_t modelCount() const { return m_slots.size(); }
+    ModelSlot& slot(size_t index) { return *m_slots[index]; }
+
+    // 已经 Resident 的模型数量 / 是否全部模型都已结束 (Resident 或 Failed)
+    size_t residentCount() const { return m_resident.load(std::memory_order_acquire); }
+    bool finished() const { return m_finished.load(std::memory_order_acquire) == m_slots.size(); }
+
+    /**
+     * @brief 取得着色器源码, 尚未读完时阻塞等待 (只是一次文件读取)
+     */
+    ShaderSource shaderSource(const std::string& name);
+
+private:
+    void loadModel(ModelSlot& slot, const OptionsProvider& optionsFor, size_t workerThreads);
+    static ShaderSource readShader(const SceneManifest::Shader& shader);
+
+    SceneManifest m_manifest;
+    std::vector<std::unique_ptr<ModelSlot>> m_slots;
+    std::unordered_map<std::string, std::shared_future<ShaderSource>> m_shaders;
+    std::atomic<size_t> m_resident{0};
+    std::atomic<size_t> m_finished{0};
+    OptionsProvider m_optionsFor;
+
+    // 最后声明, 最先析构: 等待任务结束时槽位仍然有效
+    std::unique_ptr<ThreadPool> m_pool;
+};
@@ -0,0 +1,177 @@
+#include "SceneManifest.hpp"
+#include "CommonTypes.hpp"
+#include "Json.hpp"
+#include "VirtualFileSystem.hpp"
+#include "macros.h"
+
+#include <algorithm>
+
+namespace {
+
+std::string resolvePath(const std::string& baseDir, const std::string& path) {
+    if (path.empty() || path[0] == '/' || path.find(':') != std::string::npos) {
+        return path;
+    }
+    return baseDir + "/" + path;
+}
+
+glm::vec3 readVec3(const JsonValue& value, const glm::vec3& fallback) {
+    if (!value.isArray() || value.size() < 3) {
+        return fallback;
+    }
+    return glm::vec3(value[0].asFloat(fallback.x), value[1].asFloat(fallback.y), value[2].asFloat(fallback.z));
+}
+
+SceneManifest::InstanceSet readInstanceSet(const std::string& name, const JsonValue& value) {
+    SceneManifest::InstanceSet set;
+    set.name    = name;
+    set.scale   = value["scale"].asFloat(1.0f);
+    set.spacing = value["spacing"].asFloat(1.0f);
+    set.columns = static_cast<int>(std::max<int64_t>(0, value["columns"].asInt(0)));
+    set.offset  = readVec3(value["offset"], glm::vec3(0.0f));
+    for (const JsonValue& position : value["positions"].elements()) {
+        set.positions.push_back(readVec3(position, glm::vec3(0.0f)));
+    }
+    const int64_t count = value["count"].asInt(set.positions.empty() ? 1 : static_cast<int64_t>(set.positions.size()));
+    set.count = static_cast<int>(std::max<int64_t>(1, count));
+    if (!set.positions.empty()) {
+        set.count = std::min(set.count, static_cast<int>(set.positions.size()));
+    }
+    return set;
+}
+
+} // namespace
+
+bool SceneManifest::load(const std::string& path, const std::string& baseDir, std::string* outError) {
+    AssetFile file;
+    if (!file.open(path)) {
+        if (outError) *outError = "file not found";
+        return false;
+    }
+
+    JsonValue doc;
+    std::string error;
+    if (!JsonValue::parse(reinterpret_cast<const char*>(file.data()), file.size(), doc, &error)) {
+        if (outError) *outError = error;
+        return false;
+    }
+
+    *this = SceneManifest();
+
+    for (const JsonValue& value : doc["shaders"].elements()) {
+        Shader shader;
+        shader.name     = value["name"].asString();
+        shader.vertex   = resolvePath(baseDir, value["vertex"].asString());
+        shader.fragment = resolvePath(baseDir, value["fragment"].asString());
+        if (shader.name.empty()) {
+            LOGE("SceneManifest: shader without name skipped");
+            continue;
+        }
+        shaders.push_back(std::move(shader));
+    }
+
+    for (const JsonValue& value : doc["textures"].elements()) {
+        Texture texture;
+        texture.key      = value["key"].asString();
+        texture.path     = resolvePath(baseDir, value["path"].asString());
+        texture.mipmap   = value["mipmap"].asBool(true);
+        texture.uniform  = value["uniform"].asString();
+        texture.priority = static_cast<int>(value["priority"].asInt(0));
+        if (texture.key.empty() || value["path"].asString().empty()) {
+            LOGE("SceneManifest: texture entry needs both key and path");
+            continue;
+        }
+        textures.push_back(std::move(texture));
+    }
+
+    std::vector<InstanceSet> sets;
+    for (const JsonValue::Member& member : doc["instanceSets"].members()) {
+        sets.push_back(readInstanceSet(member.first, member.second));
+    }
+
+    for (const JsonValue& value : doc["models"].elements()) {
+        Model model;
+        model.path     = value["path"].asString();
+        model.name     = value.has("name") ? value["name"].asString() : model.path;
+        model.priority = static_cast<int>(value["priority"].asInt(0));
+        model.hero     = value["hero"].asBool(false);
+        if (value.has("shader")) model.shader = value["shader"].asString();
+        if (model.path.empty()) {
+            LOGE("SceneManifest: model '%s' has no path", model.name.c_str());
+            continue;
+        }
+        model.path = resolvePath(baseDir, model.path);
+
+        // 实例组可以引用 instanceSets 中的名字, 也可以直接内联
+        const JsonValue& instances = value["instances"];
+        if (instances.isString()) {
+            auto it = std::find_if(sets.begin(), sets.end(),
+                                   [&](const InstanceSet& set) { return set.name == instances.asString(); });
+            if (it != sets.end()) {
+                model.instances = *it;
+            } else {
+                LOGE("SceneManifest: model '%s' references unknown instance set '%s'",
+                     model.name.c_str(), instances.asString().c_str());
+            }
+        } else if (instances.isObject()) {
+            model.instances = readInstanceSet(model.name, instances);
+        }
+        models.push_back(std::move(model));
+    }
+
+    if (models.empty()) {
+        if (outError) *outError = "no models listed";
+        return false;
+    }
+    finalize();
+    return true;
+}
+
+SceneManifest SceneManifest::makeDefault(const std::string& baseDir) {
+    SceneManifest manifest;
+
+    Texture mask;
+    mask.key     = "fadeEdgeMask";
+    mask.path    = baseDir + "/chufengmask.jpg";
+    mask.mipmap  = false;
+    mask.uniform = "fadeEdgeMaskTexture";
+    manifest.textures.push_back(mask);
+
+    Model model;
+    model.name = "chufeng";
+    model.path = baseDir + "/chufeng.obj";
+    model.hero = true;
+    model.instances.name  = "row";
+    model.instances.count = INSTANCES_COUNT;
+    model.instances.scale = INSTANCE_SCALE;
+    manifest.models.push_back(model);
+
+    manifest.finalize();
+    return manifest;
+}
+
+const SceneManifest::Model* SceneManifest::hero() const {
+    return models.empty() ? nullptr : &models.front();
+}
+
+const SceneManifest::Shader* SceneManifest::findShader(const std::string& name) const {
+    for (const Shader& shader : shaders) {
+        if (shader.name == name) return &shader;
+    }
+    return nullptr;
+}
+
+void SceneManifest::finalize() {
+    std::stable_sort(textures.begin(), textures.end(),
+                     [](const Texture& a, const Texture& b) { return a.priority > b.priority; });
+    std::stable_sort(models.begin(), models.end(),
+                     [](const Model& a, const Model& b) { return a.priority > b.priority; });
+
+    // hero 排在最前: 显式标记的第一个, 否则就是优先级最高的模型
+    auto hero = std::find_if(models.begin(), models.end(), [](const Model& model) { return model.hero; });
+    if (hero == models.end()) hero = models.begin();
+    std::rotate(models.begin(), hero, hero + 1);
+    for (size_t i = 0; i < models.size(); ++i) {
+        models[i].hero = (i == 0);
+    }
+}
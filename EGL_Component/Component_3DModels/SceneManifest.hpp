@@ -0,0 +1,85 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "glm/glm.hpp"
+
+/**
+ * @brief 场景清单: 列出场景用到的模型、实例组、全局纹理与着色器 (<modelDir>/scene.json)
+ *
+ * {
+ *   "shaders":  [ { "name": "wind", "vertex": "shaders/wind.vert", "fragment": "shaders/wind.frag" } ],
+ *   "textures": [ { "key": "fadeEdgeMask", "path": "chufengmask.jpg", "mipmap": false,
+ *                   "uniform": "fadeEdgeMaskTexture", "priority": 100 } ],
+ *   "instanceSets": { "row": { "count": 4, "scale": 0.1, "spacing": 1.0, "offset": [0, 0, 0] },
+ *                     "pair": { "scale": 0.1, "positions": [ [0, 0, 1], [0, 0, -1] ] },
+ *                     "field": { "count": 10000, "columns": 100, "scale": 0.1, "spacing": 1.2 } },
+ *   "models":   [ { "name": "chufeng", "path": "chufeng.obj", "priority": 100, "hero": true,
+ *                   "shader": "wind", "instances": "row" } ]
+ * }
+ *
+ * - 路径相对于清单所在目录; 着色器路径不含后缀, 加载时按平台补 ".core" (桌面) / ".es" (GLES)
+ * - priority 越大越先加载; hero 模型 (没有标记时取优先级最高的模型) 排在所有模型之前,
+ *   它承担相机取景、拾取与触摸交互
+ * - 实例组没有 positions 时按模型缩放后的宽度 * spacing 沿 X 轴居中排成一行 (再加上 offset),
+ *   给出 columns 时排成每行 columns 个的网格 (行沿 Z 轴展开, 行距同列距), 给出 positions 时按列表逐个放置
+ * - 实例数只受内存限制; hero 的实例按顺序编号 1..count 用于拾取
+ */
+struct SceneManifest {
+    struct Shader {
+        std::string name;
+        std::string vertex;
+        std::string fragment;
+    };
+
+    struct Texture {
+        std::string key;
+        std::string path;
+        bool mipmap = true;
+        std::string uniform;    // 非空时绑定到场景着色器的同名 sampler
+        int priority = 0;
+    };
+
+    struct InstanceSet {
+        std::string name;
+        int count = 1;
+        float scale = 1.0f;
+        float spacing = 1.0f;
+        int columns = 0;            // > 0 时按网格排列
+        glm::vec3 offset = glm::vec3(0.0f);
+        std::vector<glm::vec3> positions;
+    };
+
+    struct Model {
+        std::string name;
+        std::string path;
+        int priority = 0;
+        bool hero = false;
+        std::string shader = "wind";
+        InstanceSet instances;
+    };
+
+    std::vector<Shader>  shaders;
+    std::vector<Texture> textures;
+    std::vector<Model>   models;
+
+    /**
+     * @brief 读取清单 (经由虚拟文件系统, 可以位于资源包内)
+     * @param baseDir 清单中相对路径的根目录
+     * @return false 文件不存在、语法错误或没有任何模型
+     */
+    bool load(const std::string& path, const std::string& baseDir, std::string* outError = nullptr);
+
+    /**
+     * @brief 没有清单时的默认场景: 与之前写死的 chufeng.obj + fadeEdgeMask 一致
+     */
+    static SceneManifest makeDefault(const std::string& baseDir);
+
+    const Model* hero() const;
+    const Shader* findShader(const std::string& name) const;
+
+private:
+    // 按优先级排序 (稳定, 同优先级保持文件中的顺序) 并确定唯一的 hero 模型
+    void finalize();
+};
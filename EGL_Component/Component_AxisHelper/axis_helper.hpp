@@ -79,9 +79,19 @@ public:
         GLboolean wasDepth = glIsEnabled(GL_DEPTH_TEST);
         if (cfg_.depthTest) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
 
-        glLineWidth(cfg_.lineWidth);
-
         glUseProgram(program_);
+        draw(view, proj, model);
+        glUseProgram(0);
+
+        // restore depth state
+        if (wasDepth) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
+    }
+
+    // Draw calls only: the caller (e.g. RenderQueue) has already bound program() and set the depth state.
+    void draw(const glm::mat4& view, const glm::mat4& proj, const glm::mat4& model = glm::mat4(1.0f)) {
+        if (!initialized_) return;
+
+        glLineWidth(cfg_.lineWidth);
         glm::mat4 mvp = proj * view * model;
         glUniformMatrix4fv(uniformMVP_, 1, GL_FALSE, glm::value_ptr(mvp));
 
@@ -98,12 +108,12 @@ public:
         }
 
         glBindVertexArray(0);
-        glUseProgram(0);
-
-        // restore depth state
-        if (wasDepth) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
     }
 
+    // Program handle (0 until init() succeeds).
+    GLuint program() const { return program_; }
+    bool depthTestEnabled() const { return cfg_.depthTest; }
+
 private:
     Config cfg_;
     bool initialized_ = false;
@@ -209,6 +209,23 @@ void BoundingBoxRenderer::drawBoundingBox(const glm::vec3& minBounds,
     glUseProgram(currentProgram);
 }
 
+void BoundingBoxRenderer::beginBatch() {
+    glBindVertexArray(mVAO);
+}
+
+void BoundingBoxRenderer::drawBatched(const glm::vec3& minBounds, const glm::vec3& maxBounds,
+                                      const glm::mat4& mvpMatrix, const glm::vec3& color) {
+    // 单位立方体 [0,1] 先缩放再平移到 [minBounds, maxBounds]
+    glm::mat4 modelMatrix = glm::translate(glm::mat4(1.0f), minBounds) * glm::scale(glm::mat4(1.0f), maxBounds - minBounds);
+    mProgram->setMVP(mvpMatrix * modelMatrix);
+    mProgram->setColor(color);
+    glDrawElements(GL_LINES, INDEX_COUNT, GL_UNSIGNED_INT, 0);
+}
+
+void BoundingBoxRenderer::endBatch() {
+    glBindVertexArray(0);
+}
+
 void BoundingBoxRenderer::cleanup() {
     if (mVAO != 0) {
         glDeleteVertexArrays(1, &mVAO);
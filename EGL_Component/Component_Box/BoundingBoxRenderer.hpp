@@ -51,6 +51,20 @@ public:
                         const glm::vec3& maxBounds,
                         const glm::mat4& mvpMatrix,
                         const glm::vec3& color = glm::vec3(1.0f, 1.0f, 1.0f));
+
+    /**
+     * 批量绘制 (RenderQueue 使用): 程序、混合与深度状态由调用者设置, 这里不查询也不恢复 GL 状态
+     * beginBatch 绑定 VAO, drawBatched 只设置 uniform 并绘制, endBatch 解绑 VAO
+     */
+    void beginBatch();
+    void drawBatched(const glm::vec3& minBounds, const glm::vec3& maxBounds,
+                     const glm::mat4& mvpMatrix, const glm::vec3& color);
+    void endBatch();
+
+    /**
+     * 包围盒着色器程序句柄 (未初始化时为 0)
+     */
+    GLuint programHandle() const { return mProgram ? mProgram->handle() : 0; }
     
     /**
      * 清理资源
@@ -0,0 +1,178 @@
+#include "EglSurfaceHost.hpp"
+
+#if defined(__ANDROID__) || defined(WIND_HAS_EGL)
+
+#include <cstring>
+
+#include "macros.h"
+
+EglSurfaceHost::~EglSurfaceHost() {
+    terminate();
+}
+
+bool EglSurfaceHost::initialize() {
+    if (initialized()) return true;
+
+    m_display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+    if (m_display == EGL_NO_DISPLAY) {
+        LOGE("eglGetDisplay failed");
+        return false;
+    }
+    if (eglInitialize(m_display, nullptr, nullptr) != EGL_TRUE) {
+        LOGE("eglInitialize failed: 0x%x", eglGetError());
+        m_display = EGL_NO_DISPLAY;
+        return false;
+    }
+    eglBindAPI(EGL_OPENGL_ES_API);
+
+    // 优先选择窗口与 pbuffer 都支持的 config (pbuffer 用作占位表面), 其次只支持其中一种的
+    const EGLint surfaceTypes[] = { EGL_WINDOW_BIT | EGL_PBUFFER_BIT, EGL_WINDOW_BIT, EGL_PBUFFER_BIT };
+    EGLint numConfigs = 0;
+    for (EGLint surfaceType : surfaceTypes) {
+        const EGLint configAttribs[] = {
+            EGL_SURFACE_TYPE, surfaceType,
+            EGL_RED_SIZE, 8,
+            EGL_GREEN_SIZE, 8,
+            EGL_BLUE_SIZE, 8,
+            EGL_DEPTH_SIZE, 24,     // 3D 渲染需要深度缓冲
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_ES3_BIT,
+            EGL_NONE
+        };
+        if (eglChooseConfig(m_display, configAttribs, &m_config, 1, &numConfigs) == EGL_TRUE && numConfigs > 0) {
+            break;
+        }
+    }
+    if (numConfigs <= 0) {
+        LOGE("eglChooseConfig failed: no GLES3 config with window or pbuffer support");
+        terminate();
+        return false;
+    }
+    eglGetConfigAttrib(m_display, m_config, EGL_SURFACE_TYPE, &m_surfaceTypes);
+
+    const EGLint contextAttribs[] = { EGL_CONTEXT_CLIENT_VERSION, 3, EGL_NONE };
+    m_context = eglCreateContext(m_display, m_config, EGL_NO_CONTEXT, contextAttribs);
+    if (m_context == EGL_NO_CONTEXT) {
+        LOGE("eglCreateContext failed: 0x%x", eglGetError());
+        terminate();
+        return false;
+    }
+
+    const char* extensions = eglQueryString(m_display, EGL_EXTENSIONS);
+    m_surfaceless = extensions && std::strstr(extensions, "EGL_KHR_surfaceless_context") != nullptr;
+    if (m_surfaceTypes & EGL_PBUFFER_BIT) {
+        const EGLint pbufferAttribs[] = { EGL_WIDTH, 1, EGL_HEIGHT, 1, EGL_NONE };
+        m_placeholder = eglCreatePbufferSurface(m_display, m_config, pbufferAttribs);
+    }
+    if (!bindPlaceholder()) {
+        LOGE("EGL: context created but cannot be made current without a window surface");
+    }
+    LOGI("EGL initialized (placeholder: %s)",
+         m_placeholder != EGL_NO_SURFACE ? "1x1 pbuffer" : (m_surfaceless ? "surfaceless" : "none"));
+    return true;
+}
+
+void EglSurfaceHost::terminate() {
+    if (m_display == EGL_NO_DISPLAY) return;
+
+    eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (m_surface != EGL_NO_SURFACE) {
+        eglDestroySurface(m_display, m_surface);
+    }
+    if (m_placeholder != EGL_NO_SURFACE) {
+        eglDestroySurface(m_display, m_placeholder);
+    }
+    if (m_context != EGL_NO_CONTEXT) {
+        eglDestroyContext(m_display, m_context);
+    }
+    eglTerminate(m_display);
+    m_display = EGL_NO_DISPLAY;
+    m_context = EGL_NO_CONTEXT;
+    m_surface = EGL_NO_SURFACE;
+    m_placeholder = EGL_NO_SURFACE;
+    m_width = 0;
+    m_height = 0;
+}
+
+bool EglSurfaceHost::attachWindow(EGLNativeWindowType window) {
+    if (!initialized()) return false;
+    if (!(m_surfaceTypes & EGL_WINDOW_BIT)) {
+        LOGE("EGL: the selected config does not support window surfaces");
+        return false;
+    }
+    return attachSurface(eglCreateWindowSurface(m_display, m_config, window, nullptr), "window");
+}
+
+bool EglSurfaceHost::attachPbuffer(int width, int height) {
+    if (!initialized()) return false;
+    if (!(m_surfaceTypes & EGL_PBUFFER_BIT)) {
+        LOGE("EGL: the selected config does not support pbuffer surfaces");
+        return false;
+    }
+    const EGLint pbufferAttribs[] = { EGL_WIDTH, width, EGL_HEIGHT, height, EGL_NONE };
+    return attachSurface(eglCreatePbufferSurface(m_display, m_config, pbufferAttribs), "pbuffer");
+}
+
+bool EglSurfaceHost::attachSurface(EGLSurface surface, const char* kind) {
+    if (surface == EGL_NO_SURFACE) {
+        LOGE("EGL: failed to create %s surface: 0x%x", kind, eglGetError());
+        return false;
+    }
+    if (eglMakeCurrent(m_display, surface, surface, m_context) != EGL_TRUE) {
+        LOGE("EGL: eglMakeCurrent on the new %s surface failed: 0x%x", kind, eglGetError());
+        eglDestroySurface(m_display, surface);
+        return false;
+    }
+    // 旧表面已不再是当前表面, 可以立即销毁
+    if (m_surface != EGL_NO_SURFACE) {
+        eglDestroySurface(m_display, m_surface);
+    }
+    m_surface = surface;
+    eglQuerySurface(m_display, m_surface, EGL_WIDTH, &m_width);
+    eglQuerySurface(m_display, m_surface, EGL_HEIGHT, &m_height);
+    LOGI("EGL: attached %s surface %dx%d", kind, m_width, m_height);
+    return true;
+}
+
+void EglSurfaceHost::detach() {
+    if (m_surface == EGL_NO_SURFACE) return;
+
+    bindPlaceholder();
+    eglDestroySurface(m_display, m_surface);
+    m_surface = EGL_NO_SURFACE;
+    m_width = 0;
+    m_height = 0;
+    LOGI("EGL: surface detached, context kept");
+}
+
+bool EglSurfaceHost::bindPlaceholder() {
+    if (m_placeholder != EGL_NO_SURFACE) {
+        return eglMakeCurrent(m_display, m_placeholder, m_placeholder, m_context) == EGL_TRUE;
+    }
+    if (m_surfaceless) {
+        return eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, m_context) == EGL_TRUE;
+    }
+    // 无法在没有表面时保持当前: 上下文 (及其资源) 仍然存在, 下一次 attach 时重新绑定
+    eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    return false;
+}
+
+bool EglSurfaceHost::makeCurrent() {
+    if (!initialized()) return false;
+    if (m_surface != EGL_NO_SURFACE) {
+        return eglMakeCurrent(m_display, m_surface, m_surface, m_context) == EGL_TRUE;
+    }
+    return bindPlaceholder();
+}
+
+void EglSurfaceHost::releaseCurrent() {
+    if (m_display != EGL_NO_DISPLAY) {
+        eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    }
+}
+
+bool EglSurfaceHost::swapBuffers() {
+    if (m_surface == EGL_NO_SURFACE) return false;
+    return eglSwapBuffers(m_display, m_surface) == EGL_TRUE;
+}
+
+#endif // __ANDROID__ || WIND_HAS_EGL
@@ -0,0 +1,70 @@
+#pragma once
+
+// EGL 只在 Android 与提供 libEGL 的 Linux 构建 (CMake 找到 EGL 时定义 WIND_HAS_EGL) 中使用, Windows 桌面走 GLFW
+#if defined(__ANDROID__) || defined(WIND_HAS_EGL)
+
+#include <EGL/egl.h>
+
+/**
+ * @brief EGL 上下文与绘制表面的宿主: 上下文的生命周期与窗口表面分开管理
+ *
+ * Android 重建 Surface (旋转、切换应用) 时只更换绘制表面, 同一个上下文中的
+ * VBO / 纹理 / 程序 / FBO 全部保留:
+ *   detach()              销毁窗口表面, 上下文改为绑定到 1x1 占位 pbuffer (没有 pbuffer 时使用无表面绑定)
+ *   attachWindow(window)  在同一个上下文上创建新的窗口表面并设为当前
+ * attachPbuffer(width, height) 以 pbuffer 代替窗口, 在没有显示设备的 Linux 上验证同样的流程
+ * (Mesa 需要设置环境变量 EGL_PLATFORM=surfaceless)。
+ *
+ * 上下文同一时刻只能在一个线程上为当前: 渲染线程退出前调用 releaseCurrent(),
+ * 其它线程 (新的渲染线程 / 析构) 使用 GL 之前先 makeCurrent() 或 attach*。
+ * 失败时返回 false 并输出日志。
+ */
+class EglSurfaceHost {
+public:
+    EglSurfaceHost() = default;
+    ~EglSurfaceHost();
+
+    EglSurfaceHost(const EglSurfaceHost&) = delete;
+    EglSurfaceHost& operator=(const EglSurfaceHost&) = delete;
+
+    // 创建 display / config / 上下文, 并以占位表面设为当前 (此时已可以创建 GL 资源)
+    bool initialize();
+    // 销毁表面与上下文 (上下文中的全部 GL 资源随之释放)
+    void terminate();
+
+    // 在当前线程上切换到新的表面; 成功后才销毁旧表面, 失败时保持原状
+    bool attachWindow(EGLNativeWindowType window);
+    bool attachPbuffer(int width, int height);
+
+    // 销毁当前表面, 上下文保留并在当前线程上绑定占位表面
+    void detach();
+
+    // 在当前线程上绑定上下文 (有表面时绑定表面, 否则绑定占位表面)
+    bool makeCurrent();
+    void releaseCurrent();
+    bool swapBuffers();
+
+    bool initialized() const { return m_context != EGL_NO_CONTEXT; }
+    bool hasSurface() const { return m_surface != EGL_NO_SURFACE; }
+    // 当前表面的实际尺寸 (EGL_WIDTH / EGL_HEIGHT), 没有表面时为 0
+    int width() const { return m_width; }
+    int height() const { return m_height; }
+    EGLDisplay display() const { return m_display; }
+    EGLContext context() const { return m_context; }
+
+private:
+    bool attachSurface(EGLSurface surface, const char* kind);
+    bool bindPlaceholder();
+
+    EGLDisplay m_display = EGL_NO_DISPLAY;
+    EGLConfig m_config = nullptr;
+    EGLint m_surfaceTypes = 0;                  // 所选 config 支持的表面类型 (EGL_WINDOW_BIT / EGL_PBUFFER_BIT)
+    EGLContext m_context = EGL_NO_CONTEXT;
+    EGLSurface m_surface = EGL_NO_SURFACE;      // 当前的窗口 / pbuffer 表面
+    EGLSurface m_placeholder = EGL_NO_SURFACE;  // 没有表面时绑定的 1x1 pbuffer
+    bool m_surfaceless = false;                 // EGL_KHR_surfaceless_context
+    int m_width = 0;
+    int m_height = 0;
+};
+
+#endif // __ANDROID__ || WIND_HAS_EGL
@@ -0,0 +1,623 @@
+#include "InstanceBVH.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <random>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "macros.h"
+
+namespace {
+
+// glm::min/max 的 vec3 版本经函数指针逐分量调用, 构建时占大半耗时; 这里直接展开
+inline glm::vec3 minPerAxis(const glm::vec3& a, const glm::vec3& b) {
+    return glm::vec3(a.x < b.x ? a.x : b.x, a.y < b.y ? a.y : b.y, a.z < b.z ? a.z : b.z);
+}
+inline glm::vec3 maxPerAxis(const glm::vec3& a, const glm::vec3& b) {
+    return glm::vec3(a.x > b.x ? a.x : b.x, a.y > b.y ? a.y : b.y, a.z > b.z ? a.z : b.z);
+}
+
+float surfaceArea(const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+    const glm::vec3 d = maxPerAxis(boundsMax - boundsMin, glm::vec3(0.0f));
+    return 2.0f * (d.x * d.y + d.y * d.z + d.z * d.x);
+}
+
+// 与 InstanceCuller::cullScalar 相同的表达式: 包围盒 (中心 c, 半长 e) 相对平面的有符号距离与投影半径
+inline float planeDistance(const glm::vec4& plane, const glm::vec3& c) {
+    return (plane.x * c.x + plane.y * c.y) + (plane.z * c.z + plane.w);
+}
+inline float planeRadius(const glm::vec4& plane, const glm::vec3& e) {
+    return (std::fabs(plane.x) * e.x + std::fabs(plane.y) * e.y) + std::fabs(plane.z) * e.z;
+}
+
+// 射线与包围盒的 slab 测试, 命中时 outEntry 为进入点的 t (起点在盒内时为 0)
+inline bool rayBox(const glm::vec3& origin, const glm::vec3& invDirection, const glm::vec3& boundsMin,
+                   const glm::vec3& boundsMax, float maxDistance, float& outEntry) {
+    const glm::vec3 t0 = (boundsMin - origin) * invDirection;
+    const glm::vec3 t1 = (boundsMax - origin) * invDirection;
+    const glm::vec3 tNear = minPerAxis(t0, t1);
+    const glm::vec3 tFar = maxPerAxis(t0, t1);
+    const float entry = std::max(std::max(tNear.x, tNear.y), std::max(tNear.z, 0.0f));
+    const float exit = std::min(std::min(tFar.x, tFar.y), std::min(tFar.z, maxDistance));
+    outEntry = entry;
+    return entry <= exit;
+}
+
+}   // namespace
+
+void InstanceBVH::build(const InstanceCuller& culler) {
+    const size_t count = culler.instanceCount();
+    m_center.resize(count);
+    m_extent.resize(count);
+    m_indices.resize(count);
+    m_leafOf.assign(count, kInvalid);
+    m_nodes.clear();
+    m_parent.clear();
+    m_refitsSinceBuild = 0;
+    if (count == 0) {
+        return;
+    }
+    m_nodes.reserve(2 * count);
+    m_parent.reserve(2 * count);
+
+    // 构建期间按划分就地重排的实例包围盒: 连续访问, 不经过下标间接寻址
+    struct BuildPrim {
+        glm::vec3 boundsMin;
+        glm::vec3 boundsMax;
+        glm::vec3 center;
+        uint32_t instance;
+    };
+    std::vector<BuildPrim> prims(count);
+    for (size_t i = 0; i < count; ++i) {
+        culler.instanceBounds(i, m_center[i], m_extent[i]);
+        prims[i] = { m_center[i] - m_extent[i], m_center[i] + m_extent[i], m_center[i], static_cast<uint32_t>(i) };
+    }
+
+    struct Task {
+        uint32_t node;
+        uint32_t first;
+        uint32_t count;
+    };
+    struct Bin {
+        glm::vec3 boundsMin;
+        glm::vec3 boundsMax;
+        uint32_t count;
+    };
+    std::vector<Task> tasks;
+    tasks.push_back({ 0, 0, static_cast<uint32_t>(count) });
+    m_nodes.emplace_back();
+    m_parent.push_back(kInvalid);
+
+    while (!tasks.empty()) {
+        const Task task = tasks.back();
+        tasks.pop_back();
+        BuildPrim* const first = prims.data() + task.first;
+        BuildPrim* const last = first + task.count;
+
+        // 节点包围盒与实例中心的包围盒
+        glm::vec3 boundsMin(1e30f), boundsMax(-1e30f), centroidMin(1e30f), centroidMax(-1e30f);
+        for (const BuildPrim* prim = first; prim != last; ++prim) {
+            boundsMin = minPerAxis(boundsMin, prim->boundsMin);
+            boundsMax = maxPerAxis(boundsMax, prim->boundsMax);
+            centroidMin = minPerAxis(centroidMin, prim->center);
+            centroidMax = maxPerAxis(centroidMax, prim->center);
+        }
+        m_nodes[task.node].boundsMin = boundsMin;
+        m_nodes[task.node].boundsMax = boundsMax;
+
+        auto makeLeaf = [&]() {
+            m_nodes[task.node].first = task.first;
+            m_nodes[task.node].count = task.count;
+            for (const BuildPrim* prim = first; prim != last; ++prim) {
+                m_leafOf[prim->instance] = task.node;
+            }
+        };
+        if (task.count <= kLeafSize) {
+            makeLeaf();
+            continue;
+        }
+
+        // 三个轴同时分桶 (一次遍历), 求 SAH 代价最小的划分
+        const glm::vec3 centroidExtent = centroidMax - centroidMin;
+        glm::vec3 scale;
+        for (int axis = 0; axis < 3; ++axis) {
+            scale[axis] = centroidExtent[axis] > 0.0f ? kBins / centroidExtent[axis] : 0.0f;
+        }
+        Bin bins[3][kBins];
+        for (auto& axisBins : bins) {
+            for (Bin& bin : axisBins) {
+                bin = { glm::vec3(1e30f), glm::vec3(-1e30f), 0 };
+            }
+        }
+        for (const BuildPrim* prim = first; prim != last; ++prim) {
+            for (int axis = 0; axis < 3; ++axis) {
+                const int b = std::min(kBins - 1, static_cast<int>((prim->center[axis] - centroidMin[axis]) * scale[axis]));
+                Bin& bin = bins[axis][b];
+                bin.boundsMin = minPerAxis(bin.boundsMin, prim->boundsMin);
+                bin.boundsMax = maxPerAxis(bin.boundsMax, prim->boundsMax);
+                ++bin.count;
+            }
+        }
+
+        int bestAxis = -1;
+        int bestSplit = 0;
+        float bestCost = 1e30f;
+        for (int axis = 0; axis < 3; ++axis) {
+            if (centroidExtent[axis] <= 0.0f) {
+                continue;
+            }
+            // 从右向左累计右侧的面积与数量, 再从左向右求每个划分位置的代价
+            const Bin* axisBins = bins[axis];
+            float rightArea[kBins];
+            uint32_t rightCount[kBins];
+            glm::vec3 accMin(1e30f), accMax(-1e30f);
+            uint32_t accCount = 0;
+            for (int b = kBins - 1; b > 0; --b) {
+                accMin = minPerAxis(accMin, axisBins[b].boundsMin);
+                accMax = maxPerAxis(accMax, axisBins[b].boundsMax);
+                accCount += axisBins[b].count;
+                rightArea[b] = accCount > 0 ? surfaceArea(accMin, accMax) : 0.0f;
+                rightCount[b] = accCount;
+            }
+            accMin = glm::vec3(1e30f);
+            accMax = glm::vec3(-1e30f);
+            accCount = 0;
+            for (int b = 0; b < kBins - 1; ++b) {
+                accMin = minPerAxis(accMin, axisBins[b].boundsMin);
+                accMax = maxPerAxis(accMax, axisBins[b].boundsMax);
+                accCount += axisBins[b].count;
+                if (accCount == 0 || rightCount[b + 1] == 0) {
+                    continue;
+                }
+                const float cost = accCount * surfaceArea(accMin, accMax) + rightCount[b + 1] * rightArea[b + 1];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestSplit = b + 1;
+                }
+            }
+        }
+
+        // 全部实例中心重合 (无法划分), 或划分不比叶子便宜且叶子不大
+        const float parentArea = surfaceArea(boundsMin, boundsMax);
+        const float leafCost = task.count * parentArea;
+        const float splitCost = parentArea + bestCost;  // 遍历代价 1 (按父节点面积计)
+        if (bestAxis < 0 || (splitCost >= leafCost && task.count <= kMaxLeafSize)) {
+            makeLeaf();
+            continue;
+        }
+
+        BuildPrim* middle = std::partition(first, last, [&](const BuildPrim& prim) {
+            return std::min(kBins - 1, static_cast<int>((prim.center[bestAxis] - centroidMin[bestAxis]) * scale[bestAxis])) < bestSplit;
+        });
+        const uint32_t leftCount = static_cast<uint32_t>(middle - first);
+
+        const uint32_t left = static_cast<uint32_t>(m_nodes.size());
+        m_nodes[task.node].first = left;
+        m_nodes[task.node].count = 0;
+        m_nodes.emplace_back();
+        m_nodes.emplace_back();
+        m_parent.push_back(task.node);
+        m_parent.push_back(task.node);
+        tasks.push_back({ left + 1, task.first + leftCount, task.count - leftCount });
+        tasks.push_back({ left, task.first, leftCount });
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+        m_indices[i] = prims[i].instance;
+    }
+}
+
+void InstanceBVH::updateLeafBounds(Node& node) const {
+    glm::vec3 boundsMin(1e30f), boundsMax(-1e30f);
+    for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+        const uint32_t instance = m_indices[i];
+        boundsMin = minPerAxis(boundsMin, m_center[instance] - m_extent[instance]);
+        boundsMax = maxPerAxis(boundsMax, m_center[instance] + m_extent[instance]);
+    }
+    node.boundsMin = boundsMin;
+    node.boundsMax = boundsMax;
+}
+
+bool InstanceBVH::updateInnerBounds(uint32_t nodeIndex) {
+    Node& node = m_nodes[nodeIndex];
+    const Node& left = m_nodes[node.first];
+    const Node& right = m_nodes[node.first + 1];
+    const glm::vec3 boundsMin = minPerAxis(left.boundsMin, right.boundsMin);
+    const glm::vec3 boundsMax = maxPerAxis(left.boundsMax, right.boundsMax);
+    if (boundsMin == node.boundsMin && boundsMax == node.boundsMax) {
+        return false;
+    }
+    node.boundsMin = boundsMin;
+    node.boundsMax = boundsMax;
+    return true;
+}
+
+void InstanceBVH::refitInstance(size_t index, const InstanceCuller& culler) {
+    if (index >= m_center.size() || m_nodes.empty()) {
+        return;
+    }
+    culler.instanceBounds(index, m_center[index], m_extent[index]);
+    ++m_refitsSinceBuild;
+
+    uint32_t nodeIndex = m_leafOf[index];
+    Node& leaf = m_nodes[nodeIndex];
+    const glm::vec3 oldMin = leaf.boundsMin;
+    const glm::vec3 oldMax = leaf.boundsMax;
+    updateLeafBounds(leaf);
+    if (leaf.boundsMin == oldMin && leaf.boundsMax == oldMax) {
+        return;
+    }
+    // 包围盒可能变大也可能变小, 逐级重新合并, 某一级不再变化时上面的节点也不会变化
+    for (nodeIndex = m_parent[nodeIndex]; nodeIndex != kInvalid; nodeIndex = m_parent[nodeIndex]) {
+        if (!updateInnerBounds(nodeIndex)) {
+            break;
+        }
+    }
+}
+
+InstanceBVH::Aabb InstanceBVH::instanceBox(uint32_t instance, float inflateY) const {
+    const glm::vec3 extent = m_extent[instance] + glm::vec3(0.0f, inflateY, 0.0f);
+    return { m_center[instance] - extent, m_center[instance] + extent };
+}
+
+size_t InstanceBVH::cullFrustum(const InstanceCuller::Frustum& frustum, float inflateY, std::vector<uint32_t>& outVisible) {
+    const auto start = std::chrono::high_resolution_clock::now();
+    outVisible.clear();
+    m_stats.nodesVisited = 0;
+    if (!m_nodes.empty()) {
+        const glm::vec3 inflate(0.0f, inflateY, 0.0f);
+        // mask 的第 p 位表示仍需测试第 p 个平面; 完全在平面内侧的节点清除该位, 子树不再测试
+        struct Entry {
+            uint32_t node;
+            uint32_t mask;
+        };
+        std::vector<Entry> stack;
+        stack.reserve(64);
+        stack.push_back({ 0, 0x3F });
+        while (!stack.empty()) {
+            const Entry entry = stack.back();
+            stack.pop_back();
+            const Node& node = m_nodes[entry.node];
+            ++m_stats.nodesVisited;
+
+            uint32_t mask = entry.mask;
+            if (mask != 0) {
+                const glm::vec3 center = (node.boundsMin + node.boundsMax) * 0.5f;
+                const glm::vec3 extent = (node.boundsMax - node.boundsMin) * 0.5f + inflate;
+                bool outside = false;
+                for (int p = 0; p < 6; ++p) {
+                    if (!(mask & (1u << p))) {
+                        continue;
+                    }
+                    const float distance = planeDistance(frustum.planes[p], center);
+                    const float radius = planeRadius(frustum.planes[p], extent);
+                    if (distance + radius < 0.0f) {
+                        outside = true;
+                        break;
+                    }
+                    if (distance - radius >= 0.0f) {
+                        mask &= ~(1u << p);
+                    }
+                }
+                if (outside) {
+                    continue;
+                }
+            }
+
+            if (node.count == 0) {
+                stack.push_back({ node.first + 1, mask });
+                stack.push_back({ node.first, mask });
+                continue;
+            }
+            for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                const uint32_t instance = m_indices[i];
+                bool inside = true;
+                if (mask != 0) {
+                    const glm::vec3 extent = m_extent[instance] + inflate;
+                    for (int p = 0; p < 6 && inside; ++p) {
+                        if (mask & (1u << p)) {
+                            inside = planeDistance(frustum.planes[p], m_center[instance]) +
+                                     planeRadius(frustum.planes[p], extent) >= 0.0f;
+                        }
+                    }
+                }
+                if (inside) {
+                    outVisible.push_back(instance);
+                }
+            }
+        }
+    }
+    m_stats.results = outVisible.size();
+    m_stats.queryMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    return outVisible.size();
+}
+
+bool InstanceBVH::raycast(const glm::vec3& origin, const glm::vec3& direction, float inflateY, RayHit& outHit,
+                          float maxDistance) {
+    const auto start = std::chrono::high_resolution_clock::now();
+    m_stats.nodesVisited = 0;
+    m_stats.results = 0;
+    const glm::vec3 invDirection = 1.0f / direction;    // 分量为 0 时得到 inf, slab 测试仍然成立
+    const glm::vec3 inflate(0.0f, inflateY, 0.0f);
+    float best = maxDistance;
+    bool hit = false;
+
+    if (!m_nodes.empty()) {
+        std::vector<uint32_t> stack;
+        stack.reserve(64);
+        float entry = 0.0f;
+        if (rayBox(origin, invDirection, m_nodes[0].boundsMin - inflate, m_nodes[0].boundsMax + inflate, best, entry)) {
+            stack.push_back(0);
+        }
+        while (!stack.empty()) {
+            const Node& node = m_nodes[stack.back()];
+            stack.pop_back();
+            ++m_stats.nodesVisited;
+            if (node.count > 0) {
+                for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                    const Aabb box = instanceBox(m_indices[i], inflateY);
+                    if (rayBox(origin, invDirection, box.min, box.max, best, entry) && (!hit || entry < best)) {
+                        best = entry;
+                        outHit.instance = m_indices[i];
+                        outHit.distance = entry;
+                        hit = true;
+                    }
+                }
+                continue;
+            }
+            // 近的子节点后入栈先访问, 远的子节点在 best 缩短后可能被跳过
+            float entryLeft = 0.0f, entryRight = 0.0f;
+            const Node& left = m_nodes[node.first];
+            const Node& right = m_nodes[node.first + 1];
+            const bool hitLeft = rayBox(origin, invDirection, left.boundsMin - inflate, left.boundsMax + inflate, best, entryLeft);
+            const bool hitRight = rayBox(origin, invDirection, right.boundsMin - inflate, right.boundsMax + inflate, best, entryRight);
+            if (hitLeft && hitRight) {
+                const bool leftFirst = entryLeft <= entryRight;
+                stack.push_back(leftFirst ? node.first + 1 : node.first);
+                stack.push_back(leftFirst ? node.first : node.first + 1);
+            } else if (hitLeft) {
+                stack.push_back(node.first);
+            } else if (hitRight) {
+                stack.push_back(node.first + 1);
+            }
+        }
+    }
+    m_stats.results = hit ? 1 : 0;
+    m_stats.queryMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    return hit;
+}
+
+size_t InstanceBVH::queryRegion(const Aabb& region, float inflateY, std::vector<uint32_t>& outInstances) {
+    const auto start = std::chrono::high_resolution_clock::now();
+    outInstances.clear();
+    m_stats.nodesVisited = 0;
+    const glm::vec3 inflate(0.0f, inflateY, 0.0f);
+    auto overlaps = [&](const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+        return glm::all(glm::lessThanEqual(boundsMin - inflate, region.max)) &&
+               glm::all(glm::greaterThanEqual(boundsMax + inflate, region.min));
+    };
+    if (!m_nodes.empty()) {
+        std::vector<uint32_t> stack;
+        stack.reserve(64);
+        stack.push_back(0);
+        while (!stack.empty()) {
+            const Node& node = m_nodes[stack.back()];
+            stack.pop_back();
+            ++m_stats.nodesVisited;
+            if (!overlaps(node.boundsMin, node.boundsMax)) {
+                continue;
+            }
+            if (node.count == 0) {
+                stack.push_back(node.first + 1);
+                stack.push_back(node.first);
+                continue;
+            }
+            for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                const uint32_t instance = m_indices[i];
+                if (overlaps(m_center[instance] - m_extent[instance], m_center[instance] + m_extent[instance])) {
+                    outInstances.push_back(instance);
+                }
+            }
+        }
+    }
+    m_stats.results = outInstances.size();
+    m_stats.queryMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    return outInstances.size();
+}
+
+void InstanceBVH::collectVisibleNodeBounds(const InstanceCuller::Frustum& frustum, float inflateY, size_t maxBoxes,
+                                           std::vector<Aabb>& outBounds) const {
+    outBounds.clear();
+    if (m_nodes.empty() || maxBoxes == 0) {
+        return;
+    }
+    const glm::vec3 inflate(0.0f, inflateY, 0.0f);
+    auto visible = [&](const Node& node) {
+        const glm::vec3 center = (node.boundsMin + node.boundsMax) * 0.5f;
+        const glm::vec3 extent = (node.boundsMax - node.boundsMin) * 0.5f + inflate;
+        for (const glm::vec4& plane : frustum.planes) {
+            if (planeDistance(plane, center) + planeRadius(plane, extent) < 0.0f) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    std::vector<uint32_t> level, next;
+    if (visible(m_nodes[0])) {
+        level.push_back(0);
+    }
+    while (true) {
+        // 展开一层: 内部节点换成视锥内的子节点, 叶子保留
+        next.clear();
+        bool expanded = false;
+        for (uint32_t index : level) {
+            const Node& node = m_nodes[index];
+            if (node.count > 0) {
+                next.push_back(index);
+                continue;
+            }
+            expanded = true;
+            for (uint32_t child = node.first; child <= node.first + 1; ++child) {
+                if (visible(m_nodes[child])) {
+                    next.push_back(child);
+                }
+            }
+        }
+        if (!expanded || next.size() > maxBoxes) {
+            break;
+        }
+        level.swap(next);
+    }
+    for (uint32_t index : level) {
+        outBounds.push_back({ m_nodes[index].boundsMin - inflate, m_nodes[index].boundsMax + inflate });
+    }
+}
+
+float InstanceBVH::sahCost() const {
+    if (m_nodes.empty()) {
+        return 0.0f;
+    }
+    const float rootArea = surfaceArea(m_nodes[0].boundsMin, m_nodes[0].boundsMax);
+    if (rootArea <= 0.0f) {
+        return 0.0f;
+    }
+    float cost = 0.0f;
+    for (const Node& node : m_nodes) {
+        const float area = surfaceArea(node.boundsMin, node.boundsMax) / rootArea;
+        cost += node.count == 0 ? area : area * node.count;
+    }
+    return cost;
+}
+
+// ---- 构建 / refit / 查询耗时 (INSTANCE_BVH_BENCHMARK_ON_STARTUP) ----
+void InstanceBVH::benchmark() {
+    using Clock = std::chrono::high_resolution_clock;
+    auto elapsedMs = [](Clock::time_point begin) {
+        return std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+    };
+    const size_t counts[] = { 1000, 10000, 100000 };
+    constexpr int kViews = 32;
+    constexpr int kRays = 1000;
+    constexpr int kRegions = 200;
+    const float inflateY = InstanceCuller::windDisplacement(1.0f);
+
+    for (size_t count : counts) {
+        // 实例分布在边长随实例数增长的正方形内, 密度与默认网格相近
+        const float half = std::sqrt(static_cast<float>(count)) * 1.0f;
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<float> position(-half, half);
+        std::uniform_real_distribution<float> scale(0.05f, 0.2f);
+        std::vector<InstanceData> instances(count);
+        for (size_t i = 0; i < count; ++i) {
+            instances[i].modelMatrix = glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(position(rng), 0.0f, position(rng))),
+                                                  glm::vec3(scale(rng)));
+            instances[i].offset = glm::vec4(0.0f);
+            instances[i].instanceId = static_cast<uint32_t>(i + 1);
+        }
+        InstanceCuller culler;
+        culler.setInstances(instances.data(), count, glm::vec3(-5.0f, 0.0f, -1.0f), glm::vec3(5.0f, 4.0f, 1.0f));
+
+        InstanceBVH bvh;
+        auto begin = Clock::now();
+        bvh.build(culler);
+        const double buildMs = elapsedMs(begin);
+        const float builtCost = bvh.sahCost();
+
+        // refit: 1% 的实例被拖动 (逐个 refit), 与每帧全部重建比较
+        std::uniform_int_distribution<size_t> pick(0, count - 1);
+        std::uniform_real_distribution<float> drag(-2.0f, 2.0f);
+        const size_t dragged = std::max<size_t>(1, count / 100);
+        begin = Clock::now();
+        for (size_t k = 0; k < dragged; ++k) {
+            const size_t index = pick(rng);
+            instances[index].offset = glm::vec4(drag(rng), drag(rng), 0.0f, 0.0f);
+            culler.updateInstance(index, instances[index]);
+            bvh.refitInstance(index, culler);
+        }
+        const double refitMs = elapsedMs(begin);
+        const float refitCost = bvh.sahCost();
+
+        // 视锥剔除: 相机绕场景旋转, 与 InstanceCuller 的结果按集合核对
+        const glm::mat4 proj = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, half * 0.6f);
+        std::vector<uint32_t> flatVisible, bvhVisible;
+        double flatMs = 0.0, bvhMs = 0.0;
+        size_t visibleSum = 0, nodesSum = 0;
+        bool identical = true;
+        for (int v = 0; v < kViews; ++v) {
+            const float angle = glm::two_pi<float>() * v / kViews;
+            const glm::mat4 view = glm::lookAt(glm::vec3(std::cos(angle), 0.2f, std::sin(angle)) * half * 0.5f,
+                                               glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+            const InstanceCuller::Frustum frustum = InstanceCuller::Frustum::fromMatrix(proj * view);
+            culler.cull(frustum, inflateY, flatVisible);
+            flatMs += culler.stats().cullMs;
+            bvh.cullFrustum(frustum, inflateY, bvhVisible);
+            bvhMs += bvh.stats().queryMs;
+            nodesSum += bvh.stats().nodesVisited;
+            visibleSum += bvhVisible.size();
+            std::sort(bvhVisible.begin(), bvhVisible.end());
+            identical = identical && bvhVisible == flatVisible;
+        }
+
+        // 射线: 从上方斜向下射向随机位置, 与逐个实例测试的最近命中核对
+        std::vector<std::pair<glm::vec3, glm::vec3>> rays(kRays);
+        for (auto& ray : rays) {
+            const glm::vec3 target(position(rng), 0.5f, position(rng));
+            ray.first = target + glm::vec3(0.0f, 30.0f, 20.0f);
+            ray.second = glm::normalize(target - ray.first);
+        }
+        begin = Clock::now();
+        size_t rayHits = 0;
+        std::vector<int> bvhRay(kRays, -1);
+        for (int r = 0; r < kRays; ++r) {
+            RayHit hit;
+            if (bvh.raycast(rays[r].first, rays[r].second, inflateY, hit)) {
+                bvhRay[r] = static_cast<int>(hit.instance);
+                ++rayHits;
+            }
+        }
+        const double bvhRayMs = elapsedMs(begin);
+        begin = Clock::now();
+        bool raysIdentical = true;
+        for (int r = 0; r < kRays; ++r) {
+            const glm::vec3 invDirection = 1.0f / rays[r].second;
+            float best = 1e30f;
+            int bestInstance = -1;
+            for (size_t i = 0; i < count; ++i) {
+                const Aabb box = bvh.instanceBox(static_cast<uint32_t>(i), inflateY);
+                float entry = 0.0f;
+                if (rayBox(rays[r].first, invDirection, box.min, box.max, best, entry) && entry < best) {
+                    best = entry;
+                    bestInstance = static_cast<int>(i);
+                }
+            }
+            // 距离相同的两个实例 (重叠的包围盒) 可能取到不同的一个, 只核对命中与否
+            raysIdentical = raysIdentical && ((bestInstance < 0) == (bvhRay[r] < 0));
+        }
+        const double bruteRayMs = elapsedMs(begin);
+
+        // 区域: 随机的 10 x 10 区域
+        std::vector<uint32_t> found;
+        size_t regionSum = 0;
+        begin = Clock::now();
+        for (int q = 0; q < kRegions; ++q) {
+            const glm::vec3 corner(position(rng), -1.0f, position(rng));
+            regionSum += bvh.queryRegion({ corner, corner + glm::vec3(10.0f, 2.0f, 10.0f) }, 0.0f, found);
+        }
+        const double regionMs = elapsedMs(begin);
+
+        LOGI("InstanceBVH benchmark %6d instances: build %.3f ms (%d nodes, SAH %.1f), refit %d dragged %.3f ms (SAH %.1f)",
+             static_cast<int>(count), buildMs, static_cast<int>(bvh.nodeCount()), builtCost,
+             static_cast<int>(dragged), refitMs, refitCost);
+        LOGI("InstanceBVH benchmark %6d instances: frustum flat %.3f ms / BVH %.3f ms (%d nodes, %d visible), %s",
+             static_cast<int>(count), flatMs / kViews, bvhMs / kViews, static_cast<int>(nodesSum / kViews),
+             static_cast<int>(visibleSum / kViews), identical ? "identical" : "DIFFERENT");
+        LOGI("InstanceBVH benchmark %6d instances: ray BVH %.4f ms / brute %.4f ms per ray (%d / %d hit, %s), "
+             "region %.4f ms per query (%d found on average)",
+             static_cast<int>(count), bvhRayMs / kRays, bruteRayMs / kRays, static_cast<int>(rayHits), kRays,
+             raysIdentical ? "identical" : "DIFFERENT", regionMs / kRegions, static_cast<int>(regionSum / kRegions));
+    }
+}
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "InstanceCuller.hpp"
+
+// 置 1 后在场景就绪时运行一次 InstanceBVH::benchmark 并输出日志
+#define INSTANCE_BVH_BENCHMARK_ON_STARTUP 0
+
+/**
+ * @brief 实例包围盒上的层次包围体 (BVH, 纯 CPU)
+ *
+ * - build: 按 SAH (表面积启发式) 分桶构建, 实例包围盒取自 InstanceCuller (世界空间, 已计入拖拽偏移)
+ * - refitInstance: 单个实例的包围盒变化 (拖拽) 时只更新它所在的叶子, 沿父节点向上直到包围盒不再变化;
+ *   拓扑不变, 多次 refit 后树的质量下降, 由调用者在 refitsSinceBuild() 过大时重新 build
+ * - 查询: 视锥剔除 (完全在某个平面内侧的子树不再测试该平面) / 射线拾取 / 区域查询,
+ *   Y 方向的风场扩张 inflateY 在查询时统一加到节点与实例包围盒上, 不影响树结构
+ *
+ * 节点的两个子节点相邻存放, 叶子引用 m_indices 中连续的一段实例下标。
+ */
+class InstanceBVH {
+public:
+    struct Aabb {
+        glm::vec3 min;
+        glm::vec3 max;
+    };
+
+    struct RayHit {
+        uint32_t instance = 0;
+        float distance = 0.0f;  // 射线进入实例包围盒的参数 t (起点在盒内时为 0)
+    };
+
+    struct Stats {
+        size_t nodesVisited = 0;    // 最近一次查询访问的节点数
+        size_t results = 0;         // 最近一次查询的结果数
+        double queryMs = 0.0;       // 最近一次查询的耗时
+    };
+
+    static constexpr int kBins = 16;            // 每个轴上的 SAH 分桶数
+    static constexpr uint32_t kLeafSize = 4;    // 不超过该数的实例直接作为叶子
+    static constexpr uint32_t kMaxLeafSize = 16;// SAH 判断不划分时叶子的上限
+
+    // 按 culler 当前的实例包围盒重新构建
+    void build(const InstanceCuller& culler);
+    // 第 index 个实例的包围盒已在 culler 中更新 (InstanceCuller::updateInstance 之后调用)
+    void refitInstance(size_t index, const InstanceCuller& culler);
+
+    /**
+     * @brief 视锥剔除, 可见实例的下标按树的顺序写入 outVisible (结果集合与 InstanceCuller::cull 相同)
+     * @return 可见实例数
+     */
+    size_t cullFrustum(const InstanceCuller::Frustum& frustum, float inflateY, std::vector<uint32_t>& outVisible);
+    /**
+     * @brief 射线与实例包围盒求交, 返回最近的一个
+     * @param maxDistance 只考虑 t <= maxDistance 的交点
+     * @return false 射线没有碰到任何实例包围盒
+     */
+    bool raycast(const glm::vec3& origin, const glm::vec3& direction, float inflateY, RayHit& outHit,
+                 float maxDistance = 1e30f);
+    // 包围盒与 region 相交的实例下标写入 outInstances
+    size_t queryRegion(const Aabb& region, float inflateY, std::vector<uint32_t>& outInstances);
+
+    /**
+     * @brief 调试绘制用: 逐层展开视锥内的节点, 在展开后不超过 maxBoxes 个的最深一层停下, 输出这些节点的包围盒
+     */
+    void collectVisibleNodeBounds(const InstanceCuller::Frustum& frustum, float inflateY, size_t maxBoxes,
+                                  std::vector<Aabb>& outBounds) const;
+
+    size_t instanceCount() const { return m_center.size(); }
+    // 全部实例的包围盒 (根节点, 不含 inflateY); 空树时返回 false
+    bool rootBounds(Aabb& outBounds) const {
+        if (m_nodes.empty()) return false;
+        outBounds = { m_nodes[0].boundsMin, m_nodes[0].boundsMax };
+        return true;
+    }
+    size_t nodeCount() const { return m_nodes.size(); }
+    size_t refitsSinceBuild() const { return m_refitsSinceBuild; }
+    // 以根节点表面积归一化的 SAH 代价 (遍历代价 1, 实例测试代价 1), 用于比较树的质量
+    float sahCost() const;
+    const Stats& stats() const { return m_stats; }
+
+    /**
+     * @brief 1k / 10k / 100k 个随机实例: 构建、全部 / 1% 实例 refit、视锥剔除 (与 InstanceCuller 对比)、
+     *        射线与区域查询 (与逐个测试对比) 的耗时, 并核对结果一致, 写入日志
+     */
+    static void benchmark();
+
+private:
+    struct Node {
+        glm::vec3 boundsMin;
+        uint32_t first = 0;     // 内部节点: 左子节点下标 (右子节点为 first + 1); 叶子: m_indices 中的起点
+        glm::vec3 boundsMax;
+        uint32_t count = 0;     // 0 表示内部节点
+    };
+    static constexpr uint32_t kInvalid = 0xFFFFFFFFu;
+
+    void updateLeafBounds(Node& node) const;
+    bool updateInnerBounds(uint32_t nodeIndex);
+    Aabb instanceBox(uint32_t instance, float inflateY) const;
+
+    std::vector<Node> m_nodes;
+    std::vector<uint32_t> m_parent;     // 与 m_nodes 对应, 根为 kInvalid
+    std::vector<uint32_t> m_indices;    // 叶子引用的实例下标
+    std::vector<uint32_t> m_leafOf;     // 实例 -> 所在叶子
+    // 实例包围盒 (中心/半长, 与 InstanceCuller 的值一致)
+    std::vector<glm::vec3> m_center;
+    std::vector<glm::vec3> m_extent;
+    size_t m_refitsSinceBuild = 0;
+    Stats m_stats;
+};
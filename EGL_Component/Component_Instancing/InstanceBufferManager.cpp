@@ -0,0 +1,247 @@
+#include "InstanceBufferManager.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <random>
+
+InstanceBufferManager::InstanceBufferManager(size_t stride, int ringSize, UploadMode mode)
+    : m_stride(stride), m_mode(mode) {
+    m_ring.resize(static_cast<size_t>(std::max(1, ringSize)));
+}
+
+InstanceBufferManager::~InstanceBufferManager() {
+    for (Slot& slot : m_ring) {
+        if (slot.fence) {
+            glDeleteSync(slot.fence);
+        }
+        if (slot.buffer != 0) {
+            glDeleteBuffers(1, &slot.buffer);
+        }
+    }
+}
+
+void InstanceBufferManager::reset(const void* data, size_t count) {
+    m_count = count;
+    m_current = 0;
+    m_pending.clear();
+    for (Slot& slot : m_ring) {
+        if (slot.buffer == 0) {
+            glGenBuffers(1, &slot.buffer);
+        }
+        if (slot.fence) {
+            glDeleteSync(slot.fence);
+            slot.fence = nullptr;
+        }
+        slot.behind.clear();
+        // 重新分配存储 (旧存储由驱动在 GPU 用完后释放), 不需要等待
+        glBindBuffer(GL_ARRAY_BUFFER, slot.buffer);
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(count * m_stride), data, GL_DYNAMIC_DRAW);
+    }
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void InstanceBufferManager::markDirty(size_t first, size_t count) {
+    if (first >= m_count || count == 0) {
+        return;
+    }
+    m_pending.emplace_back(first, std::min(m_count, first + count));
+    // 一帧内标记次数很多时先就地合并, 限制区间表的大小
+    if (m_pending.size() >= 4096) {
+        coalesce(m_pending, 0);
+    }
+}
+
+void InstanceBufferManager::coalesce(std::vector<Range>& ranges, size_t mergeGap) {
+    if (ranges.size() < 2) {
+        return;
+    }
+    std::sort(ranges.begin(), ranges.end());
+    size_t out = 0;
+    for (size_t i = 1; i < ranges.size(); ++i) {
+        if (ranges[i].first <= ranges[out].second + mergeGap) {
+            ranges[out].second = std::max(ranges[out].second, ranges[i].second);
+        } else {
+            ranges[++out] = ranges[i];
+        }
+    }
+    ranges.resize(out + 1);
+}
+
+bool InstanceBufferManager::flush(const void* data) {
+    if (m_pending.empty() || m_count == 0 || m_ring[0].buffer == 0) {
+        return false;
+    }
+
+    // 本帧的区间所有缓冲区都要补上; 当前缓冲区马上写入, 其余的轮到时再写
+    coalesce(m_pending, 0);
+    for (Slot& slot : m_ring) {
+        slot.behind.insert(slot.behind.end(), m_pending.begin(), m_pending.end());
+    }
+    m_pending.clear();
+
+    bool switched = false;
+    if (m_ring.size() > 1) {
+        // 之前提交的绘制可能仍在读取当前缓冲区: 插入 fence 后换到下一个
+        Slot& previous = m_ring[m_current];
+        if (previous.fence) {
+            glDeleteSync(previous.fence);
+        }
+        previous.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        m_current = (m_current + 1) % static_cast<int>(m_ring.size());
+        switched = true;
+    }
+
+    Slot& slot = m_ring[m_current];
+    waitFence(slot);
+    coalesce(slot.behind, m_stride > 0 ? kMergeGapBytes / m_stride : 0);
+    upload(slot, static_cast<const uint8_t*>(data));
+    slot.behind.clear();
+    ++m_stats.flushes;
+    return switched;
+}
+
+void InstanceBufferManager::waitFence(Slot& slot) {
+    if (!slot.fence) {
+        return;
+    }
+    GLenum result = glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    if (result == GL_TIMEOUT_EXPIRED) {
+        // GPU 落后了整整一轮缓冲区, 只能等待 (最多 1 秒)
+        ++m_stats.fenceWaits;
+        glClientWaitSync(slot.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000ull);
+    }
+    glDeleteSync(slot.fence);
+    slot.fence = nullptr;
+}
+
+void InstanceBufferManager::upload(Slot& slot, const uint8_t* data) {
+    std::vector<Range>& ranges = slot.behind;
+    if (ranges.empty()) {
+        return;
+    }
+    // 脏数据超过一半时一次写入整个缓冲区
+    size_t dirty = 0;
+    for (const Range& range : ranges) {
+        dirty += range.second - range.first;
+    }
+    if (dirty * 2 > m_count) {
+        ranges.assign(1, Range(0, m_count));
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, slot.buffer);
+    bool done = false;
+    if (m_mode == UploadMode::MapUnsynchronized) {
+        const size_t spanBegin = ranges.front().first;
+        const size_t spanEnd = ranges.back().second;
+        // 单缓冲时该缓冲区可能仍在被读取, 交给驱动同步
+        GLbitfield access = GL_MAP_WRITE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT;
+        if (m_ring.size() > 1) {
+            access |= GL_MAP_UNSYNCHRONIZED_BIT;
+        }
+        uint8_t* mapped = static_cast<uint8_t*>(glMapBufferRange(
+            GL_ARRAY_BUFFER, static_cast<GLintptr>(spanBegin * m_stride),
+            static_cast<GLsizeiptr>((spanEnd - spanBegin) * m_stride), access));
+        if (mapped) {
+            for (const Range& range : ranges) {
+                const size_t offset = (range.first - spanBegin) * m_stride;
+                const size_t bytes = (range.second - range.first) * m_stride;
+                std::memcpy(mapped + offset, data + range.first * m_stride, bytes);
+                glFlushMappedBufferRange(GL_ARRAY_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(bytes));
+                m_stats.bytes += bytes;
+            }
+            done = glUnmapBuffer(GL_ARRAY_BUFFER) == GL_TRUE;
+            if (!done) {
+                // 映射期间存储内容丢失 (极少见): 整个缓冲区的内容都未定义, 用 SubData 重新写入全部实例
+                LOGE("InstanceBufferManager: glUnmapBuffer reported corrupted storage, rewriting with glBufferSubData");
+                ranges.assign(1, Range(0, m_count));
+            }
+        } else {
+            LOGE("InstanceBufferManager: glMapBufferRange failed (0x%x), falling back to glBufferSubData", glGetError());
+            m_mode = UploadMode::SubData;
+        }
+    }
+    if (!done) {
+        for (const Range& range : ranges) {
+            const size_t bytes = (range.second - range.first) * m_stride;
+            glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(range.first * m_stride),
+                            static_cast<GLsizeiptr>(bytes), data + range.first * m_stride);
+            m_stats.bytes += bytes;
+        }
+    }
+    m_stats.ranges += ranges.size();
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+// ---- 三种写法对比 (INSTANCE_BUFFER_BENCHMARK_ON_STARTUP) ----
+void InstanceBufferManager::benchmark() {
+    constexpr size_t kInstances = 100000;
+    constexpr size_t kStride = 100;             // sizeof(InstanceData)
+    constexpr int kFrames = 60;
+    constexpr size_t kScattered = 2000;         // 每帧随机更新的实例 (拖拽、动画)
+    constexpr size_t kBlock = 1000;             // 每帧整段更新的实例 (一组实例的变换)
+
+    std::vector<uint8_t> data(kInstances * kStride, 0);
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<size_t> pick(0, kInstances - 1);
+    std::vector<std::vector<size_t>> frames(kFrames);
+    for (int f = 0; f < kFrames; ++f) {
+        const size_t blockStart = (static_cast<size_t>(f) * 7919) % (kInstances - kBlock);
+        for (size_t i = 0; i < kBlock; ++i) {
+            frames[f].push_back(blockStart + i);
+        }
+        for (size_t i = 0; i < kScattered; ++i) {
+            frames[f].push_back(pick(rng));
+        }
+    }
+
+    using Clock = std::chrono::high_resolution_clock;
+    auto touch = [&](size_t index, int frame) { data[index * kStride] = static_cast<uint8_t>(frame); };
+
+    // 1. 旧写法: 单缓冲, 每个实例一次 glBufferSubData
+    {
+        GLuint buffer = 0;
+        glGenBuffers(1, &buffer);
+        glBindBuffer(GL_ARRAY_BUFFER, buffer);
+        glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(data.size()), data.data(), GL_DYNAMIC_DRAW);
+        glFinish();
+        const auto begin = Clock::now();
+        size_t calls = 0;
+        for (int f = 0; f < kFrames; ++f) {
+            for (size_t index : frames[f]) {
+                touch(index, f);
+                glBufferSubData(GL_ARRAY_BUFFER, static_cast<GLintptr>(index * kStride), kStride, &data[index * kStride]);
+                ++calls;
+            }
+        }
+        glFinish();
+        const double ms = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+        LOGI("InstanceBuffer benchmark: per-instance glBufferSubData  %.3f ms/frame, %d calls/frame",
+             ms / kFrames, static_cast<int>(calls / kFrames));
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glDeleteBuffers(1, &buffer);
+    }
+
+    // 2/3. 脏区间合并 + 轮换缓冲区
+    const UploadMode modes[] = { UploadMode::SubData, UploadMode::MapUnsynchronized };
+    const char* names[] = { "coalesced glBufferSubData", "coalesced unsynchronized map" };
+    for (int m = 0; m < 2; ++m) {
+        InstanceBufferManager manager(kStride, kDefaultRingSize, modes[m]);
+        manager.reset(data.data(), kInstances);
+        glFinish();
+        const auto begin = Clock::now();
+        for (int f = 0; f < kFrames; ++f) {
+            for (size_t index : frames[f]) {
+                touch(index, f);
+                manager.markDirty(index);
+            }
+            manager.flush(data.data());
+        }
+        glFinish();
+        const double ms = std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+        const Stats& stats = manager.stats();
+        LOGI("InstanceBuffer benchmark: %-28s %.3f ms/frame, %d uploads/frame, %d KB/frame, %d fence waits",
+             names[m], ms / kFrames, static_cast<int>(stats.ranges / kFrames),
+             static_cast<int>(stats.bytes / kFrames / 1024), static_cast<int>(stats.fenceWaits));
+    }
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "macros.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// 置 1 后在场景就绪时运行一次 InstanceBufferManager::benchmark (需要 GL 上下文)
+#define INSTANCE_BUFFER_BENCHMARK_ON_STARTUP 0
+
+/**
+ * @brief 实例缓冲区的流式更新: CPU 侧记录脏区间, 每帧合并后一次写入, 绘制中的缓冲区不被改写
+ *
+ * - 数据由调用者持有 (例如 Model 的实例数组), 本类只保存 GPU 副本; 修改 CPU 数据后调用 markDirty
+ * - 多个 GPU 缓冲区轮流使用 (默认 3 个): 有脏区间的帧 flush 时切换到下一个缓冲区,
+ *   每个缓冲区记录自己落后的区间, 轮到它时补齐; 离开一个缓冲区时插入 fence, 再次写入前确认 GPU 已读完,
+ *   因此写入可以使用 GL_MAP_UNSYNCHRONIZED_BIT, 不会因为 GPU 仍在读取而阻塞
+ * - 没有更新的帧不切换缓冲区, 也不产生任何 GL 调用
+ * - 区间排序合并, 间隔小于 kMergeGapBytes 的相邻区间并为一次写入; 脏数据超过一半时整体写入
+ *
+ * 切换缓冲区后 buffer() 改变, 调用者需要把实例属性重新指向它 (flush 返回 true)。
+ * 所有方法必须在 GL 线程调用。
+ */
+class InstanceBufferManager {
+public:
+    enum class UploadMode {
+        MapUnsynchronized,  // glMapBufferRange(UNSYNCHRONIZED | FLUSH_EXPLICIT), 逐区间 glFlushMappedBufferRange
+        SubData,            // 逐区间 glBufferSubData
+    };
+
+    struct Stats {
+        uint64_t flushes = 0;       // 有脏数据的 flush 次数
+        uint64_t ranges = 0;        // 合并后的写入次数
+        uint64_t bytes = 0;         // 写入的字节数
+        uint64_t fenceWaits = 0;    // 写入前 fence 尚未完成而等待的次数
+    };
+
+    static constexpr int kDefaultRingSize = 3;
+    static constexpr size_t kMergeGapBytes = 256;
+
+    /**
+     * @param stride 每个实例的字节数
+     * @param ringSize 轮换的缓冲区个数, 1 表示单缓冲 (写入前等待 GPU 读完)
+     */
+    explicit InstanceBufferManager(size_t stride, int ringSize = kDefaultRingSize,
+                                   UploadMode mode = UploadMode::MapUnsynchronized);
+    ~InstanceBufferManager();
+
+    InstanceBufferManager(const InstanceBufferManager&) = delete;
+    InstanceBufferManager& operator=(const InstanceBufferManager&) = delete;
+
+    // 重新分配全部缓冲区并写入完整数据 (实例数变化时); 清空所有脏区间
+    void reset(const void* data, size_t count);
+
+    // 标记 [first, first + count) 个实例需要上传
+    void markDirty(size_t first, size_t count = 1);
+
+    /**
+     * @brief 每帧绘制前调用一次: 切换到下一个缓冲区并写入它落后的全部区间
+     * @param data 与 reset 时相同布局的 CPU 数据 (至少 count() 个实例)
+     * @return true 当前缓冲区已切换, 需要重新设置实例属性指针
+     */
+    bool flush(const void* data);
+
+    GLuint buffer() const { return m_ring.empty() ? 0 : m_ring[m_current].buffer; }
+    size_t count() const { return m_count; }
+    size_t stride() const { return m_stride; }
+    bool hasPendingUpdates() const { return !m_pending.empty(); }
+    const Stats& stats() const { return m_stats; }
+
+    /**
+     * @brief 对比三种写法更新 100k 实例中分散的若干实例的耗时:
+     *        逐实例 glBufferSubData (旧写法) / 合并区间 + SubData / 合并区间 + 无同步映射
+     */
+    static void benchmark();
+
+private:
+    using Range = std::pair<size_t, size_t>;   // [begin, end), 单位: 实例
+
+    struct Slot {
+        GLuint buffer = 0;
+        GLsync fence = nullptr;         // 离开该缓冲区时插入, 再次写入前等待
+        std::vector<Range> behind;      // 该缓冲区尚未写入的区间
+    };
+
+    static void coalesce(std::vector<Range>& ranges, size_t mergeGap);
+    void waitFence(Slot& slot);
+    void upload(Slot& slot, const uint8_t* data);
+
+    size_t m_stride;
+    UploadMode m_mode;
+    size_t m_count = 0;
+    std::vector<Slot> m_ring;
+    int m_current = 0;
+    std::vector<Range> m_pending;       // 上次 flush 之后标记的区间
+    Stats m_stats;
+};
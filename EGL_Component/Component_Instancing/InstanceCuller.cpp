@@ -0,0 +1,259 @@
+#include "InstanceCuller.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <random>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "macros.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define WIND_CULL_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define WIND_CULL_NEON 1
+#include <arm_neon.h>
+#endif
+
+InstanceCuller::Frustum InstanceCuller::Frustum::fromMatrix(const glm::mat4& m) {
+    // glm 按列存储: m[col][row]; 平面 = 第 4 行 ± 第 1/2/3 行
+    const glm::vec4 row0(m[0][0], m[1][0], m[2][0], m[3][0]);
+    const glm::vec4 row1(m[0][1], m[1][1], m[2][1], m[3][1]);
+    const glm::vec4 row2(m[0][2], m[1][2], m[2][2], m[3][2]);
+    const glm::vec4 row3(m[0][3], m[1][3], m[2][3], m[3][3]);
+
+    Frustum frustum;
+    frustum.planes[0] = row3 + row0;    // 左
+    frustum.planes[1] = row3 - row0;    // 右
+    frustum.planes[2] = row3 + row1;    // 下
+    frustum.planes[3] = row3 - row1;    // 上
+    frustum.planes[4] = row3 + row2;    // 近
+    frustum.planes[5] = row3 - row2;    // 远
+    for (glm::vec4& plane : frustum.planes) {
+        const float length = glm::length(glm::vec3(plane));
+        if (length > 0.0f) {
+            plane /= length;
+        }
+    }
+    return frustum;
+}
+
+bool InstanceCuller::simdAvailable() {
+#if defined(WIND_CULL_SSE2) || defined(WIND_CULL_NEON)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void InstanceCuller::setInstances(const InstanceData* instances, size_t count,
+                                  const glm::vec3& localMin, const glm::vec3& localMax) {
+    m_localCenter = (localMin + localMax) * 0.5f;
+    m_localExtent = (localMax - localMin) * 0.5f;
+    m_count = count;
+    m_centerX.resize(count);
+    m_centerY.resize(count);
+    m_centerZ.resize(count);
+    m_extentX.resize(count);
+    m_extentY.resize(count);
+    m_extentZ.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        computeBounds(i, instances[i]);
+    }
+}
+
+void InstanceCuller::updateInstance(size_t index, const InstanceData& instance) {
+    if (index < m_count) {
+        computeBounds(index, instance);
+    }
+}
+
+void InstanceCuller::computeBounds(size_t index, const InstanceData& instance) {
+    // 仿射变换后的 AABB: 中心直接变换, 半长取矩阵线性部分的绝对值乘以原半长
+    const glm::mat4& m = instance.modelMatrix;
+    const glm::vec3 center = glm::vec3(m * glm::vec4(m_localCenter, 1.0f));
+    glm::vec3 extent;
+    for (int row = 0; row < 3; ++row) {
+        extent[row] = std::fabs(m[0][row]) * m_localExtent.x + std::fabs(m[1][row]) * m_localExtent.y +
+                      std::fabs(m[2][row]) * m_localExtent.z;
+    }
+    // 拖拽偏移按纹理坐标 x (0 ~ 1) 比例作用在世界空间的 XY 上: 包围盒朝两侧各扩一半
+    const float dragX = std::fabs(instance.offset.x) * 0.5f;
+    const float dragY = std::fabs(instance.offset.y) * 0.5f;
+    m_centerX[index] = center.x + instance.offset.x * 0.5f;
+    m_centerY[index] = center.y - instance.offset.y * 0.5f;
+    m_centerZ[index] = center.z;
+    m_extentX[index] = extent.x + dragX;
+    m_extentY[index] = extent.y + dragY;
+    m_extentZ[index] = extent.z;
+}
+
+size_t InstanceCuller::cullScalar(const Frustum& frustum, float inflateY, size_t begin,
+                                  std::vector<uint32_t>& outVisible) const {
+    size_t visible = 0;
+    for (size_t i = begin; i < m_count; ++i) {
+        const float ey = m_extentY[i] + inflateY;
+        bool inside = true;
+        for (const glm::vec4& plane : frustum.planes) {
+            // 与向量化路径相同的结合顺序, 保证两条路径结果一致
+            const float distance = (plane.x * m_centerX[i] + plane.y * m_centerY[i]) + (plane.z * m_centerZ[i] + plane.w);
+            const float radius = (std::fabs(plane.x) * m_extentX[i] + std::fabs(plane.y) * ey) + std::fabs(plane.z) * m_extentZ[i];
+            if (distance + radius < 0.0f) {
+                inside = false;
+                break;
+            }
+        }
+        if (inside) {
+            outVisible.push_back(static_cast<uint32_t>(i));
+            ++visible;
+        }
+    }
+    return visible;
+}
+
+size_t InstanceCuller::cull(const Frustum& frustum, float inflateY, std::vector<uint32_t>& outVisible, bool simd) {
+    const auto start = std::chrono::high_resolution_clock::now();
+    outVisible.clear();
+    outVisible.reserve(m_count);
+    size_t i = 0;
+    (void)simd;
+
+#if defined(WIND_CULL_SSE2)
+    if (simd) {
+        __m128 nx[6], ny[6], nz[6], nw[6], ax[6], ay[6], az[6];
+        for (int p = 0; p < 6; ++p) {
+            nx[p] = _mm_set1_ps(frustum.planes[p].x);
+            ny[p] = _mm_set1_ps(frustum.planes[p].y);
+            nz[p] = _mm_set1_ps(frustum.planes[p].z);
+            nw[p] = _mm_set1_ps(frustum.planes[p].w);
+            ax[p] = _mm_set1_ps(std::fabs(frustum.planes[p].x));
+            ay[p] = _mm_set1_ps(std::fabs(frustum.planes[p].y));
+            az[p] = _mm_set1_ps(std::fabs(frustum.planes[p].z));
+        }
+        const __m128 inflate = _mm_set1_ps(inflateY);
+        const __m128 zero = _mm_setzero_ps();
+        for (; i + 4 <= m_count; i += 4) {
+            const __m128 cx = _mm_loadu_ps(&m_centerX[i]);
+            const __m128 cy = _mm_loadu_ps(&m_centerY[i]);
+            const __m128 cz = _mm_loadu_ps(&m_centerZ[i]);
+            const __m128 ex = _mm_loadu_ps(&m_extentX[i]);
+            const __m128 ey = _mm_add_ps(_mm_loadu_ps(&m_extentY[i]), inflate);
+            const __m128 ez = _mm_loadu_ps(&m_extentZ[i]);
+            int inside = 0xF;
+            for (int p = 0; p < 6 && inside; ++p) {
+                const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(nx[p], cx), _mm_mul_ps(ny[p], cy)),
+                                                   _mm_add_ps(_mm_mul_ps(nz[p], cz), nw[p]));
+                const __m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(ax[p], ex), _mm_mul_ps(ay[p], ey)),
+                                                 _mm_mul_ps(az[p], ez));
+                inside &= _mm_movemask_ps(_mm_cmpge_ps(_mm_add_ps(distance, radius), zero));
+            }
+            for (int lane = 0; lane < 4; ++lane) {
+                if (inside & (1 << lane)) {
+                    outVisible.push_back(static_cast<uint32_t>(i + lane));
+                }
+            }
+        }
+    }
+#elif defined(WIND_CULL_NEON)
+    if (simd) {
+        float32x4_t nx[6], ny[6], nz[6], nw[6], ax[6], ay[6], az[6];
+        for (int p = 0; p < 6; ++p) {
+            nx[p] = vdupq_n_f32(frustum.planes[p].x);
+            ny[p] = vdupq_n_f32(frustum.planes[p].y);
+            nz[p] = vdupq_n_f32(frustum.planes[p].z);
+            nw[p] = vdupq_n_f32(frustum.planes[p].w);
+            ax[p] = vdupq_n_f32(std::fabs(frustum.planes[p].x));
+            ay[p] = vdupq_n_f32(std::fabs(frustum.planes[p].y));
+            az[p] = vdupq_n_f32(std::fabs(frustum.planes[p].z));
+        }
+        const float32x4_t inflate = vdupq_n_f32(inflateY);
+        const float32x4_t zero = vdupq_n_f32(0.0f);
+        for (; i + 4 <= m_count; i += 4) {
+            const float32x4_t cx = vld1q_f32(&m_centerX[i]);
+            const float32x4_t cy = vld1q_f32(&m_centerY[i]);
+            const float32x4_t cz = vld1q_f32(&m_centerZ[i]);
+            const float32x4_t ex = vld1q_f32(&m_extentX[i]);
+            const float32x4_t ey = vaddq_f32(vld1q_f32(&m_extentY[i]), inflate);
+            const float32x4_t ez = vld1q_f32(&m_extentZ[i]);
+            uint32x4_t inside = vdupq_n_u32(0xFFFFFFFFu);
+            for (int p = 0; p < 6; ++p) {
+                // 与 SSE 路径相同的运算顺序 (不使用 FMA)
+                const float32x4_t distance = vaddq_f32(vaddq_f32(vmulq_f32(nx[p], cx), vmulq_f32(ny[p], cy)),
+                                                       vaddq_f32(vmulq_f32(nz[p], cz), nw[p]));
+                const float32x4_t radius = vaddq_f32(vaddq_f32(vmulq_f32(ax[p], ex), vmulq_f32(ay[p], ey)),
+                                                     vmulq_f32(az[p], ez));
+                inside = vandq_u32(inside, vcgeq_f32(vaddq_f32(distance, radius), zero));
+            }
+            uint32_t lanes[4];
+            vst1q_u32(lanes, inside);
+            for (int lane = 0; lane < 4; ++lane) {
+                if (lanes[lane]) {
+                    outVisible.push_back(static_cast<uint32_t>(i + lane));
+                }
+            }
+        }
+    }
+#endif
+
+    cullScalar(frustum, inflateY, i, outVisible);
+
+    m_stats.tested = m_count;
+    m_stats.visible = outVisible.size();
+    m_stats.cullMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+    return outVisible.size();
+}
+
+// ---- 标量与向量化路径对比 (INSTANCE_CULL_BENCHMARK_ON_STARTUP) ----
+void InstanceCuller::benchmark(size_t count, int iterations) {
+    if (count == 0 || iterations <= 0) return;
+
+    // 200 x 200 范围内随机分布、随机缩放的实例
+    std::vector<InstanceData> instances(count);
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> position(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> scale(0.05f, 0.2f);
+    for (size_t i = 0; i < count; ++i) {
+        instances[i].modelMatrix = glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(position(rng), 0.0f, position(rng))),
+                                              glm::vec3(scale(rng)));
+        instances[i].offset = glm::vec4(0.0f);
+        instances[i].instanceId = static_cast<uint32_t>(i + 1);
+    }
+
+    InstanceCuller culler;
+    auto boundsStart = std::chrono::high_resolution_clock::now();
+    culler.setInstances(instances.data(), count, glm::vec3(-5.0f, 0.0f, -1.0f), glm::vec3(5.0f, 4.0f, 1.0f));
+    const double boundsMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - boundsStart).count();
+
+    const glm::mat4 proj = glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 120.0f);
+    std::vector<uint32_t> scalarVisible, simdVisible;
+    double scalarMs = 0.0, simdMs = 0.0;
+    size_t visibleSum = 0;
+    bool identical = true;
+    for (int it = 0; it < iterations; ++it) {
+        // 相机绕场景旋转, 每次看到不同的一部分
+        const float angle = glm::two_pi<float>() * it / iterations;
+        const glm::mat4 view = glm::lookAt(glm::vec3(std::cos(angle) * 60.0f, 20.0f, std::sin(angle) * 60.0f),
+                                           glm::vec3(0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+        const Frustum frustum = Frustum::fromMatrix(proj * view);
+        culler.cull(frustum, windDisplacement(1.0f), scalarVisible, false);
+        scalarMs += culler.stats().cullMs;
+        culler.cull(frustum, windDisplacement(1.0f), simdVisible, true);
+        simdMs += culler.stats().cullMs;
+        visibleSum += simdVisible.size();
+        identical = identical && scalarVisible == simdVisible;
+    }
+
+    LOGI("InstanceCuller benchmark %d instances: bounds %.3f ms, scalar %.3f ms, %s %.3f ms (%.2fx), "
+         "%d visible on average, outputs %s",
+         static_cast<int>(count), boundsMs, scalarMs / iterations,
+#if defined(WIND_CULL_SSE2)
+         "SSE2",
+#elif defined(WIND_CULL_NEON)
+         "NEON",
+#else
+         "scalar",
+#endif
+         simdMs / iterations, simdMs > 0.0 ? scalarMs / simdMs : 0.0,
+         static_cast<int>(visibleSum / iterations), identical ? "identical" : "DIFFERENT");
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "CommonTypes.hpp"
+
+// 置 1 后在场景就绪时运行一次 InstanceCuller::benchmark 并输出日志
+#define INSTANCE_CULL_BENCHMARK_ON_STARTUP 0
+
+/**
+ * @brief 实例的视锥剔除 (纯 CPU, 不依赖 GL 上下文)
+ *
+ * - setInstances 由模型包围盒与实例矩阵计算每个实例的世界空间 AABB, 以中心/半长的 SoA 形式保存;
+ *   拖拽偏移 (InstanceData::offset) 与风场波动的最大位移计入包围盒, 保证剔除是保守的
+ * - cull 用 proj * view 提取的 6 个平面测试全部 AABB, 可见实例的下标按原顺序紧凑写出
+ * - 一次测试 4 个包围盒: SSE2 (x86) / NEON (ARM), 其它平台及 simd = false 时走标量路径, 两者结果一致
+ */
+class InstanceCuller {
+public:
+    struct Frustum {
+        glm::vec4 planes[6];    // xyz 为指向视锥内部的单位法线, w 为距离
+
+        // 从裁剪矩阵 (proj * view) 提取左右下上近远六个平面 (OpenGL 裁剪空间 -w..w)
+        static Frustum fromMatrix(const glm::mat4& viewProj);
+    };
+
+    struct Stats {
+        size_t tested = 0;
+        size_t visible = 0;
+        double cullMs = 0.0;    // 最近一次 cull 的耗时
+    };
+
+    /**
+     * @brief wind.vert.glsl 中顶点沿 Y 的最大位移:
+     *        三个波叠加的幅度之和 1 + 0.3 + 0.15, 乘以最上层的层系数 1.5 与 uWaveAmp (X 位置系数最大为 1)
+     */
+    static float windDisplacement(float waveAmp) { return waveAmp * 1.5f * 1.45f; }
+
+    // 当前编译目标是否有向量化实现
+    static bool simdAvailable();
+
+    /**
+     * @brief 计算全部实例的世界空间包围盒 (实例数或实例矩阵变化时调用)
+     * @param localMin/localMax 模型空间包围盒 (Model::boundsMin/boundsMax)
+     */
+    void setInstances(const InstanceData* instances, size_t count, const glm::vec3& localMin, const glm::vec3& localMax);
+    // 只更新一个实例的包围盒 (拖拽偏移变化)
+    void updateInstance(size_t index, const InstanceData& instance);
+    // 第 index 个实例的世界空间包围盒 (中心/半长, 不含 inflateY)
+    void instanceBounds(size_t index, glm::vec3& outCenter, glm::vec3& outExtent) const {
+        outCenter = glm::vec3(m_centerX[index], m_centerY[index], m_centerZ[index]);
+        outExtent = glm::vec3(m_extentX[index], m_extentY[index], m_extentZ[index]);
+    }
+
+    /**
+     * @brief 测试全部实例, 可见实例的下标 (升序) 写入 outVisible
+     * @param inflateY 额外的 Y 方向扩张 (windDisplacement(uWaveAmp))
+     * @return 可见实例数
+     */
+    size_t cull(const Frustum& frustum, float inflateY, std::vector<uint32_t>& outVisible, bool simd = true);
+
+    size_t instanceCount() const { return m_count; }
+    const Stats& stats() const { return m_stats; }
+
+    /**
+     * @brief 随机分布的 count 个实例在若干视角下比较标量与向量化路径的耗时与结果, 写入日志
+     */
+    static void benchmark(size_t count = 100000, int iterations = 50);
+
+private:
+    void computeBounds(size_t index, const InstanceData& instance);
+    size_t cullScalar(const Frustum& frustum, float inflateY, size_t begin, std::vector<uint32_t>& outVisible) const;
+
+    glm::vec3 m_localCenter = glm::vec3(0.0f);
+    glm::vec3 m_localExtent = glm::vec3(0.0f);
+    size_t m_count = 0;
+    // SoA: 世界空间中心与半长
+    std::vector<float> m_centerX, m_centerY, m_centerZ;
+    std::vector<float> m_extentX, m_extentY, m_extentZ;
+    Stats m_stats;
+};
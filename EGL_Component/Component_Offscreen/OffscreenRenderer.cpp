@@ -64,6 +64,17 @@ void OffscreenRenderer::initScreenRender() {
     glBindVertexArray(0);
 }
 
+void OffscreenRenderer::resize(int width, int height) {
+    if (width == mWidth && height == mHeight) {
+        return;
+    }
+    mFbo.reset();
+    mWidth = width;
+    mHeight = height;
+    mFbo = std::make_unique<LyFBOMSAA>(mWidth, mHeight);
+    LOGI("OffscreenRenderer: MSAA FBO resized to %dx%d.", mWidth, mHeight);
+}
+
 void OffscreenRenderer::beginFrame() {
     mFbo->bindForDraw();
     glEnable(GL_DEPTH_TEST);
@@ -57,6 +57,15 @@ public:
      */
     void drawToScreen();
 
+    /**
+     * @brief Recreates the FBO at the new size; does nothing if the size is unchanged.
+     * The screen quad and shader are size independent and are kept.
+     */
+    void resize(int width, int height);
+
+    int width() const { return mWidth; }
+    int height() const { return mHeight; }
+
 private:
     void initScreenRender();
 
@@ -0,0 +1,222 @@
+#include "RenderQueue.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+uint32_t RenderQueue::registerMaterial(std::function<void()> bind) {
+    m_materials.push_back(std::move(bind));
+    return static_cast<uint32_t>(m_materials.size());
+}
+
+void RenderQueue::reset(float maxDepth) {
+    m_items.clear();
+    m_maxDepth = maxDepth > 0.0f ? maxDepth : 1.0f;
+}
+
+void RenderQueue::submit(DrawItem item) {
+    if (!item.draw) {
+        return;
+    }
+    if (item.pass == Pass::Transparent) {
+        item.depthWrite = false;
+    }
+    m_items.push_back(std::move(item));
+}
+
+uint64_t RenderQueue::makeKey(const DrawItem& item, float maxDepth) {
+    const float normalized = std::min(std::max(item.depth / maxDepth, 0.0f), 1.0f);
+    const uint64_t depth = static_cast<uint64_t>(normalized * 0xFFFFFF) & 0xFFFFFF;
+    const uint64_t pass = static_cast<uint64_t>(item.pass) & 0x3;
+    const uint64_t blend = static_cast<uint64_t>(item.blend) & 0x3;
+    const uint64_t program = static_cast<uint64_t>(item.program) & 0x3FF;
+    const uint64_t material = static_cast<uint64_t>(item.material) & 0x3FFF;
+    const uint64_t mesh = static_cast<uint64_t>(item.mesh) & 0xFFF;
+    if (item.pass == Pass::Transparent) {
+        // 由远到近: 深度取反后放在程序与材质之前
+        return (pass << 62) | (blend << 60) | ((0xFFFFFF - depth) << 36) | (program << 26) | (material << 12) | mesh;
+    }
+    return (pass << 62) | (blend << 60) | (program << 50) | (material << 36) | (depth << 12) | mesh;
+}
+
+void RenderQueue::radixSort(std::vector<std::pair<uint64_t, uint32_t>>& keys,
+                            std::vector<std::pair<uint64_t, uint32_t>>& scratch) {
+    const size_t count = keys.size();
+    if (count < 2) {
+        return;
+    }
+    // 一次遍历统计全部 8 个字节的分布
+    uint32_t histograms[8][256] = {};
+    for (const auto& entry : keys) {
+        for (int byte = 0; byte < 8; ++byte) {
+            ++histograms[byte][(entry.first >> (byte * 8)) & 0xFF];
+        }
+    }
+    scratch.resize(count);
+    for (int byte = 0; byte < 8; ++byte) {
+        uint32_t* histogram = histograms[byte];
+        // 该字节所有键都相同 (例如只用到少数几个 pass): 这一轮不改变顺序
+        if (histogram[(keys[0].first >> (byte * 8)) & 0xFF] == count) {
+            continue;
+        }
+        uint32_t offset = 0;
+        for (int digit = 0; digit < 256; ++digit) {
+            const uint32_t bucket = histogram[digit];
+            histogram[digit] = offset;
+            offset += bucket;
+        }
+        for (const auto& entry : keys) {
+            scratch[histogram[(entry.first >> (byte * 8)) & 0xFF]++] = entry;
+        }
+        keys.swap(scratch);
+    }
+}
+
+void RenderQueue::transition(const DrawItem& item, bool apply) {
+    if (item.program != 0 && (!m_state.programKnown || m_state.program != item.program)) {
+        if (apply) glUseProgram(item.program);
+        m_state.program = item.program;
+        m_state.programKnown = true;
+        ++m_stats.programChanges;
+    }
+    if (item.material != kNoMaterial && item.material != m_state.material) {
+        if (apply && item.material <= m_materials.size() && m_materials[item.material - 1]) {
+            m_materials[item.material - 1]();
+        }
+        m_state.material = item.material;
+        ++m_stats.materialChanges;
+    }
+    const int blend = static_cast<int>(item.blend);
+    if (blend != m_state.blend) {
+        if (apply) {
+            if (item.blend == BlendMode::Opaque) {
+                glDisable(GL_BLEND);
+            } else {
+                glEnable(GL_BLEND);
+                glBlendFunc(GL_SRC_ALPHA, item.blend == BlendMode::Additive ? GL_ONE : GL_ONE_MINUS_SRC_ALPHA);
+            }
+        }
+        m_state.blend = blend;
+        ++m_stats.blendChanges;
+    }
+    const int depthTest = item.depthTest ? 1 : 0;
+    const int depthWrite = item.depthWrite ? 1 : 0;
+    if (depthTest != m_state.depthTest || depthWrite != m_state.depthWrite) {
+        if (apply) {
+            if (depthTest != m_state.depthTest) {
+                if (item.depthTest) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
+            }
+            if (depthWrite != m_state.depthWrite) {
+                glDepthMask(item.depthWrite ? GL_TRUE : GL_FALSE);
+            }
+        }
+        m_state.depthTest = depthTest;
+        m_state.depthWrite = depthWrite;
+        ++m_stats.depthStateChanges;
+    }
+}
+
+void RenderQueue::execute() {
+    using Clock = std::chrono::high_resolution_clock;
+    m_stats = Stats();
+    m_stats.items = m_items.size();
+
+    const auto sortStart = Clock::now();
+    m_keys.resize(m_items.size());
+    for (size_t i = 0; i < m_items.size(); ++i) {
+        m_keys[i] = { makeKey(m_items[i], m_maxDepth), static_cast<uint32_t>(i) };
+    }
+    radixSort(m_keys, m_scratch);
+    const auto executeStart = Clock::now();
+    m_stats.sortMs = std::chrono::duration<double, std::milli>(executeStart - sortStart).count();
+
+    // 帧开始时 GL 状态未知, 第一项的全部状态都会设置
+    m_state = State();
+    for (const auto& entry : m_keys) {
+        const DrawItem& item = m_items[entry.second];
+        transition(item, true);
+        item.draw();
+        if (item.program == 0) {
+            m_state.programKnown = false;
+        }
+    }
+
+    if (!m_items.empty()) {
+        glDisable(GL_BLEND);
+        glEnable(GL_DEPTH_TEST);
+        glDepthMask(GL_TRUE);
+        glUseProgram(0);
+    }
+    m_stats.executeMs = std::chrono::duration<double, std::milli>(Clock::now() - executeStart).count();
+}
+
+// ---- 排序与状态切换对比 (RENDER_QUEUE_BENCHMARK_ON_STARTUP) ----
+void RenderQueue::benchmark() {
+    using Clock = std::chrono::high_resolution_clock;
+    const size_t counts[] = { 1000, 10000, 100000 };
+    constexpr int kRepeats = 20;
+    constexpr float kMaxDepth = 100.0f;
+
+    for (size_t count : counts) {
+        // 8 个程序、64 个材质、256 个网格, 四分之一为透明项
+        RenderQueue queue;
+        for (int m = 0; m < 64; ++m) {
+            queue.registerMaterial(nullptr);
+        }
+        queue.reset(kMaxDepth);
+        std::mt19937 rng(3);
+        std::uniform_int_distribution<int> program(1, 8), material(1, 64), mesh(0, 255), kind(0, 3);
+        std::uniform_real_distribution<float> depth(0.0f, kMaxDepth);
+        for (size_t i = 0; i < count; ++i) {
+            DrawItem item;
+            const bool transparent = kind(rng) == 0;
+            item.pass = transparent ? Pass::Transparent : Pass::Opaque;
+            item.blend = transparent ? BlendMode::Alpha : BlendMode::Opaque;
+            item.program = static_cast<GLuint>(program(rng));
+            item.material = static_cast<uint32_t>(material(rng));
+            item.mesh = static_cast<uint32_t>(mesh(rng));
+            item.depth = depth(rng);
+            item.draw = [] {};
+            queue.submit(std::move(item));
+        }
+
+        std::vector<std::pair<uint64_t, uint32_t>> source(count), keys, scratch;
+        for (size_t i = 0; i < count; ++i) {
+            source[i] = { makeKey(queue.m_items[i], kMaxDepth), static_cast<uint32_t>(i) };
+        }
+        double radixMs = 0.0, stdMs = 0.0;
+        bool identical = true;
+        for (int r = 0; r < kRepeats; ++r) {
+            keys = source;
+            auto begin = Clock::now();
+            radixSort(keys, scratch);
+            radixMs += std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+
+            auto reference = source;
+            begin = Clock::now();
+            std::stable_sort(reference.begin(), reference.end(),
+                             [](const auto& a, const auto& b) { return a.first < b.first; });
+            stdMs += std::chrono::duration<double, std::milli>(Clock::now() - begin).count();
+            identical = identical && reference == keys;
+        }
+
+        // 状态切换: 提交顺序 vs 排序后
+        auto countTransitions = [&](const std::vector<std::pair<uint64_t, uint32_t>>& order) {
+            queue.m_stats = Stats();
+            queue.m_state = State();
+            for (const auto& entry : order) {
+                queue.transition(queue.m_items[entry.second], false);
+            }
+            return queue.m_stats;
+        };
+        const Stats unsorted = countTransitions(source);
+        const Stats sorted = countTransitions(keys);
+
+        LOGI("RenderQueue benchmark %6d items: radix %.3f ms, std::stable_sort %.3f ms (%s); "
+             "program/material/blend changes %d/%d/%d unsorted -> %d/%d/%d sorted",
+             static_cast<int>(count), radixMs / kRepeats, stdMs / kRepeats, identical ? "identical" : "DIFFERENT",
+             static_cast<int>(unsorted.programChanges), static_cast<int>(unsorted.materialChanges),
+             static_cast<int>(unsorted.blendChanges), static_cast<int>(sorted.programChanges),
+             static_cast<int>(sorted.materialChanges), static_cast<int>(sorted.blendChanges));
+    }
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "macros.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// 置 1 后在场景就绪时运行一次 RenderQueue::benchmark 并输出日志 (只用 CPU)
+#define RENDER_QUEUE_BENCHMARK_ON_STARTUP 0
+
+/**
+ * @brief 按 64 位排序键排序后执行的绘制队列
+ *
+ * 各组件每帧 submit 绘制项 (pass、混合方式、程序、材质、深度、网格 + 一个只发出绘制调用的回调),
+ * execute 时对排序键做基数排序, 然后按顺序执行: 程序、材质、混合与深度状态只在与上一项不同时才切换。
+ *
+ * 排序键 (高位 -> 低位):
+ *   非透明 pass: pass 2 | blend 2 | program 10 | material 14 | depth 24     | mesh 12   (同一状态内由近到远)
+ *   Transparent: pass 2 | blend 2 | ~depth 24  | program 10  | material 14 | mesh 12   (由远到近, 深度优先于状态)
+ *
+ * program 与 material 在键中只取低位用于分组, 状态是否切换按完整的值判断。
+ * 所有方法必须在 GL 线程调用 (benchmark 除外)。
+ */
+class RenderQueue {
+public:
+    enum class Pass : uint8_t {
+        Background = 0,     // 天空盒等, 最先绘制
+        Opaque = 1,
+        Transparent = 2,    // 关闭深度写入, 由远到近
+        Overlay = 3,        // 坐标轴、包围盒等辅助元素
+    };
+
+    enum class BlendMode : uint8_t {
+        Opaque = 0,         // 关闭混合
+        Alpha = 1,          // SRC_ALPHA, ONE_MINUS_SRC_ALPHA
+        Additive = 2,       // SRC_ALPHA, ONE
+    };
+
+    static constexpr uint32_t kNoMaterial = 0;
+
+    struct DrawItem {
+        Pass pass = Pass::Opaque;
+        BlendMode blend = BlendMode::Opaque;
+        GLuint program = 0;                 // 0 表示 draw 自行设置程序, 执行后队列不再假定当前程序
+        uint32_t material = kNoMaterial;    // registerMaterial 的返回值
+        float depth = 0.0f;                 // 到相机的距离 (reset 时给出的范围内)
+        uint32_t mesh = 0;                  // 同一材质内的次序, 例如 VAO
+        bool depthTest = true;
+        bool depthWrite = true;             // Transparent pass 中总是关闭
+        std::function<void()> draw;         // 只发出绘制调用 (可以设置 uniform、绑定 VAO)
+    };
+
+    struct Stats {
+        size_t items = 0;
+        size_t programChanges = 0;
+        size_t materialChanges = 0;
+        size_t blendChanges = 0;
+        size_t depthStateChanges = 0;
+        double sortMs = 0.0;
+        double executeMs = 0.0;
+    };
+
+    /**
+     * @brief 注册一组材质状态 (纹理等), 切换到该材质时调用 bind; bind 不能改变当前程序
+     * @return 材质编号, 用作 DrawItem::material
+     */
+    uint32_t registerMaterial(std::function<void()> bind);
+
+    // 每帧开始时调用: 清空上一帧的绘制项; maxDepth 为深度量化的范围 (通常是远裁剪面)
+    void reset(float maxDepth);
+    void submit(DrawItem item);
+
+    /**
+     * @brief 排序并执行本帧全部绘制项; 结束后恢复默认状态 (关闭混合、开启深度测试与写入、程序 0)
+     */
+    void execute();
+
+    size_t size() const { return m_items.size(); }
+    const Stats& stats() const { return m_stats; }
+
+    static uint64_t makeKey(const DrawItem& item, float maxDepth);
+    /**
+     * @brief 按 64 位键的 LSD 基数排序 (每次 8 位, 所有键在该字节相同的轮次跳过), 稳定
+     * @param scratch 与 keys 等长的临时空间, 由调用者复用
+     */
+    static void radixSort(std::vector<std::pair<uint64_t, uint32_t>>& keys,
+                          std::vector<std::pair<uint64_t, uint32_t>>& scratch);
+
+    /**
+     * @brief 1k / 10k / 100k 个随机绘制项: 基数排序与 std::stable_sort 的耗时, 提交顺序与排序后执行所需的状态切换次数
+     */
+    static void benchmark();
+
+private:
+    struct State {
+        GLuint program = 0;
+        uint32_t material = kNoMaterial;
+        int blend = -1;             // -1: 未知, 第一项时一定设置
+        int depthTest = -1;
+        int depthWrite = -1;
+        bool programKnown = false;
+    };
+
+    // 切换到 item 需要的状态; apply 为 false 时只统计切换次数, 不发出 GL 调用
+    void transition(const DrawItem& item, bool apply);
+
+    std::vector<DrawItem> m_items;
+    std::vector<std::pair<uint64_t, uint32_t>> m_keys;      // (排序键, 绘制项下标)
+    std::vector<std::pair<uint64_t, uint32_t>> m_scratch;
+    std::vector<std::function<void()>> m_materials;         // 下标 = 材质编号 - 1
+    float m_maxDepth = 1.0f;
+    State m_state;
+    Stats m_stats;
+};
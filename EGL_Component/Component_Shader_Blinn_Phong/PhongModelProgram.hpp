@@ -1,6 +1,7 @@
 #pragma once
 
 #include "ShaderProgram.hpp"
+#include "VertexLayout.hpp"
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <unordered_map>
@@ -13,6 +14,9 @@
 
 class ModelProgram : public ShaderProgram {
 public:
+    // 顶点着色器读取的模型属性, 模型导入据此裁剪属性; 与 activeAttributeMask() 核对
+    static constexpr uint32_t kVertexAttributes = VertexAttrib::Position | VertexAttrib::Normal | VertexAttrib::TexCoord;
+
     // UBO 的绑定点
     static constexpr GLuint BINDING_GLOBALS = 0;
 
@@ -15,6 +15,7 @@
 #include <unordered_map>
 
 #include "macros.h"
+#include "VertexLayout.hpp"
 
 #ifndef __COMPLEX_MODEL__
 #define __COMPLEX_MODEL__
@@ -24,6 +25,9 @@
 
 class ModelProgram : public ShaderProgram {
 public:
+    // 顶点着色器读取的模型属性 (aNormal 声明了但没有使用), 模型导入据此裁剪属性; 与 activeAttributeMask() 核对
+    static constexpr uint32_t kVertexAttributes = VertexAttrib::Position | VertexAttrib::TexCoord;
+
     struct WindUBO {
         glm::mat4 proj;
         glm::mat4 view;
@@ -41,14 +45,19 @@ public:
         glm::vec3 boundMax;
         float deltaY;           // 保留单一deltaY用于兼容性
 
-        // 每个实例的独立偏移数组
-        InstanceOffset instanceOffsets[INSTANCES_COUNT];
+        // 每个实例的独立偏移不在 UBO 中: 随实例缓冲提供 (InstanceData::offset, location 11), 实例数不受 UBO 大小限制
     };
     // UBO 的绑定点
     static constexpr GLuint BINDING_GLOBALS = 0;
 
     ModelProgram()
-    : ShaderProgram(WIND_VERTEX_SHADER, WIND_FRAGMENT_SHADER)
+    : ModelProgram(WIND_VERTEX_SHADER, WIND_FRAGMENT_SHADER)
+    {
+    }
+
+    // 使用外部源码 (例如资源包中预处理过的 shaders/wind.vert.core), 编译失败时抛出异常
+    ModelProgram(const std::string& vertexSource, const std::string& fragmentSource)
+    : ShaderProgram(vertexSource, fragmentSource)
     {
         GLuint program = handle();
 
@@ -3,4 +3,4 @@
 // Auto-generated from wind.frag.glsl
 // Do not edit this file manually
 
-const char* const WIND_FRAGMENT_SHADER = "#version 460 core\n\n#extension GL_ARB_separate_shader_objects : enable\n#extension GL_ARB_shading_language_420pack : enable\n\n#define INSTANCES_COUNT 4\n\nlayout(location=0) in vec3 FragPos;\nlayout(location=1) in vec2 TexCoords;\nlayout(location=2) flat in uint InstanceID;\nlayout(location=3) in float layerIndex;\nlayout(location=4) in float heightFactor;\nlayout(location=5) in vec4 ColorFromVertex;\n\nlayout(location=0) out vec4 FragColor;\n\nlayout(std140, binding=0) uniform Globals {\n    mat4 uProj;\n    mat4 uView;\n    mat4 uModel;\n\n    float uTime;\n    float uWaveAmp;\n    float uWaveSpeed;\n    int uPickedInstanceID;\n\n    vec4 uColor;\n\n    vec3 uBoundsMin;\n    float deltaX;\n    vec3 uBoundsMax;\n    float deltaY;\n\n    vec4 InstanceOffset[ INSTANCES_COUNT ];\n};\n\nstruct Material {\n    sampler2D texture_diffuse1;\n    sampler2D texture_diffuse2;\n    sampler2D texture_diffuse3;\n};\nuniform Material material;\n\nuniform sampler2D fadeEdgeMaskTexture;\n\nvoid main() {\n    vec4 texColor;\n\n    float timeOffset = uTime * 0.1;\n    vec2 moving_coords = vec2(TexCoords.x - timeOffset, TexCoords.y);\n\n    float opacity;\n    if (layerIndex < 0.05) {\n        texColor = texture(material.texture_diffuse1, moving_coords);\n        opacity = 0.4;\n    } else if (layerIndex - 1.0 < 0.05 )  {\n        texColor = texture(material.texture_diffuse2, moving_coords);\n        opacity = 0.4;\n    } else {\n        texColor = texture(material.texture_diffuse3, vec2( moving_coords));\n        opacity = 0.5;\n    }\n\n    vec3 windColor = vec3( 1. ) * 0.8;\n\n    if ((texColor.r + texColor.g + texColor.b)*0.3333 < 0.05) {\n        discard;\n\n    } else {\n        const float FADE_THREASHHOLD = 0.2;\n        vec4 tempTexture = texture( fadeEdgeMaskTexture, TexCoords );\n        float tempFactor = ( tempTexture.r + tempTexture.g + tempTexture.b )*0.33333;\n        tempFactor = 1.0 - smoothstep( FADE_THREASHHOLD, 0.15, tempFactor ) * tempFactor;\n        tempFactor = mix( 0.0, tempFactor, step( FADE_THREASHHOLD, tempFactor ));\n        FragColor = vec4( windColor, (texColor.r + texColor.g + texColor.b) * 0.33333 * opacity * tempFactor );\n\n    }\n\n}";
+const char* const WIND_FRAGMENT_SHADER = "#version 460 core\n\n#extension GL_ARB_separate_shader_objects : enable\n#extension GL_ARB_shading_language_420pack : enable\n\nlayout(location=0) in vec3 FragPos;\nlayout(location=1) in vec2 TexCoords;\nlayout(location=2) flat in uint InstanceID;\nlayout(location=3) in float layerIndex;\nlayout(location=4) in float heightFactor;\nlayout(location=5) in vec4 ColorFromVertex;\n\nlayout(location=0) out vec4 FragColor;\n\nlayout(std140, binding=0) uniform Globals {\n    mat4 uProj;\n    mat4 uView;\n    mat4 uModel;\n\n    float uTime;\n    float uWaveAmp;\n    float uWaveSpeed;\n    int uPickedInstanceID;\n\n    vec4 uColor;\n\n    vec3 uBoundsMin;\n    float deltaX;\n    vec3 uBoundsMax;\n    float deltaY;\n};\n\nstruct Material {\n    sampler2D texture_diffuse1;\n    sampler2D texture_diffuse2;\n    sampler2D texture_diffuse3;\n};\nuniform Material material;\n\nuniform sampler2D fadeEdgeMaskTexture;\n\nvoid main() {\n    vec4 texColor;\n\n    float timeOffset = uTime * 0.1;\n    vec2 moving_coords = vec2(TexCoords.x - timeOffset, TexCoords.y);\n\n    float opacity;\n    if (layerIndex < 0.05) {\n        texColor = texture(material.texture_diffuse1, moving_coords);\n        opacity = 0.4;\n    } else if (layerIndex - 1.0 < 0.05 )  {\n        texColor = texture(material.texture_diffuse2, moving_coords);\n        opacity = 0.4;\n    } else {\n        texColor = texture(material.texture_diffuse3, vec2( moving_coords));\n        opacity = 0.5;\n    }\n\n    vec3 windColor = vec3( 1. ) * 0.8;\n\n    if ((texColor.r + texColor.g + texColor.b)*0.3333 < 0.05) {\n        discard;\n\n    } else {\n        const float FADE_THREASHHOLD = 0.2;\n        vec4 tempTexture = texture( fadeEdgeMaskTexture, TexCoords );\n        float tempFactor = ( tempTexture.r + tempTexture.g + tempTexture.b )*0.33333;\n        tempFactor = 1.0 - smoothstep( FADE_THREASHHOLD, 0.15, tempFactor ) * tempFactor;\n        tempFactor = mix( 0.0, tempFactor, step( FADE_THREASHHOLD, tempFactor ));\n        FragColor = vec4( windColor, (texColor.r + texColor.g + texColor.b) * 0.33333 * opacity * tempFactor );\n\n    }\n\n}";
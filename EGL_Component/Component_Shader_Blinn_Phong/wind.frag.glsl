@@ -4,8 +4,6 @@
 #extension GL_ARB_separate_shader_objects : enable
 #extension GL_ARB_shading_language_420pack : enable
 
-#define INSTANCES_COUNT 4
-
 // 从顶点着色器传入的、经过插值的数据
 layout(location=0) in vec3 FragPos;
 layout(location=1) in vec2 TexCoords;
@@ -33,9 +31,6 @@ layout(std140, binding=0) uniform Globals {
     float deltaX;
     vec3 uBoundsMax;
     float deltaY;
-
-    // 每个实例的独立偏移数组
-    vec4 InstanceOffset[ INSTANCES_COUNT ];
 };
 
 // 材质结构体，现在包含多种纹理
@@ -3,4 +3,4 @@
 // Auto-generated from wind.frag.glsl
 // Do not edit this file manually
 
-const char* const WIND_FRAGMENT_SHADER = "#version 310 es\n\n\nprecision highp float;\n#define INSTANCES_COUNT 4\n\nlayout(location=0) in vec3 FragPos;\nlayout(location=1) in vec2 TexCoords;\nlayout(location=2) flat in uint InstanceID;\nlayout(location=3) in float layerIndex;\nlayout(location=4) in float heightFactor;\nlayout(location=5) in vec4 ColorFromVertex;\n\nlayout(location=0) out vec4 FragColor;\n\nlayout(std140, binding=0) uniform Globals {\n    mat4 uProj;\n    mat4 uView;\n    mat4 uModel;\n\n    float uTime;\n    float uWaveAmp;\n    float uWaveSpeed;\n    int uPickedInstanceID;\n\n    vec4 uColor;\n\n    vec3 uBoundsMin;\n    float deltaX;\n    vec3 uBoundsMax;\n    float deltaY;\n\n    vec4 InstanceOffset[ INSTANCES_COUNT ];\n};\n\nstruct Material {\n    sampler2D texture_diffuse1;\n    sampler2D texture_diffuse2;\n    sampler2D texture_diffuse3;\n};\nuniform Material material;\n\nvoid main() {\n    vec4 texColor;\n\n    float timeOffset = uTime * 0.1;\n    vec2 moving_coords = vec2(TexCoords.x - timeOffset, TexCoords.y);\n\n    int layerIdx = int(layerIndex + 0.5);\n    if (layerIdx == 0) {\n        texColor = texture(material.texture_diffuse1, moving_coords);\n    } else if (layerIdx == 1) {\n        texColor = texture(material.texture_diffuse2, moving_coords);\n    } else {\n        texColor = texture(material.texture_diffuse3, moving_coords);\n    }\n\n    if (texColor.r < 0.1 || texColor.g < 0.1 || texColor.b < 0.1) {\n        discard;\n    }\n\n    float brightness = dot(texColor.rgb, vec3(0.299, 0.587, 0.114));\n    texColor.a = smoothstep(0.0, 0.7, brightness);\n\n    if (uPickedInstanceID > 0 && abs(float(uPickedInstanceID) - float(InstanceID)) < 0.01) {\n\n        texColor.r -= deltaX * 0.1;\n        texColor.g -= deltaY * 0.1;\n        texColor.b -= deltaX * 0.1;\n    }\n\n    FragColor = texColor;\n}";
+const char* const WIND_FRAGMENT_SHADER = "#version 310 es\n\n\nprecision highp float;\nlayout(location=0) in vec3 FragPos;\nlayout(location=1) in vec2 TexCoords;\nlayout(location=2) flat in uint InstanceID;\nlayout(location=3) in float layerIndex;\nlayout(location=4) in float heightFactor;\nlayout(location=5) in vec4 ColorFromVertex;\n\nlayout(location=0) out vec4 FragColor;\n\nlayout(std140, binding=0) uniform Globals {\n    mat4 uProj;\n    mat4 uView;\n    mat4 uModel;\n\n    float uTime;\n    float uWaveAmp;\n    float uWaveSpeed;\n    int uPickedInstanceID;\n\n    vec4 uColor;\n\n    vec3 uBoundsMin;\n    float deltaX;\n    vec3 uBoundsMax;\n    float deltaY;\n};\n\nstruct Material {\n    sampler2D texture_diffuse1;\n    sampler2D texture_diffuse2;\n    sampler2D texture_diffuse3;\n};\nuniform Material material;\n\nvoid main() {\n    vec4 texColor;\n\n    float timeOffset = uTime * 0.1;\n    vec2 moving_coords = vec2(TexCoords.x - timeOffset, TexCoords.y);\n\n    int layerIdx = int(layerIndex + 0.5);\n    if (layerIdx == 0) {\n        texColor = texture(material.texture_diffuse1, moving_coords);\n    } else if (layerIdx == 1) {\n        texColor = texture(material.texture_diffuse2, moving_coords);\n    } else {\n        texColor = texture(material.texture_diffuse3, moving_coords);\n    }\n\n    if (texColor.r < 0.1 || texColor.g < 0.1 || texColor.b < 0.1) {\n        discard;\n    }\n\n    float brightness = dot(texColor.rgb, vec3(0.299, 0.587, 0.114));\n    texColor.a = smoothstep(0.0, 0.7, brightness);\n\n    if (uPickedInstanceID > 0 && abs(float(uPickedInstanceID) - float(InstanceID)) < 0.01) {\n\n        texColor.r -= deltaX * 0.1;\n        texColor.g -= deltaY * 0.1;\n        texColor.b -= deltaX * 0.1;\n    }\n\n    FragColor = texColor;\n}";
@@ -4,14 +4,14 @@
 #extension GL_ARB_separate_shader_objects : enable
 #extension GL_ARB_shading_language_420pack : enable
 
-#define INSTANCES_COUNT 4
-
 layout(location=0) in vec3 aPos;
 layout(location=1) in vec3 aNormal;
 layout(location=2) in vec2 aTexCoords;
 layout(location=5) in mat4 aInstanceMatrix;
 layout(location=9) in uint aInstanceId;
 layout(location=10) in vec4 aColor;
+// 每个实例的拖拽偏移 (xy), 随实例缓冲逐实例提供, 实例数量不受 UBO 大小限制
+layout(location=11) in vec4 aInstanceOffset;
 
 // UBO: 包含 MVP 矩阵
 layout(std140, binding=0) uniform Globals {
@@ -31,27 +31,31 @@ layout(std140, binding=0) uniform Globals {
     float deltaX;
     vec3 uBoundsMax;
     float deltaY;
-
-    // 每个实例的独立偏移数组
-    vec4 InstanceOffset[ INSTANCES_COUNT ];
 };
 
 // 输出到片段着色器
 layout(location=0) out vec3 FragPos;
 layout(location=1) out vec2 TexCoords;
-layout(location=2) out uint InstanceID;
+layout(location=2) flat out uint InstanceID;
 layout(location=3) out float layerIndex;
 layout(location=4) out float heightFactor;
 layout(location=5) out vec4 ColorFromVertex;
 
 // uniform sampler2D vertexMovementTexture;
 
+// 顶点位置反量化: Compact 顶点格式下 aPos 是相对 Mesh 包围盒归一化的 [0,1] 值
+// Full 格式下由 CPU 端设置为 scale = 1, offset = 0
+uniform vec3 uPosScale;
+uniform vec3 uPosOffset;
+
 void main() {
+    // 还原模型空间位置
+    vec3 modelPos = aPos * uPosScale + uPosOffset;
+
     // 将顶点位置和法线变换到世界空间
-    FragPos = vec3(aInstanceMatrix * vec4(aPos, 1.0));
+    FragPos = vec3(aInstanceMatrix * vec4(modelPos, 1.0));
     
     // 根据包围盒计算高度因子 用于判断层索引
-    vec3 modelPos = aPos;
     float heightRatio = ( modelPos.y - uBoundsMin.y ) / ( uBoundsMax.y - uBoundsMin.y );
     heightRatio = clamp( heightRatio, 0.0, 1.0 );
 
@@ -120,11 +124,8 @@ void main() {
     TexCoords = aTexCoords;
 
     // 应用每个实例的独立偏移
-    int instanceIndex = int(aInstanceId) - 1;
-    if (instanceIndex >= 0 && instanceIndex < 4) {
-        FragPos.x += InstanceOffset[instanceIndex].x  * TexCoords.x;
-        FragPos.y -= InstanceOffset[instanceIndex].y  * TexCoords.x;
-    }
+    FragPos.x += aInstanceOffset.x * TexCoords.x;
+    FragPos.y -= aInstanceOffset.y * TexCoords.x;
 
     gl_Position = uProj * uView * vec4(FragPos, 1.0);
 }
\ No newline at end of file
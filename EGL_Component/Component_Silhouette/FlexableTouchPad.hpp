@@ -25,6 +25,7 @@ public:
     {
         // 初始化着色器程序 片段着色器输出 ID
         mainProgram = std::make_unique<SilhouettesClass>();
+        mainModel.checkProgramAttributes("SilhouettesClass", mainProgram->activeAttributeMask());
         // 初始化离屏渲染 注意后面的参数 GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT
         mainFBO = std::make_unique<IntFBO>(m_width, m_height, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT);
         
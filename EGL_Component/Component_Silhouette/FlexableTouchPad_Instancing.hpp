@@ -29,6 +29,7 @@ public:
         {
         // 初始化着色器程序 片段着色器输出 ID
         mainProgram = std::make_unique<SilhouettesClass>();
+        mainModel.checkProgramAttributes("SilhouettesClass", mainProgram->activeAttributeMask());
         // 初始化离屏渲染 注意后面的参数 GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT
         mainFBO = std::make_unique<IntFBO>(m_width, m_height, GL_R32UI, GL_RED_INTEGER, GL_UNSIGNED_INT);
         
@@ -93,7 +94,7 @@ public:
         // 该类成员变量包含 m_globals 所以变换矩阵已经更新
         mainProgram->updateUBOData(g);
         #ifdef ENABLE_INSTANCING
-        const_cast<Model&>(mainModel).DrawInstanced(mainProgram->handle(), INSTANCES_COUNT);
+        const_cast<Model&>(mainModel).DrawInstanced(mainProgram->handle(), mainModel.drawInstanceCount());   // 与主绘制一致, 只绘制视锥内的实例
         #else
         mainModel.Draw(mainProgram->handle());
         #endif
@@ -146,11 +147,6 @@ public:
         }
     }
 
-    void updatePadGlobalInstanceOffsetArray( InstanceOffset* offset ) {
-        memcpy(g.instanceOffsets, offset, 
-                sizeof(InstanceOffset) * INSTANCES_COUNT);
-    }
-
 private:
     int m_width, m_height;
     Globals& g;
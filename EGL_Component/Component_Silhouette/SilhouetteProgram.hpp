@@ -1,5 +1,6 @@
 #pragma once
 #include "ShaderProgram.hpp"
+#include "VertexLayout.hpp"
 #include "LyFBO.h"
 #include "UniformBuffer.hpp"
 #include "GlobalBindingPoints.hpp"
@@ -14,6 +15,9 @@
 
 class SilhouettesClass : public ShaderProgram {
 public:
+    // 拾取 pass 只读位置
+    static constexpr uint32_t kVertexAttributes = VertexAttrib::Position;
+
     SilhouettesClass() : ShaderProgram(vertex_shader, frag_shader) {
         blockIndex = glGetUniformBlockIndex(handle(), "Globals");
         m_uboClass = std::make_unique<UniformBuffer>( sizeof( Globals), UboBindingPoints::Globals );
@@ -52,6 +56,10 @@ private:
             uint id;
         };
 
+        // 顶点位置反量化 (与 wind.vert.glsl 一致)
+        uniform vec3 uPosScale;
+        uniform vec3 uPosOffset;
+
         out vec2 TexCoords;
         flat out uint instanceID;
         
@@ -59,7 +67,7 @@ private:
         {
             instanceID = id;
             // 先计算变换后的位置
-            vec4 worldPos = modelMatrix * vec4(aPos, 1.0);
+            vec4 worldPos = modelMatrix * vec4(aPos * uPosScale + uPosOffset, 1.0);
             // 正常变换
             gl_Position = projMatrix * viewMatrix * worldPos;
         }
@@ -94,6 +102,10 @@ private:
             uint id;
         };
 
+        // 顶点位置反量化 (与 wind.vert.glsl 一致)
+        uniform vec3 uPosScale;
+        uniform vec3 uPosOffset;
+
         out vec2 TexCoords;
         flat out uint instanceID;
         
@@ -101,7 +113,7 @@ private:
         {
             instanceID = id;
             // 先计算变换后的位置
-            vec4 worldPos = modelMatrix * vec4(aPos, 1.0);
+            vec4 worldPos = modelMatrix * vec4(aPos * uPosScale + uPosOffset, 1.0);
             // 正常变换
             gl_Position = projMatrix * viewMatrix * worldPos;
         }
@@ -1,5 +1,6 @@
 #pragma once
 #include "ShaderProgram.hpp"
+#include "VertexLayout.hpp"
 #include "LyFBO.h"
 #include "UniformBuffer.hpp"
 #include "GlobalBindingPoints.hpp"
@@ -14,6 +15,9 @@
 
 class SilhouettesClass : public ShaderProgram {
 public:
+    // 拾取 pass 只读位置与纹理坐标 (alpha 裁剪), 正好是属性流 0
+    static constexpr uint32_t kVertexAttributes = VertexAttrib::Position | VertexAttrib::TexCoord;
+
     SilhouettesClass() : ShaderProgram(vertex_shader, frag_shader) {
         blockIndex = glGetUniformBlockIndex(handle(), "Globals");
         m_uboClass = std::make_unique<UniformBuffer>( sizeof( Globals), UboBindingPoints::Globals );
@@ -37,22 +41,19 @@ private:
     constexpr static const char* vertex_shader = R"(
         #version 310 es
         precision mediump float;
-        #define INSTANCES_COUNT 4
         layout (location = 0) in vec3 aPos;
         layout (location = 2) in vec2 aTexCoords;
         // layout (location = 2) in vec3 aNormal;
         // layout (location = 3) in mat4 instanceTransform;
         layout (location = 5) in mat4 aInstanceMatrix;
         layout (location = 9) in uint aInstanceId;
+        layout (location = 11) in vec4 aInstanceOffset;   // 每个实例的拖拽偏移 (xy), 与 wind.vert.glsl 一致
 
         layout(std140) uniform Globals {
             mat4 modelMatrix;
             mat4 viewMatrix;
             mat4 projMatrix;
 
-            // 每个实例的独立偏移数组
-            vec4 InstanceOffset[ INSTANCES_COUNT ];
-
             // 新增字段
             int pickedInstanceID;
             float deltaX;
@@ -65,6 +66,10 @@ private:
         // 纹理在OpenGL中是全局加载 所以此处可以直接读取
         uniform sampler2D vertexMovementTexture;
 
+        // 顶点位置反量化 (与 wind.vert.glsl 一致)
+        uniform vec3 uPosScale;
+        uniform vec3 uPosOffset;
+
         
         flat out uint instanceID;
         
@@ -74,23 +79,16 @@ private:
             vec2 TexCoords = aTexCoords;
             vec3 FragPos;
             // 将顶点位置和法线变换到世界空间
-            FragPos = vec3(aInstanceMatrix * vec4(aPos, 1.0));
+            FragPos = vec3(aInstanceMatrix * vec4(aPos * uPosScale + uPosOffset, 1.0));
 
             // // 应用每个实例的独立偏移
-            // int instanceIndex = int(aInstanceId) - 1;  // 实例ID从1开始，数组索引从0开始
-            // if (instanceIndex >= 0 && instanceIndex < INSTANCES_COUNT) {
-            //     // 使用该实例的独立偏移
-            //     vec4 movementData = texture( vertexMovementTexture, TexCoords );
-            //     float movementFactor = (movementData.r + movementData.g + movementData.b) * 0.33333333;
-            //     FragPos.x += InstanceOffset[instanceIndex].x * movementFactor;
-            //     FragPos.y -= InstanceOffset[instanceIndex].y * movementFactor;  // Y轴方向相反
-            // }
+            // vec4 movementData = texture( vertexMovementTexture, TexCoords );
+            // float movementFactor = (movementData.r + movementData.g + movementData.b) * 0.33333333;
+            // FragPos.x += aInstanceOffset.x * movementFactor;
+            // FragPos.y -= aInstanceOffset.y * movementFactor;  // Y轴方向相反
                 // 应用每个实例的独立偏移
-                int instanceIndex = int(aInstanceId) - 1;
-                if (instanceIndex >= 0 && instanceIndex < 4) {
-                    FragPos.x += InstanceOffset[instanceIndex].x  * TexCoords.x;
-                    FragPos.y -= InstanceOffset[instanceIndex].y  * TexCoords.x;
-                }
+                FragPos.x += aInstanceOffset.x * TexCoords.x;
+                FragPos.y -= aInstanceOffset.y * TexCoords.x;
 
             gl_Position = projMatrix * viewMatrix * vec4(FragPos, 1.0);
         }
@@ -111,22 +109,19 @@ private:
     #else
     constexpr static const char* vertex_shader = R"(
         #version 330 core
-        #define INSTANCES_COUNT 4
         layout (location = 0) in vec3 aPos;
         layout (location = 2) in vec2 aTexCoords;
         // layout (location = 2) in vec3 aNormal;
         // layout (location = 3) in mat4 instanceTransform;
         layout (location = 5) in mat4 aInstanceMatrix;
         layout (location = 9) in uint aInstanceId;
+        layout (location = 11) in vec4 aInstanceOffset;   // 每个实例的拖拽偏移 (xy), 与 wind.vert.glsl 一致
 
         layout(std140) uniform Globals {
             mat4 modelMatrix;
             mat4 viewMatrix;
             mat4 projMatrix;
 
-            // 每个实例的独立偏移数组
-            vec4 InstanceOffset[ INSTANCES_COUNT ];
-
             // 新增字段
             int pickedInstanceID;
             float deltaX;
@@ -139,6 +134,10 @@ private:
         // 纹理在OpenGL中是全局加载 所以此处可以直接读取
         uniform sampler2D vertexMovementTexture;
 
+        // 顶点位置反量化 (与 wind.vert.glsl 一致)
+        uniform vec3 uPosScale;
+        uniform vec3 uPosOffset;
+
         
         flat out uint instanceID;
         
@@ -148,23 +147,16 @@ private:
             vec2 TexCoords = aTexCoords;
             vec3 FragPos;
             // 将顶点位置和法线变换到世界空间
-            FragPos = vec3(aInstanceMatrix * vec4(aPos, 1.0));
+            FragPos = vec3(aInstanceMatrix * vec4(aPos * uPosScale + uPosOffset, 1.0));
 
             // // 应用每个实例的独立偏移
-            // int instanceIndex = int(aInstanceId) - 1;  // 实例ID从1开始，数组索引从0开始
-            // if (instanceIndex >= 0 && instanceIndex < INSTANCES_COUNT) {
-            //     // 使用该实例的独立偏移
-            //     vec4 movementData = texture( vertexMovementTexture, TexCoords );
-            //     float movementFactor = (movementData.r + movementData.g + movementData.b) * 0.33333333;
-            //     FragPos.x += InstanceOffset[instanceIndex].x * movementFactor;
-            //     FragPos.y -= InstanceOffset[instanceIndex].y * movementFactor;  // Y轴方向相反
-            // }
+            // vec4 movementData = texture( vertexMovementTexture, TexCoords );
+            // float movementFactor = (movementData.r + movementData.g + movementData.b) * 0.33333333;
+            // FragPos.x += aInstanceOffset.x * movementFactor;
+            // FragPos.y -= aInstanceOffset.y * movementFactor;  // Y轴方向相反
                 // 应用每个实例的独立偏移
-                int instanceIndex = int(aInstanceId) - 1;
-                if (instanceIndex >= 0 && instanceIndex < 4) {
-                    FragPos.x += InstanceOffset[instanceIndex].x  * TexCoords.x;
-                    FragPos.y -= InstanceOffset[instanceIndex].y  * TexCoords.x;
-                }
+                FragPos.x += aInstanceOffset.x * TexCoords.x;
+                FragPos.y -= aInstanceOffset.y * TexCoords.x;
 
             gl_Position = projMatrix * viewMatrix * vec4(FragPos, 1.0);
         }
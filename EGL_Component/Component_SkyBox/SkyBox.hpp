@@ -15,7 +15,8 @@
 #include <string>
 #include <iostream>
 #include <memory>
-#include "stb_image.h"
+#include <array>
+#include "TextureLoader.hpp"
 #include "SkyBoxShader.hpp"
 #include "macros.h"
 
@@ -24,7 +25,7 @@ class Skybox
   public:
     Skybox(std::string model_dir)
     {
-        std::vector<std::string> faces
+        std::array<std::string, 6> faces
         {
             model_dir+"/skybox/"+"right.jpg",
             model_dir+"/skybox/"+"left.jpg",
@@ -34,7 +35,7 @@ class Skybox
             model_dir+"/skybox/"+"back.jpg"
         };
         mShader = std::make_unique<SkyBoxShader>();
-        // 加载 cube texture的+X,-X,+Y,-Y,+Z,-Z方向的6个面
+        // 加载 cube texture的+X,-X,+Y,-Y,+Z,-Z方向的6个面 (6 个面在线程池中并行解码, 上传在后续帧完成)
         loadCubemap(faces);
         // 加载 skybox 的顶点、顶点纹理坐标信息，设置 VAO, VBO
         setupMesh();
@@ -50,7 +51,7 @@ class Skybox
         mShader->setMat4("view", view);
         glBindVertexArray(skyboxVAO);
         glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_CUBE_MAP, cubemapTexture);
+        glBindTexture(GL_TEXTURE_CUBE_MAP, mCubemap.id());
         glDrawArrays(GL_TRIANGLES, 0, 36);
         glBindVertexArray(0);
         glDepthFunc(GL_LESS); // set depth function back to default
@@ -59,7 +60,7 @@ class Skybox
   private:
     // render data
     unsigned int skyboxVAO, skyboxVBO;
-    unsigned int cubemapTexture;
+    TextureLoader::Handle mCubemap;
     const float skyboxVertices[108] = {
         // positions          
         -1.0f,  1.0f, -1.0f,
@@ -106,38 +107,16 @@ class Skybox
     };
     std::unique_ptr<SkyBoxShader> mShader;
 
-    void loadCubemap(std::vector<std::string> faces)
+    void loadCubemap(const std::array<std::string, 6>& faces)
     {
-        
-        // 生成一个 cube map 纹理
-        glGenTextures(1, &cubemapTexture);
-        // 绑定该纹理
-        glBindTexture(GL_TEXTURE_CUBE_MAP, cubemapTexture);
-
-        int width, height, nrChannels;
-        // 加载纹理图片
-        for (unsigned int i = 0; i < faces.size(); i++)
-        {
-            // right(+X), left(-X), top(+Y), bottom(-Y), front(+Z), back(-Z)
-            unsigned char *data = stbi_load(faces[i].c_str(), &width, &height, &nrChannels, 0);
-            if (data)
-            {
-                glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGB, width, height, 0, GL_RGB, GL_UNSIGNED_BYTE,
-                             data);
-                stbi_image_free(data);
-            }
-            else
-            {
-                // std::cout << "Cubemap texture failed to load at path: " << faces[i] << std::endl;
-                LOGI("Cubemap texture failed to load at path: %s", faces[i].c_str());
-                stbi_image_free(data);
-            }
-        }
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_CUBE_MAP, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+        // right(+X), left(-X), top(+Y), bottom(-Y), front(+Z), back(-Z)
+        TextureLoader::Options options;
+        options.generateMipmap = false;
+        options.wrapS     = GL_CLAMP_TO_EDGE;
+        options.wrapT     = GL_CLAMP_TO_EDGE;
+        options.minFilter = GL_LINEAR;
+        options.magFilter = GL_LINEAR;
+        mCubemap = TextureLoader::getInstance().loadCubemap(faces, options);
     }
 
     // initializes all the buffer objects/arrays
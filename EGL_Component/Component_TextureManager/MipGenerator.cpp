@@ -0,0 +1,345 @@
+#include "MipGenerator.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#include "macros.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define WIND_MIP_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define WIND_MIP_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace {
+
+    // 工作空间: 每个通道 14bit (0..16383), 4 个样本之和不超过 uint16 范围
+    constexpr int kWorkMax = 16383;
+
+    struct Tables {
+        uint16_t srgbToLinear[256];
+        uint16_t unormToWork[256];
+        uint8_t  linearToSrgb[kWorkMax + 1];
+        uint8_t  workToUnorm[kWorkMax + 1];
+
+        Tables() {
+            for (int v = 0; v < 256; ++v) {
+                const double c = v / 255.0;
+                const double linear = c <= 0.04045 ? c / 12.92 : std::pow((c + 0.055) / 1.055, 2.4);
+                srgbToLinear[v] = static_cast<uint16_t>(std::lround(linear * kWorkMax));
+                // 与向量化路径的 (v << 6) | (v >> 2) 完全一致
+                unormToWork[v] = static_cast<uint16_t>((v << 6) | (v >> 2));
+            }
+            for (int i = 0; i <= kWorkMax; ++i) {
+                const double linear = static_cast<double>(i) / kWorkMax;
+                const double c = linear <= 0.0031308 ? linear * 12.92 : 1.055 * std::pow(linear, 1.0 / 2.4) - 0.055;
+                linearToSrgb[i] = static_cast<uint8_t>(std::min(255L, std::lround(c * 255.0)));
+                workToUnorm[i]  = static_cast<uint8_t>(std::lround(i * 255.0 / kWorkMax));
+            }
+        }
+    };
+
+    const Tables& tables() {
+        static const Tables instance;
+        return instance;
+    }
+
+    // RGB 在工作空间中按 4 通道存放 (第 4 通道恒为 0), 这样 1/2/4 个 uint16 对应一个像素, 便于向量化
+    inline int workLanes(int channels) {
+        return channels == 3 ? 4 : channels;
+    }
+
+    // 灰度/RGB 的前 1/3 个通道为颜色; 灰度+Alpha 与 RGBA 的最后一个通道为 Alpha
+    inline bool isColorChannel(int channel, int channels) {
+        return channels == 1 || channels == 3 || channel < channels - 1;
+    }
+
+    void decodeRow(const unsigned char* src, int width, int channels, bool srgb, uint16_t* out, bool simd) {
+        const Tables& t = tables();
+        const int lanes = workLanes(channels);
+        int x = 0;
+        (void)simd;
+#if defined(WIND_MIP_SSE2)
+        // 线性数据且布局一致 (1/2/4 通道) 时直接 8bit -> 14bit 扩展
+        if (simd && !srgb && channels != 3) {
+            const int count = width * channels;
+            const __m128i zero = _mm_setzero_si128();
+            int i = 0;
+            for (; i + 16 <= count; i += 16) {
+                const __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                const __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+                const __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_or_si128(_mm_slli_epi16(lo, 6), _mm_srli_epi16(lo, 2)));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8), _mm_or_si128(_mm_slli_epi16(hi, 6), _mm_srli_epi16(hi, 2)));
+            }
+            x = i / channels;
+        }
+#elif defined(WIND_MIP_NEON)
+        if (simd && !srgb && channels != 3) {
+            const int count = width * channels;
+            int i = 0;
+            for (; i + 8 <= count; i += 8) {
+                const uint16x8_t wide = vmovl_u8(vld1_u8(src + i));
+                vst1q_u16(out + i, vorrq_u16(vshlq_n_u16(wide, 6), vshrq_n_u16(wide, 2)));
+            }
+            x = i / channels;
+        }
+#endif
+        for (; x < width; ++x) {
+            const unsigned char* p = src + static_cast<size_t>(x) * channels;
+            uint16_t* w = out + static_cast<size_t>(x) * lanes;
+            for (int c = 0; c < channels; ++c) {
+                w[c] = (srgb && isColorChannel(c, channels)) ? t.srgbToLinear[p[c]] : t.unormToWork[p[c]];
+            }
+            if (lanes != channels) w[3] = 0;
+        }
+    }
+
+    void encodeRow(const uint16_t* work, int width, int channels, bool srgb, unsigned char* out) {
+        const Tables& t = tables();
+        const int lanes = workLanes(channels);
+        for (int x = 0; x < width; ++x) {
+            const uint16_t* w = work + static_cast<size_t>(x) * lanes;
+            unsigned char* p = out + static_cast<size_t>(x) * channels;
+            for (int c = 0; c < channels; ++c) {
+                p[c] = (srgb && isColorChannel(c, channels)) ? t.linearToSrgb[w[c]] : t.workToUnorm[w[c]];
+            }
+        }
+    }
+
+    // 2x2 归约一行: out[x] = (r0[2x] + r0[2x+1] + r1[2x] + r1[2x+1] + 2) >> 2
+    void reduceRowScalar(const uint16_t* r0, const uint16_t* r1, int srcWidth, int lanes, uint16_t* out, int from) {
+        const int outWidth = std::max(srcWidth / 2, 1);
+        for (int x = from; x < outWidth; ++x) {
+            const int x0 = std::min(2 * x, srcWidth - 1);
+            const int x1 = std::min(2 * x + 1, srcWidth - 1);
+            for (int c = 0; c < lanes; ++c) {
+                const uint32_t sum = r0[x0 * lanes + c] + r0[x1 * lanes + c] + r1[x0 * lanes + c] + r1[x1 * lanes + c];
+                out[x * lanes + c] = static_cast<uint16_t>((sum + 2) >> 2);
+            }
+        }
+    }
+
+    void reduceRow(const uint16_t* r0, const uint16_t* r1, int srcWidth, int lanes, uint16_t* out, bool simd) {
+        const int outWidth = std::max(srcWidth / 2, 1);
+        int x = 0;
+        (void)simd;
+        // srcWidth == 1 时需要复制边缘, 交给标量路径
+        if (simd && srcWidth >= 2) {
+#if defined(WIND_MIP_SSE2)
+            const __m128i two = _mm_set1_epi16(2);
+            if (lanes == 4) {
+                // 每个寄存器 2 个像素: 竖直相加后, 交换 64 位半区再相加得到 2 个输出
+                for (; x + 2 <= outWidth; x += 2) {
+                    const size_t o = static_cast<size_t>(x) * 8;
+                    const __m128i a = _mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(r0 + o)),
+                                                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(r1 + o)));
+                    const __m128i b = _mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(r0 + o + 8)),
+                                                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(r1 + o + 8)));
+                    const __m128i sum = _mm_add_epi16(_mm_unpacklo_epi64(a, b), _mm_unpackhi_epi64(a, b));
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x * 4), _mm_srli_epi16(_mm_add_epi16(sum, two), 2));
+                }
+            } else if (lanes == 2) {
+                // 每个像素 32 位: 按奇偶像素拆分后相加, 一次得到 4 个输出
+                for (; x + 4 <= outWidth; x += 4) {
+                    const size_t o = static_cast<size_t>(x) * 4;
+                    const __m128i a = _mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(r0 + o)),
+                                                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(r1 + o)));
+                    const __m128i b = _mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(r0 + o + 8)),
+                                                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(r1 + o + 8)));
+                    const __m128 af = _mm_castsi128_ps(a);
+                    const __m128 bf = _mm_castsi128_ps(b);
+                    const __m128i even = _mm_castps_si128(_mm_shuffle_ps(af, bf, _MM_SHUFFLE(2, 0, 2, 0)));
+                    const __m128i odd  = _mm_castps_si128(_mm_shuffle_ps(af, bf, _MM_SHUFFLE(3, 1, 3, 1)));
+                    const __m128i sum = _mm_add_epi16(even, odd);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x * 2), _mm_srli_epi16(_mm_add_epi16(sum, two), 2));
+                }
+            } else if (lanes == 1) {
+                // 相邻两个 uint16 在 32 位通道内相加, 移位后不超过 14bit, 可以有符号打包回 16 位
+                const __m128i low16 = _mm_set1_epi32(0xFFFF);
+                const __m128i two32 = _mm_set1_epi32(2);
+                for (; x + 8 <= outWidth; x += 8) {
+                    const size_t o = static_cast<size_t>(x) * 2;
+                    const __m128i a = _mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(r0 + o)),
+                                                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(r1 + o)));
+                    const __m128i b = _mm_add_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(r0 + o + 8)),
+                                                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(r1 + o + 8)));
+                    const __m128i sa = _mm_add_epi32(_mm_and_si128(a, low16), _mm_srli_epi32(a, 16));
+                    const __m128i sb = _mm_add_epi32(_mm_and_si128(b, low16), _mm_srli_epi32(b, 16));
+                    const __m128i ra = _mm_srli_epi32(_mm_add_epi32(sa, two32), 2);
+                    const __m128i rb = _mm_srli_epi32(_mm_add_epi32(sb, two32), 2);
+                    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x), _mm_packs_epi32(ra, rb));
+                }
+            }
+#elif defined(WIND_MIP_NEON)
+            if (lanes == 4) {
+                for (; x + 2 <= outWidth; x += 2) {
+                    const size_t o = static_cast<size_t>(x) * 8;
+                    const uint16x8_t a = vaddq_u16(vld1q_u16(r0 + o), vld1q_u16(r1 + o));
+                    const uint16x8_t b = vaddq_u16(vld1q_u16(r0 + o + 8), vld1q_u16(r1 + o + 8));
+                    const uint16x4_t sa = vadd_u16(vget_low_u16(a), vget_high_u16(a));
+                    const uint16x4_t sb = vadd_u16(vget_low_u16(b), vget_high_u16(b));
+                    // vrshr: (x + 2) >> 2, 与标量路径一致
+                    vst1q_u16(out + x * 4, vrshrq_n_u16(vcombine_u16(sa, sb), 2));
+                }
+            } else if (lanes == 2) {
+                for (; x + 4 <= outWidth; x += 4) {
+                    const size_t o = static_cast<size_t>(x) * 4;
+                    const uint16x8_t a = vaddq_u16(vld1q_u16(r0 + o), vld1q_u16(r1 + o));
+                    const uint16x8_t b = vaddq_u16(vld1q_u16(r0 + o + 8), vld1q_u16(r1 + o + 8));
+                    const uint32x4x2_t pixels = vuzpq_u32(vreinterpretq_u32_u16(a), vreinterpretq_u32_u16(b));
+                    const uint16x8_t sum = vaddq_u16(vreinterpretq_u16_u32(pixels.val[0]), vreinterpretq_u16_u32(pixels.val[1]));
+                    vst1q_u16(out + x * 2, vrshrq_n_u16(sum, 2));
+                }
+            } else if (lanes == 1) {
+                for (; x + 8 <= outWidth; x += 8) {
+                    const size_t o = static_cast<size_t>(x) * 2;
+                    const uint16x8_t a = vaddq_u16(vld1q_u16(r0 + o), vld1q_u16(r1 + o));
+                    const uint16x8_t b = vaddq_u16(vld1q_u16(r0 + o + 8), vld1q_u16(r1 + o + 8));
+                    vst1q_u16(out + x, vcombine_u16(vrshrn_n_u32(vpaddlq_u16(a), 2), vrshrn_n_u32(vpaddlq_u16(b), 2)));
+                }
+            }
+#endif
+        }
+        reduceRowScalar(r0, r1, srcWidth, lanes, out, x);
+    }
+
+    // 工作空间图像之间的单级归约
+    void reduceImage(const std::vector<uint16_t>& src, int width, int height, int lanes,
+                     std::vector<uint16_t>& dst, bool simd) {
+        const int outWidth  = std::max(width / 2, 1);
+        const int outHeight = std::max(height / 2, 1);
+        dst.resize(static_cast<size_t>(outWidth) * outHeight * lanes);
+        for (int y = 0; y < outHeight; ++y) {
+            const uint16_t* r0 = src.data() + static_cast<size_t>(std::min(2 * y, height - 1)) * width * lanes;
+            const uint16_t* r1 = src.data() + static_cast<size_t>(std::min(2 * y + 1, height - 1)) * width * lanes;
+            reduceRow(r0, r1, width, lanes, dst.data() + static_cast<size_t>(y) * outWidth * lanes, simd);
+        }
+    }
+
+    // 8bit 源图直接流式归约到工作空间, 避免把整张 level 0 展开成 16bit
+    void reduceSource(const unsigned char* pixels, int width, int height, int channels, bool srgb,
+                      std::vector<uint16_t>& dst, bool simd) {
+        const int lanes = workLanes(channels);
+        const int outWidth  = std::max(width / 2, 1);
+        const int outHeight = std::max(height / 2, 1);
+        const size_t rowBytes = static_cast<size_t>(width) * channels;
+        std::vector<uint16_t> row0(static_cast<size_t>(width) * lanes);
+        std::vector<uint16_t> row1(static_cast<size_t>(width) * lanes);
+        dst.resize(static_cast<size_t>(outWidth) * outHeight * lanes);
+        for (int y = 0; y < outHeight; ++y) {
+            decodeRow(pixels + rowBytes * std::min(2 * y, height - 1), width, channels, srgb, row0.data(), simd);
+            decodeRow(pixels + rowBytes * std::min(2 * y + 1, height - 1), width, channels, srgb, row1.data(), simd);
+            reduceRow(row0.data(), row1.data(), width, lanes, dst.data() + static_cast<size_t>(y) * outWidth * lanes, simd);
+        }
+    }
+
+    void encodeImage(const std::vector<uint16_t>& work, int width, int height, int channels, bool srgb, unsigned char* out) {
+        const int lanes = workLanes(channels);
+        for (int y = 0; y < height; ++y) {
+            encodeRow(work.data() + static_cast<size_t>(y) * width * lanes, width, channels, srgb,
+                      out + static_cast<size_t>(y) * width * channels);
+        }
+    }
+
+} // namespace
+
+namespace MipGenerator {
+
+bool simdAvailable() {
+#if defined(WIND_MIP_SSE2) || defined(WIND_MIP_NEON)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void downsample(const unsigned char* src, int width, int height, int channels, bool srgb,
+                unsigned char* dst, bool simd) {
+    std::vector<uint16_t> work;
+    reduceSource(src, width, height, channels, srgb, work, simd);
+    encodeImage(work, std::max(width / 2, 1), std::max(height / 2, 1), channels, srgb, dst);
+}
+
+bool generate(const unsigned char* pixels, int width, int height, int channels, bool srgb,
+              std::vector<Level>& outLevels, bool simd) {
+    outLevels.clear();
+    if (!pixels || width <= 0 || height <= 0 || channels < 1 || channels > 4) return false;
+
+    // 后续层级在 14bit 工作空间中继续归约, 不经过 8bit 量化, 也不重复查表解码
+    const int lanes = workLanes(channels);
+    std::vector<uint16_t> current;
+    std::vector<uint16_t> next;
+    int levelWidth = width;
+    int levelHeight = height;
+    while (levelWidth > 1 || levelHeight > 1) {
+        if (outLevels.empty()) {
+            reduceSource(pixels, levelWidth, levelHeight, channels, srgb, next, simd);
+        } else {
+            reduceImage(current, levelWidth, levelHeight, lanes, next, simd);
+        }
+        levelWidth  = std::max(levelWidth / 2, 1);
+        levelHeight = std::max(levelHeight / 2, 1);
+        current.swap(next);
+
+        Level level;
+        level.width  = levelWidth;
+        level.height = levelHeight;
+        level.pixels.resize(static_cast<size_t>(levelWidth) * levelHeight * channels);
+        encodeImage(current, levelWidth, levelHeight, channels, srgb, level.pixels.data());
+        outLevels.push_back(std::move(level));
+    }
+    return true;
+}
+
+BenchmarkResult benchmark(int width, int height, int channels, bool srgb, int iterations) {
+    BenchmarkResult result;
+    if (width <= 0 || height <= 0 || channels < 1 || channels > 4 || iterations <= 0) return result;
+
+    // 带噪声的渐变, 避免全部命中相同的查表项
+    std::vector<unsigned char> image(static_cast<size_t>(width) * height * channels);
+    uint32_t seed = 0x9E3779B9u;
+    for (size_t i = 0; i < image.size(); ++i) {
+        seed = seed * 1664525u + 1013904223u;
+        image[i] = static_cast<unsigned char>((i / channels % width) * 255 / width / 2 + (seed >> 25));
+    }
+
+    auto run = [&](bool simd, std::vector<Level>& levels) {
+        auto start = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            generate(image.data(), width, height, channels, srgb, levels, simd);
+        }
+        const double seconds = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start).count();
+        return seconds > 0.0 ? static_cast<double>(width) * height * iterations / seconds / 1.0e6 : 0.0;
+    };
+
+    std::vector<Level> scalarLevels;
+    std::vector<Level> simdLevels;
+    result.scalarMPixelsPerSecond = run(false, scalarLevels);
+    result.simdMPixelsPerSecond   = run(true, simdLevels);
+
+    result.identical = scalarLevels.size() == simdLevels.size();
+    for (size_t i = 0; result.identical && i < scalarLevels.size(); ++i) {
+        result.identical = scalarLevels[i].pixels == simdLevels[i].pixels;
+    }
+
+    LOGI("MipGenerator benchmark %dx%d x%d %s: scalar %.1f MPix/s, %s %.1f MPix/s (%.2fx), outputs %s",
+         width, height, channels, srgb ? "sRGB" : "linear", result.scalarMPixelsPerSecond,
+#if defined(WIND_MIP_SSE2)
+         "SSE2",
+#elif defined(WIND_MIP_NEON)
+         "NEON",
+#else
+         "scalar",
+#endif
+         result.simdMPixelsPerSecond,
+         result.scalarMPixelsPerSecond > 0.0 ? result.simdMPixelsPerSecond / result.scalarMPixelsPerSecond : 0.0,
+         result.identical ? "identical" : "DIFFER");
+    return result;
+}
+
+} // namespace MipGenerator
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// 置 1 后在 ModelRenderer 初始化时运行一次 MipGenerator::benchmark 并输出日志
+#define MIP_BENCHMARK_ON_STARTUP 0
+
+/**
+ * @brief CPU mip 链生成 (工作线程使用, 替代渲染线程上的 glGenerateMipmap)
+ *
+ * - 支持 1~4 通道 8bit 图像, 每级 2x2 盒式滤波, 奇数边缘复制最后一行/列
+ * - srgb = true 时颜色通道先按 sRGB 曲线转到线性空间 (14bit) 再平均, 结果再编码回 sRGB;
+ *   Alpha 通道与 srgb = false 的图像 (法线、遮罩) 始终线性平均
+ * - 2x2 归约使用 SSE2 (x86) / NEON (ARM) 实现, 其它平台及 simd = false 时走标量路径, 两者结果逐字节一致
+ */
+namespace MipGenerator {
+
+    struct Level {
+        int width  = 0;
+        int height = 0;
+        std::vector<unsigned char> pixels;  // 紧密排列, 通道数与源图相同
+    };
+
+    // 当前编译目标是否有向量化实现
+    bool simdAvailable();
+
+    /**
+     * @brief 生成 level 1 .. 1x1 的所有层级 (不含 level 0)
+     * @return false 参数无效
+     */
+    bool generate(const unsigned char* pixels, int width, int height, int channels, bool srgb,
+                  std::vector<Level>& outLevels, bool simd = true);
+
+    // 单级缩小: dst 需要 max(w/2,1) * max(h/2,1) * channels 字节
+    void downsample(const unsigned char* src, int width, int height, int channels, bool srgb,
+                    unsigned char* dst, bool simd = true);
+
+    struct BenchmarkResult {
+        double scalarMPixelsPerSecond = 0.0;
+        double simdMPixelsPerSecond   = 0.0;
+        bool   identical              = false;  // 两条路径输出是否逐字节一致
+    };
+
+    /**
+     * @brief 用合成图像比较标量与向量化路径的吞吐 (按源图像素计), 结果写入日志
+     */
+    BenchmarkResult benchmark(int width = 2048, int height = 2048, int channels = 4, bool srgb = true, int iterations = 8);
+
+} // namespace MipGenerator
@@ -0,0 +1,245 @@
+#include "TextureCache.hpp"
+
+#include <filesystem>
+
+#include "VirtualFileSystem.hpp"
+
+TextureCache& TextureCache::getInstance() {
+    static TextureCache instance;
+    return instance;
+}
+
+// 先构造 TextureLoader, 保证其在本单例之后析构 (静态对象按构造完成的逆序析构)
+TextureCache::TextureCache() {
+    TextureLoader::getInstance();
+}
+
+// ---------------------------------------------------------------------------
+// Ref / Record
+// ---------------------------------------------------------------------------
+
+GLuint TextureCache::Ref::id() const {
+    return m_record ? m_record->handle.id() : 0;
+}
+
+const TextureLoader::Handle& TextureCache::Ref::handle() const {
+    static const TextureLoader::Handle kEmpty;
+    return m_record ? m_record->handle : kEmpty;
+}
+
+// 最后一个 Ref 释放 (可能在任意线程): 交给 GL 线程删除
+TextureCache::Record::~Record() {
+    if (owner) owner->retire(*this);
+}
+
+void TextureCache::retire(Record& record) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_records.find(record.contentKey);
+    // 同一内容可能已被重新加载为新的条目, 只移除已失效的那一个
+    if (it != m_records.end() && it->second.expired()) {
+        m_records.erase(it);
+    }
+    m_retiredBytesSaved += record.hits.load() * record.handle.gpuBytes();
+    m_retired.push_back(record.handle);
+}
+
+// ---------------------------------------------------------------------------
+// 获取
+// ---------------------------------------------------------------------------
+
+TextureCache::Ref TextureCache::acquire(const std::string& path, const Options& options) {
+    const std::string canonical = canonicalPath(path);
+    const uint64_t optionBits = optionsKey(options);
+    const std::string pathKey = canonical + "#" + std::to_string(optionBits);
+
+    // 包内条目的修改时间为烘焙时源文件的修改时间
+    uint64_t fileSize = 0;
+    int64_t fileMTime = 0;
+    VirtualFileSystem::getInstance().stat(canonical, fileSize, fileMTime);
+
+    uint64_t contentKey = 0;
+    bool pathKnown = false;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_requests;
+        auto it = m_pathIndex.find(pathKey);
+        if (it != m_pathIndex.end() && it->second.fileSize == fileSize && it->second.fileMTime == fileMTime) {
+            contentKey = it->second.contentKey;
+            pathKnown = true;
+        }
+    }
+
+    // 新路径 (或文件已变化): 对文件内容做哈希, 不同路径的相同图像由此合并
+    if (!pathKnown) {
+        AssetFile file;
+        if (file.open(canonical)) {
+            contentKey = hashBytes(file.data(), file.size(), optionBits);
+        } else {
+            // 文件不存在: 按路径去重, 加载失败的日志只出现一次
+            contentKey = hashBytes(reinterpret_cast<const unsigned char*>(canonical.data()), canonical.size(), ~optionBits);
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_pathIndex[pathKey] = { contentKey, fileSize, fileMTime };
+    }
+
+    return acquireByContent(contentKey, canonical, pathKnown, [&canonical, &options]() {
+        return TextureLoader::getInstance().load2D(canonical, options);
+    });
+}
+
+TextureCache::Ref TextureCache::acquireFromMemory(const std::string& label, const unsigned char* data, size_t size,
+                                                  const Options& options) {
+    const uint64_t contentKey = hashBytes(data, size, optionsKey(options));
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_requests;
+    }
+    return acquireByContent(contentKey, label, false, [&]() {
+        return TextureLoader::getInstance().load2DFromMemory(label, data, size, options, std::to_string(contentKey));
+    });
+}
+
+TextureCache::Ref TextureCache::acquireByContent(uint64_t contentKey, const std::string& label, bool pathHit,
+                                                 const std::function<TextureLoader::Handle()>& load) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_records.find(contentKey);
+    if (it != m_records.end()) {
+        std::shared_ptr<Record> existing = it->second.lock();
+        if (existing) {
+            ++(pathHit ? m_pathHits : m_contentHits);
+            existing->hits.fetch_add(1);
+            if (!pathHit) {
+                LOGI("TextureCache: %s shares content with %s", label.c_str(), existing->label.c_str());
+            }
+            return Ref(existing);
+        }
+    }
+
+    // load 只提交解码任务, 不会回调本类, 可以在锁内执行
+    auto record = std::make_shared<Record>();
+    record->owner      = this;
+    record->contentKey = contentKey;
+    record->label      = label;
+    record->handle     = load();
+    m_records[contentKey] = record;
+    return Ref(record);
+}
+
+// ---------------------------------------------------------------------------
+// GL 线程
+// ---------------------------------------------------------------------------
+
+size_t TextureCache::collectGarbage() {
+    std::vector<TextureLoader::Handle> retired;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_retired.empty()) return 0;
+        retired.swap(m_retired);
+    }
+
+    size_t deleted = 0;
+    std::vector<TextureLoader::Handle> pending;
+    for (const TextureLoader::Handle& handle : retired) {
+        if (handle.settled()) {
+            TextureLoader::destroy(handle);
+            ++deleted;
+        } else {
+            pending.push_back(handle);
+        }
+    }
+
+    if (!pending.empty()) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_retired.insert(m_retired.end(), pending.begin(), pending.end());
+    }
+    if (deleted > 0) {
+        LOGI("TextureCache: deleted %d unreferenced textures", static_cast<int>(deleted));
+    }
+    return deleted;
+}
+
+size_t TextureCache::releaseGLResources() {
+    collectGarbage();
+
+    TextureLoader::contextLost();
+
+    // 临时 shared_ptr 可能是最后一个引用, 其析构 (retire) 会再次加锁, 在锁外释放
+    std::vector<std::shared_ptr<Record>> live;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        for (const auto& pair : m_records) {
+            if (auto record = pair.second.lock()) live.push_back(std::move(record));
+        }
+        m_records.clear();
+    }
+    if (!live.empty()) {
+        LOGE("TextureCache: %d textures still referenced when the GL context is released", static_cast<int>(live.size()));
+    }
+    return live.size();
+}
+
+TextureCache::Stats TextureCache::stats() const {
+    Stats result;
+    // 先取出存活条目再在锁外统计: 临时 shared_ptr 可能是最后一个引用, 其析构会再次加锁
+    std::vector<std::shared_ptr<Record>> live;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        result.requests    = m_requests;
+        result.pathHits    = m_pathHits;
+        result.contentHits = m_contentHits;
+        result.bytesSaved  = m_retiredBytesSaved;
+        live.reserve(m_records.size());
+        for (const auto& pair : m_records) {
+            if (auto record = pair.second.lock()) live.push_back(std::move(record));
+        }
+    }
+    result.liveTextures = live.size();
+    for (const auto& record : live) {
+        const size_t bytes = record->handle.gpuBytes();
+        result.gpuBytes   += bytes;
+        result.bytesSaved += record->hits.load() * bytes;
+    }
+    return result;
+}
+
+void TextureCache::logStats() const {
+    const Stats s = stats();
+    LOGI("TextureCache: %d requests, %d dedupe hits (%d path, %d content), %d live textures, %d KB GPU, ~%d KB saved",
+         static_cast<int>(s.requests), static_cast<int>(s.pathHits + s.contentHits),
+         static_cast<int>(s.pathHits), static_cast<int>(s.contentHits), static_cast<int>(s.liveTextures),
+         static_cast<int>(s.gpuBytes / 1024), static_cast<int>(s.bytesSaved / 1024));
+}
+
+// ---------------------------------------------------------------------------
+// 键
+// ---------------------------------------------------------------------------
+
+// 采样选项不同的同一图像必须是不同的纹理对象
+uint64_t TextureCache::optionsKey(const Options& options) {
+    const int32_t fields[] = {
+        options.flipVertically ? 1 : 0, options.generateMipmap ? 1 : 0, options.allowCompressed ? 1 : 0,
+        options.cpuMipmaps ? 1 : 0, options.srgb ? 1 : 0,
+        options.wrapS, options.wrapT, options.minFilter, options.magFilter,
+    };
+    return hashBytes(reinterpret_cast<const unsigned char*>(fields), sizeof(fields), 0);
+}
+
+// FNV-1a 64
+uint64_t TextureCache::hashBytes(const unsigned char* data, size_t size, uint64_t seed) {
+    uint64_t hash = 14695981039346656037ull ^ seed;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    // 混入长度, 降低不同长度前缀碰撞的概率
+    hash ^= static_cast<uint64_t>(size);
+    hash *= 1099511628211ull;
+    return hash;
+}
+
+std::string TextureCache::canonicalPath(const std::string& path) {
+    std::error_code ec;
+    std::filesystem::path canonical = std::filesystem::weakly_canonical(path, ec);
+    if (ec) canonical = std::filesystem::path(path).lexically_normal();
+    return canonical.generic_string();
+}
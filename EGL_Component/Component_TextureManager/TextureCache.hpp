@@ -0,0 +1,128 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "TextureLoader.hpp"
+
+/**
+ * @brief 进程级纹理缓存 - 单例模式
+ *
+ * Model 与 GlobalTextureManager 都通过它获取纹理, 同一张图像只解码/上传一次:
+ * - 一级索引: 规范化路径 + 采样选项 (文件大小/修改时间变化时失效)
+ * - 二级索引: 文件内容哈希 + 采样选项, 不同相对路径/嵌入纹理指向相同内容时同样命中
+ *
+ * acquire* 返回引用计数句柄 Ref; 最后一个 Ref 释放后纹理进入待删除列表,
+ * 由 GL 线程在 collectGarbage() 中删除 (仍在解码/上传中的纹理会等到完成后再删)。
+ * acquire* 可在任意线程调用, Ref::id() 与 collectGarbage() 只能在 GL 线程调用。
+ */
+class TextureCache {
+private:
+    struct Record;
+
+public:
+    using Options = TextureLoader::Options;
+
+    /**
+     * @brief 纹理引用 (可拷贝, 最后一个副本析构时释放缓存条目)
+     */
+    class Ref {
+    public:
+        Ref() = default;
+
+        bool valid() const { return m_record != nullptr; }
+        GLuint id() const;
+        const TextureLoader::Handle& handle() const;
+
+    private:
+        friend class TextureCache;
+        explicit Ref(std::shared_ptr<Record> record) : m_record(std::move(record)) {}
+        std::shared_ptr<Record> m_record;
+    };
+
+    struct Stats {
+        size_t requests     = 0;    // acquire* 调用次数
+        size_t pathHits     = 0;    // 同一路径命中
+        size_t contentHits  = 0;    // 路径不同但内容相同命中
+        size_t liveTextures = 0;    // 当前仍被引用的纹理数
+        size_t gpuBytes     = 0;    // 已上传纹理的估算显存
+        size_t bytesSaved   = 0;    // 命中所避免的重复显存 (按已上传纹理估算)
+    };
+
+    static TextureCache& getInstance();
+
+    TextureCache(const TextureCache&) = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+
+    // 从文件获取纹理, 文件不存在时仍返回有效句柄 (加载失败后保持占位内容)
+    Ref acquire(const std::string& path, const Options& options = Options());
+
+    // 从内存中的压缩图像获取纹理, 只按内容去重
+    Ref acquireFromMemory(const std::string& label, const unsigned char* data, size_t size,
+                          const Options& options = Options());
+
+    /**
+     * @brief GL 线程每帧调用: 删除已无引用且上传已结束的纹理
+     * @return 本次删除的纹理数
+     */
+    size_t collectGarbage();
+
+    /**
+     * @brief GL 线程: GL 上下文销毁之前调用 (渲染器析构时, 先释放模型与全局纹理的引用)
+     *
+     * 删除已无引用且上传已结束的纹理, 然后通知 TextureLoader 旧纹理名全部作废: 仍在解码/等待上传的纹理
+     * 上传时在新上下文中重新创建纹理名, 之后照常由 collectGarbage 删除。否则旧纹理名会在新上下文中被删除或
+     * 被写入, 而新上下文可能已经把同一个名字分配给了其它纹理。
+     * 以 cacheDecoded 加载的纹理解码结果留在 AssetCache 中, 新上下文再次获取同一纹理时只需重新上传。
+     * @return 仍被引用的纹理数 (内容随上下文丢失, 退出去重索引, 之后的获取重新加载)
+     */
+    size_t releaseGLResources();
+
+    Stats stats() const;
+    void logStats() const;
+
+private:
+    struct Record {
+        TextureCache* owner = nullptr;
+        uint64_t contentKey = 0;
+        std::string label;
+        TextureLoader::Handle handle;
+        std::atomic<size_t> hits{0};
+
+        ~Record();
+    };
+
+    struct PathEntry {
+        uint64_t contentKey = 0;
+        uint64_t fileSize   = 0;
+        int64_t  fileMTime  = 0;
+    };
+
+    TextureCache();
+    ~TextureCache() = default;
+
+    Ref acquireByContent(uint64_t contentKey, const std::string& label, bool pathHit,
+                         const std::function<TextureLoader::Handle()>& load);
+    void retire(Record& record);
+
+    static uint64_t optionsKey(const Options& options);
+    static uint64_t hashBytes(const unsigned char* data, size_t size, uint64_t seed);
+    static std::string canonicalPath(const std::string& path);
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<std::string, PathEntry> m_pathIndex;
+    std::unordered_map<uint64_t, std::weak_ptr<Record>> m_records;
+    std::vector<TextureLoader::Handle> m_retired;
+
+    size_t m_requests = 0;
+    size_t m_pathHits = 0;
+    size_t m_contentHits = 0;
+    size_t m_retiredBytesSaved = 0;
+};
@@ -0,0 +1,397 @@
+#include "TextureEncoder.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+
+#include "MipGenerator.hpp"
+#include "TextureLoader.hpp"
+#include "ThreadPool.hpp"
+
+extern "C" {
+#include <SOIL2/image_DXT.h>
+}
+
+namespace {
+
+    // ETC1 亮度调制表 (small, large), 实际取值为 +small, +large, -small, -large
+    const int kETC1Modifiers[8][2] = {
+        { 2, 8 }, { 5, 17 }, { 9, 29 }, { 13, 42 }, { 18, 60 }, { 24, 80 }, { 33, 106 }, { 47, 183 },
+    };
+
+    // EAC 调制表, 索引 0..7
+    const int kEACModifiers[16][8] = {
+        { -3, -6, -9, -15, 2, 5, 8, 14 }, { -3, -7, -10, -13, 2, 6, 9, 12 },
+        { -2, -5, -8, -13, 1, 4, 7, 12 }, { -2, -4, -6, -13, 1, 3, 5, 12 },
+        { -3, -6, -8, -12, 2, 5, 7, 11 }, { -3, -7, -9, -11, 2, 6, 8, 10 },
+        { -4, -7, -8, -11, 3, 6, 7, 10 }, { -3, -5, -8, -11, 2, 4, 7, 10 },
+        { -2, -6, -8, -10, 1, 5, 7, 9 },  { -2, -5, -8, -10, 1, 4, 7, 9 },
+        { -2, -4, -8, -10, 1, 3, 7, 9 },  { -2, -5, -7, -10, 1, 4, 6, 9 },
+        { -3, -4, -7, -10, 2, 3, 6, 9 },  { -1, -2, -3, -10, 0, 1, 2, 9 },
+        { -4, -6, -8, -9, 3, 5, 7, 8 },   { -3, -5, -7, -9, 2, 4, 6, 8 },
+    };
+
+    inline int clamp255(int value) {
+        return value < 0 ? 0 : (value > 255 ? 255 : value);
+    }
+
+    void writeBigEndian(uint64_t bits, unsigned char* out) {
+        for (int i = 0; i < 8; ++i) {
+            out[i] = static_cast<unsigned char>(bits >> (56 - 8 * i));
+        }
+    }
+
+    // 子块: 4x4 块中的 8 个像素, 以 j = x * 4 + y 编号 (ETC 像素索引的排列方式)
+    struct SubBlock {
+        int pixels[8];
+    };
+
+    SubBlock subBlock(bool flip, int half) {
+        SubBlock sub;
+        int count = 0;
+        for (int x = 0; x < 4; ++x) {
+            for (int y = 0; y < 4; ++y) {
+                const int coord = flip ? y : x;
+                if ((coord >> 1) == half) sub.pixels[count++] = x * 4 + y;
+            }
+        }
+        return sub;
+    }
+
+    // 给定基色, 穷举 8 张调制表, 返回最小误差并输出每个像素的调制索引
+    int fitSubBlock(const int (&colors)[16][3], const SubBlock& sub, const int base[3], int& bestTable, int (&indices)[16]) {
+        int bestError = INT_MAX;
+        for (int table = 0; table < 8; ++table) {
+            const int modifiers[4] = { kETC1Modifiers[table][0], kETC1Modifiers[table][1],
+                                       -kETC1Modifiers[table][0], -kETC1Modifiers[table][1] };
+            int error = 0;
+            int chosen[8];
+            for (int p = 0; p < 8; ++p) {
+                const int* color = colors[sub.pixels[p]];
+                int pixelBest = INT_MAX;
+                for (int m = 0; m < 4; ++m) {
+                    const int dr = clamp255(base[0] + modifiers[m]) - color[0];
+                    const int dg = clamp255(base[1] + modifiers[m]) - color[1];
+                    const int db = clamp255(base[2] + modifiers[m]) - color[2];
+                    const int e = dr * dr + dg * dg + db * db;
+                    if (e < pixelBest) {
+                        pixelBest = e;
+                        chosen[p] = m;
+                    }
+                }
+                error += pixelBest;
+                if (error >= bestError) break;
+            }
+            if (error < bestError) {
+                bestError = error;
+                bestTable = table;
+                for (int p = 0; p < 8; ++p) indices[sub.pixels[p]] = chosen[p];
+            }
+        }
+        return bestError;
+    }
+
+    // 取出 (bx, by) 处的 4x4 块, 越界像素复制边缘
+    void fetchBlock(const std::vector<unsigned char>& rgba, int width, int height, int bx, int by, unsigned char* block) {
+        for (int y = 0; y < 4; ++y) {
+            const int sy = std::min(by * 4 + y, height - 1);
+            for (int x = 0; x < 4; ++x) {
+                const int sx = std::min(bx * 4 + x, width - 1);
+                std::memcpy(block + (y * 4 + x) * 4, &rgba[(static_cast<size_t>(sy) * width + sx) * 4], 4);
+            }
+        }
+    }
+
+    bool encodeLevelETC2(const std::vector<unsigned char>& rgba, int width, int height, bool hasAlpha, std::vector<unsigned char>& out) {
+        const int blocksX = (width + 3) / 4;
+        const int blocksY = (height + 3) / 4;
+        const size_t blockBytes = hasAlpha ? 16 : 8;
+        out.resize(static_cast<size_t>(blocksX) * blocksY * blockBytes);
+
+        unsigned char block[64];
+        unsigned char* dst = out.data();
+        for (int by = 0; by < blocksY; ++by) {
+            for (int bx = 0; bx < blocksX; ++bx) {
+                fetchBlock(rgba, width, height, bx, by, block);
+                // RGBA8_ETC2_EAC: 每块先是 8 字节 EAC Alpha, 再是 8 字节颜色
+                if (hasAlpha) {
+                    TextureEncoder::encodeEACAlphaBlock(block, dst);
+                    dst += 8;
+                }
+                TextureEncoder::encodeETC1Block(block, dst);
+                dst += 8;
+            }
+        }
+        return true;
+    }
+
+    bool encodeLevelBC(const std::vector<unsigned char>& rgba, int width, int height, bool hasAlpha, std::vector<unsigned char>& out) {
+        int size = 0;
+        unsigned char* data = hasAlpha ? convert_image_to_DXT5(rgba.data(), width, height, 4, &size)
+                                       : convert_image_to_DXT1(rgba.data(), width, height, 4, &size);
+        if (!data) return false;
+        out.assign(data, data + size);
+        free(data);
+        return true;
+    }
+
+} // namespace
+
+namespace TextureEncoder {
+
+void encodeETC1Block(const unsigned char* rgba, unsigned char* out) {
+    // 按 ETC 的像素编号 j = x * 4 + y 重新排列
+    int colors[16][3];
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 4; ++x) {
+            for (int c = 0; c < 3; ++c) colors[x * 4 + y][c] = rgba[(y * 4 + x) * 4 + c];
+        }
+    }
+
+    int bestError = INT_MAX;
+    uint64_t bestBits = 0;
+    for (int flip = 0; flip < 2; ++flip) {
+        const SubBlock subs[2] = { subBlock(flip != 0, 0), subBlock(flip != 0, 1) };
+
+        float average[2][3] = {};
+        for (int s = 0; s < 2; ++s) {
+            for (int p = 0; p < 8; ++p) {
+                for (int c = 0; c < 3; ++c) average[s][c] += colors[subs[s].pixels[p]][c] / 8.0f;
+            }
+        }
+
+        // 两种基色模式: 独立 (4+4 bit) 与差分 (5 bit + 3 bit 有符号差值)
+        for (int diff = 0; diff < 2; ++diff) {
+            int quantized[2][3];
+            int base[2][3];
+            bool valid = true;
+            for (int s = 0; s < 2; ++s) {
+                for (int c = 0; c < 3; ++c) {
+                    if (diff) {
+                        quantized[s][c] = std::min(31, std::max(0, static_cast<int>(average[s][c] * 31.0f / 255.0f + 0.5f)));
+                        base[s][c] = (quantized[s][c] << 3) | (quantized[s][c] >> 2);
+                    } else {
+                        quantized[s][c] = std::min(15, std::max(0, static_cast<int>(average[s][c] * 15.0f / 255.0f + 0.5f)));
+                        base[s][c] = quantized[s][c] * 17;
+                    }
+                }
+            }
+            if (diff) {
+                for (int c = 0; c < 3; ++c) {
+                    const int delta = quantized[1][c] - quantized[0][c];
+                    if (delta < -4 || delta > 3) valid = false;
+                }
+            }
+            if (!valid) continue;
+
+            int tables[2] = { 0, 0 };
+            int indices[16] = {};
+            const int error = fitSubBlock(colors, subs[0], base[0], tables[0], indices) +
+                              fitSubBlock(colors, subs[1], base[1], tables[1], indices);
+            if (error >= bestError) continue;
+            bestError = error;
+
+            // 按无符号拼接, 避免 5bit 基色左移 27 位时溢出 int
+            uint32_t q[2][3];
+            for (int s = 0; s < 2; ++s) {
+                for (int c = 0; c < 3; ++c) q[s][c] = static_cast<uint32_t>(quantized[s][c]);
+            }
+            uint32_t hi = 0;
+            if (diff) {
+                hi |= q[0][0] << 27 | ((q[1][0] - q[0][0]) & 7u) << 24;
+                hi |= q[0][1] << 19 | ((q[1][1] - q[0][1]) & 7u) << 16;
+                hi |= q[0][2] << 11 | ((q[1][2] - q[0][2]) & 7u) << 8;
+            } else {
+                hi |= q[0][0] << 28 | q[1][0] << 24;
+                hi |= q[0][1] << 20 | q[1][1] << 16;
+                hi |= q[0][2] << 12 | q[1][2] << 8;
+            }
+            hi |= static_cast<uint32_t>(tables[0] << 5 | tables[1] << 2 | diff << 1 | flip);
+
+            uint32_t lo = 0;
+            for (int j = 0; j < 16; ++j) {
+                lo |= static_cast<uint32_t>(indices[j] >> 1) << (16 + j);
+                lo |= static_cast<uint32_t>(indices[j] & 1) << j;
+            }
+            bestBits = static_cast<uint64_t>(hi) << 32 | lo;
+        }
+    }
+    writeBigEndian(bestBits, out);
+}
+
+void encodeEACAlphaBlock(const unsigned char* rgba, unsigned char* out) {
+    int alpha[16];
+    int minAlpha = 255;
+    int maxAlpha = 0;
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 4; ++x) {
+            alpha[x * 4 + y] = rgba[(y * 4 + x) * 4 + 3];
+            minAlpha = std::min(minAlpha, alpha[x * 4 + y]);
+            maxAlpha = std::max(maxAlpha, alpha[x * 4 + y]);
+        }
+    }
+
+    int bestError = INT_MAX;
+    int bestBase = minAlpha;
+    int bestMultiplier = 1;
+    int bestTable = 13;
+    int bestIndices[16];
+    std::fill(bestIndices, bestIndices + 16, 4);     // 表 13 的索引 4 为 0, 用于纯色块
+
+    if (minAlpha != maxAlpha) {
+        for (int table = 0; table < 16; ++table) {
+            const int* modifiers = kEACModifiers[table];
+            const int span = modifiers[7] - modifiers[3];
+            const int guess = (maxAlpha - minAlpha + span / 2) / span;
+            for (int multiplier = std::max(guess - 1, 1); multiplier <= std::min(guess + 1, 15); ++multiplier) {
+                const int baseGuess = clamp255(minAlpha - modifiers[3] * multiplier);
+                for (int base = std::max(baseGuess - 1, 0); base <= std::min(baseGuess + 1, 255); ++base) {
+                    int error = 0;
+                    int indices[16];
+                    for (int j = 0; j < 16 && error < bestError; ++j) {
+                        int pixelBest = INT_MAX;
+                        for (int m = 0; m < 8; ++m) {
+                            const int d = clamp255(base + modifiers[m] * multiplier) - alpha[j];
+                            if (d * d < pixelBest) {
+                                pixelBest = d * d;
+                                indices[j] = m;
+                            }
+                        }
+                        error += pixelBest;
+                    }
+                    if (error < bestError) {
+                        bestError = error;
+                        bestBase = base;
+                        bestMultiplier = multiplier;
+                        bestTable = table;
+                        std::copy(indices, indices + 16, bestIndices);
+                    }
+                }
+            }
+        }
+    }
+
+    uint64_t bits = static_cast<uint64_t>(bestBase) << 56 | static_cast<uint64_t>(bestMultiplier) << 52 |
+                    static_cast<uint64_t>(bestTable) << 48;
+    for (int j = 0; j < 16; ++j) {
+        bits |= static_cast<uint64_t>(bestIndices[j]) << (45 - 3 * j);
+    }
+    writeBigEndian(bits, out);
+}
+
+bool encode(const unsigned char* pixels, int width, int height, int channels, bool flippedY,
+            TextureCodec codec, bool generateMipmaps, CompressedImage& out) {
+    if (!pixels || width <= 0 || height <= 0 || (channels != 3 && channels != 4)) return false;
+    if (codec != TextureCodec::ETC2 && codec != TextureCodec::BC) {
+        LOGE("TextureEncoder: no CPU encoder for %s, use an external tool", TextureFormat::codecName(codec));
+        return false;
+    }
+
+    // 统一转为 RGBA 处理, 全不透明的 RGBA 图像按 RGB 编码 (ETC2 RGB8 / BC1 码率减半)
+    const size_t pixelCount = static_cast<size_t>(width) * height;
+    std::vector<unsigned char> rgba(pixelCount * 4);
+    bool hasAlpha = false;
+    for (size_t i = 0; i < pixelCount; ++i) {
+        std::memcpy(&rgba[i * 4], pixels + i * channels, 3);
+        rgba[i * 4 + 3] = channels == 4 ? pixels[i * 4 + 3] : 255;
+        hasAlpha = hasAlpha || rgba[i * 4 + 3] != 255;
+    }
+
+    out = CompressedImage();
+    out.width    = width;
+    out.height   = height;
+    out.hasAlpha = hasAlpha;
+    out.flippedY = flippedY;
+    if (codec == TextureCodec::ETC2) {
+        out.internalFormat = hasAlpha ? GLCompressedFormat::RGBA8_ETC2_EAC : GLCompressedFormat::RGB8_ETC2;
+    } else {
+        out.internalFormat = hasAlpha ? GLCompressedFormat::RGBA_S3TC_DXT5 : GLCompressedFormat::RGB_S3TC_DXT1;
+    }
+
+    int levelWidth = width;
+    int levelHeight = height;
+    while (true) {
+        CompressedLevel level;
+        level.width  = levelWidth;
+        level.height = levelHeight;
+        const bool ok = codec == TextureCodec::ETC2
+            ? encodeLevelETC2(rgba, levelWidth, levelHeight, hasAlpha, level.data)
+            : encodeLevelBC(rgba, levelWidth, levelHeight, hasAlpha, level.data);
+        if (!ok || level.data.size() != TextureFormat::levelByteSize(out.internalFormat, levelWidth, levelHeight)) {
+            LOGE("TextureEncoder: failed to encode %dx%d level", levelWidth, levelHeight);
+            out = CompressedImage();
+            return false;
+        }
+        out.levels.push_back(std::move(level));
+
+        if (!generateMipmaps || (levelWidth == 1 && levelHeight == 1)) break;
+        const int nextWidth  = std::max(levelWidth / 2, 1);
+        const int nextHeight = std::max(levelHeight / 2, 1);
+        std::vector<unsigned char> next(static_cast<size_t>(nextWidth) * nextHeight * 4);
+        MipGenerator::downsample(rgba.data(), levelWidth, levelHeight, 4, false, next.data());
+        rgba.swap(next);
+        levelWidth = nextWidth;
+        levelHeight = nextHeight;
+    }
+    return true;
+}
+
+bool cookFile(const std::string& sourcePath, TextureCodec codec, bool flipVertically, bool generateMipmaps) {
+    auto cookStart = std::chrono::high_resolution_clock::now();
+
+    TextureLoader::Image image;
+    if (!TextureLoader::decodeFile(sourcePath, flipVertically, image)) {
+        LOGE("TextureEncoder: failed to decode %s", sourcePath.c_str());
+        return false;
+    }
+
+    CompressedImage compressed;
+    if (!encode(image.pixels.data(), image.width, image.height, image.channels, flipVertically, codec, generateMipmaps, compressed)) {
+        return false;
+    }
+
+    const std::string outputPath = TextureFormat::variantPath(sourcePath, codec);
+    if (!TextureFormat::writeKTX(outputPath, compressed)) {
+        return false;
+    }
+
+    LOGI("TextureEncoder: %s -> %s (%dx%d, %d levels, %d KB vs %d KB RGBA8 with mips) in %lld ms",
+         sourcePath.c_str(), outputPath.c_str(), image.width, image.height, static_cast<int>(compressed.levels.size()),
+         static_cast<int>(compressed.byteSize() / 1024),
+         static_cast<int>(static_cast<size_t>(image.width) * image.height * 4 * 4 / 3 / 1024),
+         static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::high_resolution_clock::now() - cookStart).count()));
+    return true;
+}
+
+size_t cookDirectory(const std::string& directory, TextureCodec codec, bool flipVertically, bool generateMipmaps) {
+    std::vector<std::string> sources;
+    std::error_code error;
+    for (std::filesystem::recursive_directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+        if (!it->is_regular_file()) continue;
+        std::string extension = it->path().extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+        if (extension == ".jpg" || extension == ".jpeg" || extension == ".png" || extension == ".tga" || extension == ".bmp") {
+            sources.push_back(it->path().string());
+        }
+    }
+    if (error) {
+        LOGE("TextureEncoder: failed to scan %s (%s)", directory.c_str(), error.message().c_str());
+    }
+
+    std::vector<char> results(sources.size(), 0);
+    ThreadPool pool;
+    pool.parallelFor(sources.size(), [&](size_t i) {
+        results[i] = cookFile(sources[i], codec, flipVertically, generateMipmaps) ? 1 : 0;
+    });
+
+    const size_t cooked = static_cast<size_t>(std::count(results.begin(), results.end(), 1));
+    LOGI("TextureEncoder: cooked %d / %d textures in %s as %s", static_cast<int>(cooked),
+         static_cast<int>(sources.size()), directory.c_str(), TextureFormat::codecName(codec));
+    return cooked;
+}
+
+} // namespace TextureEncoder
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "TextureFormat.hpp"
+
+/**
+ * @brief CPU 纹理压缩编码 (离线/预处理使用)
+ *
+ * 从 JPG/PNG 源图生成带完整 mip 链的 KTX 文件, 运行时由 TextureLoader 按设备能力挑选:
+ * - ETC2: 颜色以 ETC1 兼容块编码 (ETC2 解码器向下兼容), 带 Alpha 时附加 EAC 块 (RGBA8_ETC2_EAC)
+ * - BC:   BC1 / BC3, 复用 SOIL2 的 DXT 编码器
+ * - ASTC: 不提供编码器, 需使用外部工具 (astcenc) 生成 <stem>.astc.ktx
+ *
+ * 编码较慢 (每个 4x4 块穷举调制表), 不要在渲染线程调用。
+ */
+namespace TextureEncoder {
+
+    /**
+     * @brief 压缩一张 RGB/RGBA 图像 (含 mip 链)
+     * @param pixels   紧密排列的 8bit 像素, channels 为 3 或 4
+     * @param flippedY 像素第一行是否为图像底部, 原样写入 KTXorientation
+     */
+    bool encode(const unsigned char* pixels, int width, int height, int channels, bool flippedY,
+                TextureCodec codec, bool generateMipmaps, CompressedImage& out);
+
+    /**
+     * @brief 将源图编码为 variantPath(sourcePath, codec) 指向的 KTX 文件
+     * @param flipVertically 与运行时加载选项一致 (模型纹理为 true), 方向不一致的文件在运行时会被忽略
+     */
+    bool cookFile(const std::string& sourcePath, TextureCodec codec, bool flipVertically, bool generateMipmaps = true);
+
+    /**
+     * @brief 并行编码目录下 (递归) 所有 jpg/jpeg/png/tga/bmp, 返回成功的数量
+     */
+    size_t cookDirectory(const std::string& directory, TextureCodec codec, bool flipVertically, bool generateMipmaps = true);
+
+    // 单个 4x4 块编码 (pixels 为 16 个 RGBA, 按行排列), 输出 8 字节大端块
+    void encodeETC1Block(const unsigned char* rgba, unsigned char* out);
+    void encodeEACAlphaBlock(const unsigned char* rgba, unsigned char* out);
+
+} // namespace TextureEncoder
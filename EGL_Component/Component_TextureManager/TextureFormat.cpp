@@ -0,0 +1,473 @@
+#include "TextureFormat.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include "VirtualFileSystem.hpp"
+
+size_t CompressedImage::byteSize() const {
+    size_t bytes = 0;
+    for (const CompressedLevel& level : levels) bytes += level.data.size();
+    return bytes;
+}
+
+namespace {
+
+    // 只在 GL 线程的 queryCapabilities 中写入; 加载线程在其之后启动, 之后只读
+    TextureCaps g_caps;
+
+    const unsigned char kKTX1Identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+    const unsigned char kKTX2Identifier[12] = { 0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n' };
+    const uint32_t kKTXEndianness = 0x04030201;
+
+    struct KTX1Header {
+        uint8_t  identifier[12];
+        uint32_t endianness;
+        uint32_t glType;
+        uint32_t glTypeSize;
+        uint32_t glFormat;
+        uint32_t glInternalFormat;
+        uint32_t glBaseInternalFormat;
+        uint32_t pixelWidth;
+        uint32_t pixelHeight;
+        uint32_t pixelDepth;
+        uint32_t numberOfArrayElements;
+        uint32_t numberOfFaces;
+        uint32_t numberOfMipmapLevels;
+        uint32_t bytesOfKeyValueData;
+    };
+    static_assert(sizeof(KTX1Header) == 64, "KTX1 header layout");
+
+    struct KTX2Header {
+        uint8_t  identifier[12];
+        uint32_t vkFormat;
+        uint32_t typeSize;
+        uint32_t pixelWidth;
+        uint32_t pixelHeight;
+        uint32_t pixelDepth;
+        uint32_t layerCount;
+        uint32_t faceCount;
+        uint32_t levelCount;
+        uint32_t supercompressionScheme;
+        uint32_t dfdByteOffset;
+        uint32_t dfdByteLength;
+        uint32_t kvdByteOffset;
+        uint32_t kvdByteLength;
+        uint64_t sgdByteOffset;
+        uint64_t sgdByteLength;
+    };
+    static_assert(sizeof(KTX2Header) == 80, "KTX2 header layout");
+
+    struct KTX2LevelIndex {
+        uint64_t byteOffset;
+        uint64_t byteLength;
+        uint64_t uncompressedByteLength;
+    };
+
+    // KTX2 使用 VkFormat, 这里只映射本引擎会用到的压缩格式
+    GLenum glFormatFromVk(uint32_t vkFormat) {
+        switch (vkFormat) {
+            case 131: return GLCompressedFormat::RGB_S3TC_DXT1;            // BC1_RGB_UNORM
+            case 132: return GLCompressedFormat::SRGB_S3TC_DXT1;           // BC1_RGB_SRGB
+            case 133: return GLCompressedFormat::RGBA_S3TC_DXT1;           // BC1_RGBA_UNORM
+            case 137: return GLCompressedFormat::RGBA_S3TC_DXT5;           // BC3_UNORM
+            case 138: return GLCompressedFormat::SRGB_ALPHA_S3TC_DXT5;     // BC3_SRGB
+            case 147: return GLCompressedFormat::RGB8_ETC2;
+            case 148: return GLCompressedFormat::SRGB8_ETC2;
+            case 151: return GLCompressedFormat::RGBA8_ETC2_EAC;
+            case 152: return GLCompressedFormat::SRGB8_ALPHA8_ETC2;
+            case 157: return GLCompressedFormat::RGBA_ASTC_4x4;
+            case 158: return GLCompressedFormat::SRGB8_ALPHA8_ASTC_4x4;
+            case 165: return GLCompressedFormat::RGBA_ASTC_6x6;
+            case 166: return GLCompressedFormat::SRGB8_ALPHA8_ASTC_6x6;
+            case 171: return GLCompressedFormat::RGBA_ASTC_8x8;
+            case 172: return GLCompressedFormat::SRGB8_ALPHA8_ASTC_8x8;
+            default:  return 0;
+        }
+    }
+
+    // 解析 key/value 数据中的 KTXorientation; KTX1 取值 "S=r,T=u", KTX2 取值 "ru"
+    bool parseFlippedY(const unsigned char* kvd, size_t length) {
+        size_t offset = 0;
+        while (offset + 4 <= length) {
+            uint32_t pairLength = 0;
+            std::memcpy(&pairLength, kvd + offset, 4);
+            offset += 4;
+            if (pairLength > length - offset) break;
+
+            const char* pair = reinterpret_cast<const char*>(kvd + offset);
+            const size_t keyLength = strnlen(pair, pairLength);
+            if (keyLength < pairLength && std::strcmp(pair, "KTXorientation") == 0) {
+                const std::string value(pair + keyLength + 1, strnlen(pair + keyLength + 1, pairLength - keyLength - 1));
+                return value.find('u') != std::string::npos;
+            }
+            offset += (pairLength + 3) & ~size_t(3);
+        }
+        return false;
+    }
+
+    // 包内条目或磁盘文件
+    bool fileExists(const std::string& path) {
+        return VirtualFileSystem::getInstance().exists(path);
+    }
+
+    bool hasExtension(const std::vector<std::string>& extensions, const char* name) {
+        return std::find(extensions.begin(), extensions.end(), name) != extensions.end();
+    }
+
+    bool readKTX1(const unsigned char* data, size_t size, CompressedImage& out) {
+        if (size < sizeof(KTX1Header)) return false;
+        KTX1Header header;
+        std::memcpy(&header, data, sizeof(header));
+        if (header.endianness != kKTXEndianness) {
+            LOGE("KTX: big-endian files are not supported");
+            return false;
+        }
+        if (header.glType != 0 || header.numberOfFaces != 1 || header.numberOfArrayElements > 1 || header.pixelDepth > 1) {
+            LOGE("KTX: only compressed 2D textures are supported (type=0x%x faces=%u)", header.glType, header.numberOfFaces);
+            return false;
+        }
+        if (!TextureFormat::levelByteSize(header.glInternalFormat, 1, 1)) {
+            LOGE("KTX: unknown compressed format 0x%x", header.glInternalFormat);
+            return false;
+        }
+
+        size_t offset = sizeof(KTX1Header);
+        if (header.bytesOfKeyValueData > size - offset) return false;
+        out.flippedY = parseFlippedY(data + offset, header.bytesOfKeyValueData);
+        offset += header.bytesOfKeyValueData;
+
+        out.internalFormat = header.glInternalFormat;
+        out.width    = static_cast<int>(header.pixelWidth);
+        out.height   = static_cast<int>(header.pixelHeight);
+        out.hasAlpha = TextureFormat::formatHasAlpha(out.internalFormat);
+
+        const uint32_t levelCount = std::max<uint32_t>(header.numberOfMipmapLevels, 1);
+        out.levels.resize(levelCount);
+        for (uint32_t level = 0; level < levelCount; ++level) {
+            if (offset + 4 > size) return false;
+            uint32_t imageSize = 0;
+            std::memcpy(&imageSize, data + offset, 4);
+            offset += 4;
+
+            CompressedLevel& dst = out.levels[level];
+            dst.width  = std::max(out.width >> level, 1);
+            dst.height = std::max(out.height >> level, 1);
+            if (imageSize != TextureFormat::levelByteSize(out.internalFormat, dst.width, dst.height) ||
+                imageSize > size - offset) {
+                LOGE("KTX: level %u has unexpected size %u", level, imageSize);
+                return false;
+            }
+            dst.data.assign(data + offset, data + offset + imageSize);
+            offset += (imageSize + 3) & ~size_t(3);
+        }
+        return true;
+    }
+
+    bool readKTX2(const unsigned char* data, size_t size, CompressedImage& out) {
+        if (size < sizeof(KTX2Header)) return false;
+        KTX2Header header;
+        std::memcpy(&header, data, sizeof(header));
+        if (header.supercompressionScheme != 0) {
+            LOGE("KTX2: supercompression scheme %u is not supported", header.supercompressionScheme);
+            return false;
+        }
+        if (header.faceCount != 1 || header.layerCount > 1 || header.pixelDepth > 1) {
+            LOGE("KTX2: only 2D textures are supported (faces=%u layers=%u)", header.faceCount, header.layerCount);
+            return false;
+        }
+        out.internalFormat = glFormatFromVk(header.vkFormat);
+        if (out.internalFormat == 0) {
+            LOGE("KTX2: unsupported vkFormat %u", header.vkFormat);
+            return false;
+        }
+        if (header.kvdByteLength > 0) {
+            if (header.kvdByteOffset > size || header.kvdByteLength > size - header.kvdByteOffset) return false;
+            out.flippedY = parseFlippedY(data + header.kvdByteOffset, header.kvdByteLength);
+        }
+
+        out.width    = static_cast<int>(header.pixelWidth);
+        out.height   = static_cast<int>(header.pixelHeight);
+        out.hasAlpha = TextureFormat::formatHasAlpha(out.internalFormat);
+
+        const uint32_t levelCount = std::max<uint32_t>(header.levelCount, 1);
+        if (sizeof(KTX2Header) + levelCount * sizeof(KTX2LevelIndex) > size) return false;
+        out.levels.resize(levelCount);
+        for (uint32_t level = 0; level < levelCount; ++level) {
+            KTX2LevelIndex index;
+            std::memcpy(&index, data + sizeof(KTX2Header) + level * sizeof(KTX2LevelIndex), sizeof(index));
+
+            CompressedLevel& dst = out.levels[level];
+            dst.width  = std::max(out.width >> level, 1);
+            dst.height = std::max(out.height >> level, 1);
+            if (index.byteLength != TextureFormat::levelByteSize(out.internalFormat, dst.width, dst.height) ||
+                index.byteOffset > size || index.byteLength > size - index.byteOffset) {
+                LOGE("KTX2: level %u is out of range", level);
+                return false;
+            }
+            dst.data.assign(data + index.byteOffset, data + index.byteOffset + index.byteLength);
+        }
+        return true;
+    }
+
+} // namespace
+
+namespace TextureFormat {
+
+void queryCapabilities() {
+    TextureCaps caps;
+    caps.queried = true;
+
+    const char* version = reinterpret_cast<const char*>(glGetString(GL_VERSION));
+    caps.isES = version && std::strstr(version, "OpenGL ES") != nullptr;
+
+    std::vector<std::string> extensions;
+    GLint extensionCount = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &extensionCount);
+    for (GLint i = 0; i < extensionCount; ++i) {
+        const char* name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+        if (name) extensions.emplace_back(name);
+    }
+
+    // 部分驱动不在扩展串中声明, 但会出现在 GL_COMPRESSED_TEXTURE_FORMATS 中
+    GLint formatCount = 0;
+    glGetIntegerv(GL_NUM_COMPRESSED_TEXTURE_FORMATS, &formatCount);
+    std::vector<GLint> formats(std::max(formatCount, 0));
+    if (formatCount > 0) {
+        glGetIntegerv(GL_COMPRESSED_TEXTURE_FORMATS, formats.data());
+    }
+    auto listed = [&formats](GLenum format) {
+        return std::find(formats.begin(), formats.end(), static_cast<GLint>(format)) != formats.end();
+    };
+
+    GLint major = 0;
+    GLint minor = 0;
+    glGetIntegerv(GL_MAJOR_VERSION, &major);
+    glGetIntegerv(GL_MINOR_VERSION, &minor);
+
+    // ETC2 在 GLES 3.0 中强制支持; 桌面端 GL 4.3 / ARB_ES3_compatibility 通常只是驱动内解压, 不省显存
+    caps.etc2 = caps.isES || listed(GLCompressedFormat::RGB8_ETC2);
+    caps.bc   = hasExtension(extensions, "GL_EXT_texture_compression_s3tc") ||
+                listed(GLCompressedFormat::RGBA_S3TC_DXT5);
+    caps.astc = hasExtension(extensions, "GL_KHR_texture_compression_astc_ldr") ||
+                (caps.isES && (major > 3 || (major == 3 && minor >= 2))) ||
+                listed(GLCompressedFormat::RGBA_ASTC_4x4);
+
+    g_caps = caps;
+    LOGI("TextureFormat: %s %d.%d, compressed formats: ETC2=%d BC=%d ASTC=%d",
+         caps.isES ? "GLES" : "GL", major, minor, caps.etc2, caps.bc, caps.astc);
+}
+
+const TextureCaps& capabilities() {
+    return g_caps;
+}
+
+std::vector<TextureCodec> preferredCodecs() {
+    std::vector<TextureCodec> codecs;
+    if (!g_caps.queried) return codecs;
+
+    // 移动端 ASTC 质量/码率最好, 其次是强制支持的 ETC2; 桌面端优先原生 BC
+    if (g_caps.isES) {
+        if (g_caps.astc) codecs.push_back(TextureCodec::ASTC);
+        if (g_caps.etc2) codecs.push_back(TextureCodec::ETC2);
+        if (g_caps.bc)   codecs.push_back(TextureCodec::BC);
+    } else {
+        if (g_caps.bc)   codecs.push_back(TextureCodec::BC);
+        if (g_caps.astc) codecs.push_back(TextureCodec::ASTC);
+        if (g_caps.etc2) codecs.push_back(TextureCodec::ETC2);
+    }
+    return codecs;
+}
+
+const char* codecName(TextureCodec codec) {
+    switch (codec) {
+        case TextureCodec::ETC2: return "etc2";
+        case TextureCodec::BC:   return "bc";
+        case TextureCodec::ASTC: return "astc";
+        default:                 return "none";
+    }
+}
+
+bool blockInfo(GLenum internalFormat, int& blockWidth, int& blockHeight, int& blockBytes) {
+    blockWidth = blockHeight = 4;
+    switch (internalFormat) {
+        case GLCompressedFormat::RGB8_ETC2:
+        case GLCompressedFormat::SRGB8_ETC2:
+        case GLCompressedFormat::RGB_S3TC_DXT1:
+        case GLCompressedFormat::RGBA_S3TC_DXT1:
+        case GLCompressedFormat::SRGB_S3TC_DXT1:
+            blockBytes = 8;
+            return true;
+        case GLCompressedFormat::RGBA8_ETC2_EAC:
+        case GLCompressedFormat::SRGB8_ALPHA8_ETC2:
+        case GLCompressedFormat::RGBA_S3TC_DXT5:
+        case GLCompressedFormat::SRGB_ALPHA_S3TC_DXT5:
+        case GLCompressedFormat::RGBA_ASTC_4x4:
+        case GLCompressedFormat::SRGB8_ALPHA8_ASTC_4x4:
+            blockBytes = 16;
+            return true;
+        case GLCompressedFormat::RGBA_ASTC_6x6:
+        case GLCompressedFormat::SRGB8_ALPHA8_ASTC_6x6:
+            blockWidth = blockHeight = 6;
+            blockBytes = 16;
+            return true;
+        case GLCompressedFormat::RGBA_ASTC_8x8:
+        case GLCompressedFormat::SRGB8_ALPHA8_ASTC_8x8:
+            blockWidth = blockHeight = 8;
+            blockBytes = 16;
+            return true;
+        default:
+            blockBytes = 0;
+            return false;
+    }
+}
+
+size_t levelByteSize(GLenum internalFormat, int width, int height) {
+    int blockWidth = 0;
+    int blockHeight = 0;
+    int blockBytes = 0;
+    if (!blockInfo(internalFormat, blockWidth, blockHeight, blockBytes)) return 0;
+    const size_t blocksX = (width + blockWidth - 1) / blockWidth;
+    const size_t blocksY = (height + blockHeight - 1) / blockHeight;
+    return blocksX * blocksY * blockBytes;
+}
+
+bool formatHasAlpha(GLenum internalFormat) {
+    switch (internalFormat) {
+        case GLCompressedFormat::RGB8_ETC2:
+        case GLCompressedFormat::SRGB8_ETC2:
+        case GLCompressedFormat::RGB_S3TC_DXT1:
+        case GLCompressedFormat::SRGB_S3TC_DXT1:
+            return false;
+        default:
+            return true;
+    }
+}
+
+TextureCodec codecOf(GLenum internalFormat) {
+    switch (internalFormat) {
+        case GLCompressedFormat::RGB8_ETC2:
+        case GLCompressedFormat::SRGB8_ETC2:
+        case GLCompressedFormat::RGBA8_ETC2_EAC:
+        case GLCompressedFormat::SRGB8_ALPHA8_ETC2:
+            return TextureCodec::ETC2;
+        case GLCompressedFormat::RGB_S3TC_DXT1:
+        case GLCompressedFormat::RGBA_S3TC_DXT1:
+        case GLCompressedFormat::RGBA_S3TC_DXT5:
+        case GLCompressedFormat::SRGB_S3TC_DXT1:
+        case GLCompressedFormat::SRGB_ALPHA_S3TC_DXT5:
+            return TextureCodec::BC;
+        case GLCompressedFormat::RGBA_ASTC_4x4:
+        case GLCompressedFormat::RGBA_ASTC_6x6:
+        case GLCompressedFormat::RGBA_ASTC_8x8:
+        case GLCompressedFormat::SRGB8_ALPHA8_ASTC_4x4:
+        case GLCompressedFormat::SRGB8_ALPHA8_ASTC_6x6:
+        case GLCompressedFormat::SRGB8_ALPHA8_ASTC_8x8:
+            return TextureCodec::ASTC;
+        default:
+            return TextureCodec::None;
+    }
+}
+
+bool isKTXPath(const std::string& path) {
+    const size_t dot = path.find_last_of('.');
+    if (dot == std::string::npos) return false;
+    std::string extension = path.substr(dot + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    return extension == "ktx" || extension == "ktx2";
+}
+
+std::string variantPath(const std::string& sourcePath, TextureCodec codec) {
+    const size_t slash = sourcePath.find_last_of("/\\");
+    const size_t dot = sourcePath.find_last_of('.');
+    const std::string stem = (dot != std::string::npos && (slash == std::string::npos || dot > slash))
+        ? sourcePath.substr(0, dot) : sourcePath;
+    return stem + "." + codecName(codec) + ".ktx";
+}
+
+std::string findCompressedVariant(const std::string& sourcePath) {
+    for (TextureCodec codec : preferredCodecs()) {
+        const std::string ktx = variantPath(sourcePath, codec);
+        if (fileExists(ktx + "2")) return ktx + "2";
+        if (fileExists(ktx)) return ktx;
+    }
+    return std::string();
+}
+
+bool readKTX(const std::string& path, CompressedImage& out) {
+    AssetFile file;
+    if (!file.open(path)) {
+        LOGE("KTX: failed to open %s", path.c_str());
+        return false;
+    }
+    if (!readKTX(file.data(), file.size(), out)) {
+        LOGE("KTX: failed to parse %s", path.c_str());
+        out = CompressedImage();
+        return false;
+    }
+    return true;
+}
+
+bool readKTX(const unsigned char* data, size_t size, CompressedImage& out) {
+    if (size >= 12 && std::memcmp(data, kKTX1Identifier, 12) == 0) return readKTX1(data, size, out);
+    if (size >= 12 && std::memcmp(data, kKTX2Identifier, 12) == 0) return readKTX2(data, size, out);
+    LOGE("KTX: not a KTX container");
+    return false;
+}
+
+bool writeKTX(const std::string& path, const CompressedImage& image) {
+    std::vector<uint8_t> bytes;
+    if (!writeKTX(image, bytes)) return false;
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        LOGE("KTX: failed to create %s", path.c_str());
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    return static_cast<bool>(file);
+}
+
+bool writeKTX(const CompressedImage& image, std::vector<uint8_t>& out) {
+    if (image.empty()) return false;
+
+    // KTXorientation: 记录第一行对应图像顶部 (d) 还是底部 (u), 运行时据此判断能否直接使用
+    const char kKey[] = "KTXorientation";
+    const std::string value = image.flippedY ? "S=r,T=u" : "S=r,T=d";
+    const uint32_t pairLength = static_cast<uint32_t>(sizeof(kKey) + value.size() + 1);
+    const uint32_t pairPadded = (pairLength + 3) & ~3u;
+
+    KTX1Header header{};
+    std::memcpy(header.identifier, kKTX1Identifier, 12);
+    header.endianness            = kKTXEndianness;
+    header.glInternalFormat      = image.internalFormat;
+    header.glBaseInternalFormat  = image.hasAlpha ? GL_RGBA : GL_RGB;
+    header.pixelWidth            = static_cast<uint32_t>(image.width);
+    header.pixelHeight           = static_cast<uint32_t>(image.height);
+    header.numberOfFaces         = 1;
+    header.numberOfMipmapLevels  = static_cast<uint32_t>(image.levels.size());
+    header.bytesOfKeyValueData   = 4 + pairPadded;
+
+    auto append = [&out](const void* data, size_t size) {
+        const uint8_t* bytes = static_cast<const uint8_t*>(data);
+        out.insert(out.end(), bytes, bytes + size);
+    };
+    const char zeros[4] = { 0, 0, 0, 0 };
+    out.clear();
+    out.reserve(sizeof(header) + header.bytesOfKeyValueData + image.byteSize() + image.levels.size() * 8);
+    append(&header, sizeof(header));
+    append(&pairLength, 4);
+    append(kKey, sizeof(kKey));
+    append(value.c_str(), value.size() + 1);
+    append(zeros, pairPadded - pairLength);
+    for (const CompressedLevel& level : image.levels) {
+        const uint32_t imageSize = static_cast<uint32_t>(level.data.size());
+        append(&imageSize, 4);
+        append(level.data.data(), imageSize);
+        append(zeros, ((imageSize + 3) & ~3u) - imageSize);
+    }
+    return true;
+}
+
+} // namespace TextureFormat
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "macros.h"
+
+// GLES3 头文件和 glad 不一定包含 S3TC / ASTC 的枚举, 这里统一定义
+namespace GLCompressedFormat {
+    constexpr GLenum RGB8_ETC2            = 0x9274;
+    constexpr GLenum SRGB8_ETC2           = 0x9275;
+    constexpr GLenum RGBA8_ETC2_EAC       = 0x9278;
+    constexpr GLenum SRGB8_ALPHA8_ETC2    = 0x9279;
+    constexpr GLenum RGB_S3TC_DXT1        = 0x83F0;
+    constexpr GLenum RGBA_S3TC_DXT1       = 0x83F1;
+    constexpr GLenum RGBA_S3TC_DXT5       = 0x83F3;
+    constexpr GLenum SRGB_S3TC_DXT1       = 0x8C4C;
+    constexpr GLenum SRGB_ALPHA_S3TC_DXT5 = 0x8C4F;
+    constexpr GLenum RGBA_ASTC_4x4        = 0x93B0;
+    constexpr GLenum RGBA_ASTC_6x6        = 0x93B4;
+    constexpr GLenum RGBA_ASTC_8x8        = 0x93B7;
+    constexpr GLenum SRGB8_ALPHA8_ASTC_4x4 = 0x93D0;
+    constexpr GLenum SRGB8_ALPHA8_ASTC_6x6 = 0x93D4;
+    constexpr GLenum SRGB8_ALPHA8_ASTC_8x8 = 0x93D7;
+}
+
+// 压缩纹理族, 同时决定离线产物的文件名后缀 (<stem>.etc2.ktx 等)
+enum class TextureCodec : uint32_t {
+    None = 0,
+    ETC2 = 1,   // GLES 3.0 强制支持
+    BC   = 2,   // BC1 / BC3 (S3TC), 桌面端
+    ASTC = 3,   // 只读取, 需由外部编码器 (astcenc) 生成
+};
+
+// 当前 GL 上下文支持的压缩格式
+struct TextureCaps {
+    bool queried = false;
+    bool isES    = false;
+    bool etc2    = false;
+    bool bc      = false;
+    bool astc    = false;
+};
+
+// 一个 mip 层级的压缩数据
+struct CompressedLevel {
+    int width  = 0;
+    int height = 0;
+    std::vector<unsigned char> data;
+};
+
+// 完整 mip 链的压缩图像 (levels[0] 为最大层级)
+struct CompressedImage {
+    GLenum internalFormat = 0;
+    int width  = 0;
+    int height = 0;
+    bool hasAlpha = false;
+    bool flippedY = false;          // true: 第一行是图像底部 (KTXorientation T=u), 与 SOIL_FLAG_INVERT_Y 等价
+    std::vector<CompressedLevel> levels;
+
+    bool empty() const { return internalFormat == 0 || levels.empty(); }
+    size_t byteSize() const;
+};
+
+/**
+ * @brief 压缩纹理格式层
+ *
+ * - queryCapabilities(): GL 线程调用一次, 通过扩展串与 GL_COMPRESSED_TEXTURE_FORMATS 判断 ETC2/BC/ASTC
+ * - readKTX(): 解析 KTX1 / KTX2 (无超压缩) 容器, 读出完整 mip 链
+ * - writeKTX(): 写出 KTX1 容器, 供离线编码 (TextureEncoder) 使用
+ * - findCompressedVariant(): 按当前设备的优先级查找 <stem>.<codec>.ktx2 / .ktx (资源包内或磁盘上)
+ *
+ * 除 queryCapabilities 外均不触碰 GL, 可在工作线程调用。
+ */
+namespace TextureFormat {
+
+    // GL 线程: 查询并缓存压缩格式能力, 需在任何异步加载之前调用
+    void queryCapabilities();
+    const TextureCaps& capabilities();
+
+    // 设备可直接采样的格式族, 按优先级排序 (未查询时为空)
+    std::vector<TextureCodec> preferredCodecs();
+
+    const char* codecName(TextureCodec codec);
+
+    // 压缩格式的块尺寸与每块字节数; 不是已知压缩格式时返回 false
+    bool blockInfo(GLenum internalFormat, int& blockWidth, int& blockHeight, int& blockBytes);
+    size_t levelByteSize(GLenum internalFormat, int width, int height);
+    bool formatHasAlpha(GLenum internalFormat);
+    TextureCodec codecOf(GLenum internalFormat);
+
+    bool isKTXPath(const std::string& path);
+
+    // 查找源图旁边当前设备支持的预压缩版本, 找不到返回空串
+    std::string findCompressedVariant(const std::string& sourcePath);
+
+    // 离线产物路径: "dir/name.png" -> "dir/name.etc2.ktx"
+    std::string variantPath(const std::string& sourcePath, TextureCodec codec);
+
+    bool readKTX(const std::string& path, CompressedImage& out);
+    bool readKTX(const unsigned char* data, size_t size, CompressedImage& out);
+    bool writeKTX(const std::string& path, const CompressedImage& image);
+    // 写出到内存 (资源包烘焙使用), 内容与文件版本逐字节相同
+    bool writeKTX(const CompressedImage& image, std::vector<uint8_t>& out);
+
+} // namespace TextureFormat
@@ -0,0 +1,445 @@
+#include "TextureLoader.hpp"
+
+#include <chrono>
+#include <cstring>
+#include <SOIL2/SOIL2.h>
+
+#include "VirtualFileSystem.hpp"
+#include "AssetCache.hpp"
+
+namespace {
+// 每次 contextLost 加一; 纹理名只在创建它的上下文中有效
+std::atomic<uint32_t> g_contextGeneration{0};
+}
+
+TextureLoader& TextureLoader::getInstance() {
+    static TextureLoader instance;
+    return instance;
+}
+
+// 解码是 CPU 密集型工作, 留一个核心给渲染线程
+TextureLoader::TextureLoader()
+    : m_pool(ThreadPool::defaultThreadCount() > 1 ? ThreadPool::defaultThreadCount() - 1 : 1) {
+}
+
+// ---------------------------------------------------------------------------
+// Handle
+// ---------------------------------------------------------------------------
+
+TextureLoader::State TextureLoader::Handle::state() const {
+    return m_entry ? static_cast<State>(m_entry->state.load(std::memory_order_acquire)) : State::Failed;
+}
+
+GLuint TextureLoader::Handle::id() const {
+    if (!m_entry) return 0;
+    ensureName(*m_entry);
+    return m_entry->id;
+}
+
+void TextureLoader::destroy(const Handle& handle) {
+    if (!handle.m_entry || handle.m_entry->id == 0) return;
+    // 旧上下文的纹理名已随上下文释放, 当前上下文中的同一个名字可能属于其它纹理
+    if (handle.m_entry->context == g_contextGeneration.load()) {
+        glDeleteTextures(1, &handle.m_entry->id);
+    }
+    handle.m_entry->id = 0;
+}
+
+void TextureLoader::contextLost() {
+    g_contextGeneration.fetch_add(1);
+}
+
+// ---------------------------------------------------------------------------
+// 提交解码任务
+// ---------------------------------------------------------------------------
+
+TextureLoader::Handle TextureLoader::createEntry(GLenum target, const std::string& label, const Options& options, int faceCount) {
+    auto entry = std::make_shared<Entry>();
+    entry->target  = target;
+    entry->options = options;
+    entry->label   = label;
+    entry->faces.resize(faceCount);
+    entry->facesRemaining.store(faceCount);
+    m_pending.fetch_add(1);
+    return Handle(entry);
+}
+
+TextureLoader::Handle TextureLoader::load2D(const std::string& path, const Options& options) {
+    Handle handle = createEntry(GL_TEXTURE_2D, path, options, 1);
+    std::shared_ptr<Entry> entry = handle.m_entry;
+    m_pool.submit([this, entry, path]() {
+        entry->faces[0] = loadImageCached(path, entry->options);
+        if (!entry->faces[0]) {
+            LOGE("TextureLoader: failed to decode %s (%s)", path.c_str(), SOIL_last_result());
+        }
+        finishFace(entry);
+    });
+    return handle;
+}
+
+TextureLoader::Handle TextureLoader::load2DFromMemory(const std::string& label, const unsigned char* data, size_t size,
+                                                      const Options& options, const std::string& contentKey) {
+    Handle handle = createEntry(GL_TEXTURE_2D, label, options, 1);
+    std::shared_ptr<Entry> entry = handle.m_entry;
+    const std::string cacheKey = contentKey.empty() ? std::string() : "image:memory:" + contentKey;
+    if (!cacheKey.empty()) {
+        if (std::shared_ptr<const Image> cached = AssetCache::getInstance().find<Image>(cacheKey)) {
+            entry->faces[0] = std::move(cached);
+            finishFace(entry);
+            return handle;
+        }
+    }
+    // 数据源 (如 aiScene 的嵌入纹理) 可能在解码完成前释放, 先拷贝压缩字节
+    auto bytes = std::make_shared<std::vector<unsigned char>>(data, data + size);
+    m_pool.submit([this, entry, bytes, cacheKey]() {
+        auto image = std::make_shared<Image>();
+        if (!decodeMemory(bytes->data(), bytes->size(), entry->options.flipVertically, *image)) {
+            LOGE("TextureLoader: failed to decode %s from memory (%s)", entry->label.c_str(), SOIL_last_result());
+        } else {
+            prepareMips(*image, entry->options);
+            if (!cacheKey.empty() && entry->options.cacheDecoded) {
+                AssetCache::getInstance().insert<Image>(cacheKey, image, image->byteSize());
+            }
+            entry->faces[0] = std::move(image);
+        }
+        finishFace(entry);
+    });
+    return handle;
+}
+
+TextureLoader::Handle TextureLoader::loadCubemap(const std::array<std::string, 6>& faces, const Options& options) {
+    Handle handle = createEntry(GL_TEXTURE_CUBE_MAP, faces[0], options, 6);
+    std::shared_ptr<Entry> entry = handle.m_entry;
+    for (size_t face = 0; face < faces.size(); ++face) {
+        const std::string path = faces[face];
+        m_pool.submit([this, entry, face, path]() {
+            entry->faces[face] = loadImageCached(path, entry->options);
+            if (!entry->faces[face]) {
+                LOGE("TextureLoader: cubemap face failed to load at path: %s", path.c_str());
+            }
+            finishFace(entry);
+        });
+    }
+    return handle;
+}
+
+// 工作线程: 最后一个完成的面负责把纹理放入上传队列
+void TextureLoader::finishFace(const std::shared_ptr<Entry>& entry) {
+    if (entry->facesRemaining.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+
+    entry->state.store(static_cast<int>(State::Queued), std::memory_order_release);
+    std::lock_guard<std::mutex> lock(m_queueMutex);
+    m_uploadQueue.push_back(entry);
+}
+
+// ---------------------------------------------------------------------------
+// GL 线程
+// ---------------------------------------------------------------------------
+
+size_t TextureLoader::pumpUploads(size_t maxBytes) {
+    std::deque<std::shared_ptr<Entry>> batch;
+    {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        if (m_uploadQueue.empty()) return 0;
+        batch.swap(m_uploadQueue);
+    }
+
+    auto uploadStart = std::chrono::high_resolution_clock::now();
+    size_t uploaded = 0;
+    size_t bytes = 0;
+    while (!batch.empty()) {
+        std::shared_ptr<Entry> entry = batch.front();
+        size_t entryBytes = 0;
+        for (const std::shared_ptr<const Image>& face : entry->faces) {
+            if (face) entryBytes += face->byteSize();
+        }
+        if (uploaded > 0 && bytes + entryBytes > maxBytes) break;
+
+        batch.pop_front();
+        upload(*entry);
+        bytes += entryBytes;
+        ++uploaded;
+        m_pending.fetch_sub(1);
+    }
+
+    // 超出预算的部分留到下一帧, 保持原有顺序
+    if (!batch.empty()) {
+        std::lock_guard<std::mutex> lock(m_queueMutex);
+        m_uploadQueue.insert(m_uploadQueue.begin(), batch.begin(), batch.end());
+    }
+
+    LOGI("TextureLoader: uploaded %d textures (%d KB) in %lld ms, %d pending",
+         static_cast<int>(uploaded), static_cast<int>(bytes / 1024),
+         static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::high_resolution_clock::now() - uploadStart).count()),
+         static_cast<int>(m_pending.load()));
+    return uploaded;
+}
+
+// 首次使用时创建纹理名, 用 1x1 白色像素占位, 保证采样结果确定且纹理完整
+void TextureLoader::ensureName(Entry& entry) {
+    const uint32_t context = g_contextGeneration.load();
+    if (entry.id != 0 && entry.context == context) return;
+
+    static const unsigned char kPlaceholder[4] = { 255, 255, 255, 255 };
+    glGenTextures(1, &entry.id);
+    entry.context = context;
+    glBindTexture(entry.target, entry.id);
+    if (entry.target == GL_TEXTURE_CUBE_MAP) {
+        for (GLenum face = 0; face < 6; ++face) {
+            glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + face, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, kPlaceholder);
+        }
+    } else {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, kPlaceholder);
+    }
+    // 占位纹理没有 mipmap, 先使用不依赖 mipmap 的过滤方式
+    glTexParameteri(entry.target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(entry.target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(entry.target, 0);
+}
+
+void TextureLoader::upload(Entry& entry) {
+    ensureName(entry);
+
+    bool complete = true;
+    for (const std::shared_ptr<const Image>& face : entry.faces) {
+        if (!face || face->empty()) {
+            complete = false;
+            break;
+        }
+        // 立方体贴图各面必须格式一致: 只压缩了部分面时同样视为失败
+        if (face->compressed.internalFormat != entry.faces[0]->compressed.internalFormat) {
+            LOGE("TextureLoader: %s mixes compressed and uncompressed faces", entry.label.c_str());
+            complete = false;
+        }
+    }
+    if (!complete) {
+        // 任一面解码失败: 保留占位内容, 不上传不完整的立方体贴图
+        entry.faces.clear();
+        entry.faces.shrink_to_fit();
+        entry.state.store(static_cast<int>(State::Failed), std::memory_order_release);
+        return;
+    }
+    if (entry.faces[0]->isCompressed()) {
+        uploadCompressed(entry);
+        return;
+    }
+
+    const Options& options = entry.options;
+    bool cpuMips = options.generateMipmap;
+    glBindTexture(entry.target, entry.id);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);     // RGB 行宽不一定是 4 字节对齐
+    for (size_t i = 0; i < entry.faces.size(); ++i) {
+        const Image& face = *entry.faces[i];
+        const GLenum format = (face.channels == 4) ? GL_RGBA : GL_RGB;
+        const GLenum target = entry.target == GL_TEXTURE_CUBE_MAP
+            ? static_cast<GLenum>(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i) : GL_TEXTURE_2D;
+        glTexImage2D(target, 0, format, face.width, face.height, 0, format, GL_UNSIGNED_BYTE, face.pixels.data());
+        // 工作线程已生成的 mip 链逐级上传
+        for (size_t level = 0; level < face.mips.size(); ++level) {
+            const MipGenerator::Level& mip = face.mips[level];
+            glTexImage2D(target, static_cast<GLint>(level + 1), format, mip.width, mip.height, 0, format, GL_UNSIGNED_BYTE,
+                         mip.pixels.data());
+        }
+        cpuMips = cpuMips && !face.mips.empty();
+    }
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+    // 回退: 未在 CPU 生成 (cpuMipmaps = false 或生成失败) 时由驱动生成
+    if (options.generateMipmap && !cpuMips) {
+        glGenerateMipmap(entry.target);
+    }
+    glTexParameteri(entry.target, GL_TEXTURE_WRAP_S, options.wrapS);
+    glTexParameteri(entry.target, GL_TEXTURE_WRAP_T, options.wrapT);
+    if (entry.target == GL_TEXTURE_CUBE_MAP) {
+        glTexParameteri(entry.target, GL_TEXTURE_WRAP_R, options.wrapS);
+    }
+    // 没有 mipmap 时不能使用 *_MIPMAP_* 缩小过滤, 否则纹理不完整
+    GLint minFilter = options.minFilter;
+    if (!options.generateMipmap && minFilter != GL_NEAREST && minFilter != GL_LINEAR) {
+        minFilter = GL_LINEAR;
+    }
+    glTexParameteri(entry.target, GL_TEXTURE_MIN_FILTER, minFilter);
+    glTexParameteri(entry.target, GL_TEXTURE_MAG_FILTER, options.magFilter);
+    glBindTexture(entry.target, 0);
+
+    entry.width    = entry.faces[0]->width;
+    entry.height   = entry.faces[0]->height;
+    entry.channels = entry.faces[0]->channels;
+    entry.gpuBytes = static_cast<size_t>(entry.width) * entry.height * entry.channels * entry.faces.size();
+    if (options.generateMipmap) entry.gpuBytes = entry.gpuBytes * 4 / 3;
+    // 像素已经交给驱动 (cacheDecoded 时 AssetCache 中还有一份副本留给之后的渲染器)
+    entry.faces.clear();
+    entry.faces.shrink_to_fit();
+    entry.state.store(static_cast<int>(State::Ready), std::memory_order_release);
+}
+
+// 预压缩纹理: 逐层上传文件中的 mip 链, 不再运行时生成 mipmap
+void TextureLoader::uploadCompressed(Entry& entry) {
+    const Options& options = entry.options;
+    const CompressedImage& first = entry.faces[0]->compressed;
+    const GLint levelCount = static_cast<GLint>(first.levels.size());
+
+    glBindTexture(entry.target, entry.id);
+    for (size_t i = 0; i < entry.faces.size(); ++i) {
+        const CompressedImage& image = entry.faces[i]->compressed;
+        const GLenum target = entry.target == GL_TEXTURE_CUBE_MAP
+            ? static_cast<GLenum>(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i) : GL_TEXTURE_2D;
+        for (GLint level = 0; level < static_cast<GLint>(image.levels.size()); ++level) {
+            const CompressedLevel& data = image.levels[level];
+            glCompressedTexImage2D(target, level, image.internalFormat, data.width, data.height, 0,
+                                   static_cast<GLsizei>(data.data.size()), data.data.data());
+        }
+    }
+    glTexParameteri(entry.target, GL_TEXTURE_BASE_LEVEL, 0);
+    glTexParameteri(entry.target, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+    glTexParameteri(entry.target, GL_TEXTURE_WRAP_S, options.wrapS);
+    glTexParameteri(entry.target, GL_TEXTURE_WRAP_T, options.wrapT);
+    if (entry.target == GL_TEXTURE_CUBE_MAP) {
+        glTexParameteri(entry.target, GL_TEXTURE_WRAP_R, options.wrapS);
+    }
+    GLint minFilter = options.minFilter;
+    if (levelCount == 1 && minFilter != GL_NEAREST && minFilter != GL_LINEAR) {
+        minFilter = GL_LINEAR;
+    }
+    glTexParameteri(entry.target, GL_TEXTURE_MIN_FILTER, minFilter);
+    glTexParameteri(entry.target, GL_TEXTURE_MAG_FILTER, options.magFilter);
+    glBindTexture(entry.target, 0);
+
+    size_t compressedBytes = 0;
+    for (const std::shared_ptr<const Image>& face : entry.faces) compressedBytes += face->compressed.byteSize();
+    const size_t rgbaBytes = static_cast<size_t>(first.width) * first.height * 4 * entry.faces.size() * 4 / 3;
+    LOGI("TextureLoader: %s uploaded as %s 0x%x (%d levels, %d KB, RGBA8 equivalent %d KB)",
+         entry.label.c_str(), TextureFormat::codecName(TextureFormat::codecOf(first.internalFormat)), first.internalFormat,
+         static_cast<int>(levelCount), static_cast<int>(compressedBytes / 1024), static_cast<int>(rgbaBytes / 1024));
+
+    entry.width    = first.width;
+    entry.height   = first.height;
+    entry.channels = first.hasAlpha ? 4 : 3;
+    entry.gpuBytes = compressedBytes;
+    entry.faces.clear();
+    entry.faces.shrink_to_fit();
+    entry.state.store(static_cast<int>(State::Ready), std::memory_order_release);
+}
+
+// ---------------------------------------------------------------------------
+// 解码 (工作线程)
+// ---------------------------------------------------------------------------
+
+bool TextureLoader::loadImage(const std::string& path, const Options& options, Image& out) {
+    // 直接指定的 KTX: 方向以文件为准, 无法按选项翻转
+    if (TextureFormat::isKTXPath(path)) {
+        if (!TextureFormat::readKTX(path, out.compressed)) return false;
+        out.width    = out.compressed.width;
+        out.height   = out.compressed.height;
+        out.channels = out.compressed.hasAlpha ? 4 : 3;
+        return true;
+    }
+
+    if (options.allowCompressed) {
+        const std::string variant = TextureFormat::findCompressedVariant(path);
+        if (!variant.empty()) {
+            CompressedImage compressed;
+            // 压缩块无法廉价地上下翻转, 方向不一致时回退到源图
+            if (TextureFormat::readKTX(variant, compressed)) {
+                if (compressed.flippedY == options.flipVertically &&
+                    (!options.generateMipmap || compressed.levels.size() > 1)) {
+                    out.width      = compressed.width;
+                    out.height     = compressed.height;
+                    out.channels   = compressed.hasAlpha ? 4 : 3;
+                    out.compressed = std::move(compressed);
+                    return true;
+                }
+                LOGE("TextureLoader: %s does not match the requested orientation/mipmaps, using source image", variant.c_str());
+            }
+        }
+    }
+    if (!decodeFile(path, options.flipVertically, out)) return false;
+    prepareMips(out, options);
+    return true;
+}
+
+std::shared_ptr<const TextureLoader::Image> TextureLoader::loadImageCached(const std::string& path, const Options& options) {
+    const std::string key = imageCacheKey(path, options);
+    if (!key.empty()) {
+        if (std::shared_ptr<const Image> cached = AssetCache::getInstance().find<Image>(key)) {
+            return cached;
+        }
+    }
+    auto image = std::make_shared<Image>();
+    if (!loadImage(path, options, *image)) return nullptr;
+    if (!key.empty() && options.cacheDecoded) {
+        AssetCache::getInstance().insert<Image>(key, image, image->byteSize());
+    }
+    return image;
+}
+
+// 采样参数 (wrap / filter) 不影响解码结果, 不计入键
+std::string TextureLoader::imageCacheKey(const std::string& path, const Options& options) {
+    uint64_t fileSize = 0;
+    int64_t fileMTime = 0;
+    if (!VirtualFileSystem::getInstance().stat(path, fileSize, fileMTime)) return std::string();
+
+    const unsigned flags = (options.flipVertically ? 1u : 0u) | (options.generateMipmap ? 2u : 0u) |
+                           (options.allowCompressed ? 4u : 0u) | (options.cpuMipmaps ? 8u : 0u) | (options.srgb ? 16u : 0u);
+    return "image:" + path + "#" + std::to_string(fileSize) + ":" + std::to_string(fileMTime) + ":" + std::to_string(flags);
+}
+
+void TextureLoader::prepareMips(Image& image, const Options& options) {
+    if (!options.generateMipmap || !options.cpuMipmaps || image.pixels.empty()) return;
+    if (!MipGenerator::generate(image.pixels.data(), image.width, image.height, image.channels, options.srgb, image.mips)) {
+        image.mips.clear();
+    }
+}
+
+// 源图通过虚拟文件系统映射 (资源包内或磁盘上), 压缩字节不再经过 stdio 读取
+bool TextureLoader::decodeFile(const std::string& path, bool flipVertically, Image& out) {
+    AssetFile file;
+    if (!file.open(path)) return false;
+    return decodeMemory(file.data(), file.size(), flipVertically, out);
+}
+
+bool TextureLoader::decodeMemory(const unsigned char* bytes, size_t size, bool flipVertically, Image& out) {
+    unsigned char* data = SOIL_load_image_from_memory(bytes, static_cast<int>(size),
+                                                      &out.width, &out.height, &out.channels, SOIL_LOAD_AUTO);
+    if (!data) return false;
+
+    out.pixels.assign(data, data + static_cast<size_t>(out.width) * out.height * out.channels);
+    SOIL_free_image_data(data);
+    if (flipVertically) flipRowsVertically(out);
+    expandToRGB(out);
+    return true;
+}
+
+void TextureLoader::flipRowsVertically(Image& image) {
+    const size_t rowBytes = static_cast<size_t>(image.width) * image.channels;
+    std::vector<unsigned char> row(rowBytes);
+    for (int top = 0, bottom = image.height - 1; top < bottom; ++top, --bottom) {
+        unsigned char* a = image.pixels.data() + rowBytes * top;
+        unsigned char* b = image.pixels.data() + rowBytes * bottom;
+        std::memcpy(row.data(), a, rowBytes);
+        std::memcpy(a, b, rowBytes);
+        std::memcpy(b, row.data(), rowBytes);
+    }
+}
+
+// 灰度/灰度+Alpha 在 Core Profile 下没有对应的 LUMINANCE 格式, 解码阶段统一展开为 RGB/RGBA
+void TextureLoader::expandToRGB(Image& image) {
+    if (image.channels >= 3) return;
+
+    const bool hasAlpha = (image.channels == 2);
+    const int outChannels = hasAlpha ? 4 : 3;
+    const size_t pixelCount = static_cast<size_t>(image.width) * image.height;
+    std::vector<unsigned char> expanded(pixelCount * outChannels);
+    for (size_t i = 0; i < pixelCount; ++i) {
+        const unsigned char luminance = image.pixels[i * image.channels];
+        expanded[i * outChannels + 0] = luminance;
+        expanded[i * outChannels + 1] = luminance;
+        expanded[i * outChannels + 2] = luminance;
+        if (hasAlpha) {
+            expanded[i * outChannels + 3] = image.pixels[i * image.channels + 1];
+        }
+    }
+    image.pixels.swap(expanded);
+    image.channels = outChannels;
+}
@@ -0,0 +1,192 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "macros.h"
+#include "ThreadPool.hpp"
+#include "TextureFormat.hpp"
+#include "MipGenerator.hpp"
+
+// 纹理采样与加载选项
+struct TextureLoadOptions {
+    bool flipVertically = false;    // 等价于 SOIL_FLAG_INVERT_Y
+    bool generateMipmap = true;
+    GLint wrapS     = GL_REPEAT;       // 立方体贴图的 R 方向同 wrapS
+    GLint wrapT     = GL_REPEAT;
+    GLint minFilter = GL_LINEAR_MIPMAP_LINEAR;
+    GLint magFilter = GL_LINEAR;
+    bool allowCompressed = true;    // 优先使用设备支持的预压缩版本 (<stem>.etc2.ktx 等)
+    bool cpuMipmaps = true;         // 在解码线程生成 mip 链并逐级上传; false 时回退到 glGenerateMipmap
+    bool srgb = false;              // 颜色纹理: mip 在线性空间平均 (法线/遮罩保持 false)
+    bool cacheDecoded = false;      // 解码结果放入进程级 AssetCache (上传后 CPU 侧仍保留一份像素, 渲染器重建时跳过解码)
+};
+
+/**
+ * @brief 统一的纹理加载管线 - 单例模式
+ *
+ * Model / GlobalTextureManager / Skybox 共用:
+ * - 解码 (JPEG/PNG 等, SOIL2) 在线程池中并行执行, 天空盒的 6 个面各自独立解码
+ * - 解码完成的图像进入上传队列, 只在 GL 线程的 pumpUploads() 中调用 glTexImage2D
+ * - load* 立即返回句柄; GL 纹理名在首次 id() 时创建并填充 1x1 占位像素,
+ *   上传完成后同一个纹理名直接换成真实内容, 调用方无需重新绑定
+ *
+ * - 若 TextureFormat::queryCapabilities() 已调用, 源图旁边存在设备支持的预压缩 KTX 时直接使用,
+ *   以 glCompressedTexImage2D 上传完整 mip 链; 也可以直接加载 .ktx / .ktx2 路径
+ * - 总是先查进程级 AssetCache; Options::cacheDecoded 为 true 时解码结果 (含 mip 链) 也放入缓存,
+ *   渲染器重建后再次加载同一图像时跳过解码, 只重新上传
+ *
+ * load* 可以在任意线程调用 (不触碰 GL), id() / pumpUploads() 只能在 GL 线程调用。
+ */
+class TextureLoader {
+public:
+    using Options = TextureLoadOptions;
+
+    // 解码后的 CPU 图像 (灰度/灰度+Alpha 已展开为 RGB/RGBA); 来自 KTX 时像素在 compressed 中
+    struct Image {
+        int width = 0;
+        int height = 0;
+        int channels = 0;
+        std::vector<unsigned char> pixels;
+        std::vector<MipGenerator::Level> mips;  // level 1 .. 1x1, 为空时由 GL 生成
+        CompressedImage compressed;
+
+        bool isCompressed() const { return !compressed.empty(); }
+        bool empty() const { return pixels.empty() && compressed.empty(); }
+        size_t byteSize() const {
+            size_t bytes = pixels.size() + compressed.byteSize();
+            for (const MipGenerator::Level& level : mips) bytes += level.pixels.size();
+            return bytes;
+        }
+    };
+
+    enum class State : int {
+        Decoding = 0,   // 在线程池中解码
+        Queued   = 1,   // 等待 GL 线程上传
+        Ready    = 2,   // 已上传
+        Failed   = 3,   // 解码失败, 纹理保持占位内容
+    };
+
+private:
+    struct Entry {
+        GLenum target = GL_TEXTURE_2D;
+        Options options;
+        std::string label;                      // 日志用 (文件路径或键名)
+        std::atomic<int> state{static_cast<int>(State::Decoding)};
+        std::atomic<int> facesRemaining{1};
+        // GL_TEXTURE_2D 为 1 个, 立方体贴图为 6 个; 与 AssetCache 共享, 解码失败时为空指针
+        std::vector<std::shared_ptr<const Image>> faces;
+        int width = 0;                          // 上传后有效
+        int height = 0;
+        int channels = 0;
+        size_t gpuBytes = 0;                    // 上传后估算的显存占用 (含 mip 链)
+        GLuint id = 0;                          // 只在 GL 线程读写
+        uint32_t context = 0;                   // id 所属的 GL 上下文 (contextLost 的计数)
+    };
+
+public:
+    /**
+     * @brief 纹理句柄 (可拷贝, 共享同一份加载状态)
+     */
+    class Handle {
+    public:
+        Handle() = default;
+
+        bool valid() const { return m_entry != nullptr; }
+        State state() const;
+        bool ready() const { return state() == State::Ready; }
+        // 已上传或已失败: 不会再有上传任务引用这个纹理名
+        bool settled() const { return state() == State::Ready || state() == State::Failed; }
+
+        // GL 线程调用: 返回纹理名, 尚未上传时先创建 1x1 占位纹理
+        GLuint id() const;
+        GLenum target() const { return m_entry ? m_entry->target : GL_TEXTURE_2D; }
+
+        // 上传完成前为 0
+        int width() const    { return ready() ? m_entry->width : 0; }
+        int height() const   { return ready() ? m_entry->height : 0; }
+        int channels() const { return ready() ? m_entry->channels : 0; }
+        size_t gpuBytes() const { return ready() ? m_entry->gpuBytes : 0; }
+
+    private:
+        friend class TextureLoader;
+        explicit Handle(std::shared_ptr<Entry> entry) : m_entry(std::move(entry)) {}
+        std::shared_ptr<Entry> m_entry;
+    };
+
+    static TextureLoader& getInstance();
+
+    TextureLoader(const TextureLoader&) = delete;
+    TextureLoader& operator=(const TextureLoader&) = delete;
+
+    // 从文件异步加载 2D 纹理
+    Handle load2D(const std::string& path, const Options& options = Options());
+
+    /**
+     * @brief 从内存中的压缩图像 (png/jpg 字节流) 异步加载 2D 纹理, data 会被拷贝
+     * @param contentKey 非空时作为解码结果在 AssetCache 中的键 (调用方保证同一内容 + 选项得到同一个键),
+     *        只有 options.cacheDecoded 时才放入缓存
+     */
+    Handle load2DFromMemory(const std::string& label, const unsigned char* data, size_t size,
+                            const Options& options = Options(), const std::string& contentKey = std::string());
+
+    // 异步加载立方体贴图, 顺序为 +X, -X, +Y, -Y, +Z, -Z; 6 个面并行解码, 全部完成后一次上传
+    Handle loadCubemap(const std::array<std::string, 6>& faces, const Options& options = Options());
+
+    /**
+     * @brief GL 线程每帧调用: 上传已解码完成的纹理
+     * @param maxBytes 本次最多上传的像素字节数 (至少上传一个), 用于限制单帧卡顿
+     * @return 本次上传的纹理数
+     */
+    size_t pumpUploads(size_t maxBytes = SIZE_MAX);
+
+    /**
+     * @brief GL 线程: 删除句柄对应的纹理名 (要求 settled(), 否则后续上传会重新创建纹理名)
+     */
+    static void destroy(const Handle& handle);
+
+    /**
+     * @brief GL 上下文销毁时调用: 此前创建的纹理名全部作废 (随上下文一起释放, 不再 glDeleteTextures),
+     *        之后仍被使用的纹理 (如等待上传的条目) 在新上下文中重新创建纹理名
+     */
+    static void contextLost();
+
+    // 尚未上传的纹理数 (解码中 + 等待上传)
+    size_t pendingCount() const { return m_pending.load(); }
+
+    // 解码辅助函数 (线程安全)
+    static bool decodeFile(const std::string& path, bool flipVertically, Image& out);
+    static bool decodeMemory(const unsigned char* data, size_t size, bool flipVertically, Image& out);
+    // 按选项加载一个面: 预压缩版本 / KTX 优先, 否则解码源图
+    static bool loadImage(const std::string& path, const Options& options, Image& out);
+    // 同 loadImage, 先查 AssetCache, 未命中时解码 (cacheDecoded 时放入缓存); 失败返回空指针
+    static std::shared_ptr<const Image> loadImageCached(const std::string& path, const Options& options);
+    // 解码结果在 AssetCache 中的键: 路径 + 文件大小/修改时间 + 影响像素的选项; 文件不存在时为空
+    static std::string imageCacheKey(const std::string& path, const Options& options);
+    // 按选项在当前 (工作) 线程生成 mip 链
+    static void prepareMips(Image& image, const Options& options);
+    static void flipRowsVertically(Image& image);
+    static void expandToRGB(Image& image);
+
+private:
+    TextureLoader();
+    ~TextureLoader() = default;
+
+    Handle createEntry(GLenum target, const std::string& label, const Options& options, int faceCount);
+    void finishFace(const std::shared_ptr<Entry>& entry);
+    static void ensureName(Entry& entry);
+    static void upload(Entry& entry);
+    static void uploadCompressed(Entry& entry);
+
+    ThreadPool m_pool;
+    std::mutex m_queueMutex;
+    std::deque<std::shared_ptr<Entry>> m_uploadQueue;
+    std::atomic<size_t> m_pending{0};
+};
@@ -3,9 +3,7 @@
 #include <fstream>
 #include <algorithm>
 #include <filesystem>
-
-// 使用项目中已有的STB图片加载库
-#include "../3rdparty/SOIL2/stb_image.h"
+#include "VirtualFileSystem.hpp"
 
 // 日志宏定义
 #ifdef ANDROID
@@ -26,6 +24,11 @@ GlobalTextureManager& GlobalTextureManager::getInstance() {
     return instance;
 }
 
+// 先构造 TextureCache, 保证析构 (cleanup 释放引用) 时缓存仍然存在
+GlobalTextureManager::GlobalTextureManager() {
+    TextureCache::getInstance();
+}
+
 GlobalTextureManager::~GlobalTextureManager() {
     cleanup();
 }
@@ -40,8 +43,8 @@ bool GlobalTextureManager::initialize() {
     glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &m_maxTextureUnits);
     LOGI("GlobalTextureManager initialized. Max texture units: %d", m_maxTextureUnits);
 
-    // 设置stb_image垂直翻转（OpenGL纹理坐标系）
-    stbi_set_flip_vertically_on_load(true);
+    // 垂直翻转（OpenGL纹理坐标系）改为逐个请求设置 (TextureLoader::Options::flipVertically),
+    // 不再修改 stb_image 的全局状态, 避免影响其它组件的解码结果
 
     m_initialized = true;
     return true;
@@ -71,39 +74,25 @@ bool GlobalTextureManager::loadTexture(const std::string& filePath,
         return true;
     }
 
-    // 加载图片数据
-    int width, height, channels;
-    unsigned char* data = loadImageData(filePath, width, height, channels);
-    if (!data) {
-        LOGE("Failed to load image: %s", filePath.c_str());
-        return false;
-    }
-
-    // 创建OpenGL纹理
-    GLuint textureId = createGLTexture(data, width, height, channels, generateMipmap);
-
-    // 释放图片数据
-    freeImageData(data);
-
-    if (textureId == 0) {
-        LOGE("Failed to create OpenGL texture for: %s", filePath.c_str());
-        return false;
-    }
+    // 解码在线程池中进行, 上传由 GL 线程的 TextureLoader::pumpUploads 完成
+    TextureLoader::Options options;
+    options.flipVertically = true;
+    options.generateMipmap = generateMipmap;
+    options.wrapS = m_defaultWrapS;
+    options.wrapT = m_defaultWrapT;
+    options.minFilter = m_defaultMinFilter;
+    options.magFilter = m_defaultMagFilter;
 
     // 存储纹理信息
     auto textureInfo = std::make_unique<TextureInfo>();
-    textureInfo->textureId = textureId;
-    textureInfo->width = width;
-    textureInfo->height = height;
-    textureInfo->channels = channels;
-    textureInfo->format = getGLFormat(channels);
+    textureInfo->texture = TextureCache::getInstance().acquire(filePath, options);
+    textureInfo->textureId = textureInfo->texture.id();     // 占位纹理, 上传后同一纹理名换成真实内容
     textureInfo->filePath = filePath;
     textureInfo->referenceCount = 1; // 初始引用计数为1
 
     m_textures[key] = std::move(textureInfo);
 
-    LOGI("Texture loaded successfully: %s (%dx%d, %d channels, refs: 1)",
-         key.c_str(), width, height, channels);
+    LOGI("Texture queued for async load: %s (refs: 1)", key.c_str());
 
     return true;
 }
@@ -163,7 +152,8 @@ bool GlobalTextureManager::bindToShader(const std::string& textureKey,
 void GlobalTextureManager::activateTextures() {
     for (const auto& texturePair : m_textures) {
         const std::string& textureKey = texturePair.first;
-        const TextureInfo* textureInfo = texturePair.second.get();
+        TextureInfo* textureInfo = texturePair.second.get();
+        syncTextureInfo(*textureInfo);
 
         // 查找该纹理的所有绑定
         auto bindingIt = m_shaderBindings.find(textureKey);
@@ -238,10 +228,7 @@ bool GlobalTextureManager::removeTextureInternal(const std::string& textureKey)
         return false;
     }
 
-    // 删除OpenGL纹理
-    if (it->second->textureId != 0) {
-        glDeleteTextures(1, &it->second->textureId);
-    }
+    // GL 纹理可能仍被模型共享, 由 TextureCache 在最后一个引用释放后删除
 
     // 移除绑定信息
     m_shaderBindings.erase(textureKey);
@@ -254,13 +241,7 @@ bool GlobalTextureManager::removeTextureInternal(const std::string& textureKey)
 }
 
 void GlobalTextureManager::cleanup() {
-    // 删除所有OpenGL纹理
-    for (const auto& pair : m_textures) {
-        if (pair.second->textureId != 0) {
-            glDeleteTextures(1, &pair.second->textureId);
-        }
-    }
-
+    // 释放全部缓存引用, GL 纹理由 TextureCache::collectGarbage 删除
     m_textures.clear();
     m_shaderBindings.clear();
     m_nextTextureUnit = 0;
@@ -323,47 +304,17 @@ std::string GlobalTextureManager::getUsageStatistics() const {
     return std::string(buffer);
 }
 
-unsigned char* GlobalTextureManager::loadImageData(const std::string& filePath,
-                                                   int& width, int& height, int& channels) {
-    return stbi_load(filePath.c_str(), &width, &height, &channels, 0);
-}
-
-void GlobalTextureManager::freeImageData(unsigned char* data) {
-    if (data) {
-        stbi_image_free(data);
+void GlobalTextureManager::syncTextureInfo(TextureInfo& info) const {
+    const TextureLoader::Handle& handle = info.texture.handle();
+    if (info.width != 0 || !handle.ready()) {
+        return;
     }
-}
-
-GLuint GlobalTextureManager::createGLTexture(unsigned char* data, int width, int height,
-                                           int channels, bool generateMipmap) {
-    GLuint textureId;
-    glGenTextures(1, &textureId);
-    glBindTexture(GL_TEXTURE_2D, textureId);
-
-    // 设置纹理参数
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_defaultWrapS);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_defaultWrapT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_defaultMinFilter);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_defaultMagFilter);
-
-    // 上传纹理数据
-    GLenum format = getGLFormat(channels);
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-
-    // 生成Mipmap
-    if (generateMipmap) {
-        glGenerateMipmap(GL_TEXTURE_2D);
-    }
-
-    // 检查OpenGL错误
-    GLenum error = glGetError();
-    if (error != GL_NO_ERROR) {
-        LOGE("OpenGL error creating texture: 0x%x", error);
-        glDeleteTextures(1, &textureId);
-        return 0;
-    }
-
-    return textureId;
+    info.width = handle.width();
+    info.height = handle.height();
+    info.channels = handle.channels();
+    info.format = getGLFormat(info.channels);
+    LOGI("Texture uploaded: %s (%dx%d, %d channels)",
+         info.filePath.c_str(), info.width, info.height, info.channels);
 }
 
 GLenum GlobalTextureManager::getGLFormat(int channels) const {
@@ -393,7 +344,6 @@ bool GlobalTextureManager::validateFilePath(const std::string& filePath) const {
         return false;
     }
 
-    // 检查文件是否存在
-    std::ifstream file(filePath);
-    return file.good();
+    // 检查文件是否存在 (资源包内或磁盘上)
+    return VirtualFileSystem::getInstance().exists(filePath);
 }
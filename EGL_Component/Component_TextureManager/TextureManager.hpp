@@ -5,6 +5,7 @@
 #include <memory>
 #include <vector>
 #include "macros.h"
+#include "TextureCache.hpp"
 
 /**
  * @brief 全局纹理管理器 - 单例模式
@@ -17,6 +18,8 @@
  * - 资源去重：自动检测并避免重复加载相同纹理
  * - 延迟初始化：在首次使用时才创建实例
  * - 自动清理：程序结束时自动释放所有资源
+ * - 异步加载：解码交给 TextureLoader 的线程池, 纹理名立即可用, 像素在后续帧上传
+ * - 共享缓存：纹理来自 TextureCache, 与模型加载器引用同一图像时只上传一次
  *
  * 使用场景：
  * - UI纹理、背景纹理、粒子纹理等独立纹理
@@ -30,12 +33,13 @@ public:
      */
     struct TextureInfo {
         GLuint textureId = 0;           // OpenGL纹理ID
-        int width = 0;                  // 纹理宽度
+        int width = 0;                  // 纹理宽度 (上传完成前为 0)
         int height = 0;                 // 纹理高度
         int channels = 0;               // 通道数
         GLenum format = GL_RGB;         // 纹理格式
         std::string filePath;           // 原始文件路径
         size_t referenceCount = 0;      // 引用计数
+        TextureCache::Ref texture;      // 缓存引用, 释放后由 TextureCache 删除 GL 纹理
 
         bool isValid() const { return textureId != 0; }
     };
@@ -82,8 +86,8 @@ public:
      * @param filePath 图片文件路径（支持相对路径和绝对路径）
      * @param textureKey 纹理的唯一标识符（可选，默认使用文件路径）
      * @param generateMipmap 是否生成Mipmap（默认true）
-     * @return true 加载成功
-     * @return false 加载失败
+     * @return true 已提交加载 (纹理名立即可用, 解码完成前为占位内容)
+     * @return false 未初始化或文件不存在
      */
     bool loadTexture(const std::string& filePath,
                     const std::string& textureKey = "",
@@ -198,7 +202,7 @@ private:
     /**
      * @brief 私有构造函数（单例模式）
      */
-    GlobalTextureManager() = default;
+    GlobalTextureManager();
 
     /**
      * @brief 析构函数 - 自动清理所有纹理资源
@@ -206,39 +210,9 @@ private:
     ~GlobalTextureManager();
 
     /**
-     * @brief 从文件加载图片数据
-     *
-     * @param filePath 文件路径
-     * @param width 输出宽度
-     * @param height 输出高度
-     * @param channels 输出通道数
-     * @return unsigned char* 图片数据指针，使用后需要释放
-     */
-    unsigned char* loadImageData(const std::string& filePath,
-                                int& width,
-                                int& height,
-                                int& channels);
-
-    /**
-     * @brief 释放图片数据
-     */
-    void freeImageData(unsigned char* data);
-
-    /**
-     * @brief 创建OpenGL纹理
-     *
-     * @param data 图片数据
-     * @param width 宽度
-     * @param height 高度
-     * @param channels 通道数
-     * @param generateMipmap 是否生成Mipmap
-     * @return GLuint 纹理ID，0表示失败
+     * @brief 纹理上传完成后把尺寸/格式同步到 TextureInfo
      */
-    GLuint createGLTexture(unsigned char* data,
-                          int width,
-                          int height,
-                          int channels,
-                          bool generateMipmap);
+    void syncTextureInfo(TextureInfo& info) const;
 
     /**
      * @brief 根据通道数确定OpenGL格式
@@ -0,0 +1,56 @@
+#include "AssetIOSystem.hpp"
+#include "macros.h"
+
+#include <cstring>
+
+size_t AssetIOStream::Read(void* buffer, size_t size, size_t count) {
+    if (size == 0 || count == 0 || m_position >= m_file.size()) return 0;
+    // 与 fread 一致: 只读取完整的元素, 返回读到的元素个数
+    const size_t available = (m_file.size() - m_position) / size;
+    const size_t elements = count < available ? count : available;
+    std::memcpy(buffer, m_file.data() + m_position, elements * size);
+    m_position += elements * size;
+    return elements;
+}
+
+size_t AssetIOStream::Write(const void*, size_t, size_t) {
+    return 0;
+}
+
+// 语义与 Assimp::MemoryIOStream 一致: aiOrigin_END 时 offset 为距离末尾的字节数
+aiReturn AssetIOStream::Seek(size_t offset, aiOrigin origin) {
+    const size_t length = m_file.size();
+    switch (origin) {
+        case aiOrigin_SET:
+            if (offset > length) return aiReturn_FAILURE;
+            m_position = offset;
+            break;
+        case aiOrigin_CUR:     // 向后跳转时 offset 为回绕后的负数, 相加后同样回绕
+            if (offset + m_position > length) return aiReturn_FAILURE;
+            m_position += offset;
+            break;
+        case aiOrigin_END:
+            if (offset > length) return aiReturn_FAILURE;
+            m_position = length - offset;
+            break;
+        default:
+            return aiReturn_FAILURE;
+    }
+    return aiReturn_SUCCESS;
+}
+
+bool AssetIOSystem::Exists(const char* file) const {
+    return file && VirtualFileSystem::getInstance().exists(file);
+}
+
+Assimp::IOStream* AssetIOSystem::Open(const char* file, const char* mode) {
+    if (!file) return nullptr;
+    if (mode && (std::strchr(mode, 'w') || std::strchr(mode, 'a'))) {
+        LOGE("AssetIOSystem: write access is not supported (%s)", file);
+        return nullptr;
+    }
+
+    AssetFile asset;
+    if (!asset.open(file)) return nullptr;
+    return new AssetIOStream(std::move(asset));
+}
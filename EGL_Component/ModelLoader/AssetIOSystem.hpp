@@ -0,0 +1,37 @@
+#pragma once
+
+#include <assimp/IOStream.hpp>
+#include <assimp/IOSystem.hpp>
+
+#include "VirtualFileSystem.hpp"
+
+/**
+ * @brief Assimp 的文件访问接口, 经由 VirtualFileSystem 读取
+ *
+ * 没有被 wind_cook 烘焙的模型 (FBX 等, 或包内缓存与运行时选项不一致时的回退) 仍由 Assimp 导入,
+ * 通过 Importer::SetIOHandler 安装后, 模型本体及其引用的 MTL / .bin 等都优先从资源包读取,
+ * 包内数据不拷贝, 直接作为只读内存流交给 Assimp。只支持读取。
+ */
+class AssetIOStream : public Assimp::IOStream {
+public:
+    explicit AssetIOStream(AssetFile&& file) : m_file(std::move(file)) {}
+
+    size_t Read(void* buffer, size_t size, size_t count) override;
+    size_t Write(const void* buffer, size_t size, size_t count) override;
+    aiReturn Seek(size_t offset, aiOrigin origin) override;
+    size_t Tell() const override { return m_position; }
+    size_t FileSize() const override { return m_file.size(); }
+    void Flush() override {}
+
+private:
+    AssetFile m_file;
+    size_t    m_position = 0;
+};
+
+class AssetIOSystem : public Assimp::IOSystem {
+public:
+    bool Exists(const char* file) const override;
+    char getOsSeparator() const override { return '/'; }
+    Assimp::IOStream* Open(const char* file, const char* mode = "rb") override;
+    void Close(Assimp::IOStream* file) override { delete file; }
+};
@@ -0,0 +1,436 @@
+#include "GltfAsset.hpp"
+#include "Json.hpp"
+#include "macros.h"
+
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+
+namespace {
+
+constexpr uint32_t kGlbMagic     = 0x46546C67;     // "glTF"
+constexpr uint32_t kGlbChunkJson = 0x4E4F534A;     // "JSON"
+constexpr uint32_t kGlbChunkBin  = 0x004E4942;     // "BIN\0"
+
+uint32_t readU32(const uint8_t* p) {
+    uint32_t value;
+    std::memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+size_t componentSize(uint32_t componentType) {
+    switch (componentType) {
+    case GltfComponent::Byte:
+    case GltfComponent::UnsignedByte:  return 1;
+    case GltfComponent::Short:
+    case GltfComponent::UnsignedShort: return 2;
+    case GltfComponent::UnsignedInt:
+    case GltfComponent::Float:         return 4;
+    default:                           return 0;
+    }
+}
+
+uint32_t componentCount(const std::string& type) {
+    if (type == "SCALAR") return 1;
+    if (type == "VEC2")   return 2;
+    if (type == "VEC3")   return 3;
+    if (type == "VEC4")   return 4;
+    if (type == "MAT2")   return 4;
+    if (type == "MAT3")   return 9;
+    if (type == "MAT4")   return 16;
+    return 0;
+}
+
+int indexOf(const JsonValue& value) {
+    return value.isNumber() ? static_cast<int>(value.asInt(-1)) : -1;
+}
+
+int hexDigit(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+// glTF 的 uri 是 URI 引用, 文件名中的空格等字符会被百分号编码
+std::string percentDecode(const std::string& uri) {
+    std::string out;
+    out.reserve(uri.size());
+    for (size_t i = 0; i < uri.size(); ++i) {
+        if (uri[i] == '%' && i + 2 < uri.size() && hexDigit(uri[i + 1]) >= 0 && hexDigit(uri[i + 2]) >= 0) {
+            out.push_back(static_cast<char>(hexDigit(uri[i + 1]) * 16 + hexDigit(uri[i + 2])));
+            i += 2;
+        } else {
+            out.push_back(uri[i]);
+        }
+    }
+    return out;
+}
+
+bool isDataUri(const std::string& uri) {
+    return uri.compare(0, 5, "data:") == 0;
+}
+
+} // namespace
+
+size_t GltfAsset::Accessor::elementSize() const {
+    return componentSize(componentType) * components;
+}
+
+bool GltfAsset::isGltfPath(const std::string& path) {
+    std::string ext = std::filesystem::path(path).extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return ext == ".gltf" || ext == ".glb";
+}
+
+bool GltfAsset::open(const std::string& path) {
+    close();
+    m_directory = std::filesystem::path(path).parent_path().string();
+
+    if (!m_file.open(path)) {
+        LOGE("glTF: failed to map %s", path.c_str());
+        return false;
+    }
+
+    const uint8_t* data = m_file.data();
+    const size_t size = m_file.size();
+    bool ok = false;
+
+    if (size >= 12 && readU32(data) == kGlbMagic) {
+        // GLB: 12 字节文件头 + JSON 块 + 可选 BIN 块, 每块 8 字节块头
+        const uint32_t version = readU32(data + 4);
+        const size_t length = std::min<size_t>(readU32(data + 8), size);
+        if (version != 2 || length < 20) {
+            LOGE("glTF: unsupported GLB version %u in %s", version, path.c_str());
+            close();
+            return false;
+        }
+        const char* json = nullptr;
+        size_t jsonSize = 0;
+        const uint8_t* bin = nullptr;
+        size_t binSize = 0;
+        for (size_t offset = 12; offset + 8 <= length;) {
+            const size_t chunkSize = readU32(data + offset);
+            const uint32_t chunkType = readU32(data + offset + 4);
+            if (chunkSize > length - offset - 8) break;
+            if (chunkType == kGlbChunkJson && !json) {
+                json = reinterpret_cast<const char*>(data + offset + 8);
+                jsonSize = chunkSize;
+            } else if (chunkType == kGlbChunkBin && !bin) {
+                bin = data + offset + 8;
+                binSize = chunkSize;
+            }
+            offset += 8 + ((chunkSize + 3) & ~size_t(3));
+        }
+        if (!json) {
+            LOGE("glTF: GLB without JSON chunk: %s", path.c_str());
+            close();
+            return false;
+        }
+        ok = parseDocument(json, jsonSize, bin, binSize);
+    } else {
+        // .gltf: JSON 解析完成后文本本身不再需要
+        ok = parseDocument(reinterpret_cast<const char*>(data), size, nullptr, 0);
+        m_file.close();
+    }
+
+    if (!ok) {
+        LOGE("glTF: %s is not supported by the native reader", path.c_str());
+        close();
+        return false;
+    }
+    m_open = true;
+    return true;
+}
+
+void GltfAsset::close() {
+    m_open = false;
+    m_scene = -1;
+    m_file.close();
+    m_externalFiles.clear();
+    m_decoded.clear();
+    m_buffers.clear();
+    m_bufferViews.clear();
+    m_accessors.clear();
+    m_meshes.clear();
+    m_nodes.clear();
+    m_sceneRoots.clear();
+    m_images.clear();
+    m_materials.clear();
+}
+
+bool GltfAsset::decodeDataUri(const std::string& uri, std::vector<uint8_t>& out) const {
+    const size_t comma = uri.find(',');
+    if (comma == std::string::npos || uri.rfind(";base64", comma) == std::string::npos) {
+        LOGE("glTF: only base64 data URIs are supported");
+        return false;
+    }
+
+    static const struct Table {
+        int8_t value[256];
+        Table() {
+            std::fill(value, value + 256, static_cast<int8_t>(-1));
+            const char* alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+            for (int i = 0; i < 64; ++i) value[static_cast<unsigned char>(alphabet[i])] = static_cast<int8_t>(i);
+        }
+    } table;
+
+    out.clear();
+    out.reserve((uri.size() - comma - 1) / 4 * 3);
+    uint32_t accumulator = 0;
+    int bits = 0;
+    for (size_t i = comma + 1; i < uri.size(); ++i) {
+        const unsigned char c = static_cast<unsigned char>(uri[i]);
+        if (c == '=') break;
+        const int8_t v = table.value[c];
+        if (v < 0) return false;
+        accumulator = (accumulator << 6) | static_cast<uint32_t>(v);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            out.push_back(static_cast<uint8_t>(accumulator >> bits));
+        }
+    }
+    return true;
+}
+
+bool GltfAsset::resolveBuffer(const std::string& uri, Buffer& out) {
+    if (isDataUri(uri)) {
+        m_decoded.emplace_back();
+        if (!decodeDataUri(uri, m_decoded.back())) return false;
+        out.data = m_decoded.back().data();
+        out.size = m_decoded.back().size();
+        return true;
+    }
+
+    const std::string path = m_directory + "/" + percentDecode(uri);
+    AssetFile file;
+    if (!file.open(path)) {
+        LOGE("glTF: failed to map buffer %s", path.c_str());
+        return false;
+    }
+    out.data = file.data();
+    out.size = file.size();
+    m_externalFiles.push_back(std::move(file));     // 移动不改变映射地址
+    return true;
+}
+
+bool GltfAsset::parseDocument(const char* json, size_t length, const uint8_t* glbBin, size_t glbBinSize) {
+    JsonValue doc;
+    std::string error;
+    if (!JsonValue::parse(json, length, doc, &error)) {
+        LOGE("glTF: JSON parse error: %s", error.c_str());
+        return false;
+    }
+
+    const std::string& version = doc["asset"]["version"].asString();
+    if (version.compare(0, 2, "2.") != 0) {
+        LOGE("glTF: unsupported asset version '%s'", version.c_str());
+        return false;
+    }
+    for (const JsonValue& extension : doc["extensionsRequired"].elements()) {
+        LOGE("glTF: required extension %s is not supported", extension.asString().c_str());
+        return false;
+    }
+
+    // ---- buffers / bufferViews ----
+    const JsonValue& buffers = doc["buffers"];
+    m_buffers.resize(buffers.size());
+    for (size_t i = 0; i < buffers.size(); ++i) {
+        const JsonValue& buffer = buffers[i];
+        const size_t byteLength = static_cast<size_t>(buffer["byteLength"].asInt(0));
+        if (const JsonValue* uri = buffer.find("uri")) {
+            if (!resolveBuffer(uri->asString(), m_buffers[i])) return false;
+        } else if (i == 0 && glbBin) {
+            m_buffers[i].data = glbBin;
+            m_buffers[i].size = glbBinSize;
+        } else {
+            LOGE("glTF: buffer %d has no data", static_cast<int>(i));
+            return false;
+        }
+        if (m_buffers[i].size < byteLength) {
+            LOGE("glTF: buffer %d is truncated (%d < %d bytes)", static_cast<int>(i),
+                 static_cast<int>(m_buffers[i].size), static_cast<int>(byteLength));
+            return false;
+        }
+    }
+
+    const JsonValue& bufferViews = doc["bufferViews"];
+    m_bufferViews.resize(bufferViews.size());
+    for (size_t i = 0; i < bufferViews.size(); ++i) {
+        const JsonValue& view = bufferViews[i];
+        BufferView& out = m_bufferViews[i];
+        out.buffer     = indexOf(view["buffer"]);
+        out.byteOffset = static_cast<size_t>(view["byteOffset"].asInt(0));
+        out.byteLength = static_cast<size_t>(view["byteLength"].asInt(0));
+        out.byteStride = static_cast<size_t>(view["byteStride"].asInt(0));
+        if (out.buffer < 0 || static_cast<size_t>(out.buffer) >= m_buffers.size() ||
+            out.byteOffset > m_buffers[out.buffer].size ||
+            out.byteLength > m_buffers[out.buffer].size - out.byteOffset) {
+            LOGE("glTF: bufferView %d is out of range", static_cast<int>(i));
+            return false;
+        }
+    }
+
+    // ---- accessors: 在这里完成全部范围检查, 之后的 span 访问直接使用指针 ----
+    const JsonValue& accessors = doc["accessors"];
+    m_accessors.resize(accessors.size());
+    for (size_t i = 0; i < accessors.size(); ++i) {
+        const JsonValue& accessor = accessors[i];
+        Accessor& out = m_accessors[i];
+        out.bufferView    = indexOf(accessor["bufferView"]);
+        out.byteOffset    = static_cast<size_t>(accessor["byteOffset"].asInt(0));
+        out.componentType = static_cast<uint32_t>(accessor["componentType"].asInt(0));
+        out.components    = componentCount(accessor["type"].asString());
+        out.count         = static_cast<size_t>(accessor["count"].asInt(0));
+        out.normalized    = accessor["normalized"].asBool(false);
+
+        const JsonValue& min = accessor["min"];
+        const JsonValue& max = accessor["max"];
+        if (min.size() >= 3 && max.size() >= 3) {
+            out.hasBounds = true;
+            out.min = glm::vec3(min[0].asFloat(), min[1].asFloat(), min[2].asFloat());
+            out.max = glm::vec3(max[0].asFloat(), max[1].asFloat(), max[2].asFloat());
+        }
+
+        if (accessor.has("sparse")) {
+            LOGE("glTF: sparse accessor %d is not supported", static_cast<int>(i));
+            return false;
+        }
+        const size_t elementSize = out.elementSize();
+        if (elementSize == 0 || out.bufferView < 0 || static_cast<size_t>(out.bufferView) >= m_bufferViews.size()) {
+            LOGE("glTF: accessor %d has no usable data", static_cast<int>(i));
+            return false;
+        }
+        const BufferView& view = m_bufferViews[out.bufferView];
+        const size_t stride = view.byteStride ? view.byteStride : elementSize;
+        if (out.count > 0 &&
+            (out.byteOffset > view.byteLength ||
+             elementSize > view.byteLength - out.byteOffset ||
+             out.count - 1 > (view.byteLength - out.byteOffset - elementSize) / stride)) {
+            LOGE("glTF: accessor %d is out of range", static_cast<int>(i));
+            return false;
+        }
+    }
+
+    // ---- meshes ----
+    const JsonValue& meshes = doc["meshes"];
+    m_meshes.resize(meshes.size());
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        const JsonValue& mesh = meshes[i];
+        m_meshes[i].name = mesh["name"].asString();
+        for (const JsonValue& primitive : mesh["primitives"].elements()) {
+            const JsonValue& attributes = primitive["attributes"];
+            Primitive out;
+            out.position  = indexOf(attributes["POSITION"]);
+            out.normal    = indexOf(attributes["NORMAL"]);
+            out.texcoord0 = indexOf(attributes["TEXCOORD_0"]);
+            out.tangent   = indexOf(attributes["TANGENT"]);
+            out.indices   = indexOf(primitive["indices"]);
+            out.material  = indexOf(primitive["material"]);
+            out.mode      = static_cast<uint32_t>(primitive["mode"].asInt(Triangles));
+            for (int accessor : { out.position, out.normal, out.texcoord0, out.tangent, out.indices }) {
+                if (accessor >= static_cast<int>(m_accessors.size())) {
+                    LOGE("glTF: mesh %d references missing accessor %d", static_cast<int>(i), accessor);
+                    return false;
+                }
+            }
+            m_meshes[i].primitives.push_back(out);
+        }
+    }
+
+    // ---- nodes / scenes ----
+    const JsonValue& nodes = doc["nodes"];
+    m_nodes.resize(nodes.size());
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        m_nodes[i].mesh = indexOf(nodes[i]["mesh"]);
+        for (const JsonValue& child : nodes[i]["children"].elements()) {
+            m_nodes[i].children.push_back(indexOf(child));
+        }
+    }
+    const JsonValue& scenes = doc["scenes"];
+    m_scene = indexOf(doc["scene"]);
+    if (m_scene < 0 && scenes.size() > 0) m_scene = 0;
+    for (const JsonValue& root : scenes[static_cast<size_t>(std::max(m_scene, 0))]["nodes"].elements()) {
+        m_sceneRoots.push_back(indexOf(root));
+    }
+
+    // ---- images / textures / materials ----
+    const JsonValue& images = doc["images"];
+    m_images.resize(images.size());
+    for (size_t i = 0; i < images.size(); ++i) {
+        const JsonValue& image = images[i];
+        Image& out = m_images[i];
+        const int view = indexOf(image["bufferView"]);
+        if (view >= 0 && static_cast<size_t>(view) < m_bufferViews.size()) {
+            const BufferView& bufferView = m_bufferViews[view];
+            out.data = m_buffers[bufferView.buffer].data + bufferView.byteOffset;
+            out.size = bufferView.byteLength;
+        } else if (const JsonValue* uri = image.find("uri")) {
+            if (isDataUri(uri->asString())) {
+                m_decoded.emplace_back();
+                if (!decodeDataUri(uri->asString(), m_decoded.back())) return false;
+                out.data = m_decoded.back().data();
+                out.size = m_decoded.back().size();
+            } else {
+                out.uri = percentDecode(uri->asString());
+            }
+        }
+    }
+
+    const JsonValue& textures = doc["textures"];
+    auto imageOfTexture = [&](const JsonValue& textureInfo) -> int {
+        const int texture = indexOf(textureInfo["index"]);
+        if (texture < 0) return -1;
+        const int image = indexOf(textures[static_cast<size_t>(texture)]["source"]);
+        return (image >= 0 && static_cast<size_t>(image) < m_images.size()) ? image : -1;
+    };
+    const JsonValue& materials = doc["materials"];
+    m_materials.resize(materials.size());
+    for (size_t i = 0; i < materials.size(); ++i) {
+        const JsonValue& material = materials[i];
+        m_materials[i].name           = material["name"].asString();
+        m_materials[i].baseColorImage = imageOfTexture(material["pbrMetallicRoughness"]["baseColorTexture"]);
+        m_materials[i].normalImage    = imageOfTexture(material["normalTexture"]);
+    }
+    return true;
+}
+
+std::vector<int> GltfAsset::meshesInSceneOrder() const {
+    std::vector<int> order;
+    if (m_sceneRoots.empty()) {
+        for (size_t i = 0; i < m_meshes.size(); ++i) order.push_back(static_cast<int>(i));
+        return order;
+    }
+
+    // 显式栈的深度优先遍历, visited 防止损坏文件中的环
+    std::vector<uint8_t> visited(m_nodes.size(), 0);
+    std::vector<int> stack(m_sceneRoots.rbegin(), m_sceneRoots.rend());
+    while (!stack.empty()) {
+        const int node = stack.back();
+        stack.pop_back();
+        if (node < 0 || static_cast<size_t>(node) >= m_nodes.size() || visited[node]) continue;
+        visited[node] = 1;
+        const Node& current = m_nodes[node];
+        if (current.mesh >= 0 && static_cast<size_t>(current.mesh) < m_meshes.size()) {
+            order.push_back(current.mesh);
+        }
+        stack.insert(stack.end(), current.children.rbegin(), current.children.rend());
+    }
+    return order;
+}
+
+const uint8_t* GltfAsset::accessorData(int accessor, size_t& outStride) const {
+    if (accessor < 0 || static_cast<size_t>(accessor) >= m_accessors.size()) return nullptr;
+    const Accessor& a = m_accessors[accessor];
+    const BufferView& view = m_bufferViews[a.bufferView];
+    outStride = view.byteStride ? view.byteStride : a.elementSize();
+    return m_buffers[view.buffer].data + view.byteOffset + a.byteOffset;
+}
+
+size_t GltfAsset::residentBytes() const {
+    size_t bytes = m_file.size();
+    for (const AssetFile& file : m_externalFiles) bytes += file.size();
+    for (const std::vector<uint8_t>& decoded : m_decoded) bytes += decoded.capacity();
+    return bytes;
+}
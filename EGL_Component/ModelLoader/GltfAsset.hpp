@@ -0,0 +1,199 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "VirtualFileSystem.hpp"
+
+// glTF accessor.componentType (与 GL 枚举值相同)
+namespace GltfComponent {
+    constexpr uint32_t Byte          = 5120;
+    constexpr uint32_t UnsignedByte  = 5121;
+    constexpr uint32_t Short         = 5122;
+    constexpr uint32_t UnsignedShort = 5123;
+    constexpr uint32_t UnsignedInt   = 5125;
+    constexpr uint32_t Float         = 5126;
+}
+
+/**
+ * @brief 带步长的只读类型视图, 直接指向 glTF 缓冲区 (映射文件或解码后的 data URI)
+ *
+ * 元素按 memcpy 读取, 不要求源数据对齐; stride == sizeof(T) 时可以整体当作 T 数组使用。
+ */
+template <typename T>
+struct StridedSpan {
+    const uint8_t* data = nullptr;
+    size_t count  = 0;
+    size_t stride = sizeof(T);
+
+    bool empty() const { return data == nullptr || count == 0; }
+    bool contiguous() const { return stride == sizeof(T); }
+
+    T operator[](size_t index) const {
+        T value;
+        std::memcpy(&value, data + index * stride, sizeof(T));
+        return value;
+    }
+};
+
+/**
+ * @brief glTF 2.0 / GLB 原生读取器 (只读几何与材质纹理引用, 不含动画/蒙皮)
+ *
+ * - .glb: 整个文件 mmap, JSON 块就地解析, BIN 块直接作为 buffer 0
+ * - .gltf: 外部 .bin 逐个 mmap; data URI (base64) 解码到自有内存
+ * - open() 时校验全部 bufferView / accessor 的范围, 之后的 span 访问不再做边界检查
+ * - 不支持的特性 (sparse accessor、extensionsRequired、非 2.0 版本) 让 open() 失败, 由调用方回退到 Assimp
+ *
+ * 通过 span 取得的指针在 close() / 析构之前有效。只允许移动, 不允许拷贝。
+ */
+class GltfAsset {
+public:
+    struct BufferView {
+        int    buffer     = -1;
+        size_t byteOffset = 0;
+        size_t byteLength = 0;
+        size_t byteStride = 0;  // 0 表示紧密排列
+    };
+
+    struct Accessor {
+        int      bufferView    = -1;
+        size_t   byteOffset    = 0;    // 相对 bufferView
+        uint32_t componentType = 0;
+        uint32_t components    = 1;    // SCALAR=1, VEC2=2, VEC3=3, VEC4=4, MAT4=16 ...
+        size_t   count         = 0;
+        bool     normalized    = false;
+        bool     hasBounds     = false;    // min/max 前三个分量
+        glm::vec3 min{0.0f};
+        glm::vec3 max{0.0f};
+
+        size_t elementSize() const;
+    };
+
+    // glTF primitive.mode
+    enum PrimitiveMode : uint32_t {
+        Points = 0, Lines = 1, LineLoop = 2, LineStrip = 3, Triangles = 4, TriangleStrip = 5, TriangleFan = 6,
+    };
+
+    struct Primitive {
+        int position  = -1;     // accessor 下标, -1 表示不存在
+        int normal    = -1;
+        int texcoord0 = -1;
+        int tangent   = -1;
+        int indices   = -1;
+        int material  = -1;
+        uint32_t mode = Triangles;
+    };
+
+    struct Mesh {
+        std::string name;
+        std::vector<Primitive> primitives;
+    };
+
+    struct Node {
+        int mesh = -1;
+        std::vector<int> children;
+    };
+
+    struct Image {
+        std::string uri;                // 外部文件 (已做百分号解码), 嵌入图像为空
+        const uint8_t* data = nullptr;  // 嵌入图像 (bufferView 或 data URI) 的压缩字节
+        size_t size = 0;
+    };
+
+    // 纹理已解析到 image 下标, -1 表示没有
+    struct Material {
+        std::string name;
+        int baseColorImage = -1;
+        int normalImage    = -1;
+    };
+
+    GltfAsset() = default;
+    ~GltfAsset() { close(); }
+
+    GltfAsset(GltfAsset&&) noexcept = default;
+    GltfAsset& operator=(GltfAsset&&) noexcept = default;
+    GltfAsset(const GltfAsset&) = delete;
+    GltfAsset& operator=(const GltfAsset&) = delete;
+
+    // 按扩展名判断 (.gltf / .glb, 不区分大小写)
+    static bool isGltfPath(const std::string& path);
+
+    /**
+     * @brief 读取并校验 .gltf / .glb
+     * @return false 文件无效或包含不支持的特性
+     */
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const { return m_open; }
+
+    const std::vector<BufferView>& bufferViews() const { return m_bufferViews; }
+    const std::vector<Accessor>& accessors() const { return m_accessors; }
+    const std::vector<Mesh>& meshes() const { return m_meshes; }
+    const std::vector<Node>& nodes() const { return m_nodes; }
+    const std::vector<Image>& images() const { return m_images; }
+    const std::vector<Material>& materials() const { return m_materials; }
+
+    /**
+     * @brief 默认场景中按深度优先顺序出现的 Mesh 下标 (与 Assimp 路径的 processNode 顺序一致)
+     *
+     * 没有场景定义时返回全部 Mesh。节点变换不参与 (Assimp 路径同样不应用节点变换)。
+     */
+    std::vector<int> meshesInSceneOrder() const;
+
+    /**
+     * @brief 访问器的首元素地址与步长
+     * @return nullptr 下标无效
+     */
+    const uint8_t* accessorData(int accessor, size_t& outStride) const;
+
+    /**
+     * @brief 以 T 类型视图访问 accessor
+     * @return false 组件类型 / 分量数与 T 不一致
+     */
+    template <typename T>
+    bool span(int accessor, uint32_t componentType, uint32_t components, StridedSpan<T>& out) const {
+        if (accessor < 0 || static_cast<size_t>(accessor) >= m_accessors.size()) return false;
+        const Accessor& a = m_accessors[accessor];
+        if (a.componentType != componentType || a.components != components || a.elementSize() != sizeof(T)) {
+            return false;
+        }
+        out.data = accessorData(accessor, out.stride);
+        out.count = a.count;
+        return out.data != nullptr;
+    }
+
+    // 映射文件 + 解码后的 data URI 占用的 CPU 内存
+    size_t residentBytes() const;
+
+private:
+    struct Buffer {
+        const uint8_t* data = nullptr;
+        size_t size = 0;
+    };
+
+    bool parseDocument(const char* json, size_t length, const uint8_t* glbBin, size_t glbBinSize);
+    bool resolveBuffer(const std::string& uri, Buffer& out);
+    bool decodeDataUri(const std::string& uri, std::vector<uint8_t>& out) const;
+
+    std::string m_directory;
+    bool m_open = false;
+    int m_scene = -1;
+
+    AssetFile m_file;                               // .glb 本体 (或 .gltf 的 JSON), 可能来自资源包
+    std::vector<AssetFile> m_externalFiles;         // 外部 .bin
+    std::vector<std::vector<uint8_t>> m_decoded;    // data URI 解码结果
+
+    std::vector<Buffer>     m_buffers;
+    std::vector<BufferView> m_bufferViews;
+    std::vector<Accessor>   m_accessors;
+    std::vector<Mesh>       m_meshes;
+    std::vector<Node>       m_nodes;
+    std::vector<int>        m_sceneRoots;
+    std::vector<Image>      m_images;
+    std::vector<Material>   m_materials;
+};
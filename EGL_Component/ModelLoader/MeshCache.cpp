@@ -0,0 +1,325 @@
+#include "MeshCache.hpp"
+#include "macros.h"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+constexpr uint64_t kBlockAlignment = 16;
+
+#pragma pack(push, 1)
+struct FileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t importFlags;
+    uint32_t processFlags;
+    uint32_t vertexFormat;
+    uint32_t vertexAttributes;
+    uint32_t vertexStride;
+    int64_t  sourceMTime;
+    uint64_t sourceSize;
+    uint32_t meshCount;
+    uint32_t textureCount;
+    float    boundsMin[3];
+    float    boundsMax[3];
+    uint64_t meshTableOffset;
+    uint64_t textureTableOffset;
+    uint64_t stringTableOffset;
+    uint64_t stringTableSize;
+    uint32_t sourcePathOffset;      // 相对字符串表
+    uint32_t sourcePathLength;
+};
+
+struct MeshRecord {
+    uint64_t vertexOffset;          // 相对文件头
+    uint64_t indexOffset;
+    uint32_t vertexCount;
+    uint32_t indexCount;
+    uint32_t indexSize;             // 2: uint16, 4: uint32
+    uint32_t firstTexture;
+    uint32_t textureCount;
+    float    boundsMin[3];
+    float    boundsMax[3];
+};
+
+struct TextureRecord {
+    uint32_t typeOffset;            // 相对字符串表
+    uint32_t typeLength;
+    uint32_t pathOffset;
+    uint32_t pathLength;
+};
+#pragma pack(pop)
+
+uint64_t alignUp(uint64_t value) {
+    return (value + kBlockAlignment - 1) & ~(kBlockAlignment - 1);
+}
+
+std::string normalizedPath(const std::string& path) {
+    return std::filesystem::path(path).lexically_normal().generic_string();
+}
+
+// 追加字符串到字符串表, 返回其偏移
+uint32_t appendString(std::string& table, const std::string& value) {
+    uint32_t offset = static_cast<uint32_t>(table.size());
+    table.append(value);
+    return offset;
+}
+
+void writePadding(std::ofstream& out, uint64_t& cursor, uint64_t target) {
+    static const char zeros[kBlockAlignment] = {};
+    while (cursor < target) {
+        uint64_t chunk = std::min<uint64_t>(target - cursor, kBlockAlignment);
+        out.write(zeros, static_cast<std::streamsize>(chunk));
+        cursor += chunk;
+    }
+}
+
+} // namespace
+
+bool MeshCache::makeKey(const std::string& sourcePath, uint32_t importFlags, uint32_t processFlags,
+                        VertexFormat vertexFormat, uint32_t vertexAttributes, Key& outKey) {
+    const VirtualFileSystem& vfs = VirtualFileSystem::getInstance();
+    uint64_t size = 0;
+    int64_t mtime = 0;
+    // 只打包了烘焙结果时源文件不存在, 键中的源文件状态保持为 0 (包内缓存不校验这两项)
+    if (!vfs.stat(sourcePath, size, mtime) && vfs.find(cachePathFor(sourcePath)).empty()) {
+        return false;
+    }
+
+    outKey.sourcePath  = normalizedPath(sourcePath);
+    outKey.sourceMTime = mtime;
+    outKey.sourceSize  = size;
+    outKey.importFlags = importFlags;
+    outKey.processFlags = processFlags;
+    outKey.vertexFormat = vertexFormat;
+    outKey.vertexAttributes = VertexLayout::storedAttributes(vertexFormat, vertexAttributes);
+    return true;
+}
+
+std::string MeshCache::cachePathFor(const std::string& sourcePath) {
+    return sourcePath + ".meshcache";
+}
+
+bool MeshCache::write(const std::string& cachePath,
+                      const Key& key,
+                      const std::vector<MeshView>& meshes,
+                      const glm::vec3& boundsMin,
+                      const glm::vec3& boundsMax) {
+    // ---- 1. 组织字符串表与纹理表 ----
+    std::string stringTable;
+    std::vector<TextureRecord> textureRecords;
+    std::vector<MeshRecord> meshRecords(meshes.size());
+
+    FileHeader header{};
+    header.sourcePathOffset = appendString(stringTable, key.sourcePath);
+    header.sourcePathLength = static_cast<uint32_t>(key.sourcePath.size());
+
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        meshRecords[i].firstTexture = static_cast<uint32_t>(textureRecords.size());
+        meshRecords[i].textureCount = static_cast<uint32_t>(meshes[i].textures.size());
+        for (const TextureRef& ref : meshes[i].textures) {
+            TextureRecord record{};
+            record.typeLength = static_cast<uint32_t>(ref.type.size());
+            record.typeOffset = appendString(stringTable, ref.type);
+            record.pathLength = static_cast<uint32_t>(ref.path.size());
+            record.pathOffset = appendString(stringTable, ref.path);
+            textureRecords.push_back(record);
+        }
+    }
+
+    // ---- 2. 计算布局 ----
+    const uint64_t vertexStride = VertexLayout::stride(key.vertexFormat, key.vertexAttributes);
+    uint64_t cursor = sizeof(FileHeader);
+    header.meshTableOffset    = cursor;
+    cursor += sizeof(MeshRecord) * meshRecords.size();
+    header.textureTableOffset = cursor;
+    cursor += sizeof(TextureRecord) * textureRecords.size();
+    header.stringTableOffset  = cursor;
+    header.stringTableSize    = stringTable.size();
+    cursor += stringTable.size();
+
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        cursor = alignUp(cursor);
+        meshRecords[i].vertexOffset = cursor;
+        meshRecords[i].vertexCount  = meshes[i].vertexCount;
+        cursor += static_cast<uint64_t>(meshes[i].vertexCount) * vertexStride;
+    }
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        cursor = alignUp(cursor);
+        meshRecords[i].indexOffset = cursor;
+        meshRecords[i].indexCount  = meshes[i].indexCount;
+        meshRecords[i].indexSize   = meshes[i].indexSize;
+        cursor += static_cast<uint64_t>(meshes[i].indexCount) * meshes[i].indexSize;
+        std::memcpy(meshRecords[i].boundsMin, &meshes[i].boundsMin[0], sizeof(float) * 3);
+        std::memcpy(meshRecords[i].boundsMax, &meshes[i].boundsMax[0], sizeof(float) * 3);
+    }
+
+    header.magic        = kMagic;
+    header.version      = kVersion;
+    header.importFlags  = key.importFlags;
+    header.processFlags = key.processFlags;
+    header.vertexFormat = static_cast<uint32_t>(key.vertexFormat);
+    header.vertexAttributes = key.vertexAttributes;
+    header.vertexStride = static_cast<uint32_t>(vertexStride);
+    header.sourceMTime  = key.sourceMTime;
+    header.sourceSize   = key.sourceSize;
+    header.meshCount    = static_cast<uint32_t>(meshRecords.size());
+    header.textureCount = static_cast<uint32_t>(textureRecords.size());
+    std::memcpy(header.boundsMin, &boundsMin[0], sizeof(float) * 3);
+    std::memcpy(header.boundsMax, &boundsMax[0], sizeof(float) * 3);
+
+    // ---- 3. 写入临时文件 ----
+    const std::string tmpPath = cachePath + ".tmp";
+    {
+        std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+        if (!out) {
+            LOGE("MeshCache: cannot open %s for writing", tmpPath.c_str());
+            return false;
+        }
+
+        uint64_t written = 0;
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(meshRecords.data()), sizeof(MeshRecord) * meshRecords.size());
+        out.write(reinterpret_cast<const char*>(textureRecords.data()), sizeof(TextureRecord) * textureRecords.size());
+        out.write(stringTable.data(), static_cast<std::streamsize>(stringTable.size()));
+        written = header.stringTableOffset + stringTable.size();
+
+        for (size_t i = 0; i < meshes.size(); ++i) {
+            writePadding(out, written, meshRecords[i].vertexOffset);
+            uint64_t bytes = static_cast<uint64_t>(meshes[i].vertexCount) * vertexStride;
+            out.write(reinterpret_cast<const char*>(meshes[i].vertices), static_cast<std::streamsize>(bytes));
+            written += bytes;
+        }
+        for (size_t i = 0; i < meshes.size(); ++i) {
+            writePadding(out, written, meshRecords[i].indexOffset);
+            uint64_t bytes = static_cast<uint64_t>(meshes[i].indexCount) * meshes[i].indexSize;
+            out.write(reinterpret_cast<const char*>(meshes[i].indices), static_cast<std::streamsize>(bytes));
+            written += bytes;
+        }
+
+        if (!out) {
+            LOGE("MeshCache: failed while writing %s", tmpPath.c_str());
+            out.close();
+            std::error_code ec;
+            std::filesystem::remove(tmpPath, ec);
+            return false;
+        }
+    }
+
+    // ---- 4. 原子替换 ----
+    std::error_code ec;
+    std::filesystem::remove(cachePath, ec);     // Windows 下 rename 不能覆盖已存在文件
+    std::filesystem::rename(tmpPath, cachePath, ec);
+    if (ec) {
+        LOGE("MeshCache: rename %s failed: %s", tmpPath.c_str(), ec.message().c_str());
+        std::filesystem::remove(tmpPath, ec);
+        return false;
+    }
+
+    LOGI("MeshCache: wrote %s (%u meshes, %llu bytes)", cachePath.c_str(),
+         header.meshCount, static_cast<unsigned long long>(cursor));
+    return true;
+}
+
+bool MeshCache::open(const std::string& cachePath, const Key& key) {
+    close();
+
+    if (!m_file.open(cachePath)) {
+        return false;
+    }
+
+    const uint8_t* base = m_file.data();
+    const uint64_t size = m_file.size();
+
+    auto fail = [&](const char* reason) {
+        LOGI("MeshCache: ignoring %s (%s)", cachePath.c_str(), reason);
+        close();
+        return false;
+    };
+
+    if (size < sizeof(FileHeader)) return fail("truncated header");
+
+    FileHeader header;
+    std::memcpy(&header, base, sizeof(header));
+
+    if (header.magic != kMagic)               return fail("bad magic");
+    if (header.version != kVersion)           return fail("version mismatch");
+    const uint64_t vertexStride = VertexLayout::stride(key.vertexFormat, key.vertexAttributes);
+    if (header.vertexFormat != static_cast<uint32_t>(key.vertexFormat) ||
+        header.vertexAttributes != key.vertexAttributes ||
+        header.vertexStride != vertexStride)   return fail("vertex layout mismatch");
+    if (header.importFlags != key.importFlags ||
+        header.processFlags != key.processFlags) return fail("import flags changed");
+    const bool packaged = m_file.isPackaged();
+    if (!packaged &&
+        (header.sourceMTime != key.sourceMTime ||
+         header.sourceSize != key.sourceSize)) return fail("source file changed");
+
+    auto inRange = [size](uint64_t offset, uint64_t bytes) {
+        return offset <= size && bytes <= size - offset;
+    };
+
+    if (!inRange(header.meshTableOffset, sizeof(MeshRecord) * uint64_t(header.meshCount)) ||
+        !inRange(header.textureTableOffset, sizeof(TextureRecord) * uint64_t(header.textureCount)) ||
+        !inRange(header.stringTableOffset, header.stringTableSize)) {
+        return fail("corrupt tables");
+    }
+
+    const char* strings = reinterpret_cast<const char*>(base + header.stringTableOffset);
+    auto readString = [&](uint32_t offset, uint32_t length, std::string& out) {
+        if (uint64_t(offset) + length > header.stringTableSize) return false;
+        out.assign(strings + offset, length);
+        return true;
+    };
+
+    std::string storedPath;
+    if (!readString(header.sourcePathOffset, header.sourcePathLength, storedPath)) return fail("corrupt strings");
+    if (!packaged && storedPath != key.sourcePath) return fail("source path changed");
+
+    const MeshRecord*    meshRecords    = reinterpret_cast<const MeshRecord*>(base + header.meshTableOffset);
+    const TextureRecord* textureRecords = reinterpret_cast<const TextureRecord*>(base + header.textureTableOffset);
+
+    m_meshes.resize(header.meshCount);
+    for (uint32_t i = 0; i < header.meshCount; ++i) {
+        MeshRecord record;
+        std::memcpy(&record, &meshRecords[i], sizeof(record));
+
+        if ((record.indexSize != sizeof(uint16_t) && record.indexSize != sizeof(uint32_t)) ||
+            !inRange(record.vertexOffset, uint64_t(record.vertexCount) * vertexStride) ||
+            !inRange(record.indexOffset, uint64_t(record.indexCount) * record.indexSize) ||
+            uint64_t(record.firstTexture) + record.textureCount > header.textureCount) {
+            return fail("corrupt mesh record");
+        }
+
+        MeshView& view  = m_meshes[i];
+        view.vertices    = base + record.vertexOffset;
+        view.vertexCount = record.vertexCount;
+        view.indices     = base + record.indexOffset;
+        view.indexCount  = record.indexCount;
+        view.indexSize   = record.indexSize;
+        view.boundsMin   = glm::vec3(record.boundsMin[0], record.boundsMin[1], record.boundsMin[2]);
+        view.boundsMax   = glm::vec3(record.boundsMax[0], record.boundsMax[1], record.boundsMax[2]);
+
+        view.textures.resize(record.textureCount);
+        for (uint32_t t = 0; t < record.textureCount; ++t) {
+            TextureRecord texRecord;
+            std::memcpy(&texRecord, &textureRecords[record.firstTexture + t], sizeof(texRecord));
+            if (!readString(texRecord.typeOffset, texRecord.typeLength, view.textures[t].type) ||
+                !readString(texRecord.pathOffset, texRecord.pathLength, view.textures[t].path)) {
+                return fail("corrupt texture record");
+            }
+        }
+    }
+
+    m_boundsMin = glm::vec3(header.boundsMin[0], header.boundsMin[1], header.boundsMin[2]);
+    m_boundsMax = glm::vec3(header.boundsMax[0], header.boundsMax[1], header.boundsMax[2]);
+    return true;
+}
+
+void MeshCache::close() {
+    m_meshes.clear();
+    m_file.close();
+}
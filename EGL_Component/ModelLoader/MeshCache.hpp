@@ -0,0 +1,98 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "VirtualFileSystem.hpp"
+#include "VertexLayout.hpp"
+
+/**
+ * @brief 二进制网格缓存 (.meshcache)
+ *
+ * 首次通过 Assimp 导入模型后，把后处理完成的交错顶点、索引、每个 Mesh 的包围盒
+ * 以及纹理引用写入与源文件同目录的缓存文件。之后的启动直接 mmap 该文件，
+ * 顶点/索引数据不经过任何中间 vector，直接作为 glBufferData 的数据源。
+ *
+ * 缓存以 源文件路径 + 修改时间 + 文件大小 + Assimp 后处理标志 + 处理选项 + 顶点格式 为键，
+ * 任意一项不一致（或格式版本变化）都视为失效，重新走 Assimp 导入并覆盖缓存。
+ *
+ * 缓存也可以由 wind_cook 烘焙进资源包 (见 VirtualFileSystem): 包内的缓存与其余资源是同一次烘焙的快照,
+ * 打开时不再比较源文件路径/修改时间/大小 (安装目录与烘焙时不同, 源文件通常也没有打包), 其余键仍需一致。
+ *
+ * 文件布局（小端，所有数据块按 16 字节对齐）：
+ *   FileHeader | MeshRecord[meshCount] | TextureRecord[textureCount] | 字符串表 | 顶点块 | 索引块
+ */
+class MeshCache {
+public:
+    static constexpr uint32_t kMagic   = 0x4843574D;   // "MWCH"
+    static constexpr uint32_t kVersion = 5;    // 2: 顶点数据按 VertexFormat 编码; 3: 记录 processFlags; 4: 每个 Mesh 的索引宽度; 5: 顶点属性集与属性流
+
+    struct Key {
+        std::string sourcePath;
+        int64_t     sourceMTime = 0;
+        uint64_t    sourceSize  = 0;
+        uint32_t    importFlags = 0;
+        uint32_t    processFlags = 0;       // 导入后的 CPU 处理选项 (网格优化等)
+        VertexFormat vertexFormat = VertexFormat::Full;
+        uint32_t    vertexAttributes = VertexAttrib::All;  // 见 VertexLayout::storedAttributes
+    };
+
+    struct TextureRef {
+        std::string type;   // "texture_diffuse" 等, 与 Texture::type 一致
+        std::string path;   // 材质中记录的相对路径, 与 Texture::path 一致
+    };
+
+    // 指向缓存(或内存中)的一个 Mesh 的数据, 不拥有顶点/索引内存
+    struct MeshView {
+        const uint8_t*  vertices    = nullptr;     // VertexLayout::pack 的输出 (按 Key::vertexFormat / vertexAttributes 编码)
+        uint32_t        vertexCount = 0;
+        const uint8_t*  indices     = nullptr;     // 按 indexSize 编码
+        uint32_t        indexCount  = 0;
+        uint32_t        indexSize   = sizeof(uint32_t);    // 2 或 4
+        glm::vec3       boundsMin{0.0f};
+        glm::vec3       boundsMax{0.0f};
+        std::vector<TextureRef> textures;
+    };
+
+    /**
+     * @brief 根据源文件当前的状态生成缓存键
+     * @return false 源文件不存在, 且资源包中也没有它的缓存
+     */
+    static bool makeKey(const std::string& sourcePath, uint32_t importFlags, uint32_t processFlags,
+                        VertexFormat vertexFormat, uint32_t vertexAttributes, Key& outKey);
+
+    // 缓存文件路径: <源文件>.meshcache
+    static std::string cachePathFor(const std::string& sourcePath);
+
+    /**
+     * @brief 写入缓存（先写临时文件再重命名，避免留下半个文件）
+     */
+    static bool write(const std::string& cachePath,
+                      const Key& key,
+                      const std::vector<MeshView>& meshes,
+                      const glm::vec3& boundsMin,
+                      const glm::vec3& boundsMax);
+
+    /**
+     * @brief 映射并校验缓存文件 (优先使用资源包中的同名条目)
+     * @return false 文件不存在、已损坏或与 key 不匹配
+     */
+    bool open(const std::string& cachePath, const Key& key);
+    void close();
+
+    bool isOpen() const { return m_file.isOpen(); }
+    bool isPackaged() const { return m_file.isPackaged(); }
+    size_t mappedBytes() const { return m_file.size(); }
+    const std::vector<MeshView>& meshes() const { return m_meshes; }
+    glm::vec3 boundsMin() const { return m_boundsMin; }
+    glm::vec3 boundsMax() const { return m_boundsMax; }
+
+private:
+    AssetFile             m_file;
+    std::vector<MeshView> m_meshes;
+    glm::vec3             m_boundsMin{0.0f};
+    glm::vec3             m_boundsMax{0.0f};
+};
@@ -0,0 +1,375 @@
+#include "MeshOptimizer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace MeshOptimizer {
+
+CacheStats analyzeVertexCache(const uint32_t* indices, size_t indexCount, size_t vertexCount, unsigned int cacheSize,
+                              MonotonicArena* scratch) {
+    CacheStats stats;
+    if (indexCount < 3 || vertexCount == 0) return stats;
+
+    ArenaScope scope(scratch);
+    const ArenaAllocator<uint32_t> allocator(scratch);
+
+    // 用时间戳模拟 FIFO: 顶点在 (当前写入序号 - 写入时序号) < cacheSize 时视为命中
+    ArenaVector<uint32_t> cacheStamp(vertexCount, 0, allocator);
+    ArenaVector<uint8_t>  referenced(vertexCount, 0, allocator);
+    uint32_t stamp = cacheSize + 1;
+    size_t misses = 0;
+    size_t uniqueVertices = 0;
+
+    for (size_t i = 0; i < indexCount; ++i) {
+        const uint32_t index = indices[i];
+        if (!referenced[index]) {
+            referenced[index] = 1;
+            ++uniqueVertices;
+        }
+        if (stamp - cacheStamp[index] > cacheSize) {
+            cacheStamp[index] = stamp++;
+            ++misses;
+        }
+    }
+
+    stats.acmr = static_cast<float>(misses) / static_cast<float>(indexCount / 3);
+    stats.atvr = uniqueVertices ? static_cast<float>(misses) / static_cast<float>(uniqueVertices) : 0.0f;
+    return stats;
+}
+
+// ---------------------------------------------------------------------------
+// Forsyth, "Linear-Speed Vertex Cache Optimisation"
+// ---------------------------------------------------------------------------
+
+namespace {
+
+constexpr int   kCacheSize          = 32;
+constexpr float kCacheDecayPower    = 1.5f;
+constexpr float kLastTriangleScore  = 0.75f;
+constexpr float kValenceBoostScale  = 2.0f;
+constexpr float kValenceBoostPower  = 0.5f;
+constexpr int   kMaxValenceForTable = 32;
+
+struct ScoreTables {
+    float cache[kCacheSize];
+    float valence[kMaxValenceForTable];
+
+    ScoreTables() {
+        for (int i = 0; i < kCacheSize; ++i) {
+            if (i < 3) {
+                // 刚用过的三个顶点分数固定, 避免总是选择与上一个三角形共边的三角形形成细长条带
+                cache[i] = kLastTriangleScore;
+            } else {
+                const float scaler = 1.0f / static_cast<float>(kCacheSize - 3);
+                cache[i] = std::pow(1.0f - static_cast<float>(i - 3) * scaler, kCacheDecayPower);
+            }
+        }
+        valence[0] = 0.0f;
+        for (int i = 1; i < kMaxValenceForTable; ++i) {
+            valence[i] = kValenceBoostScale * std::pow(static_cast<float>(i), -kValenceBoostPower);
+        }
+    }
+};
+
+const ScoreTables& scoreTables() {
+    static const ScoreTables tables;
+    return tables;
+}
+
+float vertexScore(int cachePosition, uint32_t remainingValence) {
+    if (remainingValence == 0) return -1.0f;    // 没有未输出的三角形, 不再参与
+
+    const ScoreTables& tables = scoreTables();
+    float score = cachePosition >= 0 ? tables.cache[cachePosition] : 0.0f;
+    score += remainingValence < static_cast<uint32_t>(kMaxValenceForTable)
+                 ? tables.valence[remainingValence]
+                 : kValenceBoostScale * std::pow(static_cast<float>(remainingValence), -kValenceBoostPower);
+    return score;
+}
+
+} // namespace
+
+void optimizeVertexCache(uint32_t* indices, size_t indexCount, size_t vertexCount, MonotonicArena* scratch) {
+    const size_t triangleCount = indexCount / 3;
+    if (triangleCount < 2 || vertexCount == 0) return;
+
+    ArenaScope scope(scratch);
+    const ArenaAllocator<uint32_t> allocator(scratch);
+
+    // ---- 顶点 -> 三角形 邻接表 (CSR) ----
+    ArenaVector<uint32_t> valence(vertexCount, 0, allocator);
+    for (size_t i = 0; i < indexCount; ++i) ++valence[indices[i]];
+
+    ArenaVector<uint32_t> adjacencyOffset(vertexCount + 1, 0, allocator);
+    for (size_t v = 0; v < vertexCount; ++v) adjacencyOffset[v + 1] = adjacencyOffset[v] + valence[v];
+
+    ArenaVector<uint32_t> adjacency(triangleCount * 3, allocator);     // 下面的填充恰好写满每一项
+    {
+        ArenaVector<uint32_t> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1, allocator);
+        for (size_t t = 0; t < triangleCount; ++t) {
+            for (int k = 0; k < 3; ++k) {
+                const uint32_t v = indices[t * 3 + k];
+                adjacency[fill[v]++] = static_cast<uint32_t>(t);
+            }
+        }
+    }
+
+    // remaining[v] 为未输出的三角形数量, 邻接表前 remaining[v] 项即为这些三角形
+    ArenaVector<uint32_t> remaining(valence.begin(), valence.end(), allocator);
+    ArenaVector<int>      cachePosition(vertexCount, -1, allocator);
+    ArenaVector<float>    vertexScores(vertexCount, allocator);
+    for (size_t v = 0; v < vertexCount; ++v) vertexScores[v] = vertexScore(-1, remaining[v]);
+
+    ArenaVector<uint8_t> emitted(triangleCount, 0, allocator);
+
+    ArenaVector<uint32_t> output(allocator);
+    output.reserve(triangleCount * 3);
+
+    // LRU 缓存, 多留 3 个位置容纳新三角形挤出的顶点
+    uint32_t cache[kCacheSize + 3];
+    int cacheUsed = 0;
+
+    size_t scanCursor = 0;      // 没有候选时从这里线性寻找下一个未输出的三角形
+    int64_t bestTriangle = -1;
+
+    for (size_t emittedCount = 0; emittedCount < triangleCount; ++emittedCount) {
+        if (bestTriangle < 0) {
+            while (emitted[scanCursor]) ++scanCursor;
+            bestTriangle = static_cast<int64_t>(scanCursor);
+        }
+
+        const size_t t = static_cast<size_t>(bestTriangle);
+        emitted[t] = 1;
+
+        uint32_t newCache[kCacheSize + 3];
+        int newUsed = 0;
+        for (int k = 0; k < 3; ++k) {
+            const uint32_t v = indices[t * 3 + k];
+            output.push_back(v);
+            newCache[newUsed++] = v;
+
+            // 从邻接表中移除该三角形
+            uint32_t* begin = adjacency.data() + adjacencyOffset[v];
+            uint32_t* end   = begin + remaining[v];
+            uint32_t* found = std::find(begin, end, static_cast<uint32_t>(t));
+            std::swap(*found, *(end - 1));
+            --remaining[v];
+        }
+        for (int i = 0; i < cacheUsed; ++i) {
+            const uint32_t v = cache[i];
+            if (v != newCache[0] && v != newCache[1] && v != newCache[2]) {
+                newCache[newUsed++] = v;
+            }
+        }
+
+        // 更新缓存位置与顶点分数, 被挤出缓存的顶点位置重置为 -1
+        for (int i = 0; i < newUsed; ++i) {
+            const uint32_t v = newCache[i];
+            cachePosition[v] = i < kCacheSize ? i : -1;
+            vertexScores[v] = vertexScore(cachePosition[v], remaining[v]);
+        }
+
+        // 只需重算缓存内顶点相关三角形的分数, 并从中挑选下一个
+        bestTriangle = -1;
+        float bestScore = -1.0f;
+        for (int i = 0; i < newUsed; ++i) {
+            const uint32_t v = newCache[i];
+            const uint32_t* begin = adjacency.data() + adjacencyOffset[v];
+            for (uint32_t j = 0; j < remaining[v]; ++j) {
+                const uint32_t tri = begin[j];
+                const float score = vertexScores[indices[tri * 3]] + vertexScores[indices[tri * 3 + 1]] + vertexScores[indices[tri * 3 + 2]];
+                if (score > bestScore) {
+                    bestScore = score;
+                    bestTriangle = tri;
+                }
+            }
+        }
+
+        cacheUsed = std::min(newUsed, kCacheSize);
+        std::copy(newCache, newCache + cacheUsed, cache);
+    }
+
+    // 不足一个三角形的尾部索引保持原位
+    std::copy(output.begin(), output.end(), indices);
+}
+
+// ---------------------------------------------------------------------------
+// 过度绘制: Sander et al. "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw" 的簇排序部分
+// ---------------------------------------------------------------------------
+
+void optimizeOverdraw(uint32_t* indices, size_t indexCount, const Vertex* vertices, size_t vertexCount,
+                      unsigned int cacheSize, MonotonicArena* scratch) {
+    const size_t triangleCount = indexCount / 3;
+    if (triangleCount < 2 || vertexCount == 0) return;
+
+    ArenaScope scope(scratch);
+    const ArenaAllocator<uint32_t> allocator(scratch);
+
+    // ---- 1. 按缓存边界分簇: 三个顶点全部未命中的三角形作为新簇的起点 ----
+    ArenaVector<size_t> clusterStarts(allocator);
+    {
+        ArenaVector<uint32_t> cacheStamp(vertexCount, 0, allocator);
+        uint32_t stamp = cacheSize + 1;
+        for (size_t t = 0; t < triangleCount; ++t) {
+            int misses = 0;
+            for (int k = 0; k < 3; ++k) {
+                const uint32_t v = indices[t * 3 + k];
+                if (stamp - cacheStamp[v] > cacheSize) {
+                    cacheStamp[v] = stamp++;
+                    ++misses;
+                }
+            }
+            if (t == 0 || misses == 3) clusterStarts.push_back(t);
+        }
+    }
+    if (clusterStarts.size() < 2) return;
+
+    // ---- 2. 计算网格中心与每个簇的 (面积加权) 中心和法线 ----
+    glm::vec3 meshCentroid(0.0f);
+    float meshArea = 0.0f;
+    struct Cluster {
+        size_t firstTriangle;
+        size_t triangleCount;
+        float  sortKey;
+    };
+    ArenaVector<Cluster> clusters(clusterStarts.size(), allocator);
+    ArenaVector<glm::vec3> clusterCentroids(clusters.size(), glm::vec3(0.0f), allocator);
+    ArenaVector<glm::vec3> clusterNormals(clusters.size(), glm::vec3(0.0f), allocator);
+
+    for (size_t c = 0; c < clusters.size(); ++c) {
+        const size_t begin = clusterStarts[c];
+        const size_t end   = (c + 1 < clusterStarts.size()) ? clusterStarts[c + 1] : triangleCount;
+        clusters[c] = { begin, end - begin, 0.0f };
+
+        float clusterArea = 0.0f;
+        for (size_t t = begin; t < end; ++t) {
+            const glm::vec3& p0 = vertices[indices[t * 3]].Position;
+            const glm::vec3& p1 = vertices[indices[t * 3 + 1]].Position;
+            const glm::vec3& p2 = vertices[indices[t * 3 + 2]].Position;
+            const glm::vec3 crossed = glm::cross(p1 - p0, p2 - p0);
+            const float area = glm::length(crossed) * 0.5f;
+            const glm::vec3 centroid = (p0 + p1 + p2) / 3.0f;
+
+            clusterCentroids[c] += centroid * area;
+            clusterNormals[c]   += crossed;         // 叉积长度本身就是面积权重
+            clusterArea         += area;
+        }
+        meshCentroid += clusterCentroids[c];
+        meshArea     += clusterArea;
+        if (clusterArea > 0.0f) clusterCentroids[c] /= clusterArea;
+    }
+    if (meshArea <= 0.0f) return;
+    meshCentroid /= meshArea;
+
+    // ---- 3. 朝外程度越大的簇越先绘制, 它们更可能遮挡其余部分 ----
+    for (size_t c = 0; c < clusters.size(); ++c) {
+        const float normalLength = glm::length(clusterNormals[c]);
+        const glm::vec3 normal = normalLength > 0.0f ? clusterNormals[c] / normalLength : glm::vec3(0.0f);
+        clusters[c].sortKey = glm::dot(clusterCentroids[c] - meshCentroid, normal);
+    }
+    std::stable_sort(clusters.begin(), clusters.end(),
+                     [](const Cluster& a, const Cluster& b) { return a.sortKey > b.sortKey; });
+
+    ArenaVector<uint32_t> output(allocator);
+    output.reserve(triangleCount * 3);
+    for (const Cluster& cluster : clusters) {
+        output.insert(output.end(),
+                      indices + cluster.firstTriangle * 3,
+                      indices + (cluster.firstTriangle + cluster.triangleCount) * 3);
+    }
+    std::copy(output.begin(), output.end(), indices);
+}
+
+size_t optimizeVertexFetch(uint32_t* indices, size_t indexCount, Vertex* vertices, size_t vertexCount,
+                           MonotonicArena* scratch) {
+    if (indexCount == 0 || vertexCount == 0) return vertexCount;
+
+    ArenaScope scope(scratch);
+    const ArenaAllocator<uint32_t> allocator(scratch);
+
+    constexpr uint32_t kUnassigned = std::numeric_limits<uint32_t>::max();
+    ArenaVector<uint32_t> remap(vertexCount, kUnassigned, allocator);
+    ArenaVector<Vertex> reordered(allocator);
+    reordered.reserve(vertexCount);
+
+    for (size_t i = 0; i < indexCount; ++i) {
+        uint32_t& index = indices[i];
+        if (remap[index] == kUnassigned) {
+            remap[index] = static_cast<uint32_t>(reordered.size());
+            reordered.push_back(vertices[index]);
+        }
+        index = remap[index];
+    }
+    // 写回原数组, 未被引用的顶点由返回的数量截掉
+    std::copy(reordered.begin(), reordered.end(), vertices);
+    return reordered.size();
+}
+
+ArenaVector<MeshChunk> splitByVertexLimit(const uint32_t* indices, size_t indexCount,
+                                          const Vertex* vertices, size_t vertexCount,
+                                          size_t maxVertices, MonotonicArena* arena) {
+    const ArenaAllocator<uint32_t> allocator(arena);
+    ArenaVector<MeshChunk> chunks(allocator);
+    if (indexCount == 0 || maxVertices < 3) return chunks;
+
+    constexpr uint32_t kUnassigned = std::numeric_limits<uint32_t>::max();
+    ArenaVector<uint32_t> remap(vertexCount, kUnassigned, allocator);
+    ArenaVector<uint32_t> touched(allocator);  // 当前块引用过的原顶点, 换块时只重置这些项
+    touched.reserve(std::min(maxVertices, vertexCount));
+
+    // ---- 1. 贪心划分: 记录每块的起始索引与顶点数 ----
+    struct Extent {
+        size_t firstIndex;
+        size_t vertexCount;
+    };
+    ArenaVector<Extent> extents(allocator);
+    extents.push_back({ 0, 0 });
+    const size_t triangleIndices = indexCount - indexCount % 3;
+    for (size_t t = 0; t < triangleIndices; t += 3) {
+        size_t newVertices = 0;
+        for (int k = 0; k < 3; ++k) {
+            if (remap[indices[t + k]] == kUnassigned) ++newVertices;
+        }
+        if (extents.back().vertexCount + newVertices > maxVertices) {
+            for (uint32_t v : touched) remap[v] = kUnassigned;
+            touched.clear();
+            extents.push_back({ t, 0 });
+        }
+        for (int k = 0; k < 3; ++k) {
+            const uint32_t v = indices[t + k];
+            if (remap[v] == kUnassigned) {
+                remap[v] = 0;
+                touched.push_back(v);
+                ++extents.back().vertexCount;
+            }
+        }
+    }
+    for (uint32_t v : touched) remap[v] = kUnassigned;
+    touched.clear();
+
+    // ---- 2. 按统计的大小分配并写入 ----
+    chunks.reserve(extents.size());
+    for (size_t c = 0; c < extents.size(); ++c) {
+        const size_t begin = extents[c].firstIndex;
+        const size_t end = c + 1 < extents.size() ? extents[c + 1].firstIndex : triangleIndices;
+        chunks.push_back({ ArenaVector<uint32_t>(end - begin, allocator),
+                           ArenaVector<Vertex>(extents[c].vertexCount, ArenaAllocator<Vertex>(arena)) });
+        MeshChunk& chunk = chunks.back();
+        uint32_t written = 0;
+        for (size_t i = begin; i < end; ++i) {
+            const uint32_t v = indices[i];
+            if (remap[v] == kUnassigned) {
+                remap[v] = written;
+                chunk.vertices[written++] = vertices[v];
+                touched.push_back(v);
+            }
+            chunk.indices[i - begin] = remap[v];
+        }
+        for (uint32_t v : touched) remap[v] = kUnassigned;
+        touched.clear();
+    }
+    return chunks;
+}
+
+} // namespace MeshOptimizer
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "VertexLayout.hpp"
+#include "ArenaAllocator.hpp"
+
+/**
+ * @brief 导入阶段的网格优化 (纯 CPU, 不依赖 GL 上下文)
+ *
+ * 1. optimizeVertexCache : Forsyth 算法重排三角形, 提高顶点后变换缓存命中率
+ * 2. optimizeOverdraw    : 按缓存边界把三角形分簇, 外侧朝外的簇先画, 降低过度绘制
+ * 3. optimizeVertexFetch : 按索引首次引用顺序重排顶点, 提高顶点拉取的内存局部性
+ *
+ * 推荐顺序为 1 -> (2) -> 3; 第 3 步会改写索引, 必须放在最后。
+ *
+ * 索引与顶点以 (指针, 数量) 传入, 调用方可以用任意存储 (导入时为每个网格的 scratch arena 中的 ArenaVector),
+ * 各函数就地改写, 不重新分配。
+ *
+ * 各函数的 scratch 参数: 非空时内部临时数组从该 arena 分配, 返回前回退, 同一 arena 可被连续的调用反复复用;
+ * 为空时使用堆。scratch 只能由调用线程使用。
+ */
+namespace MeshOptimizer {
+
+    // FIFO 缓存模拟结果
+    struct CacheStats {
+        float acmr = 0.0f;      // Average Cache Miss Ratio: 未命中次数 / 三角形数 (理想值 0.5 ~ 0.7)
+        float atvr = 0.0f;      // Average Transformed Vertex Ratio: 未命中次数 / 被引用顶点数 (理想值 1.0)
+    };
+
+    /**
+     * @brief 以 FIFO 缓存模拟顶点着色器调用次数
+     * @param cacheSize 模拟的后变换缓存大小, 移动 GPU 通常在 16 ~ 32 之间
+     */
+    CacheStats analyzeVertexCache(const uint32_t* indices, size_t indexCount, size_t vertexCount,
+                                  unsigned int cacheSize = 16, MonotonicArena* scratch = nullptr);
+
+    void optimizeVertexCache(uint32_t* indices, size_t indexCount, size_t vertexCount, MonotonicArena* scratch = nullptr);
+
+    /**
+     * @brief 簇级别的过度绘制优化, 应在 optimizeVertexCache 之后调用
+     *
+     * 簇边界取在 FIFO 缓存完全未命中的三角形处, 因此对 ACMR 的影响很小。
+     */
+    void optimizeOverdraw(uint32_t* indices, size_t indexCount, const Vertex* vertices, size_t vertexCount,
+                          unsigned int cacheSize = 16, MonotonicArena* scratch = nullptr);
+
+    /**
+     * @brief 按首次引用顺序重排顶点并改写索引, 未被引用的顶点会被丢弃
+     * @return 重排后的顶点数 (vertices 中此后的元素不再使用)
+     */
+    size_t optimizeVertexFetch(uint32_t* indices, size_t indexCount, Vertex* vertices, size_t vertexCount,
+                               MonotonicArena* scratch = nullptr);
+
+    // 16 位索引可寻址的顶点数上限
+    constexpr size_t kMaxShortIndexVertices = 65536;
+
+    // 拆分后的子网格, 索引相对于自身的顶点数组
+    struct MeshChunk {
+        ArenaVector<uint32_t> indices;
+        ArenaVector<Vertex>   vertices;
+    };
+
+    /**
+     * @brief 按三角形顺序贪心拆分, 每块引用的顶点数不超过 maxVertices
+     *
+     * 保持原三角形顺序, 因此之前的缓存/过度绘制优化结果在块内仍然有效;
+     * 块边界上的共享顶点会被复制到相邻的块中。
+     * 先统计各块的大小再一次写入, 块的数组按实际大小从 arena 分配 (为空时用堆);
+     * 与其他函数不同, arena 在返回时不回退, 临时数组与结果一起保留到调用方释放 arena
+     */
+    ArenaVector<MeshChunk> splitByVertexLimit(const uint32_t* indices, size_t indexCount,
+                                              const Vertex* vertices, size_t vertexCount,
+                                              size_t maxVertices = kMaxShortIndexVertices,
+                                              MonotonicArena* arena = nullptr);
+
+} // namespace MeshOptimizer
@@ -1,9 +1,16 @@
 ﻿#include "ModelLoader_Universal_Instancing.hpp"
 
 #include <stdexcept>
-#include <SOIL2/SOIL2.h>
 #include <limits>
 #include <algorithm>    // 替换反斜杠
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include "ThreadPool.hpp"
+#include "MemoryStats.hpp"
+#include "MeshOptimizer.hpp"
+#include "AssetIOSystem.hpp"
 
 #if defined(_MSC_VER) // Microsoft Visual C++
     #define PROGRAMMATIC_BREAKPOINT() __debugbreak()
@@ -14,13 +21,83 @@
     #define PROGRAMMATIC_BREAKPOINT() raise(SIGTRAP)
 #endif
 
+// 桌面 GL 3.2+ 提供 glDrawElements*BaseVertex; GLES 3.0 没有, 改为上传时把索引预先加上顶点偏移
+#ifdef __ANDROID__
+#define WIND_HAS_BASE_VERTEX 0
+#else
+#define WIND_HAS_BASE_VERTEX 1
+#endif
+
+// Assimp 后处理标志, 同时也是网格缓存键的一部分: 修改这里会让已有缓存自动失效
+static constexpr unsigned int kImportFlags =
+    aiProcess_Triangulate |           // 将所有图元转换为三角形
+    aiProcess_JoinIdenticalVertices | // 合并完全相同的顶点, 否则每个面角都是独立顶点, 顶点缓存无从复用
+    aiProcess_GenSmoothNormals |      // 如果模型没有法线，则生成平滑法线
+    aiProcess_FlipUVs |               // 翻转Y轴的纹理坐标
+    aiProcess_CalcTangentSpace;       // 计算切线和副切线，用于法线贴图
+
+// 导入 arena 的首块大小, 之后逐块翻倍 (上限 MonotonicArena::kMaxBlockSize)
+static constexpr size_t kImportArenaBlockSize = 1u << 20;
+
 // --- Model Class Implementation ---
 
-Model::Model(const std::string& path) 
-    : m_boundsMin(std::numeric_limits<float>::max()),
+Model::Model(const std::string& path, const ModelLoadOptions& options) 
+    : m_options(options),
+      m_boundsMin(std::numeric_limits<float>::max()),
       m_boundsMax(std::numeric_limits<float>::lowest()) 
 {
+    // 构造函数运行在加载线程中: 导入 + 全部 CPU 侧准备工作都在这里完成
+    auto stagingStart = std::chrono::high_resolution_clock::now();
+    if (m_options.importArena) {
+        m_importArena = std::make_unique<MonotonicArena>(kImportArenaBlockSize, true);
+    }
     loadModel(path);
+    buildStaging();
+
+    m_stagedResidentBytes = cpuResidentBytes();
+    m_stagedProcessRSS = MemoryStats::residentBytes();
+    // 暂存已包含上传所需的全部数据, Assimp 场景此后不再需要, 提前释放可以降低上传阶段的峰值
+    if (m_options.residency != ResidencyPolicy::KeepSource) {
+        releaseSource();
+    }
+    LOGI("Model staged on CPU. [CPU staging phase] %lld ms",
+         static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::high_resolution_clock::now() - stagingStart).count()));
+}
+
+// 影响导入结果的非 Assimp 处理选项, 作为网格缓存键的一部分
+uint32_t Model::processFlags(const std::string& path) const {
+    uint32_t flags = 0;
+    if (m_options.optimizeVertexCache) flags |= 1u << 0;
+    if (m_options.optimizeOverdraw)    flags |= 1u << 1;
+    if (m_options.smallIndices)        flags |= 1u << 2;
+    if (m_options.nativeObj && ObjAsset::isObjPath(path)) flags |= 1u << 3;     // 两条 OBJ 路径的输出不保证逐位相同
+    return flags;
+}
+
+unsigned int Model::assimpImportFlags(uint32_t vertexAttributes) {
+    unsigned int flags = kImportFlags;
+    if (!(vertexAttributes & VertexAttrib::Normal)) {
+        flags &= ~aiProcess_GenSmoothNormals;
+    }
+    if (!(vertexAttributes & (VertexAttrib::Tangent | VertexAttrib::Bitangent))) {
+        flags &= ~aiProcess_CalcTangentSpace;
+    }
+    return flags;
+}
+
+bool Model::checkProgramAttributes(const char* programName, uint32_t activeAttributeMask) const {
+    const uint32_t missing = activeAttributeMask & VertexAttrib::All & ~vertexAttributes();
+    if (missing != 0) {
+        LOGE("%s reads vertex attributes 0x%x that the model does not upload (uploaded 0x%x), "
+             "add them to the program's kVertexAttributes", programName, missing, vertexAttributes());
+        return false;
+    }
+    return true;
+}
+
+MonotonicArena::Stats Model::importArenaStats() const {
+    return m_importArena ? m_importArena->stats() : m_importArenaStats;
 }
 
 glm::vec3 Model::boundsMin() const {
@@ -31,8 +108,72 @@ glm::vec3 Model::boundsMax() const {
     return m_boundsMax;
 }
 
+size_t Model::cpuResidentBytes() const {
+    size_t bytes = estimateSceneBytes(scene);
+    for (const StagedMesh& staged : m_stagedMeshes) {
+        bytes += staged.vertices.capacity() + staged.indices.capacity();
+    }
+    if (m_meshCache.isOpen()) {
+        bytes += m_meshCache.mappedBytes();     // 文件映射页, 被访问过的部分计入 RSS
+    }
+    if (m_gltf) {
+        bytes += m_gltf->residentBytes();
+    }
+    if (m_snapshot) {
+        bytes += m_snapshot->byteSize();    // 与 AssetCache 共享
+    }
+    if (m_obj) {
+        bytes += m_obj->residentBytes();
+    }
+    bytes += m_meshBounds.capacity() * sizeof(MeshBounds);
+    return bytes;
+}
+
+// aiScene 中几何与嵌入纹理的主要数组, 不含节点树/材质属性等零碎分配
+size_t Model::estimateSceneBytes(const aiScene* scene) {
+    if (!scene) return 0;
+
+    size_t bytes = 0;
+    for (unsigned int m = 0; m < scene->mNumMeshes; ++m) {
+        const aiMesh* mesh = scene->mMeshes[m];
+        size_t vectorsPerVertex = 1;
+        if (mesh->HasNormals())               vectorsPerVertex += 1;
+        if (mesh->HasTangentsAndBitangents()) vectorsPerVertex += 2;
+        for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_TEXTURECOORDS; ++c) {
+            if (mesh->HasTextureCoords(c)) vectorsPerVertex += 1;
+        }
+        bytes += static_cast<size_t>(mesh->mNumVertices) * vectorsPerVertex * sizeof(aiVector3D);
+        for (unsigned int c = 0; c < AI_MAX_NUMBER_OF_COLOR_SETS; ++c) {
+            if (mesh->HasVertexColors(c)) bytes += static_cast<size_t>(mesh->mNumVertices) * sizeof(aiColor4D);
+        }
+        for (unsigned int f = 0; f < mesh->mNumFaces; ++f) {
+            bytes += sizeof(aiFace) + mesh->mFaces[f].mNumIndices * sizeof(unsigned int);
+        }
+    }
+    for (unsigned int t = 0; t < scene->mNumTextures; ++t) {
+        const aiTexture* texture = scene->mTextures[t];
+        // mHeight == 0 表示压缩数据, mWidth 为字节数
+        bytes += texture->mHeight == 0 ? texture->mWidth
+                                       : static_cast<size_t>(texture->mWidth) * texture->mHeight * sizeof(aiTexel);
+    }
+    return bytes;
+}
+
+// 释放 Assimp 导入器及其持有的 aiScene; glTF 缓冲区仍被暂存直接引用时保留到上传完成
+void Model::releaseSource() {
+    scene = nullptr;
+    m_importer.reset();
+    m_obj.reset();
+    if (!m_gltfReferenced) {
+        m_gltf.reset();
+    }
+}
+
 
 void Model::Draw(GLuint program) const {
+    const GLint posScaleLocation  = glGetUniformLocation(program, "uPosScale");
+    const GLint posOffsetLocation = glGetUniformLocation(program, "uPosOffset");
+    uint32_t boundSegment = UINT32_MAX;
     for (const auto& mesh : m_meshes) {
         unsigned int diffuseNr = 1;
         unsigned int specularNr = 1;
@@ -71,6 +212,8 @@ void Model::Draw(GLuint program) const {
         }
         
         // 现在调用 Mesh 的绘制方法 它只负责绘制几何体
+        bindSegment(mesh, boundSegment);
+        mesh.applyDequantization(posScaleLocation, posOffsetLocation);
         mesh.Draw();
         // 绘制一个Mesh结束之后需要清理纹理绑定 否则着色器会同样采用
         for (unsigned int i = 0; i < mesh.textures.size(); ++i) {
@@ -78,63 +221,997 @@ void Model::Draw(GLuint program) const {
             glBindTexture(GL_TEXTURE_2D, 0); // 将一个空的纹理对象绑定到单元上
         }
     }
+    glBindVertexArray(0);
     glActiveTexture(GL_TEXTURE0);
 }
 
 void Model::loadModel(const std::string& path) {
     LOGI("Loading model from: %s", path.c_str());
+    m_directory = std::filesystem::path(path).parent_path().string();
+
+    // 同一进程中已加载过 (渲染器重建): 直接使用内存中的暂存快照, 不读取任何文件;
+    // 查找不受 publishesToAssetCache 限制, 命中的快照本来就驻留在缓存中
+    if (m_options.stageTextures) {
+        m_snapshotKey = snapshotKey(path);
+        if (!m_snapshotKey.empty()) {
+            m_snapshot = AssetCache::getInstance().find<ModelSnapshot>(m_snapshotKey);
+        }
+        if (m_snapshot) {
+            m_boundsMin = m_snapshot->boundsMin;
+            m_boundsMax = m_snapshot->boundsMax;
+            LOGI("Asset cache hit, %d meshes (%d KB) in memory, import skipped.",
+                 static_cast<int>(m_snapshot->meshes.size()), static_cast<int>(m_snapshot->byteSize() / 1024));
+            return;
+        }
+    }
+
+    // glTF 原生读取: .glb / .bin 直接映射, 不经过 Assimp 的 JSON 解析与 aiMesh 拷贝;
+    // 映射本身就是零拷贝数据源, 因此不再使用网格缓存
+    if (m_options.nativeGltf && GltfAsset::isGltfPath(path)) {
+        auto parseStart = std::chrono::high_resolution_clock::now();
+        auto asset = std::make_unique<GltfAsset>();
+        if (asset->open(path)) {
+            m_gltf = std::move(asset);
+            LOGI("glTF parsed natively in %lld ms, %d meshes, %d accessors, %d KB mapped/decoded",
+                 static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                     std::chrono::high_resolution_clock::now() - parseStart).count()),
+                 static_cast<int>(m_gltf->meshes().size()), static_cast<int>(m_gltf->accessors().size()),
+                 static_cast<int>(m_gltf->residentBytes() / 1024));
+            return;
+        }
+        LOGI("Native glTF reader rejected the file, falling back to Assimp.");
+    }
+
+    // 优先尝试二进制网格缓存: 命中时只做 mmap, 完全跳过 Assimp 的解析与后处理
+    if (m_options.useMeshCache) {
+        m_hasCacheKey = MeshCache::makeKey(path, assimpImportFlags(vertexAttributes()), processFlags(path),
+                                           m_options.vertexFormat, vertexAttributes(), m_cacheKey);
+        if (m_hasCacheKey && m_meshCache.open(MeshCache::cachePathFor(path), m_cacheKey)) {
+            m_boundsMin = m_meshCache.boundsMin();
+            m_boundsMax = m_meshCache.boundsMax();
+            LOGI("Mesh cache hit, %d meshes mapped, Assimp import skipped.", static_cast<int>(m_meshCache.meshes().size()));
+            return;
+        }
+    }
+
+    // OBJ 快速路径: 分块并行解析 + 三元组去重, 直接得到 Vertex / 索引数组; 结果同样写入网格缓存
+    if (m_options.nativeObj && ObjAsset::isObjPath(path)) {
+        auto asset = std::make_unique<ObjAsset>();
+        if (asset->open(path, m_options.workerThreads, vertexAttributes())) {
+            m_obj = std::move(asset);
+            const ObjAsset::Stats& stats = m_obj->stats();
+            LOGI("OBJ parsed natively: %d KB in %d chunks on %d threads, parse %.1f ms, assemble %.1f ms, %d meshes",
+                 static_cast<int>(stats.sourceBytes / 1024), static_cast<int>(stats.chunks), static_cast<int>(stats.threads),
+                 stats.parseMs, stats.assembleMs, static_cast<int>(m_obj->meshes().size()));
+            return;
+        }
+        LOGI("Native OBJ parser rejected the file, falling back to Assimp.");
+    }
     
     // 使用一组通用的后处理标志，适用于大多数模型格式
     // 多线程加载 需要将opengl相关的方法放到主线程中调用
-    importer.SetPropertyInteger( AI_CONFIG_FAVOUR_SPEED, 1 );       // 提升加载速度; 20MB的模型能在170ms加载(此Flag和编译为Release)
-    scene = importer.ReadFile(path,
-        aiProcess_Triangulate |           // 将所有图元转换为三角形
-        aiProcess_GenSmoothNormals |      // 如果模型没有法线，则生成平滑法线
-        aiProcess_FlipUVs |               // 翻转Y轴的纹理坐标
-        aiProcess_CalcTangentSpace);      // 计算切线和副切线，用于法线贴图
+    m_importer = std::make_unique<Assimp::Importer>();
+    m_importer->SetPropertyInteger( AI_CONFIG_FAVOUR_SPEED, 1 );    // 提升加载速度; 20MB的模型能在170ms加载(此Flag和编译为Release)
+    m_importer->SetIOHandler( new AssetIOSystem() );               // 未烘焙的模型同样优先从资源包读取, Importer 负责释放
+    scene = m_importer->ReadFile(path, assimpImportFlags(vertexAttributes()));
 
     if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
-        throw std::runtime_error("Assimp Error: " + std::string(importer.GetErrorString()));
+        throw std::runtime_error("Assimp Error: " + std::string(m_importer->GetErrorString()));
     }
 
-    m_directory = std::filesystem::path(path).parent_path().string();
     LOGI("Successfully loaded model to RAM.");
 }
 
+/*
+    CPU 阶段: 与构造函数一起运行在加载线程中, 不调用任何 GL 接口
+    顶点转换/包围盒/索引展开/材质查询/纹理解码 全部在这里完成, 结果放入 m_stagedMeshes / m_stagedTextures
+*/
+void Model::buildStaging() {
+    if (m_snapshot) {
+        stageFromSnapshot();
+    } else if (m_meshCache.isOpen()) {
+        stageFromViews(m_meshCache.meshes());
+    } else if (m_gltf) {
+        stageFromGltf();
+    } else {
+        if (m_obj) {
+            stageFromObj();
+        } else {
+            processMeshesParallel();
+        }
+        writeMeshCache();
+    }
+    if (!m_snapshot && publishesToAssetCache()) {
+        publishSnapshot();
+    }
+
+    LOGI("Staged %d meshes, %d textures queued for decode",
+         static_cast<int>(m_stagedMeshes.size()), static_cast<int>(m_stagedTextures.size()));
+    if (m_importArena) {
+        const MonotonicArena::Stats stats = m_importArena->stats();
+        LOGI("Import arena: %d allocations in %d blocks, %d KB used / %d KB reserved",
+             static_cast<int>(stats.allocations), static_cast<int>(stats.blocks),
+             static_cast<int>(stats.usedBytes / 1024), static_cast<int>(stats.reservedBytes / 1024));
+    }
+}
 
-// RAM to Graphic RAM 
+// GPU 阶段: 渲染线程只做 glGen*/glBufferData/glTexImage2D
 void Model::uploadToGPU() {
     // PROGRAMMATIC_BREAKPOINT();
-    processNode(scene->mRootNode, scene);
-    LOGI("Successfully loaded model to -> Graphics <- RAM.");
+    auto uploadStart = std::chrono::high_resolution_clock::now();
+
+    // 纹理名立即可用 (解码未完成时为占位纹理), 像素由 TextureLoader::pumpUploads 在后续帧上传
+    std::vector<GLuint> textureIds(m_stagedTextures.size(), 0);
+    m_textureRefs.reserve(m_stagedTextures.size());
+    for (size_t i = 0; i < m_stagedTextures.size(); ++i) {
+        textureIds[i] = m_stagedTextures[i].texture.id();
+        m_textureRefs.push_back(m_stagedTextures[i].texture);
+    }
+
+    std::vector<std::vector<Texture>> meshTextures(m_stagedMeshes.size());
+    for (size_t m = 0; m < m_stagedMeshes.size(); ++m) {
+        const StagedMesh& staged = m_stagedMeshes[m];
+        std::vector<Texture>& textures = meshTextures[m];
+        textures.reserve(staged.textures.size());
+        for (const StagedTextureRef& ref : staged.textures) {
+            Texture texture;
+            texture.id   = textureIds[ref.index];
+            texture.type = ref.type;
+            texture.path = m_stagedTextures[ref.index].path;
+            textures.push_back(texture);
+        }
+    }
+    uploadGeometry(meshTextures);
+
+    if (m_options.residency != ResidencyPolicy::Lean) {
+        m_meshBounds.reserve(m_stagedMeshes.size());
+        for (const StagedMesh& staged : m_stagedMeshes) {
+            m_meshBounds.push_back({staged.boundsMin, staged.boundsMax});
+        }
+    }
+
+    // 数据已经交给驱动, 暂存数据与缓存映射都不再需要
+    if (m_options.residency != ResidencyPolicy::KeepSource) {
+        m_stagedMeshes.clear();
+        m_stagedMeshes.shrink_to_fit();
+        if (m_importArena) {
+            // 暂存的编码顶点/索引全部在 arena 中, 一次归还
+            m_importArenaStats = m_importArena->stats();
+            m_importArena.reset();
+        }
+        m_stagedTextures.clear();
+        m_stagedTextures.shrink_to_fit();
+        m_stagedTextureIndex.clear();
+        m_meshCache.close();
+        m_gltf.reset();
+        m_snapshot.reset();
+    }
+
+    // AssetCache 是进程级的 (含其它模型与纹理), 单独列出; 模型 CPU 数据中与它共享的快照只在命中时计入
+    static const char* const kPolicyNames[] = { "KeepSource", "BoundsProxy", "Lean" };
+    LOGI("Residency [%s]: model CPU data %d KB -> %d KB, asset cache %d KB, process RSS %d MB -> %d MB",
+         kPolicyNames[static_cast<uint32_t>(m_options.residency)],
+         static_cast<int>(m_stagedResidentBytes / 1024), static_cast<int>(cpuResidentBytes() / 1024),
+         static_cast<int>(AssetCache::getInstance().stats().bytes / 1024),
+         static_cast<int>(m_stagedProcessRSS / (1024 * 1024)),
+         static_cast<int>(MemoryStats::residentBytes() / (1024 * 1024)));
+
+    LOGI("Successfully loaded model to -> Graphics <- RAM. [GPU upload phase] %lld ms",
+         static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::high_resolution_clock::now() - uploadStart).count()));
 }
 
+/*
+    所有 Mesh 的顶点依次写入共享 VBO, 索引写入同一个 EBO; 每个 Mesh 只记录所在段、段内 baseVertex 与索引字节偏移。
+    索引偏移按 4 字节对齐, 16/32 位索引可以混放。
+    有 base vertex 时只有一段; GLES 没有 base vertex, 索引上传时加上段内偏移, 16 位索引的 Mesh 会越过
+    65536 个顶点时开始新的一段 (新的 VBO + VAO), 预偏移后的索引仍然是 16 位。
+*/
+void Model::uploadGeometry(const std::vector<std::vector<Texture>>& meshTextures) {
+    const VertexFormat format = m_options.vertexFormat;
+    const uint32_t attributes = vertexAttributes();
+    const size_t stride = VertexLayout::stride(format, attributes);
+    const size_t streamStrides[2] = { VertexLayout::streamStride(format, attributes, 0),
+                                      VertexLayout::streamStride(format, attributes, 1) };
+
+    // ---- 1. 布局 ----
+    struct Range {
+        uint32_t segment;
+        size_t   baseVertex;    // 段内的首个顶点
+        size_t   indexOffset;
+    };
+    std::vector<Range> ranges(m_stagedMeshes.size());
+    std::vector<size_t> segmentVertices(1, 0);
+    size_t vertexTotal = 0;
+    size_t indexBytes  = 0;
+    for (size_t m = 0; m < m_stagedMeshes.size(); ++m) {
+        const StagedMesh& staged = m_stagedMeshes[m];
+        Range& range = ranges[m];
+#if !WIND_HAS_BASE_VERTEX
+        if (staged.indexSize == sizeof(uint16_t) && segmentVertices.back() > 0 &&
+            segmentVertices.back() + staged.vertexCount() > MeshOptimizer::kMaxShortIndexVertices) {
+            segmentVertices.push_back(0);
+        }
+#endif
+        range.segment    = static_cast<uint32_t>(segmentVertices.size() - 1);
+        range.baseVertex = segmentVertices.back();
+        indexBytes = (indexBytes + 3) & ~size_t(3);
+        range.indexOffset = indexBytes;
+        indexBytes += staged.indexCount() * staged.indexSize;
+        segmentVertices.back() += staged.vertexCount();
+        vertexTotal += staged.vertexCount();
+    }
+
+    // ---- 2. 每段一次分配, 按 Mesh 写入 (mmap 的缓存数据直接作为数据源, 不再拼接 CPU 副本) ----
+    // 段内属性流 1 整体排在流 0 之后: [段内全部 Mesh 的流 0][段内全部 Mesh 的流 1], 两段共用同一个 baseVertex
+    m_segments.resize(segmentVertices.size());
+    glGenBuffers(1, &m_EBO);
+    for (size_t s = 0; s < m_segments.size(); ++s) {
+        GeometrySegment& segment = m_segments[s];
+        glGenVertexArrays(1, &segment.vao);
+        glGenBuffers(1, &segment.vbo);
+        glBindVertexArray(segment.vao);
+        glBindBuffer(GL_ARRAY_BUFFER, segment.vbo);
+        glBufferData(GL_ARRAY_BUFFER, segmentVertices[s] * stride, nullptr, GL_STATIC_DRAW);
+        // EBO 绑定记录在 VAO 中
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_EBO);
+        if (s == 0) {
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, indexBytes, nullptr, GL_STATIC_DRAW);
+        }
+        // 设置顶点属性指针 (按顶点格式与属性集)
+        VertexLayout::setupAttributes(format, attributes, segmentVertices[s] * streamStrides[0]);
+    }
+
+#if !WIND_HAS_BASE_VERTEX
+    std::vector<uint8_t> rebased;
+#endif
+    GLuint boundBuffer = 0;
+    for (size_t m = 0; m < m_stagedMeshes.size(); ++m) {
+        const StagedMesh& staged = m_stagedMeshes[m];
+        const Range& range = ranges[m];
+        const size_t vertexCount = staged.vertexCount();
+        if (m_segments[range.segment].vbo != boundBuffer) {
+            boundBuffer = m_segments[range.segment].vbo;
+            glBindBuffer(GL_ARRAY_BUFFER, boundBuffer);
+        }
+        glBufferSubData(GL_ARRAY_BUFFER, range.baseVertex * streamStrides[0],
+                        vertexCount * streamStrides[0], staged.vertexData());
+        if (streamStrides[1] > 0) {
+            glBufferSubData(GL_ARRAY_BUFFER, segmentVertices[range.segment] * streamStrides[0] + range.baseVertex * streamStrides[1],
+                            vertexCount * streamStrides[1], staged.vertexData() + vertexCount * streamStrides[0]);
+        }
 
-void Model::processNode(aiNode* node, const aiScene* scene) {
+        const size_t indexCount = staged.indexCount();
+#if WIND_HAS_BASE_VERTEX
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, range.indexOffset, indexCount * staged.indexSize, staged.indexData());
+#else
+        // 没有 base vertex: 索引加上该 Mesh 在段 VBO 中的起始顶点; 分段保证 16 位索引不会溢出
+        rebased.resize(indexCount * staged.indexSize);
+        const uint32_t base = static_cast<uint32_t>(range.baseVertex);
+        if (staged.indexSize == sizeof(uint16_t)) {
+            const uint16_t* source = reinterpret_cast<const uint16_t*>(staged.indexData());
+            uint16_t* target = reinterpret_cast<uint16_t*>(rebased.data());
+            for (size_t i = 0; i < indexCount; ++i) {
+                target[i] = static_cast<uint16_t>(base + source[i]);
+            }
+        } else {
+            const uint32_t* source = reinterpret_cast<const uint32_t*>(staged.indexData());
+            uint32_t* target = reinterpret_cast<uint32_t*>(rebased.data());
+            for (size_t i = 0; i < indexCount; ++i) {
+                target[i] = base + source[i];
+            }
+        }
+        glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, range.indexOffset, rebased.size(), rebased.data());
+#endif
+    }
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+    // ---- 3. 每个 Mesh 的绘制记录 ----
+    m_meshes.reserve(m_stagedMeshes.size());
+    for (size_t m = 0; m < m_stagedMeshes.size(); ++m) {
+        const StagedMesh& staged = m_stagedMeshes[m];
+        const Range& range = ranges[m];
+        m_meshes.emplace_back(format, range.segment, WIND_HAS_BASE_VERTEX ? static_cast<GLint>(range.baseVertex) : 0,
+                              range.indexOffset, staged.indexCount(), staged.indexSize, meshTextures[m]);
+        m_meshes.back().setBounds(staged.boundsMin, staged.boundsMax);
+    }
+
+    LOGI( "Meshes quantities add-up to : %d, vertex format %s, attributes 0x%x (%d + %d bytes/vertex, all attributes %d), "
+          "shared vertex buffer %d KB in %d segments, shared index buffer %d KB",
+          static_cast<int>(m_meshes.size()), VertexLayout::name(format), attributes,
+          static_cast<int>(streamStrides[0]), static_cast<int>(streamStrides[1]),
+          static_cast<int>(VertexLayout::stride(format, VertexAttrib::All)),
+          static_cast<int>(vertexTotal * stride / 1024), static_cast<int>(m_segments.size()),
+          static_cast<int>(indexBytes / 1024) );
+}
+
+void Model::stageFromViews(const std::vector<MeshCache::MeshView>& views) {
+    m_stagedMeshes.reserve(views.size());
+    for (const MeshCache::MeshView& view : views) {
+        StagedMesh staged;
+        staged.format = m_options.vertexFormat;
+        staged.attributes = vertexAttributes();
+        // 顶点/索引直接指向映射内存 (或快照), 上传时由 glBufferData 读取
+        staged.mappedVertices    = view.vertices;
+        staged.mappedVertexCount = view.vertexCount;
+        staged.mappedIndices     = view.indices;
+        staged.mappedIndexCount  = view.indexCount;
+        staged.indexSize         = view.indexSize;
+        staged.boundsMin = view.boundsMin;
+        staged.boundsMax = view.boundsMax;
+        for (const MeshCache::TextureRef& ref : view.textures) {
+            staged.textures.push_back({ ref.type, stageTextureFromFile(ref.path, ref.type) });
+        }
+        m_stagedMeshes.push_back(std::move(staged));
+    }
+}
+
+void Model::writeMeshCache() const {
+    if (!m_options.useMeshCache || !m_hasCacheKey) return;
+
+    // 嵌入式纹理只存在于 aiScene 中, 缓存无法独立还原, 这类模型不写缓存
+    if (scene && scene->mNumTextures > 0) {
+        LOGI("Model has embedded textures, mesh cache disabled.");
+        return;
+    }
+
+    std::vector<MeshCache::MeshView> views(m_stagedMeshes.size());
+    for (size_t i = 0; i < m_stagedMeshes.size(); ++i) {
+        const StagedMesh& staged = m_stagedMeshes[i];
+        views[i].vertices    = staged.vertexData();
+        views[i].vertexCount = static_cast<uint32_t>(staged.vertexCount());
+        views[i].indices     = staged.indexData();
+        views[i].indexCount  = static_cast<uint32_t>(staged.indexCount());
+        views[i].indexSize   = staged.indexSize;
+        views[i].boundsMin   = staged.boundsMin;
+        views[i].boundsMax   = staged.boundsMax;
+        for (const StagedTextureRef& ref : staged.textures) {
+            views[i].textures.push_back({ ref.type, m_stagedTextures[ref.index].path });
+        }
+    }
+
+    MeshCache::write(MeshCache::cachePathFor(m_cacheKey.sourcePath), m_cacheKey, views, m_boundsMin, m_boundsMax);
+}
+
+
+// ---- 进程级暂存快照 (AssetCache) ----
+
+// 与网格缓存键的组成相同; 另外区分 glTF 的原生 / Assimp 路径 (两者不经过同一个缓存)
+std::string Model::snapshotKey(const std::string& path) const {
+    uint64_t fileSize = 0;
+    int64_t fileMTime = 0;
+    if (!VirtualFileSystem::getInstance().stat(path, fileSize, fileMTime)) return std::string();
+
+    const uint32_t gltfFlag = (m_options.nativeGltf && GltfAsset::isGltfPath(path)) ? 1u : 0u;
+    return "model:" + path + "#" + std::to_string(fileSize) + ":" + std::to_string(fileMTime) + ":" +
+           std::to_string(assimpImportFlags(vertexAttributes())) + ":" + std::to_string(processFlags(path)) + ":" +
+           std::to_string(static_cast<uint32_t>(m_options.vertexFormat)) + ":" + std::to_string(vertexAttributes()) + ":" +
+           std::to_string(gltfFlag);
+}
+
+bool Model::publishesToAssetCache() const {
+    return m_options.assetCache || m_options.residency == ResidencyPolicy::KeepSource;
+}
+
+void Model::stageFromSnapshot() {
+    // 先按首次暂存的顺序与采样选项重新获取纹理, Mesh 按路径引用时直接命中已暂存的条目
+    for (const ModelSnapshot::TextureEntry& texture : m_snapshot->textures) {
+        stageTextureFromFile(texture.path, texture.type, texture.flipVertically);
+    }
+    stageFromViews(m_snapshot->meshes);
+}
+
+// 暂存数据 (arena / 映射 / glTF 缓冲区) 在上传后释放, 快照拷贝一份独立持有的顶点与索引
+void Model::publishSnapshot() const {
+    if (m_snapshotKey.empty()) return;
+    for (const StagedTexture& texture : m_stagedTextures) {
+        if (texture.embedded) {
+            LOGI("Model has embedded textures, not kept in the asset cache.");
+            return;
+        }
+    }
+
+    const size_t stride = VertexLayout::stride(m_options.vertexFormat, vertexAttributes());
+    auto align = [](size_t offset) { return (offset + 15) & ~size_t(15); };
+    size_t total = 0;
+    for (const StagedMesh& staged : m_stagedMeshes) {
+        total = align(total) + staged.vertexCount() * stride;
+        total = align(total) + staged.indexCount() * staged.indexSize;
+    }
+
+    auto snapshot = std::make_shared<ModelSnapshot>();
+    snapshot->data.resize(total);
+    snapshot->meshes.resize(m_stagedMeshes.size());
+    size_t offset = 0;
+    for (size_t i = 0; i < m_stagedMeshes.size(); ++i) {
+        const StagedMesh& staged = m_stagedMeshes[i];
+        MeshCache::MeshView& view = snapshot->meshes[i];
+        const size_t vertexBytes = staged.vertexCount() * stride;
+        const size_t indexBytes  = staged.indexCount() * staged.indexSize;
+
+        offset = align(offset);
+        std::memcpy(snapshot->data.data() + offset, staged.vertexData(), vertexBytes);
+        view.vertices    = snapshot->data.data() + offset;
+        view.vertexCount = static_cast<uint32_t>(staged.vertexCount());
+        offset += vertexBytes;
+
+        offset = align(offset);
+        std::memcpy(snapshot->data.data() + offset, staged.indexData(), indexBytes);
+        view.indices    = snapshot->data.data() + offset;
+        view.indexCount = static_cast<uint32_t>(staged.indexCount());
+        view.indexSize  = staged.indexSize;
+        offset += indexBytes;
+
+        view.boundsMin = staged.boundsMin;
+        view.boundsMax = staged.boundsMax;
+        for (const StagedTextureRef& ref : staged.textures) {
+            view.textures.push_back({ ref.type, m_stagedTextures[ref.index].path });
+        }
+    }
+    for (const StagedTexture& texture : m_stagedTextures) {
+        snapshot->textures.push_back({ texture.path, texture.type, texture.flipVertically });
+    }
+    snapshot->boundsMin = m_boundsMin;
+    snapshot->boundsMax = m_boundsMax;
+
+    const size_t bytes = snapshot->byteSize();
+    AssetCache::getInstance().insert<ModelSnapshot>(m_snapshotKey, std::move(snapshot), bytes);
+}
+
+bool Model::texturesDecoded() const {
+    for (const StagedTexture& texture : m_stagedTextures) {
+        if (texture.texture.handle().state() == TextureLoader::State::Decoding) return false;
+    }
+    return true;
+}
+
+
+// ---- 原生 glTF 路径 ----
+
+namespace {
+
+// 把 primitive 的索引 (或隐式的顺序索引) 展开为三角形列表, 越界时返回 false
+// out 按展开后的大小一次分配 (使用 out 自身的分配器), 源索引直接从 accessor 读取, 不经过中间数组
+bool readGltfIndices(const GltfAsset& asset, const GltfAsset::Primitive& primitive, size_t vertexCount,
+                     ArenaVector<uint32_t>& out) {
+    size_t count = vertexCount;
+    const GltfAsset::Accessor* accessor = nullptr;
+    const uint8_t* data = nullptr;
+    size_t stride = 0;
+    if (primitive.indices >= 0) {
+        accessor = &asset.accessors()[primitive.indices];
+        data = asset.accessorData(primitive.indices, stride);
+        count = accessor->count;
+        if (accessor->componentType != GltfComponent::UnsignedByte &&
+            accessor->componentType != GltfComponent::UnsignedShort &&
+            accessor->componentType != GltfComponent::UnsignedInt) {
+            return false;
+        }
+    }
+    bool valid = true;
+    auto source = [&](size_t i) -> uint32_t {
+        if (!accessor) return static_cast<uint32_t>(i);
+        const uint8_t* element = data + i * stride;
+        uint32_t index = 0;
+        if (accessor->componentType == GltfComponent::UnsignedByte) {
+            index = *element;
+        } else if (accessor->componentType == GltfComponent::UnsignedShort) {
+            uint16_t v;
+            std::memcpy(&v, element, sizeof(v));
+            index = v;
+        } else {
+            std::memcpy(&index, element, sizeof(index));
+        }
+        if (index >= vertexCount) valid = false;
+        return index;
+    };
+
+    if (primitive.mode == GltfAsset::Triangles) {
+        out.resize(count - count % 3);
+        for (size_t i = 0; i < out.size(); ++i) out[i] = source(i);
+    } else if (primitive.mode == GltfAsset::TriangleStrip) {
+        // 奇数三角形交换前两个顶点以保持一致的环绕方向
+        out.resize(count > 2 ? (count - 2) * 3 : 0);
+        for (size_t i = 2, o = 0; i < count; ++i, o += 3) {
+            const bool odd = (i & 1) != 0;
+            out[o]     = source(odd ? i - 1 : i - 2);
+            out[o + 1] = source(odd ? i - 2 : i - 1);
+            out[o + 2] = source(i);
+        }
+    } else if (primitive.mode == GltfAsset::TriangleFan) {
+        out.resize(count > 2 ? (count - 2) * 3 : 0);
+        for (size_t i = 2, o = 0; i < count; ++i, o += 3) {
+            out[o]     = source(0);
+            out[o + 1] = source(i - 1);
+            out[o + 2] = source(i);
+        }
+    } else {
+        out.clear();
+    }
+    return valid;
+}
+
+// 纹理坐标: float 或归一化的 unsigned byte / short (glTF 核心规范允许的三种格式)
+bool readGltfTexCoords(const GltfAsset& asset, int accessor, size_t vertexCount, Vertex* vertices) {
+    if (accessor < 0) return false;
+    const GltfAsset::Accessor& a = asset.accessors()[accessor];
+    if (a.components != 2 || a.count != vertexCount) return false;
+
+    size_t stride = 0;
+    const uint8_t* data = asset.accessorData(accessor, stride);
+    for (size_t i = 0; i < vertexCount; ++i, data += stride) {
+        glm::vec2& uv = vertices[i].TexCoords;
+        if (a.componentType == GltfComponent::Float) {
+            std::memcpy(&uv, data, sizeof(uv));
+        } else if (a.componentType == GltfComponent::UnsignedShort && a.normalized) {
+            uint16_t v[2];
+            std::memcpy(v, data, sizeof(v));
+            uv = glm::vec2(v[0], v[1]) / 65535.0f;
+        } else if (a.componentType == GltfComponent::UnsignedByte && a.normalized) {
+            uv = glm::vec2(data[0], data[1]) / 255.0f;
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 缺少 NORMAL 时按面积加权累加面法线 (对应 Assimp 路径的 aiProcess_GenSmoothNormals)
+void generateSmoothNormals(Vertex* vertices, size_t vertexCount, const uint32_t* indices, size_t indexCount) {
+    Vertex* const end = vertices + vertexCount;
+    for (Vertex* vertex = vertices; vertex != end; ++vertex) vertex->Normal = glm::vec3(0.0f);
+    for (size_t i = 0; i + 2 < indexCount; i += 3) {
+        Vertex& a = vertices[indices[i]];
+        Vertex& b = vertices[indices[i + 1]];
+        Vertex& c = vertices[indices[i + 2]];
+        const glm::vec3 faceNormal = glm::cross(b.Position - a.Position, c.Position - a.Position);
+        a.Normal += faceNormal;
+        b.Normal += faceNormal;
+        c.Normal += faceNormal;
+    }
+    for (Vertex* vertex = vertices; vertex != end; ++vertex) {
+        const float length = glm::length(vertex->Normal);
+        vertex->Normal = length > 0.0f ? vertex->Normal / length : glm::vec3(0.0f, 1.0f, 0.0f);
+    }
+}
+
+/*
+    属性 span 解码为 Vertex (vertices 至少 positions.count 个); normals / tangents 为空表示缺失, 对应属性置零,
+    副切线由法线、切线与 tangent.w 重建。纹理坐标按 accessor 的分量类型另行读取
+*/
+void decodeGltfVertices(const GltfAsset& asset, const GltfAsset::Primitive& primitive,
+                        const StridedSpan<glm::vec3>& positions, const StridedSpan<glm::vec3>* normals,
+                        const StridedSpan<glm::vec4>* tangents, Vertex* vertices) {
+    const size_t vertexCount = positions.count;
+    for (size_t i = 0; i < vertexCount; ++i) {
+        Vertex& vertex = vertices[i];
+        vertex.Position  = positions[i];
+        vertex.Normal    = normals ? (*normals)[i] : glm::vec3(0.0f);
+        vertex.TexCoords = glm::vec2(0.0f);
+        vertex.Tangent   = glm::vec3(0.0f);
+        vertex.Bitangent = glm::vec3(0.0f);
+        if (tangents) {
+            const glm::vec4 tangent = (*tangents)[i];
+            vertex.Tangent   = glm::vec3(tangent);
+            vertex.Bitangent = glm::cross(vertex.Normal, vertex.Tangent) * tangent.w;
+        }
+    }
+    readGltfTexCoords(asset, primitive.texcoord0, vertexCount, vertices);
+}
+
+void gltfBounds(const GltfAsset::Accessor& accessor, const StridedSpan<glm::vec3>& positions,
+                glm::vec3& outMin, glm::vec3& outMax) {
+    if (accessor.hasBounds) {
+        outMin = accessor.min;
+        outMax = accessor.max;
+        return;
+    }
+    outMin = glm::vec3(std::numeric_limits<float>::max());
+    outMax = glm::vec3(std::numeric_limits<float>::lowest());
+    for (size_t i = 0; i < positions.count; ++i) {
+        outMin = glm::min(outMin, positions[i]);
+        outMax = glm::max(outMax, positions[i]);
+    }
+}
+
+} // namespace
+
+// StagedMesh 的编码输出从导入 arena 分配 (arena 为空时用堆), uploadToGPU 之后随 arena 一次性释放
+static void packStagedVertices(StagedMesh& staged, const Vertex* vertices, size_t count, MonotonicArena* arena) {
+    staged.vertices = ArenaVector<uint8_t>(count * VertexLayout::stride(staged.format, staged.attributes),
+                                           ArenaAllocator<uint8_t>(arena));
+    VertexLayout::pack(staged.format, staged.attributes, vertices, count, staged.boundsMin, staged.boundsMax,
+                       staged.vertices.data());
+}
+
+static void packStagedIndices(StagedMesh& staged, const uint32_t* indices, size_t count, MonotonicArena* arena) {
+    staged.indices = ArenaVector<uint8_t>(count * staged.indexSize, ArenaAllocator<uint8_t>(arena));
+    VertexLayout::packIndices(indices, count, staged.indexSize, staged.indices.data());
+}
+
+/*
+    每个网格一个 scratch arena: 解码出的 Vertex / 索引数组、优化器与拆分的临时数组都从这里分配,
+    按网格规模一次申请首块, 转换结束时整体释放。导入 arena 关闭时 (对比基准) 返回空, 全部使用堆。
+    decode 为 false 时顶点与索引已在别处 (OBJ 路径), 只预留优化器与拆分的部分
+*/
+std::unique_ptr<MonotonicArena> Model::createMeshScratch(const ModelLoadOptions& options, MonotonicArena* importArena,
+                                                         size_t vertexCount, size_t indexCount, bool decode) {
+    if (!importArena) return nullptr;
+    size_t bytes = 0;
+    if (decode) {
+        bytes += vertexCount * sizeof(Vertex) + indexCount * sizeof(uint32_t);
+    }
+    // optimizeVertexCache 约需每顶点 24 字节 + 每索引 8 字节, optimizeVertexFetch 约需每顶点 sizeof(Vertex) + 4 字节
+    if (options.optimizeVertexCache) {
+        bytes += vertexCount * (sizeof(Vertex) + 7 * sizeof(uint32_t)) + indexCount * 2 * sizeof(uint32_t);
+    }
+    // 拆分: 各块的顶点与索引 (块边界复制的顶点另计) + remap
+    if (options.smallIndices && vertexCount > MeshOptimizer::kMaxShortIndexVertices) {
+        bytes += vertexCount * (sizeof(Vertex) + sizeof(uint32_t)) + indexCount * sizeof(uint32_t);
+    }
+    if (bytes == 0) return nullptr;
+    return std::make_unique<MonotonicArena>(bytes + 4096);
+}
+
+/*
+    三条导入路径共用的并行转换: convert(i) 只写第 i 个槽位, 可在任意线程调用
+*/
+void Model::convertMeshesParallel(size_t count, const char* label, const std::function<void(size_t)>& convert) {
+    auto convertStart = std::chrono::high_resolution_clock::now();
+    const size_t threads = std::max<size_t>(1, std::min<size_t>(
+        m_options.workerThreads > 0 ? m_options.workerThreads : ThreadPool::defaultThreadCount(), count));
+    if (threads > 1) {
+        // 加载线程自身也参与 parallelFor, 所以池中只需 threads - 1 个线程
+        ThreadPool pool(threads - 1);
+        pool.parallelFor(count, convert);
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            convert(i);
+        }
+    }
+    LOGI("Converted %d %s on %d threads in %lld ms", static_cast<int>(count), label, static_cast<int>(threads),
+         static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::high_resolution_clock::now() - convertStart).count()));
+}
+
+// 按槽位顺序展开到 m_stagedMeshes, 同时归约各块的包围盒得到模型整体的AABB包围盒
+size_t Model::appendStagedChunks(std::vector<std::vector<StagedMesh>>& slots,
+                                 std::vector<std::vector<StagedTextureRef>>& slotTextures) {
+    const size_t first = m_stagedMeshes.size();
+    size_t chunkCount = 0;
+    for (const std::vector<StagedMesh>& slot : slots) chunkCount += slot.size();
+    m_stagedMeshes.reserve(first + chunkCount);
+
+    for (size_t i = 0; i < slots.size(); ++i) {
+        std::vector<StagedTextureRef>& textures = slotTextures[i];
+        std::vector<StagedMesh>& chunks = slots[i];
+        for (size_t c = 0; c < chunks.size(); ++c) {
+            StagedMesh& staged = chunks[c];
+            m_boundsMin = glm::min(m_boundsMin, staged.boundsMin);
+            m_boundsMax = glm::max(m_boundsMax, staged.boundsMax);
+            // 最后一块直接接管纹理列表 (多数 Mesh 只有一块), 其余块拷贝
+            if (c + 1 == chunks.size()) {
+                staged.textures = std::move(textures);
+            } else {
+                staged.textures = textures;
+            }
+            m_stagedMeshes.push_back(std::move(staged));
+        }
+    }
+    return first;
+}
+
+/*
+    与 processMeshesParallel 相同的结构: 每个 primitive 一个槽位并行转换, 材质/纹理在转换之前于当前线程串行暂存
+    (glTF 的 primitive 对应 Assimp 的 aiMesh)
+*/
+void Model::stageFromGltf() {
+    const GltfAsset& asset = *m_gltf;
+
+    std::vector<const GltfAsset::Primitive*> primitives;
+    for (int mesh : asset.meshesInSceneOrder()) {
+        for (const GltfAsset::Primitive& primitive : asset.meshes()[mesh].primitives) {
+            primitives.push_back(&primitive);
+        }
+    }
+    std::vector<std::vector<StagedMesh>> slots(primitives.size());
+
+    // 先提交材质纹理的解码, 解码线程与下面的网格转换同时工作
+    std::vector<std::vector<StagedTextureRef>> primitiveTextures(primitives.size());
+    for (size_t i = 0; i < primitives.size(); ++i) {
+        processGltfMaterial(primitives[i]->material, primitiveTextures[i]);
+    }
+
+    convertMeshesParallel(primitives.size(), "glTF primitives", [&](size_t i) {
+        processGltfPrimitive(asset, *primitives[i], m_options, m_importArena.get(), slots[i]);
+    });
+
+    for (size_t i = 0; i < slots.size(); ++i) {
+        const std::vector<StagedMesh>& chunks = slots[i];
+        if (m_options.optimizeVertexCache && !chunks.empty()) {
+            LOGI("Primitive %d: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f (FIFO 16)", static_cast<int>(i),
+                 chunks[0].cacheBefore.acmr, chunks[0].cacheAfter.acmr, chunks[0].cacheBefore.atvr, chunks[0].cacheAfter.atvr);
+        }
+    }
+    const size_t first = appendStagedChunks(slots, primitiveTextures);
+
+    size_t mappedVertexMeshes = 0;
+    size_t mappedIndexMeshes  = 0;
+    for (size_t i = first; i < m_stagedMeshes.size(); ++i) {
+        if (m_stagedMeshes[i].mappedVertices) ++mappedVertexMeshes;
+        if (m_stagedMeshes[i].mappedIndices)  ++mappedIndexMeshes;
+    }
+    m_gltfReferenced = mappedVertexMeshes > 0 || mappedIndexMeshes > 0;
+    LOGI("glTF: %d / %d meshes upload vertices straight from buffer views, %d index buffers mapped",
+         static_cast<int>(mappedVertexMeshes), static_cast<int>(m_stagedMeshes.size()), static_cast<int>(mappedIndexMeshes));
+}
+
+/*
+    只读 asset, 只写 outChunks, 可在任意线程并行调用。
+    不需要重排/拆分时, 与 GPU 布局一致的数据直接引用 glTF 缓冲区 (mmap 的 .glb/.bin), 不经过任何中间 vector:
+    - 顶点: Full 格式且 POSITION/NORMAL/TEXCOORD_0 在同一 bufferView 中按 Vertex 的偏移交错, 步长为 sizeof(Vertex)
+      (切线/副切线位置上的数据原样上传, 现有着色器不读取它们)
+    - 索引: 紧密排列的 16/32 位 TRIANGLES 索引
+    其余情况从各属性的 span 一次解码为 Vertex, 再走与 Assimp 路径相同的 finalizeMesh。
+    纹理坐标保持 glTF 约定 (原点在图像左上角), 对应的纹理加载时不翻转。
+*/
+void Model::processGltfPrimitive(const GltfAsset& asset, const GltfAsset::Primitive& primitive,
+                                 const ModelLoadOptions& options, MonotonicArena* arena, std::vector<StagedMesh>& outChunks) {
+    if (primitive.mode != GltfAsset::Triangles && primitive.mode != GltfAsset::TriangleStrip &&
+        primitive.mode != GltfAsset::TriangleFan) {
+        LOGE("glTF: primitive mode %u skipped, only triangles are rendered", primitive.mode);
+        return;
+    }
+    StridedSpan<glm::vec3> positions;
+    if (!asset.span(primitive.position, GltfComponent::Float, 3, positions) || positions.empty()) {
+        LOGE("glTF: primitive without float3 POSITION skipped");
+        return;
+    }
+    const size_t vertexCount = positions.count;
+    const GltfAsset::Accessor& positionAccessor = asset.accessors()[primitive.position];
+
+    StridedSpan<glm::vec3> normals;
+    StridedSpan<glm::vec2> texCoords;
+    StridedSpan<glm::vec4> tangents;
+    const bool hasNormals   = asset.span(primitive.normal, GltfComponent::Float, 3, normals) && normals.count == vertexCount;
+    const bool hasTexCoords = asset.span(primitive.texcoord0, GltfComponent::Float, 2, texCoords) && texCoords.count == vertexCount;
+    const bool hasTangents  = asset.span(primitive.tangent, GltfComponent::Float, 4, tangents) && tangents.count == vertexCount;
+
+    const bool keepOrder = !options.optimizeVertexCache &&
+                           !(options.smallIndices && vertexCount > MeshOptimizer::kMaxShortIndexVertices);
+
+    const bool needNormals = (options.vertexAttributes & VertexAttrib::Normal) != 0;
+    const bool mapVertices = keepOrder && hasNormals && hasTexCoords && options.vertexFormat == VertexFormat::Full &&
+        VertexLayout::storedAttributes(options.vertexFormat, options.vertexAttributes) == VertexAttrib::All &&
+        positions.stride == sizeof(Vertex) && normals.stride == sizeof(Vertex) && texCoords.stride == sizeof(Vertex) &&
+        normals.data == positions.data + offsetof(Vertex, Normal) &&
+        texCoords.data == positions.data + offsetof(Vertex, TexCoords) &&
+        positionAccessor.byteOffset + sizeof(Vertex) * vertexCount <=
+            asset.bufferViews()[positionAccessor.bufferView].byteLength;
+
+    uint32_t mappedIndexSize = 0;
+    if (keepOrder && (hasNormals || !needNormals) && primitive.mode == GltfAsset::Triangles && primitive.indices >= 0) {
+        const GltfAsset::Accessor& accessor = asset.accessors()[primitive.indices];
+        size_t stride = 0;
+        asset.accessorData(primitive.indices, stride);
+        if ((accessor.componentType == GltfComponent::UnsignedShort || accessor.componentType == GltfComponent::UnsignedInt) &&
+            stride == accessor.elementSize() && accessor.count % 3 == 0) {
+            mappedIndexSize = static_cast<uint32_t>(accessor.elementSize());
+        }
+    }
+
+    // 映射的索引同样要校验范围 (只读不拷贝); 展开的索引在 readGltfIndices 中校验
+    if (mappedIndexSize != 0) {
+        size_t stride = 0;
+        const uint8_t* data = asset.accessorData(primitive.indices, stride);
+        const size_t count = asset.accessors()[primitive.indices].count;
+        for (size_t i = 0; i < count && mappedIndexSize != 0; ++i) {
+            uint32_t index = 0;
+            if (mappedIndexSize == sizeof(uint16_t)) {
+                uint16_t v;
+                std::memcpy(&v, data + i * stride, sizeof(v));
+                index = v;
+            } else {
+                std::memcpy(&index, data + i * stride, sizeof(index));
+            }
+            if (index >= vertexCount) mappedIndexSize = 0;
+        }
+    }
+
+    // 解码数组 (未映射的顶点 / 展开的索引) 与后续的优化器临时数组共用本网格的 scratch arena
+    size_t indexEstimate = primitive.indices >= 0 ? asset.accessors()[primitive.indices].count : vertexCount;
+    if (primitive.mode != GltfAsset::Triangles) indexEstimate *= 3;
+    const std::unique_ptr<MonotonicArena> scratch = createMeshScratch(
+        options, arena, mapVertices ? 0 : vertexCount, mappedIndexSize != 0 ? 0 : indexEstimate, true);
+
+    ArenaVector<uint32_t> indices{ ArenaAllocator<uint32_t>(scratch.get()) };
+    if (mappedIndexSize == 0 && !readGltfIndices(asset, primitive, vertexCount, indices)) {
+        LOGE("glTF: primitive with invalid indices skipped");
+        return;
+    }
+
+    // ---- 不重排: 单块输出, 可映射的部分直接引用缓冲区 ----
+    if (mapVertices || mappedIndexSize != 0) {
+        outChunks.resize(1);
+        StagedMesh& staged = outChunks[0];
+        staged.format = options.vertexFormat;
+        staged.attributes = VertexLayout::storedAttributes(options.vertexFormat, options.vertexAttributes);
+        gltfBounds(positionAccessor, positions, staged.boundsMin, staged.boundsMax);
+
+        if (mapVertices) {
+            staged.mappedVertices    = positions.data;
+            staged.mappedVertexCount = vertexCount;
+        } else {
+            ArenaVector<Vertex> vertices(vertexCount, ArenaAllocator<Vertex>(scratch.get()));
+            decodeGltfVertices(asset, primitive, positions, hasNormals ? &normals : nullptr,
+                               hasTangents ? &tangents : nullptr, vertices.data());
+            packStagedVertices(staged, vertices.data(), vertices.size(), arena);
+        }
+
+        if (mappedIndexSize != 0) {
+            size_t stride = 0;
+            staged.mappedIndices    = asset.accessorData(primitive.indices, stride);
+            staged.mappedIndexCount = asset.accessors()[primitive.indices].count;
+            staged.indexSize        = mappedIndexSize;
+        } else {
+            staged.indexSize = VertexLayout::indexSizeFor(vertexCount);
+            packStagedIndices(staged, indices.data(), indices.size(), arena);
+        }
+        return;
+    }
+
+    // ---- 一般路径: 属性 span 一次解码为 Vertex, 之后与 Assimp 路径相同 ----
+    ArenaVector<Vertex> vertices(vertexCount, ArenaAllocator<Vertex>(scratch.get()));
+    decodeGltfVertices(asset, primitive, positions, hasNormals ? &normals : nullptr, hasTangents ? &tangents : nullptr,
+                       vertices.data());
+    if (!hasNormals && needNormals) {
+        generateSmoothNormals(vertices.data(), vertices.size(), indices.data(), indices.size());
+    }
+    finalizeMesh(vertices.data(), vertices.size(), indices.data(), indices.size(), options, arena, scratch.get(), outChunks);
+}
+
+void Model::processGltfMaterial(int material, std::vector<StagedTextureRef>& outTextures) {
+    if (material < 0 || static_cast<size_t>(material) >= m_gltf->materials().size()) return;
+    const GltfAsset::Material& source = m_gltf->materials()[material];
+
+    auto stageImage = [&](int image, const std::string& type) {
+        if (image < 0) return;
+        const GltfAsset::Image& info = m_gltf->images()[image];
+        if (info.data) {
+            // 与 Assimp 的嵌入式纹理命名一致: "*<image 下标>"
+            outTextures.push_back({ type, stageTextureFromMemory("*" + std::to_string(image), type, info.data, info.size, false) });
+        } else if (!info.uri.empty()) {
+            outTextures.push_back({ type, stageTextureFromFile(info.uri, type, false) });
+        }
+    };
+    LOGI("material %s baseColor image %d, normal image %d", source.name.c_str(), source.baseColorImage, source.normalImage);
+    stageImage(source.baseColorImage, "texture_diffuse");
+    stageImage(source.normalImage, "texture_normal");
+}
+
+// 按深度优先顺序展开节点树, 与原先串行递归的 Mesh 顺序一致
+void Model::processNode(aiNode* node, const aiScene* scene, std::vector<const aiMesh*>& outMeshes) {
     for (unsigned int i = 0; i < node->mNumMeshes; ++i) {
-        aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-        m_meshes.push_back(processMesh(mesh, scene));
+        outMeshes.push_back(scene->mMeshes[node->mMeshes[i]]);
     }
     for (unsigned int i = 0; i < node->mNumChildren; ++i) {
-        processNode(node->mChildren[i], scene);
+        processNode(node->mChildren[i], scene, outMeshes);
+    }
+}
+
+
+// ---- 原生 OBJ 路径 ----
+
+/*
+    ObjAsset 已经完成去重与三角化, 这里只并行执行 finalizeMesh; 纹理按 processMaterial 的顺序
+    (diffuse / specular / normal / ambient) 串行暂存, 与 Assimp 路径的纹理绑定顺序一致
+*/
+void Model::stageFromObj() {
+    std::vector<ObjAsset::Mesh>& meshes = m_obj->meshes();
+    std::vector<std::vector<StagedMesh>> slots(meshes.size());
+
+    // 先提交材质纹理的解码, 解码线程与下面的网格转换同时工作
+    std::vector<std::vector<StagedTextureRef>> meshTextures(meshes.size());
+    const std::vector<ObjAsset::Material>& materials = m_obj->materials();
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        if (meshes[i].material < 0) continue;
+        const ObjAsset::Material& material = materials[meshes[i].material];
+        const std::pair<const std::string*, const char*> maps[] = {
+            { &material.diffuseMap,  "texture_diffuse" },
+            { &material.specularMap, "texture_specular" },
+            { &material.normalMap,   "texture_normal" },
+            { &material.ambientMap,  "texture_ambient" },
+        };
+        for (const auto& map : maps) {
+            if (!map.first->empty()) {
+                meshTextures[i].push_back({ map.second, stageTextureFromFile(*map.first, map.second) });
+            }
+        }
+    }
+
+    convertMeshesParallel(meshes.size(), "OBJ meshes", [&](size_t i) {
+        std::vector<Vertex>& vertices = meshes[i].vertices;
+        std::vector<uint32_t>& indices = meshes[i].indices;
+        const std::unique_ptr<MonotonicArena> scratch =
+            createMeshScratch(m_options, m_importArena.get(), vertices.size(), indices.size(), false);
+        finalizeMesh(vertices.data(), vertices.size(), indices.data(), indices.size(), m_options, m_importArena.get(),
+                     scratch.get(), slots[i]);
+        // 转换完成即释放, 降低大模型的峰值内存
+        std::vector<Vertex>().swap(meshes[i].vertices);
+        std::vector<uint32_t>().swap(meshes[i].indices);
+    });
+
+    for (size_t i = 0; i < slots.size(); ++i) {
+        const std::vector<StagedMesh>& chunks = slots[i];
+        if (m_options.optimizeVertexCache && !chunks.empty()) {
+            LOGI("OBJ mesh %d (%s): ACMR %.3f -> %.3f, ATVR %.3f -> %.3f (FIFO 16)", static_cast<int>(i), meshes[i].name.c_str(),
+                 chunks[0].cacheBefore.acmr, chunks[0].cacheAfter.acmr, chunks[0].cacheBefore.atvr, chunks[0].cacheAfter.atvr);
+        }
+    }
+    appendStagedChunks(slots, meshTextures);
+    m_obj.reset();
+}
+
+/*
+    网格转换在线程池中并行执行: 每个 aiMesh 写入预分配的槽位, 输出顺序与节点遍历顺序一致
+    (一个 aiMesh 在 smallIndices 策略下可能拆成多个 StagedMesh, 最后按槽位顺序展开)
+    材质/纹理暂存会修改共享的纹理表, 在转换开始前于当前线程串行完成 (解码随即在纹理线程池中开始)
+*/
+void Model::processMeshesParallel() {
+    std::vector<const aiMesh*> meshes;
+    processNode(scene->mRootNode, scene, meshes);
+    std::vector<std::vector<StagedMesh>> slots(meshes.size());
+
+    // 先提交材质纹理的解码, 解码线程与下面的网格转换同时工作
+    std::vector<std::vector<StagedTextureRef>> meshTextures(meshes.size());
+    for (size_t i = 0; i < meshes.size(); ++i) {
+        processMaterial(meshes[i], scene, meshTextures[i]);
+    }
+
+    convertMeshesParallel(meshes.size(), "meshes", [&](size_t i) {
+        processMesh(meshes[i], m_options, m_importArena.get(), slots[i]);
+    });
+
+    for (size_t i = 0; i < slots.size(); ++i) {
+        const std::vector<StagedMesh>& chunks = slots[i];
+        if (m_options.optimizeVertexCache && !chunks.empty()) {
+            LOGI("Mesh %d: %d tris, %d verts, ACMR %.3f -> %.3f, ATVR %.3f -> %.3f (FIFO 16)",
+                 static_cast<int>(i), static_cast<int>(meshes[i]->mNumFaces), static_cast<int>(meshes[i]->mNumVertices),
+                 chunks[0].cacheBefore.acmr, chunks[0].cacheAfter.acmr, chunks[0].cacheBefore.atvr, chunks[0].cacheAfter.atvr);
+        }
+        if (chunks.size() > 1) {
+            LOGI("Mesh %d split into %d chunks for 16-bit indices", static_cast<int>(i), static_cast<int>(chunks.size()));
+        }
     }
+    const size_t first = appendStagedChunks(slots, meshTextures);
 
-    LOGI( "Meshes quantities add-up to : %d", static_cast<int>(m_meshes.size()) );
+    size_t shortIndexMeshes = 0;
+    for (size_t i = first; i < m_stagedMeshes.size(); ++i) {
+        if (m_stagedMeshes[i].indexSize == sizeof(uint16_t)) ++shortIndexMeshes;
+    }
+    LOGI("%d / %d meshes use 16-bit indices", static_cast<int>(shortIndexMeshes), static_cast<int>(m_stagedMeshes.size()));
 }
 
-Mesh Model::processMesh(aiMesh* mesh, const aiScene* scene) {
-    std::vector<Vertex> vertices;
-    std::vector<unsigned int> indices;
-    std::vector<Texture> textures;
+// 只读 aiMesh, 只写 outChunks, 可在任意线程并行调用
+void Model::processMesh(const aiMesh* mesh, const ModelLoadOptions& options, MonotonicArena* arena,
+                        std::vector<StagedMesh>& outChunks) {
+    // 解码数组与后续的优化器临时数组共用本网格的 scratch arena
+    const std::unique_ptr<MonotonicArena> scratch =
+        createMeshScratch(options, arena, mesh->mNumVertices, static_cast<size_t>(mesh->mNumFaces) * 3, true);
+    ArenaVector<Vertex> vertices{ ArenaAllocator<Vertex>(scratch.get()) };
+    ArenaVector<uint32_t> indices{ ArenaAllocator<uint32_t>(scratch.get()) };
+    vertices.reserve(mesh->mNumVertices);
+    indices.reserve(static_cast<size_t>(mesh->mNumFaces) * 3);
 
     for (unsigned int i = 0; i < mesh->mNumVertices; ++i) {
         Vertex vertex;
         vertex.Position = {mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z};
-        
-        // 更新模型的整体AABB包围盒
-        m_boundsMin = glm::min(m_boundsMin, vertex.Position);
-        m_boundsMax = glm::max(m_boundsMax, vertex.Position);
 
+        // 未请求法线/切线时 Assimp 不再生成它们, 缺失的属性统一置零
+        vertex.Normal    = glm::vec3(0.0f);
+        vertex.Tangent   = glm::vec3(0.0f);
+        vertex.Bitangent = glm::vec3(0.0f);
         if (mesh->HasNormals()) {
             vertex.Normal = {mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z};
         }
@@ -151,14 +1228,80 @@ Mesh Model::processMesh(aiMesh* mesh, const aiScene* scene) {
     }
 
     for (unsigned int i = 0; i < mesh->mNumFaces; ++i) {
-        aiFace face = mesh->mFaces[i];
+        const aiFace& face = mesh->mFaces[i];
         for (unsigned int j = 0; j < face.mNumIndices; ++j) {
             indices.push_back(face.mIndices[j]);
         }
     }
 
+    finalizeMesh(vertices.data(), vertices.size(), indices.data(), indices.size(), options, arena, scratch.get(), outChunks);
+}
+
+/*
+    只读写参数, 可在任意线程并行调用; vertices / indices 会被就地重排。
+    优化器与拆分的临时数组放在调用方为本网格创建的 scratch arena 中 (见 createMeshScratch, 为空时用堆),
+    编码结果从共享的导入 arena 分配
+*/
+void Model::finalizeMesh(Vertex* vertices, size_t vertexCount, uint32_t* indices, size_t indexCount,
+                         const ModelLoadOptions& options, MonotonicArena* arena, MonotonicArena* scratch,
+                         std::vector<StagedMesh>& outChunks) {
+    // 顶点缓存 / 过度绘制 / 顶点拉取 优化, 必须在编码之前完成 (过度绘制排序需要位置)
+    MeshOptimizer::CacheStats cacheBefore, cacheAfter;
+    if (options.optimizeVertexCache) {
+        cacheBefore = MeshOptimizer::analyzeVertexCache(indices, indexCount, vertexCount, 16, scratch);
+        MeshOptimizer::optimizeVertexCache(indices, indexCount, vertexCount, scratch);
+        if (options.optimizeOverdraw) {
+            MeshOptimizer::optimizeOverdraw(indices, indexCount, vertices, vertexCount, 16, scratch);
+        }
+        vertexCount = MeshOptimizer::optimizeVertexFetch(indices, indexCount, vertices, vertexCount, scratch);
+        cacheAfter = MeshOptimizer::analyzeVertexCache(indices, indexCount, vertexCount, 16, scratch);
+    }
+
+    auto stageChunk = [&](StagedMesh& staged, const uint32_t* chunkIndices, size_t chunkIndexCount,
+                          const Vertex* chunkVertices, size_t chunkVertexCount) {
+        staged.cacheBefore = cacheBefore;
+        staged.cacheAfter  = cacheAfter;
+
+        // 当前Mesh(块)的AABB包围盒
+        glm::vec3 chunkBoundsMin(std::numeric_limits<float>::max());
+        glm::vec3 chunkBoundsMax(std::numeric_limits<float>::lowest());
+        for (size_t v = 0; v < chunkVertexCount; ++v) {
+            chunkBoundsMin = glm::min(chunkBoundsMin, chunkVertices[v].Position);
+            chunkBoundsMax = glm::max(chunkBoundsMax, chunkVertices[v].Position);
+        }
+        staged.boundsMin = chunkBoundsMin;
+        staged.boundsMax = chunkBoundsMax;
+
+        // 按目标格式编码 (Compact 需要先得到包围盒才能量化位置)
+        staged.format = options.vertexFormat;
+        staged.attributes = VertexLayout::storedAttributes(options.vertexFormat, options.vertexAttributes);
+        packStagedVertices(staged, chunkVertices, chunkVertexCount, arena);
+
+        staged.indexSize = VertexLayout::indexSizeFor(chunkVertexCount);
+        packStagedIndices(staged, chunkIndices, chunkIndexCount, arena);
+    };
+
+    // 16 位索引最多寻址 kMaxShortIndexVertices 个顶点; 超出时按策略拆分, 否则整体使用 32 位索引
+    if (options.smallIndices && vertexCount > MeshOptimizer::kMaxShortIndexVertices) {
+        const ArenaVector<MeshOptimizer::MeshChunk> chunks = MeshOptimizer::splitByVertexLimit(
+            indices, indexCount, vertices, vertexCount, MeshOptimizer::kMaxShortIndexVertices, scratch);
+        outChunks.resize(chunks.size());
+        for (size_t c = 0; c < chunks.size(); ++c) {
+            stageChunk(outChunks[c], chunks[c].indices.data(), chunks[c].indices.size(),
+                       chunks[c].vertices.data(), chunks[c].vertices.size());
+        }
+    } else {
+        outChunks.resize(1);
+        stageChunk(outChunks[0], indices, indexCount, vertices, vertexCount);
+    }
+}
+
+void Model::processMaterial(const aiMesh* mesh, const aiScene* scene, std::vector<StagedTextureRef>& outTextures) {
     if (mesh->mMaterialIndex >= 0) {
         aiMaterial* material = scene->mMaterials[mesh->mMaterialIndex];
+        outTextures.reserve(outTextures.size() + material->GetTextureCount(aiTextureType_DIFFUSE) +
+                            material->GetTextureCount(aiTextureType_SPECULAR) + material->GetTextureCount(aiTextureType_HEIGHT) +
+                            material->GetTextureCount(aiTextureType_AMBIENT));
             aiString matName;
             scene->mMaterials[mesh->mMaterialIndex]->Get(AI_MATKEY_NAME, matName);
             std::string name;
@@ -171,24 +1314,15 @@ Mesh Model::processMesh(aiMesh* mesh, const aiScene* scene) {
             LOGI("material %s aiTextureType_HEIGHT  : %d", name.c_str(), material->GetTextureCount(aiTextureType_HEIGHT));
 
         
-        auto diffuseMaps = loadMaterialTextures(material, aiTextureType_DIFFUSE, "texture_diffuse", scene);
-        textures.insert(textures.end(), diffuseMaps.begin(), diffuseMaps.end());
-        
-        auto specularMaps = loadMaterialTextures(material, aiTextureType_SPECULAR, "texture_specular", scene);
-        textures.insert(textures.end(), specularMaps.begin(), specularMaps.end());
-        
-        auto normalMaps = loadMaterialTextures(material, aiTextureType_HEIGHT, "texture_normal", scene);
-        textures.insert(textures.end(), normalMaps.begin(), normalMaps.end());
-        
-        auto ambientMaps = loadMaterialTextures(material, aiTextureType_AMBIENT, "texture_ambient", scene);
-        textures.insert(textures.end(), ambientMaps.begin(), ambientMaps.end());
+        loadMaterialTextures(material, aiTextureType_DIFFUSE, "texture_diffuse", scene, outTextures);
+        loadMaterialTextures(material, aiTextureType_SPECULAR, "texture_specular", scene, outTextures);
+        loadMaterialTextures(material, aiTextureType_HEIGHT, "texture_normal", scene, outTextures);
+        loadMaterialTextures(material, aiTextureType_AMBIENT, "texture_ambient", scene, outTextures);
     }
-
-    return Mesh(vertices, indices, textures);
 }
 
-std::vector<Texture> Model::loadMaterialTextures(aiMaterial* mat, aiTextureType type, const std::string& typeName, const aiScene* scene) {
-    std::vector<Texture> textures;
+void Model::loadMaterialTextures(aiMaterial* mat, aiTextureType type, const std::string& typeName, const aiScene* scene,
+                                 std::vector<StagedTextureRef>& outTextures) {
     for (unsigned int i = 0; i < mat->GetTextureCount(type); ++i) {
         aiString str;
         mat->GetTexture(type, i, &str);
@@ -196,89 +1330,230 @@ std::vector<Texture> Model::loadMaterialTextures(aiMaterial* mat, aiTextureType
 
         std::replace(path.begin(), path.end(), '\\', '/');
 
-        if (m_textures_loaded.count(path)) {
-            textures.push_back(m_textures_loaded[path]);
-            continue;
-        }
-
-        Texture texture;
         // LOGI( "Man what can i say! -> %s",path.c_str() );
         const aiTexture* embeddedTexture = scene->GetEmbeddedTexture( str.C_Str() );
 
         if (  embeddedTexture != nullptr ) {
-            LOGI( "Founded embedded texture : %s", path.c_str() );
-            texture.id = textureFromMemory( embeddedTexture );
+            // Assimp 通常将嵌入式纹理存储为压缩格式（如.png），mWidth是压缩后的大小
+            outTextures.push_back({ typeName, stageTextureFromMemory(path, typeName,
+                reinterpret_cast<const unsigned char*>(embeddedTexture->pcData), embeddedTexture->mWidth, false) });
         } else { // 处理外部纹理文件
-            LOGI( "Founded texture : %s", path.c_str() );
-            texture.id = textureFromFile(m_directory + "/" + path);
-        }
-        texture.type = typeName;
-        texture.path = path;
-        textures.push_back(texture);
-        m_textures_loaded[path] = texture;
-    }
-    return textures;
-}
-
-GLuint Model::textureFromFile(const std::string& path) {
-    GLuint textureID = SOIL_load_OGL_texture(
-        path.c_str(), 
-        SOIL_LOAD_AUTO, 
-        SOIL_CREATE_NEW_ID, 
-        SOIL_FLAG_MIPMAPS | 
-        SOIL_FLAG_INVERT_Y | 
-        SOIL_FLAG_NTSC_SAFE_RGB | 
-        SOIL_FLAG_COMPRESS_TO_DXT |
-        SOIL_FLAG_DDS_LOAD_DIRECT);
-
-    if (textureID == 0) {
-        LOGE("SOIL2 failed to load texture from file: %s\nError: %s", path.c_str(), SOIL_last_result());
-        return 0;
-    }
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glBindTexture(GL_TEXTURE_2D, 0);
-    return textureID;
-}
-
-GLuint Model::textureFromMemory(const aiTexture* texture) {
-    GLuint textureID;
-    glGenTextures(1, &textureID);
-    int w, h, ch;
-    // Assimp 通常将嵌入式纹理存储为压缩格式（如.png），mWidth是压缩后的大小，需要SOIL2从内存解压
-    // LOGI( "Man what can i say! -> %s", reinterpret_cast<unsigned char*>(texture->pcData) );
-    unsigned char* data = SOIL_load_image_from_memory(
-        reinterpret_cast<unsigned char*>(texture->pcData),
-        texture->mWidth, &w, &h, &ch, SOIL_LOAD_AUTO );        // SOIL_LOAD_AUTO -> SOIL_LOAD_RGBA none of use
-
-    if (!data) {
-        LOGE("SOIL2 failed to load texture from memory. Error: %s", SOIL_last_result());
-        return 0;
-    }
-
-    GLenum format = (ch == 4) ? GL_RGBA : GL_RGB;
-    glBindTexture(GL_TEXTURE_2D, textureID);
-    glTexImage2D(GL_TEXTURE_2D, 0, format, w, h, 0, format, GL_UNSIGNED_BYTE, data);
-    glGenerateMipmap(GL_TEXTURE_2D);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    SOIL_free_image_data(data);
-    glBindTexture(GL_TEXTURE_2D, 0);
-    return textureID;
+            outTextures.push_back({ typeName, stageTextureFromFile(path, typeName) });
+        }
+    }
+}
+
+// ---- 导入内存对比 (IMPORT_ARENA_BENCHMARK_ON_STARTUP) ----
+
+/*
+    每轮依次以堆 / 导入 arena 构造同一模型, 构造结束 (暂存完成、源数据已按驻留策略释放) 时记录:
+    - 堆分配次数: 构造期间全局 operator new 的调用次数 (需要 MEMORY_STATS_COUNT_HEAP_ALLOCATIONS)
+    - 峰值 RSS 增量: 构造前归还空闲堆并重置 VmHWM, 构造后的峰值减去构造前的 RSS
+    malloc 的阈值等状态仍受前一次运行影响, 因此跑两轮并交换顺序, 以两轮结果一起判断
+*/
+void Model::benchmarkImportArena(const std::string& path, const ModelLoadOptions& options) {
+    struct Result {
+        double ms = 0.0;
+        size_t heapAllocations = 0;
+        size_t peakDelta = 0;
+        MonotonicArena::Stats arena;
+    };
+    auto run = [&](bool useArena) {
+        ModelLoadOptions runOptions = options;
+        runOptions.importArena   = useArena;
+        runOptions.useMeshCache  = false;   // 每次都走完整导入, 也不改写已有缓存
+        runOptions.stageTextures = false;
+        runOptions.assetCache    = false;
+
+        Result result;
+        MemoryStats::releaseFreeHeap();
+        const bool peakReset = MemoryStats::resetPeakResident();
+        const size_t residentBefore = MemoryStats::residentBytes();
+        const size_t allocationsBefore = MemoryStats::heapAllocations();
+        auto start = std::chrono::high_resolution_clock::now();
+        {
+            Model model(path, runOptions);
+            result.ms = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+            result.heapAllocations = MemoryStats::heapAllocations() - allocationsBefore;
+            result.arena = model.importArenaStats();
+        }
+        const size_t peak = MemoryStats::peakResidentBytes();
+        result.peakDelta = peakReset && peak > residentBefore ? peak - residentBefore : 0;
+        return result;
+    };
+
+    for (int round = 0; round < 2; ++round) {
+        const bool arenaFirst = round == 1;
+        Result heap, arena;
+        if (arenaFirst) {
+            arena = run(true);
+            heap  = run(false);
+        } else {
+            heap  = run(false);
+            arena = run(true);
+        }
+        LOGI("Import arena bench %s round %d (%s first): heap %.1f ms, %d heap allocations, peak RSS +%d KB | "
+             "arena %.1f ms, %d heap allocations (%d arena allocations in %d blocks, %d KB), peak RSS +%d KB",
+             path.c_str(), round + 1, arenaFirst ? "arena" : "heap",
+             heap.ms, static_cast<int>(heap.heapAllocations), static_cast<int>(heap.peakDelta / 1024),
+             arena.ms, static_cast<int>(arena.heapAllocations), static_cast<int>(arena.arena.allocations),
+             static_cast<int>(arena.arena.blocks), static_cast<int>(arena.arena.reservedBytes / 1024),
+             static_cast<int>(arena.peakDelta / 1024));
+    }
+#if !MEMORY_STATS_COUNT_HEAP_ALLOCATIONS
+    LOGI("Import arena bench: heap allocation counts need MEMORY_STATS_COUNT_HEAP_ALLOCATIONS = 1");
+#endif
+}
+
+// ---- 渲染器重建对比 (ASSET_CACHE_BENCHMARK_ON_STARTUP) ----
+
+/*
+    冷: 清空 AssetCache 后构造, 与进程首次启动相同 (网格缓存照常使用), 纹理重新解码
+    热: 紧接着再构造一次, 网格快照与解码后的图像都来自 AssetCache, 相当于表面重建后的新渲染器
+    两次都计时到暂存完成且全部纹理离开解码状态; 不调用 GL, 释放的纹理之后由 GL 线程上传并回收
+    两次都开启 assetCache, 与驻留策略无关
+*/
+void Model::benchmarkWarmRestart(const std::string& path, const ModelLoadOptions& baseOptions) {
+    ModelLoadOptions options = baseOptions;
+    options.assetCache = true;
+    struct Result {
+        double stagingMs = 0.0;
+        double totalMs = 0.0;
+    };
+    auto run = [&]() {
+        Result result;
+        auto start = std::chrono::high_resolution_clock::now();
+        Model model(path, options);
+        result.stagingMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+        const auto deadline = start + std::chrono::seconds(30);
+        while (!model.texturesDecoded() && std::chrono::high_resolution_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        result.totalMs = std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+        return result;
+    };
+
+    AssetCache::getInstance().clear();
+    const Result cold = run();
+    const Result warm = run();
+    const AssetCache::Stats stats = AssetCache::getInstance().stats();
+    LOGI("Warm restart bench %s: cold %.1f ms (staging %.1f ms) | warm %.1f ms (staging %.1f ms), "
+         "asset cache %d entries / %d KB",
+         path.c_str(), cold.totalMs, cold.stagingMs, warm.totalMs, warm.stagingMs,
+         static_cast<int>(stats.entries), static_cast<int>(stats.bytes / 1024));
+}
+
+// 模型纹理统一的采样参数: 重复平铺 + 三线性过滤; 颜色贴图的 mip 在线性空间平均, 法线/高光等数据贴图直接平均
+static TextureLoader::Options modelTextureOptions(bool flipVertically, const std::string& type, bool cacheDecoded) {
+    TextureLoader::Options options;
+    options.flipVertically = flipVertically;
+    options.cacheDecoded = cacheDecoded;
+    options.srgb = (type == "texture_diffuse" || type == "texture_ambient");
+    options.generateMipmap = true;
+    options.wrapS     = GL_REPEAT;
+    options.wrapT     = GL_REPEAT;
+    options.minFilter = GL_LINEAR_MIPMAP_LINEAR;
+    options.magFilter = GL_LINEAR;
+    return options;
+}
+
+// 外部纹理文件: 材质解析与网格缓存两条路径共用, 同一路径只提交一次解码
+size_t Model::stageTextureFromFile(const std::string& path, const std::string& type, bool flipVertically) {
+    auto it = m_stagedTextureIndex.find(path);
+    if (it != m_stagedTextureIndex.end()) {
+        return it->second;
+    }
+
+    LOGI( "Founded texture : %s", path.c_str() );
+    StagedTexture texture;
+    texture.path = path;
+    texture.type = type;
+    texture.flipVertically = flipVertically;
+    if (m_options.stageTextures) texture.texture = TextureCache::getInstance().acquire(m_directory + "/" + path, modelTextureOptions(flipVertically, type, publishesToAssetCache()));   // true 等价于 SOIL_FLAG_INVERT_Y
+
+    m_stagedTextures.push_back(std::move(texture));
+    m_stagedTextureIndex[path] = m_stagedTextures.size() - 1;
+    return m_stagedTextures.size() - 1;
+}
+
+// 嵌入式纹理 (Assimp aiTexture / glTF bufferView 或 data URI): 压缩字节被拷贝, 数据源可以先于解码完成释放
+size_t Model::stageTextureFromMemory(const std::string& path, const std::string& type,
+                                     const unsigned char* data, size_t size, bool flipVertically) {
+    auto it = m_stagedTextureIndex.find(path);
+    if (it != m_stagedTextureIndex.end()) {
+        return it->second;
+    }
+
+    LOGI( "Founded embedded texture : %s", path.c_str() );
+    StagedTexture texture;
+    texture.path = path;
+    texture.type = type;
+    texture.flipVertically = flipVertically;
+    texture.embedded = true;
+    if (m_options.stageTextures) texture.texture = TextureCache::getInstance().acquireFromMemory(path, data, size, modelTextureOptions(flipVertically, type, publishesToAssetCache()));
+
+    m_stagedTextures.push_back(std::move(texture));
+    m_stagedTextureIndex[path] = m_stagedTextures.size() - 1;
+    return m_stagedTextures.size() - 1;
 }
 
 void Model::setupInstances( const std::vector<InstanceData>& instanceData ) {
     m_instanceData = instanceData;
-    m_hasInstanceData = true;
+    m_hasInstanceData = !m_instanceData.empty() && !m_segments.empty();
+    if ( !m_hasInstanceData ) return;
+
+    // 所有 Mesh 共用同一份实例数据, 实例缓冲区挂在每一段的 VAO 上
+    if ( !m_instanceBuffers ) {
+        m_instanceBuffers = std::make_unique<InstanceBufferManager>( sizeof( InstanceData ) );
+    }
+    m_instanceBuffers->reset( m_instanceData.data(), m_instanceData.size() );
+    m_useVisibleSubset = false;
+    m_visibleIndices.clear();
+    m_boundInstanceBuffer = 0;
+    bindInstanceAttributes( m_instanceBuffers->buffer() );
+}
+
+void Model::bindInstanceAttributes( GLuint buffer ) {
+    if ( buffer == m_boundInstanceBuffer ) return;
+    m_boundInstanceBuffer = buffer;
+    glBindBuffer( GL_ARRAY_BUFFER, buffer );
+    for ( const GeometrySegment& segment : m_segments ) {
+        glBindVertexArray( segment.vao );
+
+        //! 顶点属性最大允许的数据大小等于一个vec4 
+        glEnableVertexAttribArray( 5 );
+        glVertexAttribPointer( 5, 4, GL_FLOAT, GL_FALSE, sizeof( InstanceData ), ( void* )offsetof( InstanceData, modelMatrix ) );
+        glEnableVertexAttribArray( 6 );
+        glVertexAttribPointer( 6, 4, GL_FLOAT, GL_FALSE, sizeof( InstanceData ), ( void* )(offsetof( InstanceData, modelMatrix ) + sizeof( glm::vec4 )) );
+        glEnableVertexAttribArray( 7 );
+        glVertexAttribPointer( 7, 4, GL_FLOAT, GL_FALSE, sizeof( InstanceData ), ( void* )(offsetof( InstanceData, modelMatrix ) + 2*sizeof( glm::vec4 )) );
+        glEnableVertexAttribArray( 8 );
+        glVertexAttribPointer( 8, 4, GL_FLOAT, GL_FALSE, sizeof( InstanceData ), ( void* )(offsetof( InstanceData, modelMatrix ) + 3*sizeof( glm::vec4 )) );
+        glEnableVertexAttribArray( 9 );
+        // 使用 glVertexAttribIPointer 传递整数ID，并将大小设置为1
+        glVertexAttribIPointer( 9, 1, GL_UNSIGNED_INT, sizeof( InstanceData ), ( void* )(offsetof( InstanceData, instanceId )) );
+        glEnableVertexAttribArray( 10 );
+        glVertexAttribPointer( 10, 4, GL_FLOAT, GL_FALSE, sizeof( InstanceData ), ( void* )(offsetof( InstanceData, color )) );
+        glEnableVertexAttribArray( 11 );
+        glVertexAttribPointer( 11, 4, GL_FLOAT, GL_FALSE, sizeof( InstanceData ), ( void* )(offsetof( InstanceData, offset )) );
 
-    for ( auto& mesh : m_meshes ) {
-        mesh.setupInstance( m_instanceData );
+        glVertexAttribDivisor( 5, 1 );
+        glVertexAttribDivisor( 6, 1 );
+        glVertexAttribDivisor( 7, 1 );
+        glVertexAttribDivisor( 8, 1 );
+        glVertexAttribDivisor( 9, 1 );      // 每一个实例更新一次ID     // 在渲染循环之前的初始化中赋值
+        glVertexAttribDivisor( 10, 1 );     // 每个实例更新一次颜色
+        glVertexAttribDivisor( 11, 1 );     // 每个实例的拖拽偏移
     }
+
+    glBindVertexArray( 0 );
+    glBindBuffer( GL_ARRAY_BUFFER, 0 );
+}
+
+void Model::bindSegment( const Mesh& mesh, uint32_t& boundSegment ) const {
+    if ( mesh.segment() == boundSegment ) return;
+    boundSegment = mesh.segment();
+    glBindVertexArray( m_segments[boundSegment].vao );
 }
 
 void Model::DrawInstanced( GLuint program, GLuint instanceCount ) const {
@@ -293,6 +1568,9 @@ void Model::DrawInstanced( GLuint program, GLuint instanceCount ) const {
     unsigned int normalNr = 1;
     unsigned int ambientNr = 1;
 
+    const GLint posScaleLocation  = glGetUniformLocation(program, "uPosScale");
+    const GLint posOffsetLocation = glGetUniformLocation(program, "uPosOffset");
+    uint32_t boundSegment = UINT32_MAX;
     for (const Mesh& mesh : m_meshes) {
         for (unsigned int i = 0; i < mesh.textures.size(); ++i) {
             unsigned int currentTextureUnit = textureQuantities + i;  // 修复3: 计算当前纹理单元
@@ -322,8 +1600,11 @@ void Model::DrawInstanced( GLuint program, GLuint instanceCount ) const {
         }
         textureQuantities += mesh.textures.size();  // 累积纹理数量
         
-        const_cast<Mesh&>(mesh).DrawInstanced(instanceCount);
+        bindSegment(mesh, boundSegment);
+        mesh.applyDequantization(posScaleLocation, posOffsetLocation);
+        mesh.DrawInstanced(instanceCount);
     }
+    glBindVertexArray(0);
     
     // 修复5: 清理所有使用过的纹理单元
     for (unsigned int i = 0; i < textureQuantities; ++i) {
@@ -340,13 +1621,17 @@ void Model::DrawInstancedWind( GLuint program, GLuint instanceCount ) const {
     }
 
     // 首先绑定所有diffuse纹理到正确的纹理单元
+    // 超出 16 位索引范围而拆分出的相邻块共享同一材质, 跳过重复纹理, 保证三层纹理仍对应前三个源 Mesh
     int textureUnit = 0;
-    for (size_t meshIndex = 0; meshIndex < m_meshes.size() && meshIndex < 3; ++meshIndex) {
+    GLuint lastDiffuse = 0;
+    for (size_t meshIndex = 0; meshIndex < m_meshes.size() && textureUnit < 3; ++meshIndex) {
         const Mesh& mesh = m_meshes[meshIndex];
         
         // 查找该mesh的diffuse纹理
         for (unsigned int i = 0; i < mesh.textures.size(); ++i) {
             if (mesh.textures[i].type == "texture_diffuse") {
+                if (textureUnit > 0 && mesh.textures[i].id == lastDiffuse) break;
+                lastDiffuse = mesh.textures[i].id;
                 glActiveTexture(GL_TEXTURE0 + textureUnit);
                 glBindTexture(GL_TEXTURE_2D, mesh.textures[i].id);
                 
@@ -359,11 +1644,17 @@ void Model::DrawInstancedWind( GLuint program, GLuint instanceCount ) const {
         }
     }
 
-    // 然后绘制所有mesh
+    // 然后绘制所有mesh: 每段的 VAO 只绑定一次
+    const GLint posScaleLocation  = glGetUniformLocation(program, "uPosScale");
+    const GLint posOffsetLocation = glGetUniformLocation(program, "uPosOffset");
+    uint32_t boundSegment = UINT32_MAX;
     for (size_t meshIndex = 0; meshIndex < m_meshes.size(); ++meshIndex) {
         const Mesh& mesh = m_meshes[meshIndex];
-        const_cast<Mesh&>(mesh).DrawInstanced(instanceCount);
+        bindSegment(mesh, boundSegment);
+        mesh.applyDequantization(posScaleLocation, posOffsetLocation);
+        mesh.DrawInstanced(instanceCount);
     }
+    glBindVertexArray(0);
     
     // 清理纹理绑定
     for (int i = 0; i < textureUnit; ++i) {
@@ -373,115 +1664,135 @@ void Model::DrawInstancedWind( GLuint program, GLuint instanceCount ) const {
     glActiveTexture(GL_TEXTURE0);
 }
 
-void Model::updateInstanceData( int instanceID, const std::vector<InstanceData>& instanceData ) {
-    if ( !m_hasInstanceData ) return;
-    for( auto& mesh : m_meshes ) {
-        mesh.updateInstance( instanceID, instanceData );
+void Model::updateInstances( size_t first, const InstanceData* instanceData, size_t count ) {
+    if ( !m_hasInstanceData || first >= m_instanceData.size() ) return;
+    count = std::min( count, m_instanceData.size() - first );
+    std::copy( instanceData, instanceData + count, m_instanceData.begin() + first );
+    m_instanceBuffers->markDirty( first, count );
+    recordVisibleEdit( first, count );
+}
+
+void Model::updateInstanceOffset( size_t index, const glm::vec4& offset ) {
+    if ( !m_hasInstanceData || index >= m_instanceData.size() ) return;
+    m_instanceData[index].offset = offset;
+    m_instanceBuffers->markDirty( index );
+    recordVisibleEdit( index, 1 );
+}
+
+void Model::recordVisibleEdit( size_t first, size_t count ) {
+    if ( !m_useVisibleSubset || m_visibleStale ) return;
+    m_visibleEditCount += count;
+    if ( m_visibleEditCount > m_visibleIndices.size() ) {
+        // 修改的实例比可见实例还多: 下次直接重新复制全部可见实例
+        m_visibleStale = true;
+        m_visibleEdits.clear();
+        return;
     }
+    m_visibleEdits.emplace_back( first, count );
 }
 
-//! ------------------------ Mesh Class Implementation ------------------------
+bool Model::flushInstanceUpdates() {
+    if ( !m_hasInstanceData || !m_instanceBuffers->hasPendingUpdates() ) return false;
+    if ( m_instanceBuffers->flush( m_instanceData.data() ) && !m_useVisibleSubset ) {
+        bindInstanceAttributes( m_instanceBuffers->buffer() );
+    }
+    return true;
+}
 
-Mesh::Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std::vector<Texture> textures)
-    : vertices(std::move(vertices)), indices(std::move(indices)), textures(std::move(textures)) {
-    setupMesh();
-}
-
-void Mesh::setupMesh() {
-    glGenVertexArrays(1, &VAO);
-    glGenBuffers(1, &VBO);
-    glGenBuffers(1, &EBO);
-
-    glBindVertexArray(VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0], GL_STATIC_DRAW);
-
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
-
-    // 设置顶点属性指针
-    // 位置
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Position));
-    // 法线
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Normal));
-    // 纹理坐标
-    glEnableVertexAttribArray(2);
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, TexCoords));
-    // 切线
-    glEnableVertexAttribArray(3);
-    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Tangent));
-    // 副切线
-    glEnableVertexAttribArray(4);
-    glVertexAttribPointer(4, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Bitangent));
+void Model::setVisibleInstances( const std::vector<uint32_t>& visible ) {
+    if ( !m_hasInstanceData ) return;
+    if ( visible.size() >= m_instanceData.size() ) {
+        // 全部可见: 直接使用实例缓冲, 不需要复制
+        m_useVisibleSubset = false;
+        m_visibleIndices.clear();
+        m_visibleEdits.clear();
+        bindInstanceAttributes( m_instanceBuffers->buffer() );
+        return;
+    }
+    if ( m_useVisibleSubset && visible == m_visibleIndices ) {
+        // 可见列表不变: 只把修改过的实例写入它们在紧凑缓冲中的位置, 不重新分配
+        if ( m_visibleStale ) {
+            for ( size_t i = 0; i < m_visibleIndices.size(); ++i ) {
+                m_visibleData[i] = m_instanceData[m_visibleIndices[i]];
+            }
+            m_visibleBuffer->markDirty( 0, m_visibleData.size() );
+        } else {
+            for ( const auto& edit : m_visibleEdits ) {
+                for ( size_t index = edit.first; index < edit.first + edit.second; ++index ) {
+                    const uint32_t slot = m_visibleSlot[index];
+                    if ( slot == kNotVisible ) continue;
+                    m_visibleData[slot] = m_instanceData[index];
+                    m_visibleBuffer->markDirty( slot );
+                }
+            }
+        }
+        m_visibleEdits.clear();
+        m_visibleEditCount = 0;
+        m_visibleStale = false;
+        if ( m_visibleBuffer->flush( m_visibleData.data() ) ) {
+            bindInstanceAttributes( m_visibleBuffer->buffer() );
+        }
+        return;
+    }
 
-    glBindVertexArray(0);
+    m_visibleIndices = visible;
+    m_visibleData.resize( visible.size() );
+    m_visibleSlot.assign( m_instanceData.size(), kNotVisible );
+    for ( size_t i = 0; i < visible.size(); ++i ) {
+        m_visibleData[i] = m_instanceData[visible[i]];
+        m_visibleSlot[visible[i]] = static_cast<uint32_t>( i );
+    }
+    if ( !m_visibleBuffer ) {
+        m_visibleBuffer = std::make_unique<InstanceBufferManager>( sizeof( InstanceData ), 1, InstanceBufferManager::UploadMode::SubData );
+    }
+    // glBufferData 重新分配存储, 上一帧仍在读取的旧存储由驱动保留, 不会阻塞
+    m_visibleBuffer->reset( m_visibleData.data(), m_visibleData.size() );
+    m_useVisibleSubset = true;
+    m_visibleStale = false;
+    m_visibleEdits.clear();
+    m_visibleEditCount = 0;
+    bindInstanceAttributes( m_visibleBuffer->buffer() );
 }
 
-void Mesh::setupInstance( const std::vector<InstanceData>& instanceData ) {
-    if ( instanceData.empty() ) return;
-    hasInstanceData = true;
-
-    glBindVertexArray( VAO );
-    glGenBuffers( 1, &instanceVBO );
-    glBindBuffer( GL_ARRAY_BUFFER, instanceVBO );
-    glBufferData( GL_ARRAY_BUFFER, instanceData.size() * sizeof( InstanceData ), &instanceData[0], GL_STATIC_DRAW );
-
-    //! 顶点属性最大允许的数据大小等于一个vec4 
-    glEnableVertexAttribArray( 5 );
-    glVertexAttribPointer( 5, 4, GL_FLOAT, GL_FALSE, sizeof( InstanceData ), ( void* )offsetof( InstanceData, modelMatrix ) );
-    glEnableVertexAttribArray( 6 );
-    glVertexAttribPointer( 6, 4, GL_FLOAT, GL_FALSE, sizeof( InstanceData ), ( void* )(offsetof( InstanceData, modelMatrix ) + sizeof( glm::vec4 )) );
-    glEnableVertexAttribArray( 7 );
-    glVertexAttribPointer( 7, 4, GL_FLOAT, GL_FALSE, sizeof( InstanceData ), ( void* )(offsetof( InstanceData, modelMatrix ) + 2*sizeof( glm::vec4 )) );
-    glEnableVertexAttribArray( 8 );
-    glVertexAttribPointer( 8, 4, GL_FLOAT, GL_FALSE, sizeof( InstanceData ), ( void* )(offsetof( InstanceData, modelMatrix ) + 3*sizeof( glm::vec4 )) );
-    glEnableVertexAttribArray( 9 );
-    // 使用 glVertexAttribIPointer 传递整数ID，并将大小设置为1
-    glVertexAttribIPointer( 9, 1, GL_UNSIGNED_INT, sizeof( InstanceData ), ( void* )(offsetof( InstanceData, instanceId )) );
-    glEnableVertexAttribArray( 10 );
-    glVertexAttribPointer( 10, 4, GL_FLOAT, GL_FALSE, sizeof( InstanceData ), ( void* )(offsetof( InstanceData, color )) );
-
-
-    glVertexAttribDivisor( 5, 1 );
-    glVertexAttribDivisor( 6, 1 );
-    glVertexAttribDivisor( 7, 1 );
-    glVertexAttribDivisor( 8, 1 );
-    glVertexAttribDivisor( 9, 1 );      // 每一个实例更新一次ID     // 在渲染循环之前的初始化中赋值
-    glVertexAttribDivisor( 10, 1 );     // 每个实例更新一次颜色
+//! ------------------------ Mesh Class Implementation ------------------------
 
-    glBindVertexArray( 0 );
+Mesh::Mesh(VertexFormat format, uint32_t segment, GLint baseVertex, size_t indexOffset, size_t indexCount,
+           uint32_t indexSize, std::vector<Texture> textures)
+    : textures(std::move(textures)),
+      m_segment(segment),
+      m_baseVertex(baseVertex),
+      m_indexOffset(indexOffset),
+      m_indexCount(static_cast<GLsizei>(indexCount)),
+      m_indexType(VertexLayout::indexGLType(indexSize)),
+      m_format(format) {
 }
 
+void Mesh::setBounds(const glm::vec3& min, const glm::vec3& max) {
+    VertexLayout::dequantization(m_format, min, max, m_positionScale, m_positionOffset);
+}
 
-/*
-    Update the data of 1 instances
-*/
-void Mesh::updateInstance( int instanceID, const std::vector<InstanceData>& data ) {
-    if ( !hasInstanceData || data.empty() ) return;
-    glBindBuffer( GL_ARRAY_BUFFER, instanceVBO );       // instance VBO pointer in this class 
-    glBufferSubData( 
-        GL_ARRAY_BUFFER, 
-        sizeof(InstanceData) * instanceID,      /* offset ID from 1 -> instanceID */
-        sizeof(InstanceData),                   /* updata only 1 instance */
-        &data[0] );
-    glBindBuffer( GL_ARRAY_BUFFER, 0 );
+void Mesh::applyDequantization(GLint scaleLocation, GLint offsetLocation) const {
+    if (scaleLocation >= 0) {
+        glUniform3f(scaleLocation, m_positionScale.x, m_positionScale.y, m_positionScale.z);
+    }
+    if (offsetLocation >= 0) {
+        glUniform3f(offsetLocation, m_positionOffset.x, m_positionOffset.y, m_positionOffset.z);
+    }
 }
 
-// 修改 Mesh::Draw，移除所有纹理逻辑，只保留绘制命令
+// 只保留绘制命令: 纹理与 VAO 由 Model 负责绑定
 void Mesh::Draw() const {
-    glBindVertexArray(VAO);
-    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT, 0);
-    glBindVertexArray(0);
+#if WIND_HAS_BASE_VERTEX
+    glDrawElementsBaseVertex(GL_TRIANGLES, m_indexCount, m_indexType, (void*)m_indexOffset, m_baseVertex);
+#else
+    glDrawElements(GL_TRIANGLES, m_indexCount, m_indexType, (void*)m_indexOffset);
+#endif
 }
 
-void Mesh::DrawInstanced( GLuint instanceCount ) {
-    if ( !hasInstanceData ) {
-        Draw();
-        return;
-    }
-    glBindVertexArray( VAO );
-    glDrawElementsInstanced( GL_TRIANGLES, static_cast<GLsizei>( indices.size() ), GL_UNSIGNED_INT, 0 , instanceCount );
-    glBindVertexArray(0);
+void Mesh::DrawInstanced( GLuint instanceCount ) const {
+#if WIND_HAS_BASE_VERTEX
+    glDrawElementsInstancedBaseVertex( GL_TRIANGLES, m_indexCount, m_indexType, (void*)m_indexOffset, instanceCount, m_baseVertex );
+#else
+    glDrawElementsInstanced( GL_TRIANGLES, m_indexCount, m_indexType, (void*)m_indexOffset, instanceCount );
+#endif
 }
@@ -3,10 +3,19 @@
 #define __MULTITHREAD_LOAD__
 #define __COMPLEX_MODEL__
 
+// 置 1 后在加载线程开始时运行一次 Model::benchmarkImportArena 并输出日志
+// (同时把 MemoryStats.hpp 中的 MEMORY_STATS_COUNT_HEAP_ALLOCATIONS 置 1 才能得到堆分配次数)
+#define IMPORT_ARENA_BENCHMARK_ON_STARTUP 0
+
+// 置 1 后在加载线程开始时运行一次 Model::benchmarkWarmRestart (渲染器重建时 AssetCache 冷/热两种情况的 CPU 耗时)
+#define ASSET_CACHE_BENCHMARK_ON_STARTUP 0
+
 #include <string>
 #include <vector>
 #include <unordered_map>
 #include <filesystem>
+#include <memory>
+#include <functional>
 
 
 #ifdef __ANDROID__
@@ -27,15 +36,15 @@
 #include "macros.h"
 #include "Component_LoadingView/OpenGL_LoadingView.hpp"
 #include "CommonTypes.hpp"
-
-// 通用顶点结构，适用于大多数现代渲染需求
-struct Vertex {
-    glm::vec3 Position;
-    glm::vec3 Normal;
-    glm::vec2 TexCoords;
-    glm::vec3 Tangent;
-    glm::vec3 Bitangent;
-};
+#include "MeshCache.hpp"
+#include "GltfAsset.hpp"
+#include "ObjAsset.hpp"
+#include "VertexLayout.hpp"
+#include "MeshOptimizer.hpp"
+#include "ArenaAllocator.hpp"
+#include "TextureCache.hpp"
+#include "AssetCache.hpp"
+#include "InstanceBufferManager.hpp"
 
 // 通用纹理结构
 struct Texture {
@@ -44,36 +53,151 @@ struct Texture {
     std::string path; // 存储从模型文件中读取的原始路径
 };
 
+// 纹理的暂存: 从 TextureCache 获取 (跨模型/全局纹理去重), 解码与上传由 TextureLoader 异步完成
+struct StagedTexture {
+    std::string path;                   // 材质中记录的相对路径 (嵌入式纹理为 "*n")
+    std::string type;                   // 首次引用时的类型, 决定采样选项
+    bool flipVertically = true;
+    bool embedded = false;              // 来自内存 (aiScene / glTF 缓冲区), 无法从路径重新获取
+    TextureCache::Ref texture;
+};
+
+struct StagedTextureRef {
+    std::string type;                   // "texture_diffuse" 等
+    size_t index = 0;                   // m_stagedTextures 下标
+};
+
+// 网格的 CPU 暂存: 顶点/索引来自 Assimp / glTF / OBJ 转换 (从 Model 的导入 arena 分配), 或网格缓存 / glTF 缓冲区映射 (只读指针)
+struct StagedMesh {
+    VertexFormat format = VertexFormat::Full;
+    uint32_t attributes = VertexAttrib::All;    // 已保存的属性 (VertexLayout::storedAttributes)
+    ArenaVector<uint8_t> vertices;          // 已按 format / attributes 编码的顶点
+    ArenaVector<uint8_t> indices;           // 按 indexSize 编码的索引
+    uint32_t indexSize = sizeof(uint32_t);  // 2: GL_UNSIGNED_SHORT, 4: GL_UNSIGNED_INT
+
+    const uint8_t* mappedVertices = nullptr;
+    size_t mappedVertexCount = 0;
+    const uint8_t* mappedIndices = nullptr;
+    size_t mappedIndexCount = 0;
+
+    glm::vec3 boundsMin{0.0f};
+    glm::vec3 boundsMax{0.0f};
+    std::vector<StagedTextureRef> textures;
+
+    // 导入时顶点缓存优化前后的统计 (Assimp / glTF 转换路径)
+    MeshOptimizer::CacheStats cacheBefore;
+    MeshOptimizer::CacheStats cacheAfter;
+
+    const uint8_t* vertexData() const { return mappedVertices ? mappedVertices : vertices.data(); }
+    size_t vertexCount() const { return mappedVertices ? mappedVertexCount : vertices.size() / VertexLayout::stride(format, attributes); }
+    const uint8_t* indexData() const { return mappedIndices ? mappedIndices : indices.data(); }
+    size_t indexCount() const { return mappedIndices ? mappedIndexCount : indices.size() / indexSize; }
+};
+
+// 上传到 GPU 之后 Model 在 CPU 侧保留哪些数据
+enum class ResidencyPolicy : uint32_t {
+    KeepSource  = 0,    // 保留 Assimp 场景、暂存数据与缓存映射 (调试 / 需要重新上传时)
+    BoundsProxy = 1,    // 只保留每个 Mesh 的 AABB 作为拾取/剔除代理
+    Lean        = 2,    // 只保留模型整体 AABB
+};
+
+// 模型加载选项
+struct ModelLoadOptions {
+    bool useMeshCache = true;   // 启用 .meshcache 二进制缓存, 命中时跳过 Assimp 导入
+    bool nativeGltf = true;     // .gltf / .glb 使用原生读取器 (不经过 Assimp 与网格缓存), 不支持的文件回退到 Assimp
+    bool nativeObj = true;      // .obj 使用多线程快速解析器 (网格缓存未命中时), 不支持的文件回退到 Assimp
+    size_t workerThreads = 0;   // 网格转换使用的线程数 (含加载线程本身), 0 表示按 CPU 核心数
+    VertexFormat vertexFormat = VertexFormat::Compact;  // GPU 顶点格式, Compact 约为 Full 的 1/3.5 带宽
+    // 绑定到该模型的着色器读取的属性并集 (各 Program 的 kVertexAttributes): 只生成、只上传这些属性,
+    // 不含法线时跳过法线生成, 不含切线时跳过切线计算
+    uint32_t vertexAttributes = VertexAttrib::All;
+    bool optimizeVertexCache = true;    // 导入时重排三角形与顶点 (顶点缓存 + 拉取局部性)
+    bool optimizeOverdraw = false;      // 额外按簇排序三角形以减少过度绘制 (依赖 optimizeVertexCache)
+    bool smallIndices = true;           // 顶点数超过 16 位索引范围的 Mesh 拆分为多块, 保证全部使用 GL_UNSIGNED_SHORT
+    ResidencyPolicy residency = ResidencyPolicy::BoundsProxy;
+    bool stageTextures = true;  // false: 只记录材质中的纹理路径, 不提交解码 (离线烘焙网格缓存时使用, 这样的 Model 不能上传)
+    // 转换期的临时数组与暂存顶点/索引从导入 arena 分配, uploadToGPU 后整体释放; false 全部使用堆 (对比测试用)
+    bool importArena = true;
+    // 暂存结果的快照与解码后的纹理放入进程级 AssetCache, 渲染器重建后加载同一模型时直接取回, 跳过导入、转换与解码;
+    // 上传后 CPU 侧仍保留一份几何与像素, 因此默认只在 KeepSource 策略下放入, 其它策略需要显式开启
+    bool assetCache = false;
+};
+
+/**
+ * @brief 暂存完成的模型 CPU 数据的只读快照 (AssetCache 条目)
+ *
+ * 键与网格缓存键的组成相同 (源文件 + 大小/修改时间 + 导入/处理选项 + 顶点格式与属性)。
+ * 纹理只记录路径与采样选项, 取回时重新通过 TextureCache 获取 (解码结果同样来自 AssetCache)。
+ * 含嵌入式纹理的模型不生成快照。
+ */
+struct ModelSnapshot {
+    struct TextureEntry {
+        std::string path;
+        std::string type;
+        bool flipVertically = true;
+    };
+
+    std::vector<uint8_t> data;                  // 全部 Mesh 的顶点与索引 (各段 16 字节对齐)
+    std::vector<MeshCache::MeshView> meshes;    // 指向 data
+    std::vector<TextureEntry> textures;         // 与首次暂存的顺序一致
+    glm::vec3 boundsMin{0.0f};
+    glm::vec3 boundsMax{0.0f};
+
+    size_t byteSize() const { return data.size() + meshes.size() * sizeof(MeshCache::MeshView); }
+};
+
+// Mesh 的局部包围盒 (BoundsProxy 策略下上传后仍保留)
+struct MeshBounds {
+    glm::vec3 min{0.0f};
+    glm::vec3 max{0.0f};
+};
+
+/**
+ * @brief 单个 Mesh 在 Model 共享几何缓冲区中的一段
+ *
+ * 顶点/索引/实例缓冲区与 VAO 都由 Model 持有, Mesh 只记录所在的段、自己的偏移与材质,
+ * 绘制前由 Model 绑定所在段的 VAO (连续同段的 Mesh 只绑定一次)。
+ */
 class Mesh {
 public:
-    // 网格数据
-    std::vector<Vertex> vertices;
-    std::vector<unsigned int> indices;
     std::vector<Texture> textures;
-    GLuint VAO;
 
-    Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std::vector<Texture> textures);
-    void Draw() const;
+    /**
+     * @param segment     所在的几何段 (Model 的 VAO/VBO 之一)
+     * @param baseVertex  在段 VBO 中的首个顶点下标 (索引已预先偏移时为 0)
+     * @param indexOffset 在共享 EBO 中的字节偏移
+     */
+    Mesh(VertexFormat format, uint32_t segment, GLint baseVertex, size_t indexOffset, size_t indexCount,
+         uint32_t indexSize, std::vector<Texture> textures);
 
-    void setupInstance( const std::vector<InstanceData>& instanceData );
-    void DrawInstanced( GLuint instanceCount );
+    // 调用前必须已绑定所在段的 VAO
+    void Draw() const;
+    void DrawInstanced( GLuint instanceCount ) const;
 
-    void updateInstance( int instanceID, const std::vector<InstanceData>& instanceData ); 
+    // 由局部包围盒计算位置反量化参数 (包围盒本身不保存, 见 Model::meshBounds)
+    void setBounds(const glm::vec3& min, const glm::vec3& max);
+    // 把位置反量化参数写入当前程序的 uPosScale / uPosOffset
+    void applyDequantization(GLint scaleLocation, GLint offsetLocation) const;
+    VertexFormat vertexFormat() const { return m_format; }
+    GLenum indexType() const { return m_indexType; }
+    uint32_t segment() const { return m_segment; }
 
 private:
-    GLuint VBO, EBO;
-    void setupMesh();
-
-
-    // Instancing 实例化
-    GLuint instanceVBO;
-    bool hasInstanceData;
+    uint32_t m_segment = 0;
+    GLint m_baseVertex = 0;
+    size_t m_indexOffset = 0;
+    GLsizei m_indexCount = 0;
+    GLenum m_indexType = GL_UNSIGNED_INT;   // 每个 Mesh 独立选择 16/32 位索引
+    VertexFormat m_format = VertexFormat::Full;
+    glm::vec3 m_positionScale{1.0f};
+    glm::vec3 m_positionOffset{0.0f};
 };
 
 class Model {
 public:
-    // 构造函数，从指定路径加载任何 Assimp 支持的模型
-    Model(const std::string& path);
+    // 构造函数，从指定路径加载任何 Assimp 支持的模型 (.gltf / .glb / .obj 优先使用原生读取器)
+    // 只做 CPU 侧工作(导入/顶点转换/纹理解码), 可以在加载线程中调用; GL 资源由 uploadToGPU 创建
+    Model(const std::string& path, const ModelLoadOptions& options = ModelLoadOptions());
     void Draw(GLuint program) const;
 
     // 获取模型AABB包围盒的边界
@@ -82,42 +206,205 @@ public:
     // 缩放后的包围盒
     glm::vec3 scaled_boundsMin( float scale ) const { return m_boundsMin * scale; }
     glm::vec3 scaled_boundsMax( float scale ) const { return m_boundsMax * scale; }
+    // 每个 Mesh 的包围盒代理, 仅 ResidencyPolicy::BoundsProxy / KeepSource 下非空
+    const std::vector<MeshBounds>& meshBounds() const { return m_meshBounds; }
 
+    // Model 当前在 CPU 侧持有的数据量估算 (Assimp 场景 + 暂存 + 缓存映射 + 包围盒代理)
+    size_t cpuResidentBytes() const;
+
+    // Assimp 路径使用的后处理标志 (ObjAsset 与 Assimp 的一致性核对/吞吐测试使用同一组标志)
+    static unsigned int assimpImportFlags(uint32_t vertexAttributes = VertexAttrib::All);
+
+    // GPU 顶点缓冲区中实际保存的属性, 绑定的着色器读取的属性应是它的子集
+    uint32_t vertexAttributes() const { return VertexLayout::storedAttributes(m_options.vertexFormat, m_options.vertexAttributes); }
+
+    // 导入 arena 的统计; 未启用 importArena 时全为 0, uploadToGPU 释放 arena 后只保留累计的分配/块数
+    MonotonicArena::Stats importArenaStats() const;
+
+    /**
+     * @brief 导入内存对比: 同一模型分别以堆 / 导入 arena 构造 (不读写网格缓存, 不解码纹理),
+     *        输出堆分配次数、arena 块数、峰值 RSS 增量与耗时
+     */
+    static void benchmarkImportArena(const std::string& path, const ModelLoadOptions& options = ModelLoadOptions());
+
+    /**
+     * @brief 渲染器重建的 CPU 侧耗时对比: 清空 AssetCache 后构造模型 (冷) 与随后再构造一次 (热),
+     *        各自计时到模型暂存完成且全部纹理解码完成 (不上传 GL)
+     */
+    static void benchmarkWarmRestart(const std::string& path, const ModelLoadOptions& options = ModelLoadOptions());
+
+    // 网格缓存键 (启用网格缓存且源文件或其包内缓存存在时有效); wind_cook 用它核对烘焙出的缓存与运行时选项一致
+    bool meshCacheKey(MeshCache::Key& outKey) const { outKey = m_cacheKey; return m_hasCacheKey; }
+
+    // 核对着色器反射得到的属性 (ShaderProgram::activeAttributeMask) 是否都已上传; 缺失的属性读到常量默认值, 记录错误日志
+    bool checkProgramAttributes(const char* programName, uint32_t activeAttributeMask) const;
+
+    // 必须在 GL 线程调用: 把全部 Mesh 合并上传到共享的 VAO/VBO 段与 EBO 并上传纹理, 然后释放暂存
     void uploadToGPU();
 
+    // 实例数变化时调用: 重新分配实例缓冲区 (InstanceBufferManager 轮换的一组缓冲区) 并写入全部数据
     void setupInstances( const std::vector<InstanceData>& instanceData );
     void DrawInstanced( GLuint program, GLuint instanceCount ) const;
     void DrawInstancedWind( GLuint program, GLuint instanceCount ) const;
 
-    void updateInstanceData( int instanceID, const std::vector<InstanceData>& instanceData );
+    // 修改 [first, first + count) 个实例的 CPU 副本并标记为脏, 由 flushInstanceUpdates 统一上传
+    void updateInstances( size_t first, const InstanceData* instanceData, size_t count );
+    // 只修改第 index 个实例的拖拽偏移 (实例缓冲 location 11)
+    void updateInstanceOffset( size_t index, const glm::vec4& offset );
+    /**
+     * @brief 每帧绘制前调用一次: 合并本帧的脏区间写入下一个实例缓冲区, 切换后重新指向实例属性
+     * @return true 本帧有实例数据上传
+     */
+    bool flushInstanceUpdates();
+    // setupInstances 上传的实例数
+    GLuint instanceCount() const { return static_cast<GLuint>( m_instanceData.size() ); }
+
+    /**
+     * @brief 每帧剔除之后调用: 只绘制 visible 中的实例 (下标升序, 来自 InstanceCuller::cull)
+     *        部分可见时把可见实例紧凑复制到一个单独的缓冲区并让实例属性指向它; 全部可见时直接使用实例缓冲;
+     *        可见列表与实例数据都没有变化时不产生 GL 调用
+     */
+    void setVisibleInstances( const std::vector<uint32_t>& visible );
+    // 本帧实际绘制的实例数 (绘制与拾取 pass 都按它绘制)
+    GLuint drawInstanceCount() const {
+        return static_cast<GLuint>( m_useVisibleSubset ? m_visibleIndices.size() : m_instanceData.size() );
+    }
 
 private:
     std::vector<Mesh> m_meshes;
     std::string m_directory;
-    std::unordered_map<std::string, Texture> m_textures_loaded; // 缓存已加载的纹理，避免重复
 
+    // 共享几何缓冲区的一段: 有 base vertex 时只有一段, 绘制时每个 Model 只绑定一次 VAO;
+    // GLES 上索引在上传时预先偏移, 每段最多容纳 16 位索引能寻址的顶点数, 16 位索引的 Mesh 不会跨段
+    struct GeometrySegment {
+        GLuint vao = 0;
+        GLuint vbo = 0;
+    };
+    std::vector<GeometrySegment> m_segments;
+    GLuint m_EBO = 0;   // 全部段共用, 绑定记录在各段的 VAO 中
+    std::unique_ptr<InstanceBufferManager> m_instanceBuffers;
+    // 剔除后的可见实例: 单缓冲, 可见列表变化时整体重新分配写入, 不变时只写入修改过的实例
+    std::unique_ptr<InstanceBufferManager> m_visibleBuffer;
+    GLuint m_boundInstanceBuffer = 0;   // 实例属性当前指向的缓冲区
+
+    // CPU 暂存 (构造时填充, uploadToGPU 后释放)
+    std::vector<StagedMesh> m_stagedMeshes;
+    std::vector<StagedTexture> m_stagedTextures;
+    std::unordered_map<std::string, size_t> m_stagedTextureIndex; // 同一路径只提交一次解码
+
+    // 导入期分配 (暂存的编码顶点/索引) 的 arena, 多个转换线程共享; uploadToGPU 完成后与暂存一起一次性释放
+    std::unique_ptr<MonotonicArena> m_importArena;
+    MonotonicArena::Stats m_importArenaStats;   // 释放前的统计快照
+
+    // 模型持有的纹理引用, 模型销毁时释放, 无其它引用的纹理由 TextureCache 删除
+    std::vector<TextureCache::Ref> m_textureRefs;
+
+
+    const aiScene* scene = nullptr;
+    std::unique_ptr<Assimp::Importer> m_importer;  // 暂存完成后按驻留策略释放
 
-    const aiScene* scene;
-    Assimp::Importer importer;
+    // 原生 glTF 读取器; 有 Mesh 直接引用其缓冲区时保持映射, 直到 uploadToGPU 完成上传
+    std::unique_ptr<GltfAsset> m_gltf;
+    bool m_gltfReferenced = false;
+
+    // 原生 OBJ 解析结果, 暂存完成后立即释放
+    std::unique_ptr<ObjAsset> m_obj;
+
+    // 二进制网格缓存
+    ModelLoadOptions m_options;
+    MeshCache m_meshCache;          // 命中时保持映射, 直到 uploadToGPU 完成上传
+    MeshCache::Key m_cacheKey;
+    bool m_hasCacheKey = false;
+
+    // 进程级快照: 命中时暂存直接指向快照数据, 保持引用直到 uploadToGPU 完成上传
+    std::string m_snapshotKey;
+    std::shared_ptr<const ModelSnapshot> m_snapshot;
     std::unique_ptr<LoadingViewClass> mLoadingViewProgram;
 
 
     // 模型整体的AABB包围盒
     glm::vec3 m_boundsMin;
     glm::vec3 m_boundsMax;
+    std::vector<MeshBounds> m_meshBounds;
+
+    // 驻留统计: CPU 暂存完成时 (释放任何数据之前) 的快照
+    size_t m_stagedResidentBytes = 0;
+    size_t m_stagedProcessRSS = 0;
 
     void loadModel(const std::string& path);
-    void processNode(aiNode* node, const aiScene* scene);
-    Mesh processMesh(aiMesh* mesh, const aiScene* scene);
-    std::vector<Texture> loadMaterialTextures(aiMaterial* mat, aiTextureType type, const std::string& typeName, const aiScene* scene);
+    void buildStaging();
+    void processNode(aiNode* node, const aiScene* scene, std::vector<const aiMesh*>& outMeshes);
+    void processMeshesParallel();
+    static void processMesh(const aiMesh* mesh, const ModelLoadOptions& options, MonotonicArena* arena,
+                            std::vector<StagedMesh>& outChunks);
+    uint32_t processFlags(const std::string& path) const;
+    void processMaterial(const aiMesh* mesh, const aiScene* scene, std::vector<StagedTextureRef>& outTextures);
+    void loadMaterialTextures(aiMaterial* mat, aiTextureType type, const std::string& typeName, const aiScene* scene,
+                              std::vector<StagedTextureRef>& outTextures);
+
+    void releaseSource();
+    static size_t estimateSceneBytes(const aiScene* scene);
+
+    // 暂存直接指向 views 中的顶点/索引 (网格缓存映射或 AssetCache 快照)
+    void stageFromViews(const std::vector<MeshCache::MeshView>& views);
+    void writeMeshCache() const;
+
+    std::string snapshotKey(const std::string& path) const;
+    // 暂存快照与纹理解码结果是否放入 AssetCache: KeepSource 策略或 assetCache 选项开启时
+    bool publishesToAssetCache() const;
+    void stageFromSnapshot();
+    void publishSnapshot() const;
+    // 全部纹理都已结束解码 (等待上传 / 已上传 / 失败)
+    bool texturesDecoded() const;
 
-    // 纹理加载辅助函数
-    GLuint textureFromFile(const std::string& path);
-    GLuint textureFromMemory(const aiTexture* texture);
+    // 把各段 VAO 的实例属性 (location 5 ~ 11) 指向 buffer, 已指向它时直接返回
+    void bindInstanceAttributes( GLuint buffer );
+    // 绑定 mesh 所在段的 VAO, 与 boundSegment 相同时跳过
+    void bindSegment( const Mesh& mesh, uint32_t& boundSegment ) const;
+
+    // Assimp / glTF / OBJ 路径共用: 在线程池中并行执行 convert(0 .. count - 1), 记录耗时 (label 为日志中的网格类型)
+    void convertMeshesParallel(size_t count, const char* label, const std::function<void(size_t)>& convert);
+    // 按槽位顺序把转换出的块追加到 m_stagedMeshes, 归约模型包围盒, 槽位的纹理列表交给它的块; 返回第一个追加块的下标
+    size_t appendStagedChunks(std::vector<std::vector<StagedMesh>>& slots,
+                              std::vector<std::vector<StagedTextureRef>>& slotTextures);
+
+    // 原生 glTF 路径
+    void stageFromGltf();
+    static void processGltfPrimitive(const GltfAsset& asset, const GltfAsset::Primitive& primitive,
+                                     const ModelLoadOptions& options, MonotonicArena* arena, std::vector<StagedMesh>& outChunks);
+    void processGltfMaterial(int material, std::vector<StagedTextureRef>& outTextures);
+
+    // 原生 OBJ 路径
+    void stageFromObj();
+
+    // 导入格式无关的后半段: 顶点缓存优化 -> 16 位索引拆分 -> 包围盒 -> 按顶点格式编码
+    static void finalizeMesh(Vertex* vertices, size_t vertexCount, uint32_t* indices, size_t indexCount,
+                             const ModelLoadOptions& options, MonotonicArena* arena, MonotonicArena* scratch,
+                             std::vector<StagedMesh>& outChunks);
+    // 单个网格的 scratch arena (解码数组 + 优化器/拆分临时数组), 导入 arena 关闭或不需要时返回空
+    static std::unique_ptr<MonotonicArena> createMeshScratch(const ModelLoadOptions& options, MonotonicArena* importArena,
+                                                             size_t vertexCount, size_t indexCount, bool decode);
+
+    // 纹理加载辅助函数: 只提交异步解码, 不触碰 GL
+    size_t stageTextureFromFile(const std::string& path, const std::string& type, bool flipVertically = true);
+    size_t stageTextureFromMemory(const std::string& path, const std::string& type,
+                                  const unsigned char* data, size_t size, bool flipVertically);
+    void uploadGeometry(const std::vector<std::vector<Texture>>& meshTextures);
 
     // instancing
     std::vector<InstanceData> m_instanceData;
     bool m_hasInstanceData = false;
+    std::vector<uint32_t> m_visibleIndices;
+    std::vector<InstanceData> m_visibleData;
+    static constexpr uint32_t kNotVisible = 0xFFFFFFFFu;
+    std::vector<uint32_t> m_visibleSlot;    // 实例 -> 紧凑缓冲中的位置 (kNotVisible 表示不可见)
+    // 上次紧凑复制之后修改的实例区间 (first, count); 总数超过可见实例数时改为置 m_visibleStale
+    std::vector<std::pair<size_t, size_t>> m_visibleEdits;
+    size_t m_visibleEditCount = 0;
+    bool m_useVisibleSubset = false;
+    bool m_visibleStale = false;    // 需要重新复制全部可见实例 (可见列表不变时也不重新分配)
+
+    void recordVisibleEdit( size_t first, size_t count );
 
 
 };
\ No newline at end of file
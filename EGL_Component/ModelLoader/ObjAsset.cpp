@@ -0,0 +1,888 @@
+#include "ObjAsset.hpp"
+#include "VirtualFileSystem.hpp"
+#include "ThreadPool.hpp"
+#include "ArenaAllocator.hpp"
+#include "macros.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+
+namespace {
+
+constexpr uint32_t kMissing      = std::numeric_limits<uint32_t>::max();
+constexpr size_t kMinChunkBytes  = 256 * 1024;     // 小文件不值得切得太碎
+constexpr size_t kChunksPerThread = 4;              // 行长度不均匀时用更多的块平衡负载
+
+struct Corner {
+    uint32_t v  = kMissing;     // 全局 0 基下标
+    uint32_t vt = kMissing;
+    uint32_t vn = kMissing;
+};
+
+struct Event {
+    enum Kind { Group, Material, Library };
+    size_t face = 0;            // 事件发生在块内第几个面之前
+    Kind kind = Group;
+    std::string name;
+};
+
+struct Chunk {
+    const char* begin = nullptr;
+    const char* end   = nullptr;
+    size_t vCount = 0, vtCount = 0, vnCount = 0;
+    size_t vBase = 0, vtBase = 0, vnBase = 0;
+    std::vector<Corner> corners;
+    std::vector<uint32_t> faceEnds;     // 每个面在 corners 中的结束位置
+    std::vector<Event> events;
+    bool ok = true;
+};
+
+// 一个 Mesh 由若干块中连续的面区间组成
+struct Segment {
+    std::string name;
+    std::string material;
+    struct Range { size_t chunk, first, last; };
+    std::vector<Range> ranges;
+    size_t faces = 0;
+};
+
+inline bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+inline const char* skipBlanks(const char* c, const char* end) {
+    while (c < end && isBlank(*c)) ++c;
+    return c;
+}
+
+inline const char* lineEnd(const char* c, const char* end) {
+    const void* nl = std::memchr(c, '\n', static_cast<size_t>(end - c));
+    return nl ? static_cast<const char*>(nl) : end;
+}
+
+// 行首关键字之后的剩余部分 (去掉首尾空白)
+std::string restOfLine(const char* c, const char* end) {
+    c = skipBlanks(c, end);
+    while (end > c && isBlank(end[-1])) --end;
+    return std::string(c, end);
+}
+
+constexpr double kFractionScale[16] = {
+    0.0, 0.1, 0.01, 0.001, 0.0001, 0.00001, 0.000001, 0.0000001, 0.00000001, 0.000000001,
+    0.0000000001, 0.00000000001, 0.000000000001, 0.0000000000001, 0.00000000000001, 0.000000000000001,
+};
+
+/*
+    与 Assimp fast_atoreal_move<float> 相同的算术, 保证两条路径得到逐位相同的坐标:
+    整数部分按 uint64 累加后转 float; 小数部分最多取 15 位, 按 double 缩放后转 float 再相加; 指数用 float pow。
+    不抛异常, 失败返回 nullptr。
+*/
+const char* parseFloat(const char* c, const char* end, float& out) {
+    const bool negative = c < end && *c == '-';
+    if (c < end && (*c == '-' || *c == '+')) ++c;
+
+    auto isDigit = [&](const char* p) { return p < end && *p >= '0' && *p <= '9'; };
+    if (!isDigit(c) && !(c < end && *c == '.' && isDigit(c + 1))) return nullptr;
+
+    float value = 0.0f;
+    if (*c != '.') {
+        uint64_t integer = 0;
+        while (isDigit(c)) integer = integer * 10 + static_cast<uint64_t>(*c++ - '0');
+        value = static_cast<float>(integer);
+    }
+    if (c < end && *c == '.' && isDigit(c + 1)) {
+        ++c;
+        uint64_t fraction = 0;
+        unsigned digits = 0;
+        while (isDigit(c) && digits < 15) {
+            fraction = fraction * 10 + static_cast<uint64_t>(*c++ - '0');
+            ++digits;
+        }
+        while (isDigit(c)) ++c;
+        value += static_cast<float>(static_cast<double>(fraction) * kFractionScale[digits]);
+    } else if (c < end && *c == '.') {
+        ++c;
+    }
+    if (c < end && (*c == 'e' || *c == 'E')) {
+        ++c;
+        const bool negativeExponent = c < end && *c == '-';
+        if (c < end && (*c == '-' || *c == '+')) ++c;
+        if (!isDigit(c)) return nullptr;
+        uint64_t exponent = 0;
+        while (isDigit(c)) exponent = exponent * 10 + static_cast<uint64_t>(*c++ - '0');
+        float e = static_cast<float>(exponent);
+        if (negativeExponent) e = -e;
+        value *= std::pow(10.0f, e);
+    }
+    out = negative ? -value : value;
+    return c;
+}
+
+const char* parseInt(const char* c, const char* end, int64_t& out) {
+    const bool negative = c < end && *c == '-';
+    if (c < end && (*c == '-' || *c == '+')) ++c;
+    if (c >= end || *c < '0' || *c > '9') return nullptr;
+    int64_t value = 0;
+    while (c < end && *c >= '0' && *c <= '9') value = value * 10 + (*c++ - '0');
+    out = negative ? -value : value;
+    return c;
+}
+
+// OBJ 下标: 正数从 1 开始, 负数相对当前已出现的数量
+inline bool resolveIndex(int64_t raw, size_t current, uint32_t& out) {
+    if (raw > 0) {
+        out = static_cast<uint32_t>(raw - 1);
+        return true;
+    }
+    if (raw < 0 && static_cast<size_t>(-raw) <= current) {
+        out = static_cast<uint32_t>(static_cast<int64_t>(current) + raw);
+        return true;
+    }
+    return false;
+}
+
+inline bool keywordIs(const char* c, const char* end, const char* keyword) {
+    const size_t n = std::strlen(keyword);
+    return static_cast<size_t>(end - c) > n && std::memcmp(c, keyword, n) == 0 && isBlank(c[n]);
+}
+
+// 第一遍: 只统计属性行数, 用于确定各块在全局数组中的起点
+void countChunk(Chunk& chunk) {
+    for (const char* c = chunk.begin; c < chunk.end;) {
+        const char* eol = lineEnd(c, chunk.end);
+        c = skipBlanks(c, eol);
+        if (eol - c >= 2 && c[0] == 'v') {
+            if (isBlank(c[1]))                     ++chunk.vCount;
+            else if (c[1] == 't' && eol - c >= 3 && isBlank(c[2])) ++chunk.vtCount;
+            else if (c[1] == 'n' && eol - c >= 3 && isBlank(c[2])) ++chunk.vnCount;
+        }
+        c = eol + 1;
+    }
+}
+
+struct AttributeArrays {
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec2> texCoords;
+    std::vector<glm::vec3> normals;
+};
+
+// 第二遍: 属性写入全局数组 [base, base + count), 面索引解析为全局下标
+void parseChunk(Chunk& chunk, AttributeArrays& attributes) {
+    size_t v = chunk.vBase, vt = chunk.vtBase, vn = chunk.vnBase;
+    const size_t totalV = attributes.positions.size();
+    const size_t totalVT = attributes.texCoords.size();
+    const size_t totalVN = attributes.normals.size();
+
+    for (const char* line = chunk.begin; line < chunk.end && chunk.ok;) {
+        const char* eol = lineEnd(line, chunk.end);
+        const char* c = skipBlanks(line, eol);
+        line = eol + 1;
+        if (c >= eol || *c == '#') continue;
+
+        if (c[0] == 'v' && eol - c >= 2) {
+            float values[3] = {0.0f, 0.0f, 0.0f};
+            int expected = 0;
+            int minimum = 0;
+            const char* p = nullptr;
+            if (isBlank(c[1]))                           { expected = 3; minimum = 3; p = c + 1; }
+            else if (c[1] == 't' && eol - c >= 3 && isBlank(c[2])) { expected = 2; minimum = 1; p = c + 2; }
+            else if (c[1] == 'n' && eol - c >= 3 && isBlank(c[2])) { expected = 3; minimum = 3; p = c + 2; }
+            else continue;     // vp 等
+
+            int parsed = 0;
+            for (; parsed < expected; ++parsed) {
+                p = skipBlanks(p, eol);
+                if (p >= eol) break;
+                p = parseFloat(p, eol, values[parsed]);
+                if (!p) { chunk.ok = false; break; }
+            }
+            if (!chunk.ok || parsed < minimum) { chunk.ok = false; break; }
+
+            if (c[1] == 't')      attributes.texCoords[vt++] = glm::vec2(values[0], values[1]);
+            else if (c[1] == 'n') attributes.normals[vn++]   = glm::vec3(values[0], values[1], values[2]);
+            else                  attributes.positions[v++]  = glm::vec3(values[0], values[1], values[2]);
+            continue;
+        }
+
+        if (c[0] == 'f' && eol - c >= 2 && isBlank(c[1])) {
+            const size_t first = chunk.corners.size();
+            const char* p = c + 1;
+            for (;;) {
+                p = skipBlanks(p, eol);
+                if (p >= eol) break;
+                Corner corner;
+                int64_t raw = 0;
+                p = parseInt(p, eol, raw);
+                if (!p || !resolveIndex(raw, v, corner.v) || corner.v >= totalV) { chunk.ok = false; break; }
+                if (p < eol && *p == '/') {
+                    ++p;
+                    if (p < eol && *p != '/') {
+                        p = parseInt(p, eol, raw);
+                        if (!p || !resolveIndex(raw, vt, corner.vt) || corner.vt >= totalVT) { chunk.ok = false; break; }
+                    }
+                    if (p < eol && *p == '/') {
+                        ++p;
+                        p = parseInt(p, eol, raw);
+                        if (!p || !resolveIndex(raw, vn, corner.vn) || corner.vn >= totalVN) { chunk.ok = false; break; }
+                    }
+                }
+                chunk.corners.push_back(corner);
+            }
+            // 点/线退化面不参与三角形渲染
+            if (chunk.ok && chunk.corners.size() - first >= 3) {
+                chunk.faceEnds.push_back(static_cast<uint32_t>(chunk.corners.size()));
+            } else {
+                chunk.corners.resize(first);
+            }
+            continue;
+        }
+
+        if (keywordIs(c, eol, "usemtl")) {
+            chunk.events.push_back({ chunk.faceEnds.size(), Event::Material, restOfLine(c + 6, eol) });
+        } else if (keywordIs(c, eol, "mtllib")) {
+            chunk.events.push_back({ chunk.faceEnds.size(), Event::Library, restOfLine(c + 6, eol) });
+        } else if ((c[0] == 'g' || c[0] == 'o') && (eol - c == 1 || isBlank(c[1]))) {
+            chunk.events.push_back({ chunk.faceEnds.size(), Event::Group, restOfLine(c + 1, eol) });
+        }
+        // s / l / p / 其它关键字: 忽略
+    }
+}
+
+struct TripletHash {
+    size_t operator()(const Corner& corner) const {
+        uint64_t h = corner.v;
+        h = h * 0x9E3779B97F4A7C15ull ^ corner.vt;
+        h = h * 0x9E3779B97F4A7C15ull ^ corner.vn;
+        return static_cast<size_t>(h ^ (h >> 29));
+    }
+};
+struct TripletEqual {
+    bool operator()(const Corner& a, const Corner& b) const { return a.v == b.v && a.vt == b.vt && a.vn == b.vn; }
+};
+
+// 按 位置/法线/纹理坐标 的位模式去重 (不同下标指向相同数值时 Assimp 的 JoinIdenticalVertices 同样会合并)
+struct ValueKey {
+    uint32_t bits[8];
+};
+struct ValueHash {
+    size_t operator()(const ValueKey& key) const {
+        uint64_t h = 1469598103934665603ull;
+        for (uint32_t b : key.bits) h = (h ^ b) * 1099511628211ull;
+        return static_cast<size_t>(h);
+    }
+};
+struct ValueEqual {
+    bool operator()(const ValueKey& a, const ValueKey& b) const { return std::memcmp(a.bits, b.bits, sizeof(a.bits)) == 0; }
+};
+
+/*
+    开放寻址 (线性探测) 的 键 -> 顶点下标 表: 单个大 Mesh 的去重在一个线程内完成,
+    std::unordered_map 逐节点分配的开销在百 MB 级文件上占到总时间的一半以上
+*/
+template <typename Key, typename Hash, typename Equal>
+class FlatIndexMap {
+public:
+    explicit FlatIndexMap(size_t expected) {
+        size_t capacity = 16;
+        while (capacity < expected * 2) capacity <<= 1;
+        m_keys.resize(capacity);
+        m_values.assign(capacity, kMissing);
+    }
+
+    // 返回键对应的下标槽; 键不存在时以 value 插入。引用在下一次插入之前有效
+    uint32_t& findOrInsert(const Key& key, uint32_t value, bool& inserted) {
+        if ((m_size + 1) * 2 > m_values.size()) grow();
+        size_t slot = Hash()(key) & (m_values.size() - 1);
+        inserted = false;
+        while (m_values[slot] != kMissing) {
+            if (Equal()(m_keys[slot], key)) return m_values[slot];
+            slot = (slot + 1) & (m_values.size() - 1);
+        }
+        m_keys[slot] = key;
+        m_values[slot] = value;
+        ++m_size;
+        inserted = true;
+        return m_values[slot];
+    }
+
+private:
+    void grow() {
+        std::vector<Key> keys(m_keys.size() * 2);
+        std::vector<uint32_t> values(m_values.size() * 2, kMissing);
+        keys.swap(m_keys);
+        values.swap(m_values);
+        m_size = 0;
+        bool inserted = false;
+        for (size_t i = 0; i < values.size(); ++i) {
+            if (values[i] != kMissing) findOrInsert(keys[i], values[i], inserted);
+        }
+    }
+
+    std::vector<Key> m_keys;
+    std::vector<uint32_t> m_values;
+    size_t m_size = 0;
+};
+
+ValueKey valueKeyOf(const Vertex& vertex) {
+    ValueKey key;
+    std::memcpy(&key.bits[0], &vertex.Position, sizeof(float) * 3);
+    std::memcpy(&key.bits[3], &vertex.Normal, sizeof(float) * 3);
+    std::memcpy(&key.bits[6], &vertex.TexCoords, sizeof(float) * 2);
+    return key;
+}
+
+glm::vec3 normalizeSafe(const glm::vec3& v) {
+    const float length = std::sqrt(v.x * v.x + v.y * v.y + v.z * v.z);
+    return length > 0.0f ? v * (1.0f / length) : v;
+}
+
+// 与 Assimp TriangulateProcess 相同: 四边形最多有一个凹点, 从凹点开始扇形三角化
+unsigned quadStartVertex(const std::vector<Vertex>& vertices, const uint32_t* quad) {
+    for (unsigned i = 0; i < 4; ++i) {
+        const glm::vec3& v  = vertices[quad[i]].Position;
+        const glm::vec3 left  = normalizeSafe(vertices[quad[(i + 3) % 4]].Position - v);
+        const glm::vec3 diag  = normalizeSafe(vertices[quad[(i + 2) % 4]].Position - v);
+        const glm::vec3 right = normalizeSafe(vertices[quad[(i + 1) % 4]].Position - v);
+        const float angle = std::acos(glm::dot(left, diag)) + std::acos(glm::dot(right, diag));
+        if (angle > 3.14159265358979323846f) return i;
+    }
+    return 0;
+}
+
+// 缺少法线时: 按位置分组平均 (归一化的) 面法线, 对应 aiProcess_GenSmoothNormals
+void generateNormals(std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
+    struct PositionHash {
+        size_t operator()(const glm::vec3& p) const {
+            uint32_t bits[3];
+            std::memcpy(bits, &p, sizeof(bits));
+            return (static_cast<size_t>(bits[0]) * 73856093u) ^ (static_cast<size_t>(bits[1]) * 19349663u) ^
+                   (static_cast<size_t>(bits[2]) * 83492791u);
+        }
+    };
+    // 每个不同位置一个节点: 节点与桶数组放在按顶点数一次申请的 arena 中, 不再逐节点 new/delete
+    using Entry = std::pair<const glm::vec3, glm::vec3>;
+    MonotonicArena arena(vertices.size() * (sizeof(Entry) + 4 * sizeof(void*)) + 4096);
+    std::unordered_map<glm::vec3, glm::vec3, PositionHash, std::equal_to<glm::vec3>, ArenaAllocator<Entry>>
+        sums(0, PositionHash(), std::equal_to<glm::vec3>(), ArenaAllocator<Entry>(&arena));
+    sums.reserve(vertices.size());
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        const glm::vec3& a = vertices[indices[i]].Position;
+        const glm::vec3& b = vertices[indices[i + 1]].Position;
+        const glm::vec3& c = vertices[indices[i + 2]].Position;
+        const glm::vec3 faceNormal = normalizeSafe(glm::cross(b - a, c - a));
+        sums[a] += faceNormal;
+        sums[b] += faceNormal;
+        sums[c] += faceNormal;
+    }
+    for (Vertex& vertex : vertices) {
+        auto it = sums.find(vertex.Position);
+        vertex.Normal = it != sums.end() ? normalizeSafe(it->second) : glm::vec3(0.0f);
+    }
+}
+
+// 与 Assimp CalcTangentsProcess 相同的逐面公式 (投影到顶点法线平面后归一化), 按顶点累加平滑
+void generateTangents(std::vector<Vertex>& vertices, const std::vector<uint32_t>& indices) {
+    for (Vertex& vertex : vertices) {
+        vertex.Tangent = glm::vec3(0.0f);
+        vertex.Bitangent = glm::vec3(0.0f);
+    }
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        const uint32_t face[3] = { indices[i], indices[i + 1], indices[i + 2] };
+        const Vertex& p0 = vertices[face[0]];
+        const Vertex& p1 = vertices[face[1]];
+        const Vertex& p2 = vertices[face[2]];
+        const glm::vec3 v = p1.Position - p0.Position;
+        const glm::vec3 w = p2.Position - p0.Position;
+        float sx = p1.TexCoords.x - p0.TexCoords.x, sy = p1.TexCoords.y - p0.TexCoords.y;
+        float tx = p2.TexCoords.x - p0.TexCoords.x, ty = p2.TexCoords.y - p0.TexCoords.y;
+        const float dirCorrection = (tx * sy - ty * sx) < 0.0f ? -1.0f : 1.0f;
+        if (sx * ty == sy * tx) {   // 三个顶点的纹理坐标重合时使用默认方向
+            sx = 0.0f; sy = 1.0f; tx = 1.0f; ty = 0.0f;
+        }
+        const glm::vec3 tangent   = (w * sy - v * ty) * dirCorrection;
+        const glm::vec3 bitangent = (v * tx - w * sx) * dirCorrection;
+        for (uint32_t index : face) {
+            Vertex& vertex = vertices[index];
+            vertex.Tangent   += normalizeSafe(tangent - vertex.Normal * glm::dot(tangent, vertex.Normal));
+            vertex.Bitangent += normalizeSafe(bitangent - vertex.Normal * glm::dot(bitangent, vertex.Normal));
+        }
+    }
+    for (Vertex& vertex : vertices) {
+        vertex.Tangent   = normalizeSafe(vertex.Tangent);
+        vertex.Bitangent = normalizeSafe(vertex.Bitangent);
+    }
+}
+
+// 一个 Segment 的面 -> 去重顶点 + 三角形索引
+void buildMesh(const Segment& segment, const std::vector<Chunk>& chunks, const AttributeArrays& attributes,
+               uint32_t wanted, ObjAsset::Mesh& mesh) {
+    bool hasTexCoords = false;
+    bool hasNormals = false;
+    size_t cornerCount = 0;
+    for (const Segment::Range& range : segment.ranges) {
+        const Chunk& chunk = chunks[range.chunk];
+        const size_t begin = range.first == 0 ? 0 : chunk.faceEnds[range.first - 1];
+        const size_t end = range.last == 0 ? 0 : chunk.faceEnds[range.last - 1];
+        cornerCount += end - begin;
+        for (size_t i = begin; i < end && !(hasTexCoords && hasNormals); ++i) {
+            hasTexCoords |= chunk.corners[i].vt != kMissing;
+            hasNormals   |= chunk.corners[i].vn != kMissing;
+        }
+    }
+
+    // 封闭网格中每个去重顶点平均被 4~6 个面角引用
+    FlatIndexMap<Corner, TripletHash, TripletEqual> tripletIds(cornerCount / 4);
+    FlatIndexMap<ValueKey, ValueHash, ValueEqual> valueIds(cornerCount / 4);
+    mesh.vertices.reserve(cornerCount / 4);
+    mesh.indices.reserve(cornerCount * 3 / 2);
+
+    std::vector<uint32_t> polygon;
+    for (const Segment::Range& range : segment.ranges) {
+        const Chunk& chunk = chunks[range.chunk];
+        for (size_t f = range.first; f < range.last; ++f) {
+            const size_t begin = f == 0 ? 0 : chunk.faceEnds[f - 1];
+            const size_t end = chunk.faceEnds[f];
+            polygon.clear();
+            for (size_t i = begin; i < end; ++i) {
+                const Corner& corner = chunk.corners[i];
+                bool inserted = false;
+                uint32_t& tripletIndex = tripletIds.findOrInsert(corner, 0, inserted);   // 新键的值在下面确定
+                if (!inserted) {
+                    polygon.push_back(tripletIndex);
+                    continue;
+                }
+                Vertex vertex;
+                vertex.Position  = attributes.positions[corner.v];
+                vertex.Normal    = corner.vn != kMissing ? attributes.normals[corner.vn] : glm::vec3(0.0f);
+                vertex.TexCoords = glm::vec2(0.0f);
+                if (hasTexCoords) {
+                    // aiProcess_FlipUVs: 缺少 vt 的顶点按 (0, 0) 翻转
+                    const glm::vec2 uv = corner.vt != kMissing ? attributes.texCoords[corner.vt] : glm::vec2(0.0f);
+                    vertex.TexCoords = glm::vec2(uv.x, 1.0f - uv.y);
+                }
+                vertex.Tangent   = glm::vec3(0.0f);
+                vertex.Bitangent = glm::vec3(0.0f);
+
+                // 下标不同但数值相同的三元组指向同一个顶点
+                tripletIndex = valueIds.findOrInsert(valueKeyOf(vertex), static_cast<uint32_t>(mesh.vertices.size()), inserted);
+                if (inserted) {
+                    mesh.vertices.push_back(vertex);
+                }
+                polygon.push_back(tripletIndex);
+            }
+
+            if (polygon.size() == 3) {
+                mesh.indices.insert(mesh.indices.end(), polygon.begin(), polygon.end());
+            } else if (polygon.size() == 4) {
+                const unsigned s = quadStartVertex(mesh.vertices, polygon.data());
+                const uint32_t quad[6] = { polygon[s], polygon[(s + 1) % 4], polygon[(s + 2) % 4],
+                                           polygon[s], polygon[(s + 2) % 4], polygon[(s + 3) % 4] };
+                mesh.indices.insert(mesh.indices.end(), quad, quad + 6);
+            } else {
+                for (size_t i = 2; i < polygon.size(); ++i) {
+                    mesh.indices.push_back(polygon[0]);
+                    mesh.indices.push_back(polygon[i - 1]);
+                    mesh.indices.push_back(polygon[i]);
+                }
+            }
+        }
+    }
+
+    if (!hasNormals && (wanted & VertexAttrib::Normal)) {
+        generateNormals(mesh.vertices, mesh.indices);
+    }
+    // Assimp 在没有纹理坐标时不生成切线
+    if (hasTexCoords && (wanted & (VertexAttrib::Tangent | VertexAttrib::Bitangent))) {
+        generateTangents(mesh.vertices, mesh.indices);
+    }
+}
+
+double elapsedMs(std::chrono::high_resolution_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::high_resolution_clock::now() - start).count();
+}
+
+} // namespace
+
+bool ObjAsset::isObjPath(const std::string& path) {
+    std::string ext = std::filesystem::path(path).extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return ext == ".obj";
+}
+
+bool ObjAsset::open(const std::string& path, size_t threads, uint32_t attributes) {
+    m_materials.clear();
+    m_meshes.clear();
+    m_stats = Stats();
+    m_directory = std::filesystem::path(path).parent_path().string();
+
+    AssetFile file;
+    if (!file.open(path)) {
+        LOGE("OBJ: failed to map %s", path.c_str());
+        return false;
+    }
+    return parse(reinterpret_cast<const char*>(file.data()), file.size(), path, threads, attributes);
+}
+
+bool ObjAsset::openMemory(const char* data, size_t size, const std::string& directory, size_t threads, uint32_t attributes) {
+    m_materials.clear();
+    m_meshes.clear();
+    m_stats = Stats();
+    m_directory = directory;
+    return parse(data, size, "<memory>", threads, attributes);
+}
+
+bool ObjAsset::parse(const char* data, size_t size, const std::string& label, size_t threads, uint32_t attributes) {
+    auto parseStart = std::chrono::high_resolution_clock::now();
+
+    // ---- 1. 按行边界切块 ----
+    if (threads == 0) threads = ThreadPool::defaultThreadCount();
+    const char* end = data + size;
+    const size_t chunkCount = std::max<size_t>(1, std::min(threads * kChunksPerThread, size / kMinChunkBytes));
+    std::vector<Chunk> chunks;
+    chunks.reserve(chunkCount);
+    const char* cursor = data;
+    for (size_t i = 0; i < chunkCount && cursor < end; ++i) {
+        const char* split = i + 1 == chunkCount ? end : std::max(cursor, data + size * (i + 1) / chunkCount);
+        if (split < end) {
+            split = lineEnd(split, end);
+            if (split < end) ++split;
+        }
+        Chunk chunk;
+        chunk.begin = cursor;
+        chunk.end = split;
+        chunks.push_back(std::move(chunk));
+        cursor = split;
+    }
+
+    threads = std::max<size_t>(1, std::min(threads, chunks.size()));
+    std::unique_ptr<ThreadPool> pool;
+    if (threads > 1) pool = std::make_unique<ThreadPool>(threads - 1);
+    auto forEach = [&](size_t count, const std::function<void(size_t)>& body) {
+        if (pool) {
+            pool->parallelFor(count, body);
+        } else {
+            for (size_t i = 0; i < count; ++i) body(i);
+        }
+    };
+
+    // ---- 2. 统计 + 前缀和 ----
+    forEach(chunks.size(), [&](size_t i) { countChunk(chunks[i]); });
+    AttributeArrays attributeArrays;
+    size_t vTotal = 0, vtTotal = 0, vnTotal = 0;
+    for (Chunk& chunk : chunks) {
+        chunk.vBase = vTotal;   vTotal  += chunk.vCount;
+        chunk.vtBase = vtTotal; vtTotal += chunk.vtCount;
+        chunk.vnBase = vnTotal; vnTotal += chunk.vnCount;
+    }
+    attributeArrays.positions.resize(vTotal);
+    attributeArrays.texCoords.resize(vtTotal);
+    attributeArrays.normals.resize(vnTotal);
+
+    // ---- 3. 解析 ----
+    forEach(chunks.size(), [&](size_t i) { parseChunk(chunks[i], attributeArrays); });
+    size_t faceTotal = 0;
+    for (size_t i = 0; i < chunks.size(); ++i) {
+        if (!chunks[i].ok) {
+            LOGE("OBJ: unsupported or malformed data in chunk %d of %s", static_cast<int>(i), label.c_str());
+            return false;
+        }
+        faceTotal += chunks[i].faceEnds.size();
+    }
+    m_stats.parseMs = elapsedMs(parseStart);
+
+    // ---- 4. 切分 Mesh: g / o 开始新对象; usemtl 在当前 Mesh 已有面且材质不同时开始新 Mesh ----
+    auto assembleStart = std::chrono::high_resolution_clock::now();
+    std::vector<Segment> segments(1);
+    segments[0].name = "defaultobject";
+    std::string library;
+    for (size_t c = 0; c < chunks.size(); ++c) {
+        size_t position = 0;
+        auto addRange = [&](size_t last) {
+            if (last > position) {
+                segments.back().ranges.push_back({ c, position, last });
+                segments.back().faces += last - position;
+            }
+            position = last;
+        };
+        for (const Event& event : chunks[c].events) {
+            addRange(event.face);
+            if (event.kind == Event::Library) {
+                if (library.empty()) library = event.name;
+            } else if (event.kind == Event::Group) {
+                Segment next;
+                next.name = event.name;
+                next.material = segments.back().material;
+                segments.push_back(std::move(next));
+            } else if (segments.back().faces > 0 && segments.back().material != event.name) {
+                Segment next;
+                next.name = segments.back().name;
+                next.material = event.name;
+                segments.push_back(std::move(next));
+            } else {
+                segments.back().material = event.name;
+            }
+        }
+        addRange(chunks[c].faceEnds.size());
+    }
+    segments.erase(std::remove_if(segments.begin(), segments.end(),
+                                  [](const Segment& segment) { return segment.faces == 0; }),
+                   segments.end());
+
+    if (!library.empty()) {
+        std::replace(library.begin(), library.end(), '\\', '/');
+        loadMaterials(m_directory + "/" + library);
+    }
+
+    m_meshes.resize(segments.size());
+    forEach(segments.size(), [&](size_t i) {
+        buildMesh(segments[i], chunks, attributeArrays, attributes, m_meshes[i]);
+        m_meshes[i].name = segments[i].name;
+    });
+    for (size_t i = 0; i < segments.size(); ++i) {
+        for (size_t m = 0; m < m_materials.size(); ++m) {
+            if (m_materials[m].name == segments[i].material) {
+                m_meshes[i].material = static_cast<int>(m);
+                break;
+            }
+        }
+    }
+    m_stats.assembleMs  = elapsedMs(assembleStart);
+    m_stats.sourceBytes = size;
+    m_stats.chunks      = chunks.size();
+    m_stats.threads     = threads;
+    m_stats.positions   = vTotal;
+    m_stats.faces       = faceTotal;
+    return true;
+}
+
+bool ObjAsset::loadMaterials(const std::string& path) {
+    AssetFile file;
+    if (!file.open(path)) {
+        LOGE("OBJ: material library %s not found", path.c_str());
+        return false;
+    }
+    const char* c = reinterpret_cast<const char*>(file.data());
+    const char* end = c + file.size();
+    while (c < end) {
+        const char* eol = lineEnd(c, end);
+        const char* p = skipBlanks(c, eol);
+        c = eol + 1;
+
+        // 贴图语句的文件名为最后一个字段 (前面可能有 -bm / -s 等选项)
+        auto mapPath = [&](const char* keywordEnd) {
+            std::string value = restOfLine(keywordEnd, eol);
+            const size_t space = value.find_last_of(" \t");
+            if (space != std::string::npos) value = value.substr(space + 1);
+            std::replace(value.begin(), value.end(), '\\', '/');
+            return value;
+        };
+
+        if (keywordIs(p, eol, "newmtl")) {
+            m_materials.emplace_back();
+            m_materials.back().name = restOfLine(p + 6, eol);
+            continue;
+        }
+        if (m_materials.empty()) continue;
+        Material& material = m_materials.back();
+        if (keywordIs(p, eol, "map_Kd"))        material.diffuseMap  = mapPath(p + 6);
+        else if (keywordIs(p, eol, "map_Ks"))   material.specularMap = mapPath(p + 6);
+        else if (keywordIs(p, eol, "map_Ka"))   material.ambientMap  = mapPath(p + 6);
+        else if (keywordIs(p, eol, "map_Bump") || keywordIs(p, eol, "map_bump")) material.normalMap = mapPath(p + 8);
+        else if (keywordIs(p, eol, "bump"))     material.normalMap   = mapPath(p + 4);
+    }
+    return true;
+}
+
+size_t ObjAsset::residentBytes() const {
+    size_t bytes = 0;
+    for (const Mesh& mesh : m_meshes) {
+        bytes += mesh.vertices.capacity() * sizeof(Vertex) + mesh.indices.capacity() * sizeof(uint32_t);
+    }
+    return bytes;
+}
+
+// ---- 一致性核对与吞吐测试 (OBJ_BENCHMARK_ON_STARTUP) ----
+
+namespace {
+
+void collectMeshes(const aiNode* node, const aiScene* scene, std::vector<const aiMesh*>& out) {
+    for (unsigned int i = 0; i < node->mNumMeshes; ++i) out.push_back(scene->mMeshes[node->mMeshes[i]]);
+    for (unsigned int i = 0; i < node->mNumChildren; ++i) collectMeshes(node->mChildren[i], scene, out);
+}
+
+} // namespace
+
+bool ObjAsset::compareWithAssimp(const std::string& path, unsigned int importFlags) {
+    ObjAsset native;
+    if (!native.open(path)) {
+        LOGE("OBJ compare: native parser rejected %s", path.c_str());
+        return false;
+    }
+    Assimp::Importer importer;
+    importer.SetPropertyInteger(AI_CONFIG_FAVOUR_SPEED, 1);
+    const aiScene* scene = importer.ReadFile(path, importFlags);
+    if (!scene || !scene->mRootNode) {
+        LOGE("OBJ compare: Assimp failed: %s", importer.GetErrorString());
+        return false;
+    }
+    std::vector<const aiMesh*> reference;
+    collectMeshes(scene->mRootNode, scene, reference);
+
+    bool identical = reference.size() == native.meshes().size();
+    if (!identical) {
+        LOGE("OBJ compare: mesh count native %d vs Assimp %d",
+             static_cast<int>(native.meshes().size()), static_cast<int>(reference.size()));
+    }
+    const float epsilon = 1e-5f;
+    for (size_t m = 0; m < std::min(reference.size(), native.meshes().size()); ++m) {
+        const aiMesh* expected = reference[m];
+        const Mesh& actual = native.meshes()[m];
+        size_t triangles = 0;
+        size_t mismatched = 0;
+        size_t bitExact = 0;
+        float maxError = 0.0f;
+        for (unsigned int f = 0; f < expected->mNumFaces; ++f) {
+            const aiFace& face = expected->mFaces[f];
+            if (face.mNumIndices != 3) continue;
+            if (triangles * 3 + 2 >= actual.indices.size()) {
+                ++triangles;
+                ++mismatched;
+                continue;
+            }
+            bool same = true;
+            bool exact = true;
+            for (unsigned int k = 0; k < 3; ++k) {
+                const unsigned int e = face.mIndices[k];
+                const Vertex& a = actual.vertices[actual.indices[triangles * 3 + k]];
+                float values[2][8] = {
+                    { expected->mVertices[e].x, expected->mVertices[e].y, expected->mVertices[e].z,
+                      expected->HasNormals() ? expected->mNormals[e].x : 0.0f,
+                      expected->HasNormals() ? expected->mNormals[e].y : 0.0f,
+                      expected->HasNormals() ? expected->mNormals[e].z : 0.0f,
+                      expected->mTextureCoords[0] ? expected->mTextureCoords[0][e].x : 0.0f,
+                      expected->mTextureCoords[0] ? expected->mTextureCoords[0][e].y : 0.0f },
+                    { a.Position.x, a.Position.y, a.Position.z, a.Normal.x, a.Normal.y, a.Normal.z,
+                      a.TexCoords.x, a.TexCoords.y },
+                };
+                for (int i = 0; i < 8; ++i) {
+                    const float error = std::fabs(values[0][i] - values[1][i]);
+                    maxError = std::max(maxError, error);
+                    same  &= error <= epsilon;
+                    exact &= std::memcmp(&values[0][i], &values[1][i], sizeof(float)) == 0;
+                }
+            }
+            ++triangles;
+            if (!same) ++mismatched;
+            if (exact) ++bitExact;
+        }
+        const bool meshIdentical = mismatched == 0 && triangles * 3 == actual.indices.size() &&
+                                   expected->mNumVertices == actual.vertices.size();
+        identical &= meshIdentical;
+        LOGI("OBJ compare mesh %d '%s': triangles %d/%d, vertices native %d vs Assimp %d, "
+             "mismatched %d, bit-exact %d, max error %g -> %s",
+             static_cast<int>(m), actual.name.c_str(), static_cast<int>(actual.indices.size() / 3), static_cast<int>(triangles),
+             static_cast<int>(actual.vertices.size()), static_cast<int>(expected->mNumVertices),
+             static_cast<int>(mismatched), static_cast<int>(bitExact), maxError, meshIdentical ? "identical" : "DIFFERENT");
+    }
+    LOGI("OBJ compare %s: %s", path.c_str(), identical ? "native output identical to Assimp" : "outputs differ");
+    return identical;
+}
+
+// text 为空时从 path 映射文件读取; 否则解析内存中的文本 (Assimp 按 obj 格式提示读取), path 只用于日志
+void ObjAsset::benchmark(const std::string& path, unsigned int importFlags, size_t syntheticBytes) {
+    auto measure = [importFlags](const std::string& label, const std::string* text) {
+        double megabytes = 0.0;
+        if (text) {
+            megabytes = static_cast<double>(text->size()) / (1024.0 * 1024.0);
+        } else {
+            std::error_code error;
+            megabytes = static_cast<double>(std::filesystem::file_size(label, error)) / (1024.0 * 1024.0);
+            if (error) return;
+        }
+        auto openNative = [&](ObjAsset& asset, size_t threads) {
+            return text ? asset.openMemory(text->data(), text->size(), std::string(), threads) : asset.open(label, threads);
+        };
+
+        double nativeMs = 0.0, singleMs = 0.0, assimpMs = 0.0;
+        {
+            ObjAsset asset;
+            auto start = std::chrono::high_resolution_clock::now();
+            openNative(asset, 0);
+            nativeMs = elapsedMs(start);
+            LOGI("OBJ bench %s: %.1f MB, %d chunks on %d threads (parse %.1f ms, assemble %.1f ms)",
+                 label.c_str(), megabytes, static_cast<int>(asset.stats().chunks), static_cast<int>(asset.stats().threads),
+                 asset.stats().parseMs, asset.stats().assembleMs);
+        }
+        {
+            ObjAsset asset;
+            auto start = std::chrono::high_resolution_clock::now();
+            openNative(asset, 1);
+            singleMs = elapsedMs(start);
+        }
+        {
+            Assimp::Importer importer;
+            importer.SetPropertyInteger(AI_CONFIG_FAVOUR_SPEED, 1);
+            auto start = std::chrono::high_resolution_clock::now();
+            if (text) {
+                importer.ReadFileFromMemory(text->data(), text->size(), importFlags, "obj");
+            } else {
+                importer.ReadFile(label, importFlags);
+            }
+            assimpMs = elapsedMs(start);
+        }
+        auto rate = [megabytes](double ms) { return ms > 0.0 ? megabytes * 1000.0 / ms : 0.0; };
+        LOGI("OBJ bench %s: native %.1f MB/s (%.1f ms), native 1 thread %.1f MB/s (%.1f ms), Assimp %.1f MB/s (%.1f ms), speedup x%.1f",
+             label.c_str(), rate(nativeMs), nativeMs, rate(singleMs), singleMs, rate(assimpMs), assimpMs,
+             nativeMs > 0.0 ? assimpMs / nativeMs : 0.0);
+    };
+
+    measure(path, nullptr);
+    if (syntheticBytes > 0) {
+        // 合成网格只在内存中生成: 模型目录在 Android 上只读或空间有限, 也不在资源目录中留下文件
+        std::string synthetic;
+        writeSyntheticObj(synthetic, syntheticBytes);
+        measure("synthetic grid (in memory)", &synthetic);
+    }
+}
+
+void ObjAsset::writeSyntheticObj(std::string& out, size_t targetBytes) {
+    // 每个网格顶点约 150 字节 (v + vt + vn + 一个四边形面)
+    const size_t side = std::max<size_t>(2, static_cast<size_t>(std::sqrt(static_cast<double>(targetBytes) / 150.0)));
+    out.clear();
+    out.reserve(side * side * 150 + 64);
+    char line[256];
+    auto append = [&](int length) {
+        if (length > 0) out.append(line, std::min<size_t>(static_cast<size_t>(length), sizeof(line) - 1));
+    };
+    append(std::snprintf(line, sizeof(line), "# synthetic %dx%d grid\ng grid\n", static_cast<int>(side), static_cast<int>(side)));
+    for (size_t y = 0; y < side; ++y) {
+        for (size_t x = 0; x < side; ++x) {
+            const float u = static_cast<float>(x) / static_cast<float>(side - 1);
+            const float v = static_cast<float>(y) / static_cast<float>(side - 1);
+            const float h = 0.05f * std::sin(u * 40.0f) * std::cos(v * 40.0f);
+            append(std::snprintf(line, sizeof(line), "v %.6f %.6f %.6f\nvt %.6f %.6f\nvn %.6f %.6f %.6f\n",
+                                 u * 10.0f, h, v * 10.0f, u, v, -h, 1.0f, h * 0.5f));
+        }
+    }
+    for (size_t y = 0; y + 1 < side; ++y) {
+        for (size_t x = 0; x + 1 < side; ++x) {
+            const size_t a = y * side + x + 1;
+            const size_t b = a + 1;
+            const size_t c = a + side + 1;
+            const size_t d = a + side;
+            append(std::snprintf(line, sizeof(line), "f %zu/%zu/%zu %zu/%zu/%zu %zu/%zu/%zu %zu/%zu/%zu\n",
+                                 a, a, a, b, b, b, c, c, c, d, d, d));
+        }
+    }
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "VertexLayout.hpp"
+
+// 置 1 后在加载线程开始时运行一次 ObjAsset::compareWithAssimp / benchmark 并输出日志
+#define OBJ_BENCHMARK_ON_STARTUP 0
+
+/**
+ * @brief OBJ/MTL 快速解析器 (Model 对 .obj 的默认路径, 替代 Assimp 的通用 OBJ 导入)
+ *
+ * 流程:
+ * 1. mmap 源文件, 按行边界切成若干块
+ * 2. 并行第一遍: 各块统计 v / vt / vn 行数, 前缀和得到每块在全局数组中的起点
+ * 3. 并行第二遍: 各块把属性直接写入全局数组的对应区间, 面索引就地解析为全局下标 (含负数相对索引)
+ * 4. 按 g / o / usemtl 切分 Mesh (与 Assimp 的对象/材质切分规则一致), 每个 Mesh 并行去重与三角化
+ *
+ * 输出与 Assimp 在 Model 的导入标志下 (Triangulate | JoinIdenticalVertices | GenSmoothNormals | FlipUVs | CalcTangentSpace)
+ * 的结果保持一致:
+ * - 浮点解析与 Assimp fast_atof 的算术逐步相同, 坐标逐位一致
+ * - 顶点按 (位置, 法线, 纹理坐标) 的位模式去重, 保持首次出现顺序; 四边形按 Assimp 的凹点规则扇形三角化
+ * - 纹理坐标 v 翻转为 1 - v; 缺少法线时按位置分组平均面法线
+ * 差异: 超过 4 个顶点的多边形使用扇形三角化 (Assimp 为耳切法); 切线用相同的逐面公式但按顶点累加平滑
+ * (现有着色器不读取切线, Compact 格式也会丢弃它们)。compareWithAssimp 用于核对一致性。
+ */
+class ObjAsset {
+public:
+    // MTL 中引擎会使用的贴图 (路径为 MTL 中记录的原样路径, 反斜杠已替换)
+    struct Material {
+        std::string name;
+        std::string diffuseMap;     // map_Kd
+        std::string specularMap;    // map_Ks
+        std::string normalMap;      // map_Bump / bump (Assimp 映射为 aiTextureType_HEIGHT)
+        std::string ambientMap;     // map_Ka
+    };
+
+    struct Mesh {
+        std::string name;               // g / o 名称
+        int material = -1;              // materials() 下标
+        std::vector<Vertex> vertices;
+        std::vector<uint32_t> indices;  // 三角形列表
+    };
+
+    struct Stats {
+        size_t sourceBytes = 0;
+        size_t chunks      = 0;
+        size_t threads     = 0;
+        size_t positions   = 0;
+        size_t faces       = 0;
+        double parseMs     = 0.0;       // 第 2、3 步
+        double assembleMs  = 0.0;       // 第 4 步
+    };
+
+    // 按扩展名判断 (.obj, 不区分大小写)
+    static bool isObjPath(const std::string& path);
+
+    /**
+     * @brief 解析 OBJ 及其 mtllib
+     * @param threads 0 表示 ThreadPool::defaultThreadCount()
+     * @param attributes 需要的顶点属性 (VertexAttrib), 不含法线/切线时跳过对应的生成, 这些字段保持为 0
+     * @return false 文件无法读取或包含解析器不支持的语法 (调用方回退到 Assimp)
+     */
+    bool open(const std::string& path, size_t threads = 0, uint32_t attributes = VertexAttrib::All);
+    // 同 open, 解析内存中的 OBJ 文本 (只在调用期间读取 data); mtllib 相对 directory 查找
+    bool openMemory(const char* data, size_t size, const std::string& directory,
+                    size_t threads = 0, uint32_t attributes = VertexAttrib::All);
+
+    const std::vector<Material>& materials() const { return m_materials; }
+    std::vector<Mesh>& meshes() { return m_meshes; }
+    const std::vector<Mesh>& meshes() const { return m_meshes; }
+    const Stats& stats() const { return m_stats; }
+
+    // 解析结果占用的 CPU 内存
+    size_t residentBytes() const;
+
+    /**
+     * @brief 用 Assimp 以 importFlags 导入同一文件, 逐三角形比较位置/法线/纹理坐标 (容差为 Assimp 合并顶点的 1e-5)
+     * @return true 两条路径的 Mesh 数、三角形数与三角形属性全部一致
+     */
+    static bool compareWithAssimp(const std::string& path, unsigned int importFlags);
+
+    /**
+     * @brief 比较本解析器 (多线程 / 单线程) 与 Assimp 的吞吐 (MB/s), 结果写入日志
+     * @param syntheticBytes 另外在内存中生成一个约此大小的网格 OBJ 一并测量 (不写文件), 0 表示跳过
+     */
+    static void benchmark(const std::string& path, unsigned int importFlags, size_t syntheticBytes = 100u << 20);
+
+    // 生成一个约 targetBytes 大小的网格 OBJ 文本 (带 vt / vn 的四边形) 到 out, 用于吞吐测试
+    static void writeSyntheticObj(std::string& out, size_t targetBytes);
+
+private:
+    // open / openMemory 共用: 解析 [data, data + size), label 只用于日志
+    bool parse(const char* data, size_t size, const std::string& label, size_t threads, uint32_t attributes);
+    bool loadMaterials(const std::string& path);
+
+    std::string m_directory;
+    std::vector<Material> m_materials;
+    std::vector<Mesh> m_meshes;
+    Stats m_stats;
+};
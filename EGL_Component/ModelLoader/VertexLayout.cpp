@@ -0,0 +1,262 @@
+#include "VertexLayout.hpp"
+
+#include <cmath>
+#include <cstring>
+
+namespace VertexLayout {
+
+namespace {
+
+// 各属性在两种格式中的字节数 (下标为 location); 0 表示该格式不保存
+constexpr size_t kFullBytes[VertexAttrib::kCount]    = { 12, 12, 8, 12, 12 };
+constexpr size_t kCompactBytes[VertexAttrib::kCount] = { 8, 4, 4, 0, 0 };
+
+// 位置与纹理坐标在流 0, 其余在流 1
+inline unsigned streamOf(unsigned attribute) {
+    return (attribute == 0 || attribute == 2) ? 0u : 1u;
+}
+
+inline bool interleavedVertex(VertexFormat format, uint32_t stored) {
+    return format == VertexFormat::Full && stored == VertexAttrib::All;
+}
+
+inline size_t attributeBytes(VertexFormat format, unsigned attribute) {
+    return format == VertexFormat::Compact ? kCompactBytes[attribute] : kFullBytes[attribute];
+}
+
+// 属性在所属流中的字节偏移
+size_t attributeOffset(VertexFormat format, uint32_t stored, unsigned attribute) {
+    if (interleavedVertex(format, stored)) {
+        static const size_t kVertexOffsets[VertexAttrib::kCount] = {
+            offsetof(Vertex, Position), offsetof(Vertex, Normal), offsetof(Vertex, TexCoords),
+            offsetof(Vertex, Tangent), offsetof(Vertex, Bitangent),
+        };
+        return kVertexOffsets[attribute];
+    }
+    size_t offset = 0;
+    for (unsigned a = 0; a < attribute; ++a) {
+        if ((stored & (1u << a)) && streamOf(a) == streamOf(attribute)) offset += attributeBytes(format, a);
+    }
+    return offset;
+}
+
+} // namespace
+
+uint32_t storedAttributes(VertexFormat format, uint32_t attributes) {
+    uint32_t stored = (attributes & VertexAttrib::All) | VertexAttrib::Position;
+    if (format == VertexFormat::Compact) {
+        stored &= ~(VertexAttrib::Tangent | VertexAttrib::Bitangent);
+    }
+    return stored;
+}
+
+size_t streamStride(VertexFormat format, uint32_t attributes, unsigned stream) {
+    const uint32_t stored = storedAttributes(format, attributes);
+    if (interleavedVertex(format, stored)) {
+        return stream == 0 ? sizeof(Vertex) : 0;
+    }
+    size_t bytes = 0;
+    for (unsigned a = 0; a < VertexAttrib::kCount; ++a) {
+        if ((stored & (1u << a)) && streamOf(a) == stream) bytes += attributeBytes(format, a);
+    }
+    return bytes;
+}
+
+size_t stride(VertexFormat format, uint32_t attributes) {
+    return streamStride(format, attributes, 0) + streamStride(format, attributes, 1);
+}
+
+const char* name(VertexFormat format) {
+    return format == VertexFormat::Compact ? "Compact" : "Full";
+}
+
+uint16_t floatToHalf(float value) {
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const uint32_t sign     = (bits >> 16) & 0x8000u;
+    const int32_t  exponent = static_cast<int32_t>((bits >> 23) & 0xFFu) - 127 + 15;
+    uint32_t       mantissa = bits & 0x7FFFFFu;
+
+    if (((bits >> 23) & 0xFFu) == 0xFFu) {                  // Inf / NaN
+        return static_cast<uint16_t>(sign | 0x7C00u | (mantissa ? 0x200u : 0u));
+    }
+    if (exponent >= 31) {                                   // 上溢 -> Inf
+        return static_cast<uint16_t>(sign | 0x7C00u);
+    }
+    if (exponent <= 0) {                                    // 非规格化数 / 下溢
+        if (exponent < -10) return static_cast<uint16_t>(sign);
+        mantissa |= 0x800000u;
+        const uint32_t shift = static_cast<uint32_t>(14 - exponent);
+        uint32_t half = mantissa >> shift;
+        if ((mantissa >> (shift - 1)) & 1u) half += 1;      // 四舍五入
+        return static_cast<uint16_t>(sign | half);
+    }
+
+    uint32_t half = sign | (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+    if (mantissa & 0x1000u) half += 1;                      // 四舍五入 (进位可能溢出到指数, 结果仍正确)
+    return static_cast<uint16_t>(half);
+}
+
+glm::vec2 octEncode(const glm::vec3& normal) {
+    const float l1 = std::fabs(normal.x) + std::fabs(normal.y) + std::fabs(normal.z);
+    if (l1 <= 0.0f) return glm::vec2(0.0f);
+
+    glm::vec2 p = glm::vec2(normal.x, normal.y) / l1;
+    if (normal.z < 0.0f) {
+        // 下半球折叠到外侧三角形
+        const glm::vec2 folded = (glm::vec2(1.0f) - glm::abs(glm::vec2(p.y, p.x)));
+        p = glm::vec2(p.x >= 0.0f ? folded.x : -folded.x,
+                      p.y >= 0.0f ? folded.y : -folded.y);
+    }
+    return p;
+}
+
+static uint16_t quantizeUnorm16(float value) {
+    const float clamped = glm::clamp(value, 0.0f, 1.0f);
+    return static_cast<uint16_t>(std::lround(clamped * 65535.0f));
+}
+
+static int16_t quantizeSnorm16(float value) {
+    const float clamped = glm::clamp(value, -1.0f, 1.0f);
+    return static_cast<int16_t>(std::lround(clamped * 32767.0f));
+}
+
+void pack(VertexFormat format,
+          uint32_t attributes,
+          const Vertex* vertices,
+          size_t count,
+          const glm::vec3& boundsMin,
+          const glm::vec3& boundsMax,
+          uint8_t* out) {
+    const uint32_t stored = storedAttributes(format, attributes);
+    if (count == 0) return;
+    const Vertex* const end = vertices + count;
+
+    if (interleavedVertex(format, stored)) {
+        std::memcpy(out, vertices, count * sizeof(Vertex));
+        return;
+    }
+
+    // 每个属性的写入位置: 流起点 + 属性偏移, 每个顶点前进该流的步长
+    const size_t strides[2] = { streamStride(format, stored, 0), streamStride(format, stored, 1) };
+    uint8_t* const streams[2] = { out, out + count * strides[0] };
+    uint8_t* cursor[VertexAttrib::kCount] = {};
+    size_t step[VertexAttrib::kCount] = {};
+    for (unsigned a = 0; a < VertexAttrib::kCount; ++a) {
+        if (stored & (1u << a)) {
+            cursor[a] = streams[streamOf(a)] + attributeOffset(format, stored, a);
+            step[a] = strides[streamOf(a)];
+        }
+    }
+
+    if (format == VertexFormat::Full) {
+        for (const Vertex* src = vertices; src != end; ++src) {
+            const float* fields[VertexAttrib::kCount] = {
+                &src->Position.x, &src->Normal.x, &src->TexCoords.x, &src->Tangent.x, &src->Bitangent.x,
+            };
+            for (unsigned a = 0; a < VertexAttrib::kCount; ++a) {
+                if (!cursor[a]) continue;
+                std::memcpy(cursor[a], fields[a], kFullBytes[a]);
+                cursor[a] += step[a];
+            }
+        }
+        return;
+    }
+
+    // 退化轴 (例如平面模型) 的范围为 0, 量化值统一取 0
+    const glm::vec3 extent = boundsMax - boundsMin;
+    const glm::vec3 invExtent(extent.x > 0.0f ? 1.0f / extent.x : 0.0f,
+                              extent.y > 0.0f ? 1.0f / extent.y : 0.0f,
+                              extent.z > 0.0f ? 1.0f / extent.z : 0.0f);
+
+    for (const Vertex* src = vertices; src != end; ++src) {
+        const glm::vec3 unit = (src->Position - boundsMin) * invExtent;
+        const uint16_t position[4] = { quantizeUnorm16(unit.x), quantizeUnorm16(unit.y), quantizeUnorm16(unit.z), 0 };
+        std::memcpy(cursor[0], position, sizeof(position));
+        cursor[0] += step[0];
+
+        if (cursor[1]) {
+            const glm::vec2 oct = octEncode(src->Normal);
+            const int16_t normal[2] = { quantizeSnorm16(oct.x), quantizeSnorm16(oct.y) };
+            std::memcpy(cursor[1], normal, sizeof(normal));
+            cursor[1] += step[1];
+        }
+        if (cursor[2]) {
+            const uint16_t texCoords[2] = { floatToHalf(src->TexCoords.x), floatToHalf(src->TexCoords.y) };
+            std::memcpy(cursor[2], texCoords, sizeof(texCoords));
+            cursor[2] += step[2];
+        }
+    }
+}
+
+void dequantization(VertexFormat format,
+                    const glm::vec3& boundsMin,
+                    const glm::vec3& boundsMax,
+                    glm::vec3& outScale,
+                    glm::vec3& outOffset) {
+    if (format == VertexFormat::Compact) {
+        outScale  = boundsMax - boundsMin;
+        outOffset = boundsMin;
+    } else {
+        outScale  = glm::vec3(1.0f);
+        outOffset = glm::vec3(0.0f);
+    }
+}
+
+uint32_t indexSizeFor(size_t vertexCount) {
+    return vertexCount <= 65536 ? sizeof(uint16_t) : sizeof(uint32_t);
+}
+
+GLenum indexGLType(uint32_t indexSize) {
+    return indexSize == sizeof(uint16_t) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+}
+
+void packIndices(const uint32_t* indices, size_t count, uint32_t indexSize, uint8_t* out) {
+    if (count == 0) return;
+
+    if (indexSize == sizeof(uint32_t)) {
+        std::memcpy(out, indices, count * sizeof(uint32_t));
+        return;
+    }
+    uint16_t* dst = reinterpret_cast<uint16_t*>(out);
+    for (size_t i = 0; i < count; ++i) {
+        dst[i] = static_cast<uint16_t>(indices[i]);
+    }
+}
+
+void setupAttributes(VertexFormat format, uint32_t attributes, size_t secondStreamOffset) {
+    struct AttributeType {
+        GLint     components;
+        GLenum    type;
+        GLboolean normalized;
+    };
+    // 位置 / 法线 / 纹理坐标 / 切线 / 副切线
+    static const AttributeType kFull[VertexAttrib::kCount] = {
+        { 3, GL_FLOAT, GL_FALSE }, { 3, GL_FLOAT, GL_FALSE }, { 2, GL_FLOAT, GL_FALSE },
+        { 3, GL_FLOAT, GL_FALSE }, { 3, GL_FLOAT, GL_FALSE },
+    };
+    // Compact: 位置归一化到 [0,1] (着色器中用 uPosScale/uPosOffset 还原), 法线为八面体编码
+    static const AttributeType kCompact[VertexAttrib::kCount] = {
+        { 3, GL_UNSIGNED_SHORT, GL_TRUE }, { 2, GL_SHORT, GL_TRUE }, { 2, GL_HALF_FLOAT, GL_FALSE },
+        { 0, GL_NONE, GL_FALSE }, { 0, GL_NONE, GL_FALSE },
+    };
+    const AttributeType* types = format == VertexFormat::Compact ? kCompact : kFull;
+
+    const uint32_t stored = storedAttributes(format, attributes);
+    const size_t streamBase[2] = { 0, secondStreamOffset };
+    for (unsigned a = 0; a < VertexAttrib::kCount; ++a) {
+        if (!(stored & (1u << a))) {
+            // 未保存的属性: 着色器读到的是常量默认值
+            glDisableVertexAttribArray(a);
+            continue;
+        }
+        const unsigned stream = interleavedVertex(format, stored) ? 0u : streamOf(a);
+        const size_t s = streamStride(format, stored, stream);
+        glEnableVertexAttribArray(a);
+        glVertexAttribPointer(a, types[a].components, types[a].type, types[a].normalized, static_cast<GLsizei>(s),
+                              (void*)(streamBase[stream] + attributeOffset(format, stored, a)));
+    }
+}
+
+} // namespace VertexLayout
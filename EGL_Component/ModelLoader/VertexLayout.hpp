@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "macros.h"
+
+// 通用顶点结构，适用于大多数现代渲染需求 (导入阶段的解码格式, 也是 Full 布局的 GPU 格式)
+struct Vertex {
+    glm::vec3 Position;
+    glm::vec3 Normal;
+    glm::vec2 TexCoords;
+    glm::vec3 Tangent;
+    glm::vec3 Bitangent;
+};
+
+// GPU 端顶点格式
+enum class VertexFormat : uint32_t {
+    Full    = 0,    // float 属性, 全部属性时为 Vertex 原样上传 (56 字节)
+    Compact = 1,    // 量化属性 (CompactVertex 的各分量), 全部属性时 16 字节
+};
+
+// 顶点属性集合 (位序号即着色器中的 location, 与 ShaderProgram::activeAttributeMask 的位一致)
+namespace VertexAttrib {
+    constexpr uint32_t Position  = 1u << 0;
+    constexpr uint32_t Normal    = 1u << 1;
+    constexpr uint32_t TexCoord  = 1u << 2;
+    constexpr uint32_t Tangent   = 1u << 3;
+    constexpr uint32_t Bitangent = 1u << 4;
+    constexpr uint32_t All       = Position | Normal | TexCoord | Tangent | Bitangent;
+    constexpr unsigned kCount    = 5;
+}
+
+/**
+ * @brief 压缩顶点 (16 字节) 的各分量编码
+ *
+ * - location 0: 位置, uint16 归一化, 相对当前 Mesh 的 AABB (w 分量为填充)
+ * - location 1: 法线, 八面体编码 snorm16 x2
+ * - location 2: 纹理坐标, half float x2 (允许超出 [0,1] 的平铺坐标)
+ * 切线/副切线被丢弃: 现有着色器都不读取它们。
+ * 实际上传时按属性流拆分 (见 VertexLayout::pack), 结构体本身只作为编码参考与全属性时的大小。
+ */
+struct CompactVertex {
+    uint16_t position[4];
+    int16_t  normal[2];
+    uint16_t texCoords[2];
+};
+static_assert(sizeof(CompactVertex) == 16, "CompactVertex must stay 16 bytes");
+
+/*
+    属性流: 流 0 = 位置 [+ 纹理坐标], 拾取/轮廓这类只读位置与 UV 的 pass 只拉取这一段;
+    流 1 = 其余属性 (法线 / 切线 / 副切线)。每个 Mesh 的编码结果为 [流 0 x n][流 1 x n]。
+    例外: Full 格式且属性齐全时保持 Vertex 原样交错的单流布局 (glTF 零拷贝映射依赖它)。
+*/
+namespace VertexLayout {
+
+    // 格式实际能保存的属性: 位置总是保存, Compact 不保存切线/副切线
+    uint32_t storedAttributes(VertexFormat format, uint32_t attributes);
+
+    // 每个顶点的总字节数 (各流之和)
+    size_t stride(VertexFormat format, uint32_t attributes = VertexAttrib::All);
+
+    // 单个流的步长, 流中没有属性时为 0
+    size_t streamStride(VertexFormat format, uint32_t attributes, unsigned stream);
+
+    const char* name(VertexFormat format);
+
+    /**
+     * @brief 把导入得到的 count 个 Vertex 编码为目标格式, 只写出 attributes 中的属性
+     * @param boundsMin/boundsMax 当前 Mesh 的 AABB, Compact 布局以此量化位置
+     * @param out 至少 count * stride(format, attributes) 字节, 由调用方分配 (导入 arena 或 vector)
+     */
+    void pack(VertexFormat format,
+              uint32_t attributes,
+              const Vertex* vertices,
+              size_t count,
+              const glm::vec3& boundsMin,
+              const glm::vec3& boundsMax,
+              uint8_t* out);
+
+    /**
+     * @brief 着色器中还原位置所需的参数: position = aPos * scale + offset
+     *
+     * Full 布局返回 scale = 1, offset = 0, 因此着色器不需要区分两种布局。
+     */
+    void dequantization(VertexFormat format,
+                        const glm::vec3& boundsMin,
+                        const glm::vec3& boundsMax,
+                        glm::vec3& outScale,
+                        glm::vec3& outOffset);
+
+    /**
+     * @brief 为当前绑定的 VAO / GL_ARRAY_BUFFER 设置 location 0-4 的顶点属性指针, 未保存的属性被禁用
+     * @param secondStreamOffset 流 1 在缓冲区中的起始字节 (流 0 从 0 开始)
+     */
+    void setupAttributes(VertexFormat format, uint32_t attributes, size_t secondStreamOffset);
+
+    /**
+     * @brief 索引宽度: 顶点数不超过 65536 时使用 2 字节 (GL_UNSIGNED_SHORT), 否则 4 字节
+     */
+    uint32_t indexSizeFor(size_t vertexCount);
+
+    GLenum indexGLType(uint32_t indexSize);
+
+    // 把 count 个 32 位索引按 indexSize 编码到 out (至少 count * indexSize 字节)
+    void packIndices(const uint32_t* indices, size_t count, uint32_t indexSize, uint8_t* out);
+
+    // 编码辅助函数
+    uint16_t floatToHalf(float value);
+    glm::vec2 octEncode(const glm::vec3& normal);     // 返回 [-1,1]^2
+
+} // namespace VertexLayout
@@ -18,11 +18,12 @@ public:
 
     /// 允许移动，不允许拷贝 ID是一个独一无二的资源, 不能被复制 RAII(资源获取即初始化)
     // operator相当于类中的方法, 
-    ShaderProgram(ShaderProgram&& other) noexcept : ID(other.ID) { other.ID = 0; }
+    ShaderProgram(ShaderProgram&& other) noexcept : ID(other.ID), m_activeAttributes(other.m_activeAttributes) { other.ID = 0; }
     ShaderProgram& operator=(ShaderProgram&& other) noexcept {
         if (this != &other) {
             if (ID) glDeleteProgram(ID);
             ID = other.ID;
+            m_activeAttributes = other.m_activeAttributes;
             other.ID = 0;
         }
         return *this;
@@ -40,6 +41,13 @@ public:
     GLuint handle()      const { return ID; }
     GLint  uniform(const char* name) const { return glGetUniformLocation(ID, name); }
 
+    /**
+     * @brief 链接后反射得到的活动顶点属性: 第 i 位表示 location i 被着色器实际读取
+     *        (声明了但未使用的属性会被链接器剔除, 不计入; 矩阵属性占用连续多个 location)
+     *        低 5 位与 VertexAttrib 一致, 用于核对模型上传的属性是否满足该程序
+     */
+    uint32_t activeAttributeMask() const { return m_activeAttributes; }
+
     // uniform的实用函数
     /*
         example:
@@ -107,6 +115,7 @@ public:
     // ------------------------------------------------------------------------
 private:
     GLuint ID = 0;
+    uint32_t m_activeAttributes = 0;
 
     void compile(const std::string& vsSrc,
                  const std::string& fsSrc)
@@ -119,6 +128,7 @@ private:
         glAttachShader(ID, fs);
         glLinkProgram(ID);
         checkLinkErrors();
+        reflectAttributes();
 
         glDeleteShader(vs);
         glDeleteShader(fs);
@@ -142,6 +152,30 @@ private:
         return shader;
     }
 
+    void reflectAttributes()
+    {
+        GLint count = 0;
+        GLint maxLength = 0;
+        glGetProgramiv(ID, GL_ACTIVE_ATTRIBUTES, &count);
+        glGetProgramiv(ID, GL_ACTIVE_ATTRIBUTE_MAX_LENGTH, &maxLength);
+        std::string name(static_cast<size_t>(maxLength > 0 ? maxLength : 1), '\0');
+        for (GLint i = 0; i < count; ++i) {
+            GLsizei length = 0;
+            GLint size = 0;
+            GLenum type = 0;
+            glGetActiveAttrib(ID, static_cast<GLuint>(i), static_cast<GLsizei>(name.size()), &length, &size, &type, &name[0]);
+            const GLint location = glGetAttribLocation(ID, name.c_str());
+            if (location < 0) continue;     // gl_VertexID 等内置变量
+            GLint slots = 1;
+            if (type == GL_FLOAT_MAT2) slots = 2;
+            else if (type == GL_FLOAT_MAT3) slots = 3;
+            else if (type == GL_FLOAT_MAT4) slots = 4;
+            for (GLint s = 0; s < slots * size && location + s < 32; ++s) {
+                m_activeAttributes |= 1u << (location + s);
+            }
+        }
+    }
+
     void checkLinkErrors()
     {
         GLint ok{};
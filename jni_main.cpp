@@ -26,48 +26,97 @@ static std::thread g_render_thread;
 static std::atomic<bool> g_is_rendering(false);
 // 用于保护 g_renderer 的互斥锁
 static std::mutex g_renderer_mutex;
+// 当前渲染器加载的模型目录; 同一目录再次 draw_wind_test 时只更换绘制表面
+static std::string g_model_dir;
 
-extern "C" {
-
-JNIEXPORT void JNICALL
-Java_com_example_learnkotlin_MainActivity_stop_1render(JNIEnv *env, jobject thiz) {
+// 停止渲染线程 (渲染线程退出前让出 EGL 上下文), 渲染器保留
+static void join_render_thread() {
     g_is_rendering = false;
     if (g_render_thread.joinable()) {
         g_render_thread.join();
     }
+}
+
+static void render_loop(ModelRenderer* renderer) {
+    while (g_is_rendering) {
+        renderer->draw();
+        std::this_thread::sleep_for(std::chrono::milliseconds(16));
+    }
+    renderer->releaseCurrent();
+}
+
+extern "C" {
+
+JNIEXPORT void JNICALL
+Java_com_example_learnkotlin_MainActivity_stop_1render(JNIEnv *env, jobject thiz) {
+    join_render_thread();
     std::lock_guard<std::mutex> lock(g_renderer_mutex);
     if (g_renderer) {
         delete g_renderer;
         g_renderer = nullptr;
     }
+    g_model_dir.clear();
 }
 
+// Surface 销毁 (surfaceDestroyed): 停止绘制并释放窗口表面, EGL 上下文与全部 GL 资源保留
 JNIEXPORT void JNICALL
-Java_com_example_learnkotlin_MainActivity_draw_1wind_1test(JNIEnv *env, jobject thiz, jobject surface, jint w, jint h, jstring path) {
-    if (g_is_rendering) {
-        Java_com_example_learnkotlin_MainActivity_stop_1render(env, thiz);
+Java_com_example_learnkotlin_MainActivity_detach_1surface(JNIEnv *env, jobject thiz) {
+    join_render_thread();
+    std::lock_guard<std::mutex> lock(g_renderer_mutex);
+    if (g_renderer) {
+        g_renderer->detachSurface();
     }
+}
 
+JNIEXPORT void JNICALL
+Java_com_example_learnkotlin_MainActivity_draw_1wind_1test(JNIEnv *env, jobject thiz, jobject surface, jint w, jint h, jstring path) {
     const char *model_dir_path = env->GetStringUTFChars(path, nullptr);
     std::string model_dir_str = model_dir_path;
     env->ReleaseStringUTFChars(path, model_dir_path);
 
+    join_render_thread();
+    // 是复用还是重建都在锁内决定, 之后只使用这里取到的结果, 不再在锁外读取 g_renderer
+    ModelRenderer* existing = nullptr;
+    bool replace = false;
+    {
+        std::lock_guard<std::mutex> lock(g_renderer_mutex);
+        if (g_renderer && g_model_dir == model_dir_str) {
+            existing = g_renderer;
+        }
+        replace = g_renderer && !existing;
+    }
+    // 换了场景: 完整重建渲染器
+    if (replace) {
+        Java_com_example_learnkotlin_MainActivity_stop_1render(env, thiz);
+    }
+
     ANativeWindow *nativeWindow = ANativeWindow_fromSurface(env, surface);
 
     g_is_rendering = true;
 
+    if (existing) {
+        // 同一场景的表面重建 (旋转、切换应用): 同一个 EGL 上下文挂到新窗口, 模型/纹理/程序/FBO 不重新创建
+        g_render_thread = std::thread([=]() {
+            if (!existing->attachSurface(nativeWindow, w, h)) {
+                LOGD("attachSurface failed, renderer stays detached");
+                return;
+            }
+            render_loop(existing);
+        });
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(g_renderer_mutex);
+        g_model_dir = model_dir_str;
+    }
     g_render_thread = std::thread([=]() {
         ModelRenderer* local_renderer = new ModelRenderer(nativeWindow, model_dir_str, w, h);
         {
             std::lock_guard<std::mutex> lock(g_renderer_mutex);
             g_renderer = local_renderer;
         }
-
-        while (g_is_rendering) {
-            local_renderer->draw();
-            std::this_thread::sleep_for(std::chrono::milliseconds(16));
-        }
-
+        render_loop(local_renderer);
         // Renderer is deleted in stop_render
     });
 }
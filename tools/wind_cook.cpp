@@ -0,0 +1,354 @@
+/*
+    wind_cook: 把模型目录烘焙为单个资源包 (.wpak), 运行时由 VirtualFileSystem 挂载到同一目录上
+
+    用法:
+        wind_cook <模型目录> <输出.wpak> [选项]
+
+    选项:
+        --codec etc2|bc|none    纹理压缩格式, 可重复指定 (默认 etc2; none 表示不生成 KTX)
+        --format compact|full   网格缓存的顶点格式, 需与运行时 ModelLoadOptions::vertexFormat 一致 (默认 compact)
+        --attributes <列表>     网格缓存保存的属性, 逗号分隔: position,normal,texcoord,tangent,bitangent
+                                需与运行时 ModelLoadOptions::vertexAttributes 一致 (默认 position,texcoord, 同 ModelRenderer)
+        --shaders <目录>        同时打包该目录下 (递归) 的 *.glsl, 预处理方式同 Convert_GLSL_to_h.py
+        --strip-sources         已烘焙成功的模型源文件与已生成全部 KTX 的源图不再打包 (默认保留, 供回退路径使用)
+
+    包内条目 (路径相对模型目录):
+        <模型>.meshcache            MeshCache 格式, 与运行时 Model 写出的缓存相同
+        <图片>.<codec>.ktx          带 mip 链的 KTX1, 天空盒 (skybox/) 按 Skybox 的加载选项不翻转、不生成 mip
+        shaders/<名称>.core|.es     去掉注释与空行的着色器源码, 分别为桌面 Core 与 GLES 3.1 版本头
+        其余文件                    原样拷贝 (glTF / .bin / MTL / 未能烘焙的模型等)
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <regex>
+#include <string>
+#include <vector>
+
+#include "AssetPackage.hpp"
+#include "ModelLoader_Universal_Instancing.hpp"
+#include "TextureEncoder.hpp"
+#include "TextureFormat.hpp"
+#include "TextureLoader.hpp"
+#include "ThreadPool.hpp"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct CookOptions {
+    std::string sourceDir;
+    std::string outputPath;
+    std::string shaderDir;
+    std::vector<TextureCodec> codecs;
+    VertexFormat vertexFormat = VertexFormat::Compact;
+    uint32_t vertexAttributes = VertexAttrib::Position | VertexAttrib::TexCoord;
+    bool stripSources = false;
+};
+
+void printUsage() {
+    std::printf("usage: wind_cook <models dir> <output.wpak> [--codec etc2|bc|none]... [--format compact|full]\n"
+                "                 [--attributes position,normal,texcoord,tangent,bitangent] [--shaders <dir>] [--strip-sources]\n");
+}
+
+std::string lowerExtension(const fs::path& path) {
+    std::string extension = path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+    return extension;
+}
+
+bool isImage(const std::string& extension) {
+    return extension == ".jpg" || extension == ".jpeg" || extension == ".png" || extension == ".tga" || extension == ".bmp";
+}
+
+// 交给 Model 烘焙为网格缓存的格式; glTF 由原生读取器直接映射, 不经过网格缓存, 原样打包
+bool isCookableModel(const std::string& extension) {
+    return extension == ".obj" || extension == ".fbx" || extension == ".dae" || extension == ".3ds" ||
+           extension == ".ply" || extension == ".stl" || extension == ".blend";
+}
+
+bool parseAttributes(const std::string& list, uint32_t& out) {
+    out = 0;
+    size_t start = 0;
+    while (start <= list.size()) {
+        const size_t comma = std::min(list.find(',', start), list.size());
+        const std::string name = list.substr(start, comma - start);
+        if (name == "position")       out |= VertexAttrib::Position;
+        else if (name == "normal")    out |= VertexAttrib::Normal;
+        else if (name == "texcoord")  out |= VertexAttrib::TexCoord;
+        else if (name == "tangent")   out |= VertexAttrib::Tangent;
+        else if (name == "bitangent") out |= VertexAttrib::Bitangent;
+        else return false;
+        start = comma + 1;
+    }
+    return out != 0;
+}
+
+bool parseArguments(int argc, char** argv, CookOptions& options) {
+    if (argc < 3) return false;
+    options.sourceDir  = argv[1];
+    options.outputPath = argv[2];
+    bool codecGiven = false;
+    for (int i = 3; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (arg == "--codec" && hasValue) {
+            const std::string value = argv[++i];
+            codecGiven = true;
+            if (value == "etc2")      options.codecs.push_back(TextureCodec::ETC2);
+            else if (value == "bc")   options.codecs.push_back(TextureCodec::BC);
+            else if (value != "none") return false;
+        } else if (arg == "--format" && hasValue) {
+            const std::string value = argv[++i];
+            if (value == "compact")   options.vertexFormat = VertexFormat::Compact;
+            else if (value == "full") options.vertexFormat = VertexFormat::Full;
+            else return false;
+        } else if (arg == "--attributes" && hasValue) {
+            if (!parseAttributes(argv[++i], options.vertexAttributes)) return false;
+        } else if (arg == "--shaders" && hasValue) {
+            options.shaderDir = argv[++i];
+        } else if (arg == "--strip-sources") {
+            options.stripSources = true;
+        } else {
+            return false;
+        }
+    }
+    if (!codecGiven) options.codecs.push_back(TextureCodec::ETC2);
+    return true;
+}
+
+std::vector<uint8_t> toBytes(const std::string& text) {
+    return std::vector<uint8_t>(text.begin(), text.end());
+}
+
+// ---- 着色器: 与 Convert_GLSL_to_h.py 相同的预处理 ----
+
+std::string preprocessShader(std::string source) {
+    if (source.compare(0, 3, "\xEF\xBB\xBF") == 0) source.erase(0, 3);
+    source = std::regex_replace(source, std::regex("\r\n?"), "\n");
+    source = std::regex_replace(source, std::regex("/\\*[\\s\\S]*?\\*/"), "");
+    source = std::regex_replace(source, std::regex("//[^\n]*"), "");
+
+    // 去掉行尾空白, 连续空行合并为一行, 去掉首尾空行
+    std::string result;
+    bool previousEmpty = true;
+    size_t start = 0;
+    while (start < source.size()) {
+        size_t end = source.find('\n', start);
+        if (end == std::string::npos) end = source.size();
+        std::string line = source.substr(start, end - start);
+        line.erase(line.find_last_not_of(" \t") + 1);
+        if (!line.empty() || !previousEmpty) {
+            result += line;
+            result += '\n';
+        }
+        previousEmpty = line.empty();
+        start = end + 1;
+    }
+    while (!result.empty() && (result.back() == '\n')) result.pop_back();
+    return result;
+}
+
+std::string shaderForDesktop(const std::string& source) {
+    if (std::regex_search(source, std::regex("#version\\s+\\d+\\s+core"))) return source;
+    return std::regex_replace(source, std::regex("#version\\s+(\\d+)"), "#version $1 core");
+}
+
+std::string shaderForGLES(const std::string& source) {
+    std::string result = std::regex_replace(source, std::regex("#version\\s+\\d+\\s+core"), "#version 310 es");
+    result = std::regex_replace(result, std::regex("#extension\\s+GL_ARB_separate_shader_objects\\s*:\\s*enable\\s*\n?"), "");
+    result = std::regex_replace(result, std::regex("#extension\\s+GL_ARB_shading_language_420pack\\s*:\\s*enable\\s*\n?"), "");
+    return std::regex_replace(result, std::regex("(#version\\s+310\\s+es\\s*\n)"), "$1\nprecision highp float;\n");
+}
+
+size_t cookShaders(const std::string& shaderDir, AssetPackageWriter& writer) {
+    size_t count = 0;
+    std::error_code error;
+    for (fs::recursive_directory_iterator it(shaderDir, error), end; !error && it != end; it.increment(error)) {
+        if (!it->is_regular_file() || lowerExtension(it->path()) != ".glsl") continue;
+        if (it->path().generic_string().find("/3rdparty/") != std::string::npos) continue;
+
+        AssetFile file;
+        if (!file.open(it->path().string())) continue;
+        const std::string source = preprocessShader(std::string(reinterpret_cast<const char*>(file.data()), file.size()));
+        const std::string name = "shaders/" + it->path().stem().string();     // wind.vert.glsl -> shaders/wind.vert
+        writer.add(name + ".core", AssetPackage::Kind::Shader, toBytes(shaderForDesktop(source)));
+        writer.add(name + ".es", AssetPackage::Kind::Shader, toBytes(shaderForGLES(source)));
+        ++count;
+    }
+    return count;
+}
+
+// ---- 网格: 由 Model 以运行时相同的选项导入, 写出 (或复用) 源文件旁的 .meshcache ----
+
+bool cookModel(const std::string& path, const CookOptions& options, std::vector<uint8_t>& out) {
+    ModelLoadOptions loadOptions;
+    loadOptions.vertexFormat     = options.vertexFormat;
+    loadOptions.vertexAttributes = options.vertexAttributes;
+    loadOptions.stageTextures    = false;
+    loadOptions.residency        = ResidencyPolicy::Lean;
+    try {
+        Model model(path, loadOptions);
+
+        // 按运行时的键重新打开: 只有与运行时选项一致的缓存才会被打包
+        MeshCache::Key key;
+        MeshCache cache;
+        if (!model.meshCacheKey(key) || !cache.open(MeshCache::cachePathFor(path), key)) {
+            std::printf("  %s: no mesh cache was produced (embedded textures?), packing the source instead\n", path.c_str());
+            return false;
+        }
+        cache.close();
+    } catch (const std::exception& e) {
+        std::printf("  %s: import failed (%s)\n", path.c_str(), e.what());
+        return false;
+    }
+
+    MappedFile file;
+    if (!file.open(MeshCache::cachePathFor(path))) return false;
+    out.assign(file.data(), file.data() + file.size());
+    return true;
+}
+
+// ---- 纹理: 与 TextureEncoder::cookFile 相同的编码, 结果写入内存 ----
+
+struct TextureJob {
+    std::string sourcePath;
+    std::string entryPath;
+    bool flipVertically = true;
+    bool generateMipmaps = true;
+    std::vector<std::vector<uint8_t>> variants;     // 与 CookOptions::codecs 一一对应, 失败时为空
+};
+
+void cookTexture(TextureJob& job, const std::vector<TextureCodec>& codecs) {
+    job.variants.resize(codecs.size());
+    if (codecs.empty()) return;
+
+    TextureLoader::Image image;
+    if (!TextureLoader::decodeFile(job.sourcePath, job.flipVertically, image)) {
+        std::printf("  %s: decode failed\n", job.sourcePath.c_str());
+        return;
+    }
+    for (size_t c = 0; c < codecs.size(); ++c) {
+        CompressedImage compressed;
+        if (TextureEncoder::encode(image.pixels.data(), image.width, image.height, image.channels, job.flipVertically,
+                                   codecs[c], job.generateMipmaps, compressed)) {
+            TextureFormat::writeKTX(compressed, job.variants[c]);
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    CookOptions options;
+    if (!parseArguments(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+    if (!fs::is_directory(options.sourceDir)) {
+        std::printf("wind_cook: %s is not a directory\n", options.sourceDir.c_str());
+        return 1;
+    }
+
+    const auto cookStart = std::chrono::high_resolution_clock::now();
+    const fs::path root = fs::path(options.sourceDir).lexically_normal();
+    AssetPackageWriter writer;
+
+    // ---- 1. 扫描源目录 ----
+    std::vector<fs::path> models;
+    std::vector<TextureJob> textures;
+    std::vector<fs::path> rawFiles;
+    std::error_code error;
+    for (fs::recursive_directory_iterator it(root, error), end; !error && it != end; it.increment(error)) {
+        if (!it->is_regular_file()) continue;
+        const fs::path& path = it->path();
+        const std::string extension = lowerExtension(path);
+        if (extension == ".meshcache" || extension == ".tmp" || extension == ".wpak") continue;     // 旧的烘焙产物
+
+        const std::string relative = path.lexically_relative(root).generic_string();
+        if (isCookableModel(extension)) {
+            models.push_back(path);
+        } else if (isImage(extension)) {
+            TextureJob job;
+            job.sourcePath = path.string();
+            job.entryPath  = relative;
+            // 天空盒与 Skybox::loadCubemap 的选项一致; 其余 (模型材质 / GlobalTextureManager) 均为翻转 + mip
+            const bool skybox = relative.compare(0, 7, "skybox/") == 0;
+            job.flipVertically  = !skybox;
+            job.generateMipmaps = !skybox;
+            textures.push_back(std::move(job));
+        } else {
+            rawFiles.push_back(path);   // 已有的 KTX (如 astcenc 生成的 .astc.ktx) 也在这里原样打包
+        }
+    }
+    if (error) {
+        std::printf("wind_cook: failed to scan %s (%s)\n", options.sourceDir.c_str(), error.message().c_str());
+        return 1;
+    }
+
+    // ---- 2. 网格 (Model 内部已按核心数并行) ----
+    size_t cookedModels = 0;
+    for (const fs::path& path : models) {
+        const std::string relative = path.lexically_relative(root).generic_string();
+        std::vector<uint8_t> cache;
+        const bool cooked = cookModel(path.string(), options, cache);
+        if (cooked) {
+            writer.add(MeshCache::cachePathFor(relative), AssetPackage::Kind::MeshCache, std::move(cache));
+            ++cookedModels;
+        }
+        if (!cooked || !options.stripSources) {
+            writer.addFile(relative, AssetPackage::Kind::Raw, path.string());
+        }
+    }
+
+    // ---- 3. 纹理 (每张图一个任务) ----
+    std::atomic<size_t> encoded{0};
+    {
+        ThreadPool pool;
+        pool.parallelFor(textures.size(), [&](size_t i) {
+            cookTexture(textures[i], options.codecs);
+            encoded.fetch_add(1);
+        });
+    }
+    size_t cookedVariants = 0;
+    for (TextureJob& job : textures) {
+        bool complete = true;
+        for (size_t c = 0; c < options.codecs.size(); ++c) {
+            if (job.variants[c].empty()) {
+                complete = false;
+                continue;
+            }
+            writer.add(TextureFormat::variantPath(job.entryPath, options.codecs[c]), AssetPackage::Kind::Texture,
+                       std::move(job.variants[c]));
+            ++cookedVariants;
+        }
+        // 设备不支持已烘焙的格式时运行时回退到源图, 因此默认保留
+        if (!complete || !options.stripSources) {
+            writer.addFile(job.entryPath, AssetPackage::Kind::Raw, job.sourcePath);
+        }
+    }
+
+    // ---- 4. 其余文件与着色器 ----
+    for (const fs::path& path : rawFiles) {
+        const std::string relative = path.lexically_relative(root).generic_string();
+        const AssetPackage::Kind kind = TextureFormat::isKTXPath(relative) ? AssetPackage::Kind::Texture : AssetPackage::Kind::Raw;
+        writer.addFile(relative, kind, path.string());
+    }
+    const size_t shaders = options.shaderDir.empty() ? 0 : cookShaders(options.shaderDir, writer);
+
+    if (!writer.write(options.outputPath)) {
+        return 1;
+    }
+
+    std::printf("wind_cook: %d/%d models cooked, %d KTX variants from %d images, %d shaders, %d entries, %d KB payload in %lld ms\n",
+                static_cast<int>(cookedModels), static_cast<int>(models.size()), static_cast<int>(cookedVariants),
+                static_cast<int>(encoded.load()), static_cast<int>(shaders), static_cast<int>(writer.entryCount()),
+                static_cast<int>(writer.payloadBytes() / 1024),
+                static_cast<long long>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::high_resolution_clock::now() - cookStart).count()));
+    return 0;
+}